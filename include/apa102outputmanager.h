@@ -63,7 +63,7 @@ class APA102OutputManager : public IStripOutputManager
     ~APA102OutputManager() override;
 
     SuccessResultWithMessage ApplyConfig(const DeviceConfig& config, const std::vector<std::shared_ptr<GFXBase>>& devices) override;
-    void Show(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader) override;
+    void ShowPlanes(const ChannelPlanes* channels, size_t channelCount, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader) override;
     void Reset() override;
 
     size_t GetActiveChannelCount() const override { return _activeChannelCount; }
@@ -0,0 +1,186 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        blurkernels.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Packed-arithmetic kernels behind GFXBase::blurRows/blurColumns/blur2d.
+//    Each row (or column) of a blur is an independent carry chain, so the
+//    kernel runs several lines side by side, one line per 16-bit lane, and
+//    does one multiply per channel for all of them at once. The math is
+//    exactly FastLED's: nscale8 is (c * (scale + 1)) >> 8 and += is qadd8,
+//    so the output is bit-identical to the per-pixel CRGB version.
+//
+//    Lane packs:
+//
+//      BlurLanesScalar   1 lane,  plain integers; keeps lines strictly in order
+//      BlurLanesSWAR     2 lanes per uint32_t, for the ESP32's 32-bit ALU
+//      BlurLanesVector   8 lanes, GCC vector extensions (SSE2/NEON on hosts)
+//
+//    BlurLanesNative is the widest pack that pays off on the target.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+
+#include "pixeltypes.h"
+
+// BlurLanesScalar
+//
+// One line at a time. Used for Custom xy() layouts, where lines aren't guaranteed to be disjoint
+// and so have to be blurred in the same order as the original kernel did.
+
+struct BlurLanesScalar
+{
+    using Word = uint16_t;
+    static constexpr int kLanes = 1;
+
+    static Word Scale(Word w, uint16_t scalePlusOne) { return (w * scalePlusOne) >> 8; }
+    static Word QAdd(Word a, Word b) { Word sum = a + b; return sum > 255 ? 255 : sum; }
+    static uint8_t Get(Word w, int) { return w; }
+    static void Set(Word& w, int, uint8_t value) { w = value; }
+};
+
+// BlurLanesSWAR
+//
+// Two lines per 32-bit word, in the low byte of each 16-bit lane. A lane value is at most 255 and
+// a scale at most 256, so neither the product nor a saturating sum can carry into the next lane.
+
+struct BlurLanesSWAR
+{
+    using Word = uint32_t;
+    static constexpr int kLanes = 2;
+    static constexpr Word kLowBytes = 0x00FF00FF;
+
+    static Word Scale(Word w, uint16_t scalePlusOne) { return ((w * scalePlusOne) >> 8) & kLowBytes; }
+
+    static Word QAdd(Word a, Word b)
+    {
+        const Word sum = a + b;
+        const Word overflow = sum & 0x01000100;             // Bit 8 of each lane
+        return (sum | (overflow - (overflow >> 8))) & kLowBytes;
+    }
+
+    static uint8_t Get(Word w, int lane) { return w >> (lane * 16); }
+    static void Set(Word& w, int lane, uint8_t value) { w |= static_cast<Word>(value) << (lane * 16); }
+};
+
+// BlurLanesVector
+//
+// Eight lines per 128-bit vector. GCC lowers this to SSE2 or NEON on hosts; it is only built there
+// because Xtensa has no vector unit and would just unroll it back into scalar code.
+
+#if HOST_BUILD
+struct BlurLanesVector
+{
+    typedef uint16_t Word __attribute__((vector_size(16)));
+    static constexpr int kLanes = 8;
+
+    static Word Scale(Word w, uint16_t scalePlusOne) { return (w * scalePlusOne) >> 8; }
+
+    static Word QAdd(Word a, Word b)
+    {
+        const Word sum = a + b;
+        return (sum | -(sum >> 8)) & 0xFF;                  // Any lane past 255 becomes all ones
+    }
+
+    static uint8_t Get(const Word& w, int lane) { return w[lane]; }
+    static void Set(Word& w, int lane, uint8_t value) { w[lane] = value; }
+};
+
+using BlurLanesNative = BlurLanesVector;
+#else
+using BlurLanesNative = BlurLanesSWAR;
+#endif
+
+// BlurLines
+//
+// Blurs lineCount lines of lineLength pixels, starting at pixel `first` of each line; pixelAt(line, i)
+// gives the LED index of pixel i of a line. Each line is FastLED's blur1d: every pixel keeps
+// 255 - amount of itself and leaks amount / 2 into each neighbour, and when first > 0 the pixel
+// just before it still receives its neighbour's share. Lanes past the last line are zero and never
+// stored.
+
+template <typename Lanes, typename PixelAt>
+void BlurLines(CRGB* leds, uint16_t lineCount, uint16_t lineLength, uint16_t first, fract8 blur_amount, PixelAt pixelAt)
+{
+    using Word = typename Lanes::Word;
+    constexpr int kLanes = Lanes::kLanes;
+
+    if (first >= lineLength)
+        return;
+
+    // nscale8 multiplies by scale + 1, so fold the +1 in here once
+    const uint16_t keep = (255 - blur_amount) + 1;
+    const uint16_t seep = (blur_amount >> 1) + 1;
+
+    for (uint16_t line0 = 0; line0 < lineCount; line0 += kLanes)
+    {
+        const int lanes = std::min<int>(kLanes, lineCount - line0);
+
+        auto load = [&](uint16_t i, Word (&channels)[3])
+        {
+            channels[0] = channels[1] = channels[2] = Word{};
+            for (int lane = 0; lane < lanes; lane++)
+            {
+                const CRGB& pixel = leds[pixelAt(line0 + lane, i)];
+                Lanes::Set(channels[0], lane, pixel.r);
+                Lanes::Set(channels[1], lane, pixel.g);
+                Lanes::Set(channels[2], lane, pixel.b);
+            }
+        };
+
+        auto store = [&](uint16_t i, const Word (&channels)[3])
+        {
+            for (int lane = 0; lane < lanes; lane++)
+                leds[pixelAt(line0 + lane, i)] = CRGB(Lanes::Get(channels[0], lane),
+                                                      Lanes::Get(channels[1], lane),
+                                                      Lanes::Get(channels[2], lane));
+        };
+
+        // The previous pixel's result stays in registers until its right-hand neighbour has added its
+        // share, so each pixel is loaded and stored exactly once
+        Word carry[3] = {}, previous[3] = {}, current[3];
+        if (first > 0)
+            load(first - 1, previous);
+
+        for (uint16_t i = first; i < lineLength; i++)
+        {
+            load(i, current);
+            for (int c = 0; c < 3; c++)
+            {
+                const Word part = Lanes::Scale(current[c], seep);
+                current[c] = Lanes::QAdd(Lanes::Scale(current[c], keep), carry[c]);
+                previous[c] = Lanes::QAdd(previous[c], part);
+                carry[c] = part;
+            }
+            if (i > 0)
+                store(i - 1, previous);
+            for (int c = 0; c < 3; c++)
+                previous[c] = current[c];
+        }
+        store(lineLength - 1, previous);
+    }
+}
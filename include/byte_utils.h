@@ -90,3 +90,15 @@ inline uint16_t WORDFromMemory(const uint8_t * payloadData)
     return value;
 #endif
 }
+
+// The same in network byte order, which DDP, E1.31 and Art-Net's headers use
+
+inline uint32_t DWORDFromMemoryBE(const uint8_t * payloadData)
+{
+    return (uint32_t)payloadData[0] << 24 | (uint32_t)payloadData[1] << 16 | (uint32_t)payloadData[2] << 8 | payloadData[3];
+}
+
+inline uint16_t WORDFromMemoryBE(const uint8_t * payloadData)
+{
+    return (uint16_t)(payloadData[0] << 8 | payloadData[1]);
+}
@@ -87,20 +87,24 @@ class PatternRainbowFlag : public EffectWithId<PatternRainbowFlag>
             CRGB::Violet
         };
 
-        uint32_t y = 2;
-
-        for (uint32_t c = 0; c < rainbow.size() && y < MATRIX_HEIGHT; c++)
+        auto& graphics = g();
+        graphics.WithXY([&](auto mapXY)
         {
-            for (uint32_t j = 0; j < 5 && y < MATRIX_HEIGHT; j++)
+            uint32_t y = 2;
+
+            for (uint32_t c = 0; c < rainbow.size() && y < MATRIX_HEIGHT; c++)
             {
-                for (uint32_t x = 0; x < MATRIX_WIDTH; x++)
+                for (uint32_t j = 0; j < 5 && y < MATRIX_HEIGHT; j++)
                 {
-                    g().leds[XY(x, y)] += rainbow[c];
-                }
+                    for (uint32_t x = 0; x < MATRIX_WIDTH; x++)
+                    {
+                        graphics.leds[mapXY(x, y)] += rainbow[c];
+                    }
 
-                y++;
+                    y++;
+                }
             }
-        }
+        });
 
         // Noise
         g().SetNoise(1000, 1000, 0, 4000, 4000);
@@ -14,10 +14,8 @@ class PatternSM2DDPR : public EffectWithId<PatternSM2DDPR> {
     const int Scale = 127;
     const int Speed = 215;
     uint32_t effTimer;
+    std::shared_ptr<const PolarLUT> _polar;         // Fetched again only when the matrix is resized
 
-    const float HALF_WIDTH = MATRIX_WIDTH * .5;
-    const float HALF_HEIGHT = MATRIX_HEIGHT * .5;
-    const float radius = HALF_WIDTH;
     //   byte effect = 1;
 
   public:
@@ -27,24 +25,6 @@ class PatternSM2DDPR : public EffectWithId<PatternSM2DDPR> {
 
     void Start() override {}
 
-    // Use integer-only Pythagorean to compute the radius from x^2 and y^2.
-    int16_t ZVcalcRadius(int16_t x, int16_t y)
-    {
-        x *= x;
-        y *= y;
-        int16_t radi = sin8(x + y);
-        return radi;
-    }
-
-    // From point X,Y, find is the distance to center(X,Y)
-    int16_t ZVcalcDist(uint8_t x, uint8_t y, float center_x, float center_y)
-    {
-        int16_t a = (center_y - y - .5);
-        int16_t b = (center_x - x - .5);
-        int16_t dist = ZVcalcRadius(a, b);
-        return dist;
-    }
-
     void Draw() override
     {
         effTimer = sin8(millis() / 6000) / 10;
@@ -54,11 +34,19 @@ class PatternSM2DDPR : public EffectWithId<PatternSM2DDPR> {
             ZVoffset += 4;
         }
 
-        for (unsigned x = 0; x < MATRIX_WIDTH; x++)
+        // The distance term is sin8 of the squared distance from the middle of the matrix, which
+        // the shared polar map already holds
+        if (!_polar || _polar->width() != g().width() || _polar->height() != g().height())
+            _polar = PolarLUT::Get(PolarLUT::Params::Geometric(g().width(), g().height()));
+
+        const auto& polar = *_polar;
+        const float radius = polar.width() * .5;
+
+        for (unsigned x = 0; x < polar.width(); x++)
         {
-            for (unsigned y = 0; y < MATRIX_HEIGHT; y++)
+            for (unsigned y = 0; y < polar.height(); y++)
             {
-                int dist = ZVcalcDist(x, y, HALF_WIDTH, HALF_HEIGHT);
+                int dist = sin8(polar.at(x, y).squared_radius);
 
                 // exclude outside of circle
                 int brightness = 1;
@@ -27,12 +27,16 @@ class PatternSMHypnosis : public EffectWithId<PatternSMHypnosis>
     void Draw() override
     {
         t += 4;
-        const auto& rMap = GFXBase::getPolarMap();
-
-        for (uint x = 0; x < MATRIX_WIDTH; x++)
-            for (uint y = 0; y < MATRIX_HEIGHT; y++)
-                g().leds[XY(x, y)] = ColorFromPalette(g().IsPalettePaused()
-                                      ? g().GetCurrentPalette()
-                                      : RainbowStripeColors_p, t / 2 + rMap[x][y].scaled_radius + rMap[x][y].angle, sin8(rMap[x][y].angle + (rMap[x][y].scaled_radius * 2) - t));
+        const auto& rMap = g().GetPolarLUT();
+        auto& graphics = g();
+        const CRGBPalette16 palette = graphics.IsPalettePaused() ? graphics.GetCurrentPalette() : CRGBPalette16(RainbowStripeColors_p);
+
+        for (uint x = 0; x < rMap.width(); x++)
+        {
+            graphics.ForEachInSpan(SpanAxis::Column, x, 0, rMap.height(), [&](CRGB& pixel, int y)
+            {
+                pixel = ColorFromPalette(palette, t / 2 + rMap[x][y].scaled_radius + rMap[x][y].angle, sin8(rMap[x][y].angle + (rMap[x][y].scaled_radius * 2) - t));
+            });
+        }
     }
 };
@@ -24,11 +24,11 @@ class PatternSMRadialFire : public EffectWithId<PatternSMRadialFire>
         static uint32_t t;
         t += speed;
 
-        const auto& rMap = GFXBase::getPolarMap();
+        const auto& rMap = g().GetPolarLUT();
 
-        for (uint8_t x = 0; x < MATRIX_WIDTH; x++)
+        for (uint16_t x = 0; x < rMap.width(); x++)
         {
-            for (uint8_t y = 0; y < MATRIX_HEIGHT; y++)
+            for (uint16_t y = 0; y < rMap.height(); y++)
             {
                 uint8_t angle = rMap[x][y].angle;
                 uint8_t radius = rMap[x][y].unscaled_radius; // Use the unscaled radius
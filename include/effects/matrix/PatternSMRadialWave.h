@@ -26,11 +26,11 @@ class PatternSMRadialWave : public EffectWithId<PatternSMRadialWave>
     {
         static uint32_t t = 0;
         t++;
-        const auto& rMap = GFXBase::getPolarMap();
+        const auto& rMap = g().GetPolarLUT();
 
-        for (uint8_t x = 0; x < MATRIX_WIDTH; x++)
+        for (uint16_t x = 0; x < rMap.width(); x++)
         {
-            for (uint8_t y = 0; y < MATRIX_HEIGHT; y++)
+            for (uint16_t y = 0; y < rMap.height(); y++)
             {
                 uint8_t angle = rMap[x][y].angle;
                 uint8_t radius = rMap[x][y].scaled_radius;
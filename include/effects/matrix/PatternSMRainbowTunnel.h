@@ -26,17 +26,18 @@ class PatternSMRainbowTunnel : public EffectWithId<PatternSMRainbowTunnel>
         static uint16_t t;
 
         t += speed;
-        const auto& rMap = GFXBase::getPolarMap();
+        const auto& rMap = g().GetPolarLUT();
 
-        for (uint8_t x = 0; x < MATRIX_WIDTH; x++)
+        auto& graphics = g();
+
+        for (uint x = 0; x < rMap.width(); x++)
         {
-            for (uint8_t y = 0; y < MATRIX_HEIGHT; y++)
+            graphics.ForEachInSpan(SpanAxis::Column, x, 0, rMap.height(), [&](CRGB& pixel, int y)
             {
                 uint8_t angle = rMap[x][y].angle;
                 uint8_t radius = rMap[x][y].scaled_radius;
-                g().leds[XY(x, y)] =
-                    CHSV((angle * scaleX) - t + (radius * scaleY), 255, constrain(radius * 3, 0, 255));
-            }
+                pixel = CHSV((angle * scaleX) - t + (radius * scaleY), 255, constrain(radius * 3, 0, 255));
+            });
         }
     }
 };
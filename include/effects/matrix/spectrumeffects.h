@@ -421,9 +421,8 @@ class SpectrumAnalyzerEffect : public EffectWithId<SpectrumAnalyzerEffect>, virt
 
         offset %= MATRIX_WIDTH;
 
-        for (int y = yOffset2; y < pGFXChannel.height(); y++)
-            for (int x = xOffset; x < xOffset + barWidth; x++)
-                pGFXChannel.setPixel((x - offset + MATRIX_WIDTH) % MATRIX_WIDTH, y, baseColor);
+        for (int x = xOffset; x < xOffset + barWidth; x++)
+            pGFXChannel.fillSpan(SpanAxis::Column, (x - offset + MATRIX_WIDTH) % MATRIX_WIDTH, yOffset2, pGFXChannel.height() - yOffset2, baseColor);
 
         // We draw the highlight in white, but if its falling at a different rate than the bar itself,
         // it indicates a free-floating highlight, and those get faded out based on age
@@ -448,11 +447,11 @@ class SpectrumAnalyzerEffect : public EffectWithId<SpectrumAnalyzerEffect>, virt
                 float agePercent = (float) msPeakAge / (float) MILLIS_PER_SECOND;
                 uint8_t fadeAmount = std::min(255.0f, agePercent * 256);
                 colorHighlight.fadeToBlackBy(fadeAmount);
-                pGFXChannel.drawLine(xOffset, max(0, yOffset-1), xOffset + barWidth - 1, max(0, yOffset-1), colorHighlight);
+                pGFXChannel.fillSpan(SpanAxis::Row, xOffset, max(0, yOffset-1), barWidth, colorHighlight);
             }
             else
             {
-                pGFXChannel.drawLine(xOffset, max(0, yOffset2-1), xOffset + barWidth - 1, max(0, yOffset2-1), colorHighlight);
+                pGFXChannel.fillSpan(SpanAxis::Row, xOffset, max(0, yOffset2-1), barWidth, colorHighlight);
             }
         }
     }
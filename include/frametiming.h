@@ -0,0 +1,179 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        frametiming.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Per-stage timing for the render loop. RenderService::Run and the
+//    output paths time each stage of a frame with the CPU cycle counter
+//    and drop the result into a fixed-bucket log histogram. Recording is
+//    a couple of relaxed atomic increments and never takes a lock, so it
+//    is safe on any task and cheap enough to leave on; the web server and
+//    the CLI's "timings" command read percentiles out of the same
+//    histograms from their own tasks, and "timings reset" starts them over.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <array>
+#include <atomic>
+
+// RenderStage
+//
+// The stages of one pass through RenderService::Run. PostProcess includes Show, which is also
+// recorded on its own so transport time can be told apart from brightness/power work. When
+// OutputService runs Show on its own task, PostProcess includes Snapshot and OutputWait instead,
+// and Show and OutputQueue are recorded from the output task.
+
+enum class RenderStage : uint8_t
+{
+    Lock,           // Waiting for g_render_mutex + g_effect_manager_mutex
+    WiFiDraw,       // Draining incoming color data buffers
+    LocalDraw,      // EffectManager::Update and the VU meter
+    PostProcess,    // GFXBase::PostProcessFrame, including Show
+    Show,           // Output transport (RMT/I2S/SPI) or HUB75 buffer swap
+    Snapshot,       // Copying a frame into OutputService's pool
+    OutputWait,     // Render task held back because every pooled frame is still waiting to be shown
+    OutputQueue,    // A pooled frame's wait between being posted and its Show starting
+    Sleep,          // Delay until the next frame is due
+    Count
+};
+
+// StageHistogram
+//
+// Microsecond samples bucketed with four linear sub-buckets per power of two, so any reported
+// percentile is within about 25% of the true value. Buckets cover 0us to ~16s; anything longer
+// lands in the last one. Any task may record - the draw task records most stages, and the output
+// task records Show and OutputQueue when OutputService runs - and any number may read, so counts
+// are relaxed atomic increments and readers take an unsynchronized snapshot. Counts run from boot
+// until Reset(), which can drop a sample recorded while it runs.
+
+class StageHistogram
+{
+  public:
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kSubBuckets    = 1 << kSubBucketBits;
+    static constexpr size_t kMaxExponent   = 24;
+    static constexpr size_t kBucketCount   = (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+    void Record(uint32_t micros)
+    {
+        _buckets[BucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns the upper bound, in microseconds, of the bucket holding the given percentile (0-100),
+    // or 0 if nothing has been recorded yet.
+    uint32_t Percentile(float percentile) const;
+
+    uint32_t Count() const;
+
+    void Reset();
+
+    static constexpr size_t BucketFor(uint32_t micros)
+    {
+        if (micros < kSubBuckets)
+            return micros;
+
+        const size_t exponent = 31 - __builtin_clz(micros);
+        if (exponent >= kMaxExponent)
+            return kBucketCount - 1;
+
+        const size_t subBucket = (micros >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+        return (exponent - kSubBucketBits + 1) * kSubBuckets + subBucket;
+    }
+
+    static constexpr uint32_t BucketUpperBound(size_t bucket)
+    {
+        if (bucket < kSubBuckets)
+            return bucket;
+
+        const size_t exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+        const uint32_t width = 1u << (exponent - kSubBucketBits);
+        const uint32_t lower = (kSubBuckets + bucket % kSubBuckets) << (exponent - kSubBucketBits);
+        return lower + width - 1;
+    }
+
+  private:
+    std::array<std::atomic<uint32_t>, kBucketCount> _buckets {};
+};
+
+// FrameTimings
+//
+// One histogram per RenderStage. Stages are timed in CPU cycles and converted to microseconds
+// when recorded; the render task is pinned to one core, so start and end always read the same
+// counter.
+
+class FrameTimings
+{
+    std::array<StageHistogram, static_cast<size_t>(RenderStage::Count)> _stages;
+
+  public:
+    static const char* StageName(RenderStage stage);
+
+    void Record(RenderStage stage, uint32_t startCycles, uint32_t endCycles);
+
+    // For intervals that start on one task and end on another, where the two cycle counters
+    // can't be compared
+
+    void RecordMicros(RenderStage stage, uint32_t micros)
+    {
+        _stages[static_cast<size_t>(stage)].Record(micros);
+    }
+
+    const StageHistogram& Stage(RenderStage stage) const
+    {
+        return _stages[static_cast<size_t>(stage)];
+    }
+
+    // Starts every stage's percentiles over, so they cover only what happens from here on
+
+    void Reset();
+
+    // ScopedStage
+    //
+    // Records the time from construction to destruction against one stage.
+
+    class ScopedStage
+    {
+        FrameTimings& _timings;
+        RenderStage _stage;
+        uint32_t _startCycles;
+
+      public:
+        ScopedStage(FrameTimings& timings, RenderStage stage)
+            : _timings(timings), _stage(stage), _startCycles(ESP.getCycleCount())
+        {
+        }
+
+        ~ScopedStage()
+        {
+            _timings.Record(_stage, _startCycles, ESP.getCycleCount());
+        }
+
+        ScopedStage(const ScopedStage&) = delete;
+        ScopedStage& operator=(const ScopedStage&) = delete;
+    };
+};
+
+extern FrameTimings g_FrameTimings;
@@ -70,10 +70,13 @@
 #include <array>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "Adafruit_GFX.h"
 #include "crgbw.h"
 #include "pixeltypes.h"
+#include "polarlut.h"
+#include "xymapping.h"
 
 // Calculates a weight for anti-aliasing in Wu's algorithm.
 constexpr static inline uint8_t WU_WEIGHT(uint8_t a, uint8_t b)
@@ -95,6 +98,18 @@ constexpr static inline uint8_t WU_WEIGHT(uint8_t a, uint8_t b)
         uint32_t noise_scale_y;
         uint8_t  noise[MATRIX_WIDTH][MATRIX_HEIGHT];
         uint8_t  noisesmoothing;
+
+        // The unsmoothed samples from the last FillGetNoise() and the parameters they were taken
+        // at, so a frame that hasn't moved, or has slid by whole samples, can reuse them
+        uint8_t  field[MATRIX_WIDTH][MATRIX_HEIGHT];
+        uint32_t field_x;
+        uint32_t field_y;
+        uint32_t field_z;
+        uint32_t field_scale_x;
+        uint32_t field_scale_y;
+        size_t   field_width;
+        size_t   field_height;
+        bool     field_valid;
     } Noise;
 
     // A "Noise Pool" in the context of computer graphics is a multi-dimensional array of
@@ -120,6 +135,15 @@ class Boid;
 
 uint16_t XY(uint16_t x, uint16_t y);
 
+// Direction of a span for the GFXBase span primitives: a Row runs right from its start pixel and a
+// Column runs down (increasing y).
+
+enum class SpanAxis : uint8_t
+{
+    Row,
+    Column
+};
+
 class GFXBase : public Adafruit_GFX
 {
 #if USE_NOISE
@@ -135,6 +159,13 @@ protected:
     size_t _ledcount;
     bool _serpentine = true;
 
+    #if USE_PIXEL_MAP
+    // Row-major pixel -> LED lookup loaded by ConfigureTopology from a PixelMap; empty when the
+    // plain serpentine/linear math applies. xy() reads it for every pixel, so it stays on the
+    // default heap rather than PSRAM.
+    std::vector<uint16_t> _xyTable;
+    #endif
+
     // 32 Entries in the 5-bit gamma table
     static const uint8_t gamma5[32];
 
@@ -151,6 +182,13 @@ protected:
     CRGBPalette16 _targetPalette;
     String _currentPaletteName;
 
+    // _currentPalette expanded to all 256 indices at full brightness. Anything that changes
+    // _currentPalette clears _paletteCacheValid and the next ColorFromCurrentPalette rebuilds it.
+    mutable std::array<CRGB, 256> _paletteCache;
+    mutable bool _paletteCacheValid = false;
+
+    void RebuildPaletteCache() const;
+
     #if USE_NOISE
         // I was this many years old when I learned about std::once
         mutable std::unique_ptr<Noise> _ptrNoise;
@@ -173,19 +211,6 @@ public:
         pixel.b = static_cast<uint8_t>((static_cast<uint16_t>(pixel.b) * scaleFixed) >> 8);
     }
 
-    // A 3-byte struct will have one byte of padding so each element
-    // begins on a NA boundary. Making this
-    // struct __attribute__((packed)) PolarMap
-    // might conserve 25% of this buffer, but it might also force
-    // single elements to be split across a (locked) cache line.
-    // We'll thus leave this naturally aligned unless we have a
-    // really great reason not to.
-    struct PolarMap {
-        uint8_t angle;
-        uint8_t scaled_radius;
-        uint8_t unscaled_radius;
-    };
-
     // Many of the Aurora effects need direct access to these from external classes
 
     CRGB *leds = nullptr;
@@ -209,10 +234,6 @@ public:
         std::unique_ptr<Boid[]> _boids;
     #endif
 
-    // std::array nesting (rather than a raw C 2D array) so std::make_unique<PolarMapArray>()
-    // works — the standard library deletes the make_unique overload for fixed-bound arrays.
-    using PolarMapArray = std::array<std::array<PolarMap, kMatrixHeight>, kMatrixWidth>;
-
     // Definition moved to GFXBase.cpp because it uses the FillGetNoise() function template
     GFXBase(int w, int h);
 
@@ -316,6 +337,11 @@ public:
     __attribute__((always_inline))
     inline virtual uint16_t xy(uint16_t x, uint16_t y) const noexcept
     {
+        #if USE_PIXEL_MAP
+        if (!_xyTable.empty())
+            return _xyTable[y * _width + x];
+        #endif
+
         if (_serpentine && (x & 0x01))
         {
             // Odd rows run backwards
@@ -329,6 +355,63 @@ public:
         }
     }
 
+    // GetXYLayout
+    //
+    // Describes what xy() computes so WithXY() can swap in a StaticXY. A device that overrides xy()
+    // with anything other than one of the plain grids must return XYLayout::Custom.
+
+    virtual XYLayout GetXYLayout() const noexcept
+    {
+        #if USE_PIXEL_MAP
+        if (!_xyTable.empty())
+            return XYLayout::Table;
+        #endif
+        return _serpentine ? XYLayout::ColumnSerpentine : XYLayout::ColumnLinear;
+    }
+
+    // WithXY
+    //
+    // Calls fn(mapper) with the fastest mapper that is valid for the live topology: a TableXY when a
+    // pixel map is loaded, a StaticXY when the device is still MATRIX_WIDTH x MATRIX_HEIGHT with a
+    // plain layout, and a RuntimeXY over the virtual xy() otherwise (ConfigureTopology resized it,
+    // or the wiring is Custom). The topology check happens once per call, so wrap a whole frame's
+    // loop rather than a single pixel. Only the layouts this build's devices can report are
+    // instantiated, to keep the flash cost down.
+
+    template <typename Fn>
+    void WithXY(Fn&& fn) const
+    {
+        #if USE_PIXEL_MAP
+        if (GetXYLayout() == XYLayout::Table)
+        {
+            fn(TableXY{ _xyTable.data(), static_cast<uint16_t>(_width) });
+            return;
+        }
+        #endif
+
+        if (_width == MATRIX_WIDTH && _height == MATRIX_HEIGHT)
+        {
+            switch (GetXYLayout())
+            {
+                #if USE_HUB75
+                case XYLayout::RowMajor:
+                    fn(StaticXY<MATRIX_WIDTH, MATRIX_HEIGHT, XYLayout::RowMajor>());
+                    return;
+                #else
+                case XYLayout::ColumnSerpentine:
+                    fn(StaticXY<MATRIX_WIDTH, MATRIX_HEIGHT, XYLayout::ColumnSerpentine>());
+                    return;
+                case XYLayout::ColumnLinear:
+                    fn(StaticXY<MATRIX_WIDTH, MATRIX_HEIGHT, XYLayout::ColumnLinear>());
+                    return;
+                #endif
+                default:
+                    break;
+            }
+        }
+        fn(RuntimeXY<GFXBase>{*this});
+    }
+
     // Retrieves the color of a pixel at the specified X and Y coordinates.
     virtual CRGB getPixel(int16_t x, int16_t y) const;
 
@@ -374,6 +457,67 @@ public:
     // Linear-index overload
     void fadePixelToBlackBy(int16_t i, uint8_t fadeValue) noexcept;
 
+    // ForEachInSpan
+    //
+    // Calls fn(pixel, i) for pixel i of a run of count pixels along a row or column starting at
+    // (x, y). The run is clipped to the matrix once up front, and i still counts from the unclipped
+    // start so gradients don't shift at the edges. When the wiring puts the run at a fixed stride
+    // in leds[] (columns of a column-wired strip, rows of a linear one, either on a HUB75 panel) it
+    // walks a pointer; otherwise each pixel goes through the WithXY() mapper.
+
+    template <typename Fn>
+    void ForEachInSpan(SpanAxis axis, int x, int y, int count, Fn&& fn)
+    {
+        const bool isRow = axis == SpanAxis::Row;
+        int& start = isRow ? x : y;
+        const int across = isRow ? y : x;
+
+        if (across < 0 || across >= static_cast<int>(isRow ? _height : _width))
+            return;
+
+        int first = 0;
+        if (start < 0)
+        {
+            first = -start;
+            count -= first;
+            start = 0;
+        }
+        count = std::min(count, static_cast<int>(isRow ? _width : _height) - start);
+        if (count <= 0)
+            return;
+
+        const XYLayout layout = GetXYLayout();
+        const bool fixedStride = layout == XYLayout::RowMajor
+                              || layout == XYLayout::ColumnLinear
+                              || (layout == XYLayout::ColumnSerpentine && !isRow);
+        if (fixedStride)
+        {
+            CRGB* pixel = leds + xy(x, y);
+            const int stride = count > 1 ? (isRow ? xy(x + 1, y) : xy(x, y + 1)) - (pixel - leds) : 0;
+            for (int i = 0; i < count; i++, pixel += stride)
+                fn(*pixel, first + i);
+            return;
+        }
+
+        WithXY([&](auto mapXY)
+        {
+            for (int i = 0; i < count; i++)
+                fn(leds[isRow ? mapXY(x + i, y) : mapXY(x, y + i)], first + i);
+        });
+    }
+
+    // Span primitives, all clipped once and walked with ForEachInSpan
+
+    void fillSpan(SpanAxis axis, int x, int y, int count, CRGB color);
+    void fadeSpanToBlackBy(SpanAxis axis, int x, int y, int count, uint8_t fadeValue);
+    void addSpan(SpanAxis axis, int x, int y, int count, CRGB color);                    // Saturating add
+    void blendSpan(SpanAxis axis, int x, int y, int count, CRGB color, fract8 amount);   // nblend toward color
+    void copySpan(SpanAxis axis, int x, int y, int count, const CRGB* colors);
+
+    // Palette gradient along the span: pixel i gets ColorFromPalette(palette, startIndex + i * indexStep)
+    void paletteSpan(SpanAxis axis, int x, int y, int count, const CRGBPalette16& palette, uint8_t startIndex, uint8_t indexStep,
+                     uint8_t brightness = 255, TBlendType blendType = LINEARBLEND);
+
     __attribute__((always_inline)) virtual void setPixel(int x, CRGB color) noexcept
     {
         if (isValidPixel(x))
@@ -603,7 +747,38 @@ public:
 
     void DimAll(uint8_t value);
 
-    CRGB ColorFromCurrentPalette(uint8_t index = 0, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND) const;
+    // ColorFromCurrentPalette
+    //
+    // Same result as ColorFromPalette(_currentPalette, index, brightness, _currentBlendType), read from
+    // the expanded cache instead of interpolating the 16 entries on every call. Brightness is
+    // applied the way ColorFromPalette does it, after the blend, so the output is bit-identical.
+
+    CRGB ColorFromCurrentPalette(uint8_t index = 0, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND) const
+    {
+        if (!_paletteCacheValid)
+            RebuildPaletteCache();
+
+        CRGB color = _paletteCache[index];
+        if (brightness != 255)
+        {
+            if (brightness == 0)
+                return CRGB::Black;
+
+            // ColorFromPalette bumps brightness by one "for rounding" and then scale8s by it, which
+            // with FASTLED_SCALE8_FIXED is a multiply by brightness + 2
+            const uint16_t scale = brightness + 2;
+            for (int c = 0; c < 3; c++)
+            {
+                #if FASTLED_SCALE8_FIXED == 1
+                    color.raw[c] = (color.raw[c] * scale) >> 8;
+                #else
+                    if (color.raw[c])
+                        color.raw[c] = ((color.raw[c] * (scale - 1)) >> 8) + 1;
+                #endif
+            }
+        }
+        return color;
+    }
 
     static CRGB HsvToRgb(uint8_t h, uint8_t s, uint8_t v);
 
@@ -656,5 +831,16 @@ public:
 
     virtual void PostProcessFrame(uint16_t, uint16_t);
 
-    static const PolarMapArray& getPolarMap();
+    // The shared polar map for this device's current topology, centered on pixel
+    // (width / 2, height / 2). Effects that want another center or scale ask PolarLUT::Get().
+    // The device holds on to it, so a Draw() only goes to the shared cache when the size changed.
+    const PolarLUT& GetPolarLUT() const
+    {
+        if (!_polarLUT || _polarLUT->width() != _width || _polarLUT->height() != _height)
+            _polarLUT = PolarLUT::Get(PolarLUT::Params::Centered(_width, _height));
+        return *_polarLUT;
+    }
+
+private:
+    mutable std::shared_ptr<const PolarLUT> _polarLUT;
 };
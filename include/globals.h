@@ -91,8 +91,16 @@
 #define FASTLED_INTERNAL 1               // Suppresses build banners
 #include <atomic>
 #include <mutex>
+
+// Serializes the socket task's reserve and commit of incoming frames against LEDBufferManager::Reconfigure().
+// The queue itself is lock-free, so the render task never takes this.
 extern std::mutex g_buffer_mutex;
 
+// Held for just the queue operations, never while pixels are copied or drawn, by the render task taking
+// each channel's due frame and by a receiver queueing frames for several channels that must be shown
+// together, so the render task takes all of those or none. Always the last lock taken.
+extern std::mutex g_publish_mutex;
+
 // Protects the active render/configuration pipeline so runtime topology/output changes
 // cannot reconfigure device buffers while a frame is being prepared, drawn, or emitted.
 // Splitting this into two mutexes (render and effect manager) allows effects to change without 
@@ -144,6 +152,28 @@ extern std::recursive_mutex g_effect_manager_mutex;
 
 #define USE_STRIP (USE_WS281X || USE_APA102)
 
+// USE_PIXEL_MAP: 1 lets ConfigureTopology load a PixelMap from SPIFFS for strip
+// wiring the serpentine/linear math can't describe. xy() then checks for a loaded
+// table on every call, so builds without such a layout leave it off and keep the
+// plain math.
+#ifndef USE_PIXEL_MAP
+    #define USE_PIXEL_MAP 0
+#endif
+
+// ASYNC_STRIP_OUTPUT: 1 hands each finished strip frame to OutputService, which shows
+// it from its own task while the render task draws the next one. That costs a task
+// and OUTPUT_FRAME_POOL copies of the frame, so boards opt in; 0 keeps Show() on the
+// render task, as before.
+#ifndef ASYNC_STRIP_OUTPUT
+    #define ASYNC_STRIP_OUTPUT 0
+#endif
+
+// HOST_BUILD is set only by [env:native], which compiles the render core for
+// Linux/macOS against the shims in include/native to produce nd_bench.
+#ifndef HOST_BUILD
+    #define HOST_BUILD 0
+#endif
+
 #if (USE_HUB75 + USE_WS281X + USE_APA102) != 1
     #error "Define exactly one output transport: USE_HUB75, USE_WS281X, or USE_APA102"
 #endif
@@ -199,6 +229,7 @@ extern std::recursive_mutex g_effect_manager_mutex;
 
 #define DRAWING_PRIORITY        (tskIDLE_PRIORITY+8)
 #define SOCKET_PRIORITY         (tskIDLE_PRIORITY+7)
+#define OUTPUT_PRIORITY         (tskIDLE_PRIORITY+7)      // Mostly blocked on the wire; needs to refill it promptly
 #define AUDIOSERIAL_PRIORITY    (tskIDLE_PRIORITY+6)      // If equal or lower than audio, will produce garbage on serial
 #define NET_PRIORITY            (tskIDLE_PRIORITY+5)
 #define AUDIO_PRIORITY          (tskIDLE_PRIORITY+4)
@@ -232,6 +263,7 @@ extern std::recursive_mutex g_effect_manager_mutex;
 #define REMOTE_CORE             1
 #define JSONWRITER_CORE         0
 #define COLORDATA_CORE          0
+#define OUTPUT_CORE             0                         // Off the drawing core so Show overlaps the next Draw
 
 #define FASTLED_INTERNAL            1   // Suppresses the compilation banner from FastLED
 #define __STDC_FORMAT_MACROS
@@ -303,6 +335,9 @@ extern std::recursive_mutex g_effect_manager_mutex;
     #if defined(COLORDATA_SERVER_ENABLED) && COLORDATA_SERVER_ENABLED
         #error "COLORDATA_SERVER_ENABLED requires ENABLE_WIFI"
     #endif
+    #if defined(LIGHTING_PROTOCOLS_ENABLED) && LIGHTING_PROTOCOLS_ENABLED
+        #error "LIGHTING_PROTOCOLS_ENABLED requires ENABLE_WIFI"
+    #endif
 #endif
 
 #ifndef INCOMING_WIFI_ENABLED
@@ -778,6 +813,38 @@ extern const int g_aRingSizeTable[];
 
 #define WEB_SOCKETS_ANY_ENABLED (COLORDATA_WEB_SOCKET_ENABLED || EFFECTS_WEB_SOCKET_ENABLED)
 
+// LIGHTING_PROTOCOLS_ENABLED: 1 receives DDP, E1.31 (sACN) and Art-Net straight into the channel
+// frame queues; see lightingreceiver.h for how universes map onto channels. That costs three UDP
+// listeners, a task, the E1.31 multicast joins and a buffer per channel, and the protocols have no
+// authentication, so anyone on the network can drive the LEDs. Boards that take a show controller's
+// output opt in; 0 leaves the socket server as the only way in.
+
+#ifndef LIGHTING_PROTOCOLS_ENABLED
+  #define LIGHTING_PROTOCOLS_ENABLED 0
+#endif
+
+// UDP_PIXEL_SERVER_ENABLED: 1 also listens for the socket server's packets over UDP, fragmented as
+// udpassembler.h describes, so a lost datagram drops one frame instead of stalling the ones behind it.
+// That costs a UDP listener, a task, a reassembly buffer and a buffer per channel, and like the
+// socket server it takes pixels from anyone who can reach the port. Boards opt in; 0 keeps the
+// socket server alone on the port.
+
+#ifndef UDP_PIXEL_SERVER_ENABLED
+  #define UDP_PIXEL_SERVER_ENABLED 0
+#endif
+
+#if UDP_PIXEL_SERVER_ENABLED && !INCOMING_WIFI_ENABLED
+  #error "UDP_PIXEL_SERVER_ENABLED requires INCOMING_WIFI_ENABLED"
+#endif
+
+#ifndef LIGHTING_START_UNIVERSE
+  #define LIGHTING_START_UNIVERSE        1      // E1.31 universe channel 0 starts on
+#endif
+
+#ifndef LIGHTING_ARTNET_START_UNIVERSE
+  #define LIGHTING_ARTNET_START_UNIVERSE 0      // Art-Net Port-Address channel 0 starts on
+#endif
+
 // Microphone
 //
 // The M5 mic is on Pin34, but when I wire up my own microphone module I usually put it on pin 36.
@@ -832,6 +899,8 @@ extern const int g_aRingSizeTable[];
 
 #define WIFI_COMMAND_PIXELDATA64 3             // Wifi command with color data and 64-bit clock vals
 #define WIFI_COMMAND_PEAKDATA    4             // Wifi command that delivers audio peaks
+#define WIFI_COMMAND_PIXELDELTA64 5            // Wifi command with the pixels changed since the last frame; see pixeldelta.h
+#define WIFI_COMMAND_PIXELBATCH64 6            // Wifi command with frames for several channels under one clock; see pixelbatch.h
 
 // Final headers
 //
@@ -89,6 +89,11 @@ public:
         return 0;
     }
 
+    XYLayout GetXYLayout() const noexcept override
+    {
+        return XYLayout::RowMajor;
+    }
+
     // Whereas an WS281xGFX would track its own memory for the CRGB array, we simply point to the buffer already used for
     // the matrix display memory.  That also eliminated having a local draw buffer that is then copied, because the effects
     // can render directly to the right back buffer automatically.
@@ -0,0 +1,105 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        inflater.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    zlib decompression of the socket server's compressed ("DAVE") packets,
+//    kept apart from the socket code so nd_bench can run it on the host.
+//
+//    DecompressBuffer() expands a packet that has been read in full. The
+//    streaming calls expand one while it is still arriving: uzlib pulls
+//    the compressed stream off the socket a chunk at a time as it needs
+//    more, so the packet is never held whole, and the caller says where
+//    each piece of the expanded packet goes - for pixel data, straight
+//    into an LEDBuffer.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <cstddef>
+
+extern "C"
+{
+    #include "uzlib/src/uzlib.h"
+}
+
+class Inflater
+{
+  public:
+
+    // Compressed bytes read from the socket at a time, at most; about one TCP segment
+    static constexpr size_t kChunkSize = 1024;
+
+    // The "DAVE" header in front of the zlib stream: magic, compressed size, expanded size, reserved
+    static constexpr size_t kHeaderSize = 16;
+
+    // DecompressBuffer
+    //
+    // Use uzlib to decompress a zlib stream of cBuffer bytes into exactly expectedOutputSize bytes
+    // at pOutput. pOutput must have room for one byte more, which uzlib may touch.
+
+    static bool DecompressBuffer(const uint8_t * pBuffer, size_t cBuffer, uint8_t * pOutput, size_t expectedOutputSize);
+
+    // Begin
+    //
+    // Start on a zlib stream of compressedSize bytes. The first cbPrefix of them have already been read into
+    // pPrefix (which must stay valid until Finish); the rest are read from socket as they're needed.
+
+    bool Begin(int socket, const uint8_t * pPrefix, size_t cbPrefix, size_t compressedSize);
+
+    // BeginPacket
+    //
+    // Begin on a whole compressed packet of which cbReceived bytes, its header and then however much of the
+    // zlib stream came with it, are at pReceived - where the socket server's read of a 24-byte standard
+    // header leaves one. The stream's size comes from the header.
+
+    bool BeginPacket(int socket, const uint8_t * pReceived, size_t cbReceived);
+
+    // Inflate
+    //
+    // Expand exactly cb more bytes of the packet into pDest. Deflate back-references can reach anywhere
+    // back to the start of the packet, so pWindow is where its first byte sits and everything from
+    // there up to pDest must already hold what was expanded so far.
+
+    bool Inflate(uint8_t * pWindow, uint8_t * pDest, size_t cb);
+
+    // Finish
+    //
+    // Check the stream ends where the packet does and its checksum matches, and read whatever is left of
+    // compressedSize off the socket so the next packet starts in the right place.
+
+    bool Finish();
+
+  private:
+
+    static int ReadSource(uzlib_uncomp * pState);
+
+    uzlib_uncomp    _state;                         // First, so ReadSource can get back to the Inflater
+    int             _socket     = -1;
+    size_t          _remaining  = 0;                // Compressed bytes not yet read from the socket
+    bool            _done       = false;            // uzlib has seen the end of the stream and its checksum
+    bool            _readFailed = false;
+    uint8_t         _chunk[kChunkSize];
+};
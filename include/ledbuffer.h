@@ -35,11 +35,14 @@
 
 #include "globals.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <pixeltypes.h>
 #include <vector>
 
 #include "gfxbase.h"
+#include "playoutscheduler.h"
 
 class LEDBuffer
 {
@@ -47,9 +50,18 @@ class LEDBuffer
 
      std::shared_ptr<GFXBase> _pStrand;
 
+    // Room kept in front of the pixels for a wire packet's header, so a compressed packet can be
+    // inflated in place: deflate back-references may reach from the first pixels into the header.
+    // 24 bytes, or 8 CRGBs.
+
+    static constexpr size_t kWireHeaderSize = 24;
+
   private:
 
-    allocated_unique_ptr<CRGB []> _leds;
+    static constexpr size_t kHeaderPixels = kWireHeaderSize / sizeof(CRGB);
+    static_assert(kWireHeaderSize % sizeof(CRGB) == 0, "The wire header must be a whole number of pixels");
+
+    allocated_unique_ptr<CRGB []> _leds;                // kHeaderPixels of headroom, then the pixels
     uint32_t                 _pixelCount;
     uint64_t                 _timeStampMicroseconds;
     uint64_t                 _timeStampSeconds;
@@ -69,6 +81,11 @@ class LEDBuffer
 
     bool IsBufferOlderThan(const timeval & tv) const;
 
+    // The same for a frame's timestamp on its own, as LEDBufferManager keeps them for queued frames
+
+    static double TimeTillDue(uint64_t seconds, uint64_t micros);
+    static bool IsOlderThan(uint64_t seconds, uint64_t micros, const timeval & tv);
+
     static bool ValidateWirePayload(const uint8_t* payloadData,
                                     size_t payloadLength,
                                     size_t ledCount,
@@ -80,29 +97,153 @@ class LEDBuffer
 
     bool UpdateFromWire(const uint8_t* payloadData, size_t payloadLength);
 
+    // Zero-copy receive
+    //
+    // A buffer handed out by LEDBufferManager::ReserveBuffer() is filled in place: the socket
+    // server reads the pixels straight into Pixels(), or inflates a whole packet, header first,
+    // into WirePacket(), then SetFrame() stamps them before the buffer is committed.
+    // CopyFrameFrom() fans a filled buffer out to another channel's.
+
+    CRGB* Pixels();
+    const CRGB* Pixels() const;
+    uint8_t* WirePacket();                              // kWireHeaderSize bytes, then Pixels()
+    void SetFrame(uint64_t seconds, uint64_t micros, uint32_t pixelCount);
+    bool CopyFrameFrom(const LEDBuffer& source);
+
     void DrawBuffer();
     void Reconfigure(std::shared_ptr<GFXBase> pStrand);
 };
 
 // LEDBufferManager
 //
-// Manages a circular buffer of LEDBuffer objects.  The buffer itself is an array of shared_ptrs to
-// LEDBuffer objects.  The buffer is managed through a unique_ptr.  The LEDBuffer objects are managed
-// through shared_ptrs as they are also returned to callers.
+// Manages a circular queue of timestamped frames between the socket task, which queues them, and the
+// render task, which draws them. Neither takes a lock: the queue's head and tail live in one atomic
+// word that each side moves with a compare-and-swap, and frames are handed over by swapping buffers
+// out of a pool rather than by copying pixels.
+//
+// The receivers reserve a buffer, fill it, and commit it (ReserveBuffer(), CommitBuffer()); the
+// render task takes frames off the other end (GetDueBuffer(), GetOldestBuffer()). Each frame is given
+// the local time to show it as it's committed, by a PlayoutScheduler that smooths out network jitter
+// and the drift between the sender's clock and ours. A full queue drops its oldest frame,
+// and a frame stamped the same as the newest one still queued replaces it, so a receiver
+// sometimes takes a frame back off the render task's end - whichever of the two wins the swap owns it.
+// The pool holds one buffer for each queue slot, one for each BufferReservation built in, and the
+// frame the render task drew last. Depth(), the ages, the Peek*() calls and Scheduler() are safe from any task.
+// Everything else on the receiving side is serialized by g_buffer_mutex, and Reconfigure() needs both
+// sides kept out, which is what g_buffer_mutex around the receivers' reserve and commit, and
+// g_render_mutex around the render task's draw, are for.
+
+// BufferReservation
+//
+// The receivers that fill frames. Each has its own reservation on every manager, so one can fill its
+// buffer without holding g_buffer_mutex while another reserves and commits. Only the receivers built in
+// get a buffer in the pool: without UDP_PIXEL_SERVER_ENABLED, Incoming is only ever reserved by the
+// socket task between its own receives, so it shares Socket's buffer, and Lighting has one only with
+// LIGHTING_PROTOCOLS_ENABLED. nd_bench drives all of them on the host, so it has all three.
+
+enum class BufferReservation : uint8_t
+{
+    Incoming,       // ProcessIncomingData(), which reserves, fills and commits in one hold of g_buffer_mutex
+    Socket,         // SocketServer, which reads pixels straight off the TCP stream without the lock
+    Lighting,       // LightingReceiver, which builds a frame across many universe packets
+    Count
+};
 
 class LEDBufferManager
 {
-    std::unique_ptr<std::vector<std::shared_ptr<LEDBuffer>>> _ppBuffers;          // The circular array of buffer ptrs
-    std::shared_ptr<LEDBuffer> _pLastBufferAdded;   // Keeps track of the MRU buffer
-    size_t                                               _iNextBuffer;        // Head pointer index
-    size_t                                               _iLastBuffer;        // Tail pointer index
-    size_t                                               _cQueuedBuffers;     // Active frames in the circular queue
-    uint32_t                                             _cBuffers;           // Number of buffers
+    static constexpr uint16_t kNoBuffer = 0xFFFF;
+    static constexpr bool     kIncomingBuffer = UDP_PIXEL_SERVER_ENABLED || HOST_BUILD;
+    static constexpr bool     kLightingBuffer = LIGHTING_PROTOCOLS_ENABLED || HOST_BUILD;
+    static constexpr size_t   kReservations   = 1 + kIncomingBuffer + kLightingBuffer;
+
+    // Where a receiver's reservation lives in _iSpares; one past the end for a receiver not built in
+
+    static constexpr size_t ReservationIndex(BufferReservation reservation)
+    {
+        switch (reservation)
+        {
+            case BufferReservation::Incoming:   return 0;
+            case BufferReservation::Socket:     return kIncomingBuffer ? 1 : 0;
+            case BufferReservation::Lighting:   return kLightingBuffer ? 1 + kIncomingBuffer : kReservations;
+            default:                            return kReservations;
+        }
+    }
+
+    // A queued frame: the pool buffer holding it, its timestamp, and when it's due on the local clock,
+    // where the render task can check them without touching a buffer the socket task might be taking back
+
+    struct Slot
+    {
+        std::atomic<uint16_t> buffer     { kNoBuffer };
+        std::atomic<uint32_t> seconds    { 0 };
+        std::atomic<uint32_t> micros     { 0 };
+        std::atomic<uint32_t> dueSeconds { 0 };
+        std::atomic<uint32_t> dueMicros  { 0 };
+    };
+
+    // The state shared between the tasks, kept behind a pointer as atomics can't move and the managers
+    // live in a vector
+
+    struct Ring
+    {
+        Ring(uint32_t cSlots, uint32_t cPool);
+
+        // Head and tail count frames modulo wrap, a multiple of the slot count, and share one word
+        // so both sides see them change together. Counting past the slot count keeps a stale
+        // compare-and-swap from succeeding unless tens of thousands of frames went by in between.
+
+        std::atomic<uint32_t>       state { 0 };
+        uint32_t                    wrap;
+        std::unique_ptr<Slot[]>     slots;
+
+        // Buffers the render task has finished with, on their way back to the socket task; a single
+        // producer, single consumer ring with one entry more than the pool so it's never full
+
+        std::unique_ptr<uint16_t[]> returned;
+        uint32_t                    cReturned;
+        std::atomic<uint32_t>       returnedHead { 0 };
+        std::atomic<uint32_t>       returnedTail { 0 };
+    };
+
+    std::unique_ptr<std::vector<std::shared_ptr<LEDBuffer>>> _ppBuffers;          // The pool of buffers the slots point into
+    std::unique_ptr<Ring>                                _pRing;
+    std::unique_ptr<PlayoutScheduler>                    _pScheduler;         // Behind a pointer for the same reason as the Ring
+    uint32_t                                             _cBuffers;           // Number of queue slots
+
+    // The receivers' side
+    std::array<uint16_t, kReservations>                  _iSpares;            // Reserved for each receiver's next frame
+    std::shared_ptr<LEDBuffer>                           _pLastBufferAdded;   // Keeps track of the MRU buffer
+    uint64_t                                             _newestSeconds = 0;  // Its timestamp, kept here as the render task
+    uint64_t                                             _newestMicros = 0;   //   clears a buffer's when it draws it
+    uint32_t                                             _generation = 0;     // Bumped whenever the newest frame changes
+
+    // The render task's side
+    uint16_t                                             _iDrawing = kNoBuffer; // Handed out by the last GetOldestBuffer()
+
+    uint32_t Head(uint32_t state) const;
+    uint32_t Tail(uint32_t state) const;
+    uint32_t Count(uint32_t state) const;
+    uint32_t Next(uint32_t position) const;
+    uint32_t Pack(uint32_t head, uint32_t tail) const;
+
+    void     ReturnBuffer(uint16_t iBuffer);
+    uint16_t TakeFreeBuffer();
+    bool     IsReservation(const std::shared_ptr<LEDBuffer>& pBuffer, size_t & iReservation) const;
+    uint64_t Schedule(const LEDBuffer& buffer, uint64_t arrivalMicros);
+    void     Enqueue(const std::shared_ptr<LEDBuffer>& pBuffer, size_t iReservation, uint64_t dueMicros);
+    bool     PeekSlotTime(bool newest, bool due, uint64_t & seconds, uint64_t & micros) const;
+    void     ResetQueue();
 
   public:
 
     LEDBufferManager(uint32_t cBuffers, const std::shared_ptr<GFXBase>& pGFX);
 
+    // ClockMicros
+    //
+    // The local wall clock, which frames are stamped against, in microseconds
+
+    static uint64_t ClockMicros();
+
     double AgeOfOldestBuffer() const;
 
     double AgeOfNewestBuffer() const;
@@ -123,35 +264,98 @@ class LEDBufferManager
 
     bool IsEmpty() const;
 
+    // PeekOldestTime, PeekNewestTime
+    //
+    // The timestamp of the oldest or newest queued frame, or false if the queue is empty
+
+    bool PeekOldestTime(uint64_t & seconds, uint64_t & micros) const;
+    bool PeekNewestTime(uint64_t & seconds, uint64_t & micros) const;
+
+    // PeekOldestDue, PeekNewestDue
+    //
+    // The local time, in microseconds, the oldest or newest queued frame is due to be shown, or false
+    // if the queue is empty
+
+    bool PeekOldestDue(uint64_t & dueMicros) const;
+    bool PeekNewestDue(uint64_t & dueMicros) const;
+
+    // Scheduler
+    //
+    // The playout estimates and the late and dropped frame counters, which any task may read
+
+    const PlayoutScheduler& Scheduler() const;
+
     // PeekNewestBuffer
     //
-    // Get a pointer to the most recently added (newest) buffer, or nullptr if empty
+    // Get a pointer to the most recently added (newest) buffer, or nullptr if empty. For the socket
+    // task, or a queue nobody is drawing from; the render task may take it at any moment.
 
     std::shared_ptr<LEDBuffer> PeekNewestBuffer() const;
 
-    // GetNewBuffer
+    // PeekLastBuffer
+    //
+    // The most recently queued buffer even once it has been drawn, which leaves its pixels alone, or
+    // nullptr if nothing has been queued since the last Reconfigure(). Delta frames apply against it.
+    // For the socket task only.
+
+    std::shared_ptr<LEDBuffer> PeekLastBuffer() const;
+
+    // Generation
     //
-    // Grabs the next buffer in the circle, advancing the tail pointer as well if we've
-    // 'caught up' to the head pointer, which effective throws away that buffer via reuse
+    // Changes whenever a frame is queued or the manager is reconfigured, so a receiver can tell
+    // whether the frame it queued last is still the one PeekLastBuffer() returns
 
-    std::shared_ptr<LEDBuffer> GetNewBuffer();
+    uint32_t Generation() const;
 
     // GetOldestBuffer
     //
-    // Return a pointer to the very oldest buffer, or nullptr if empty
+    // Takes the oldest frame off the queue, or returns nullptr if it's empty. For the render task
+    // only. The buffer is the caller's until its next call, which returns it to the pool.
 
     std::shared_ptr<LEDBuffer> GetOldestBuffer();
 
-    // PeekOldestBuffer
+    // GetDueBuffer
+    //
+    // Takes every frame due by nowMicros off the queue and returns the newest of them, or nullptr if
+    // none is due yet; the older ones are counted as dropped. Otherwise like GetOldestBuffer().
+
+    std::shared_ptr<LEDBuffer> GetDueBuffer(uint64_t nowMicros);
+
+    // ReserveBuffer
+    //
+    // Hands out a buffer from outside the queue for the receiver to fill, the same one until it's
+    // committed. Each receiver has one reservation per manager, so it can only have one receive per
+    // channel in flight. Caller holds g_buffer_mutex.
+
+    std::shared_ptr<LEDBuffer> ReserveBuffer(BufferReservation reservation);
+
+    // CommitBuffer
+    //
+    // Queues a buffer filled since ReserveBuffer(). It replaces the newest frame if that's still
+    // queued and carries the same timestamp, and otherwise goes on the end, dropping the oldest frame
+    // if the queue is full. Either way the buffer it displaces becomes that receiver's next reservation,
+    // so no pixels are copied. Returns false, queueing nothing, if the manager was reconfigured since the
+    // reservation. arrivalMicros is when the frame arrived on the local clock, ClockMicros() if omitted.
+    // Caller holds g_buffer_mutex.
+
+    bool CommitBuffer(const std::shared_ptr<LEDBuffer>& pBuffer);
+    bool CommitBuffer(const std::shared_ptr<LEDBuffer>& pBuffer, uint64_t arrivalMicros);
+
+    // CommitBuffers
     //
-    // Take a "peek" at the newest buffer, or nullptr if empty
+    // Queues frames on several channels that must be shown together: pBuffers[i] is a reservation of
+    // pManagers[i]'s, or null to leave that channel alone. They're all given the due time the first
+    // channel's scheduler gives its frame, and queued as one, so the render task, which takes due
+    // frames under g_publish_mutex, takes all of them or none. Reservations a Reconfigure() replaced
+    // are skipped. Returns how many were queued. Caller holds g_buffer_mutex.
 
-    std::shared_ptr<LEDBuffer> PeekOldestBuffer() const;
+    static size_t CommitBuffers(LEDBufferManager * pManagers, size_t cManagers, const std::shared_ptr<LEDBuffer> * pBuffers, uint64_t arrivalMicros);
 
     void Reconfigure(const std::shared_ptr<GFXBase>& pGFX);
 
     // operator[]
     //
-    // Returns a pointer to the buffer at the specified logical index, or nullptr if empty
+    // Returns a pointer to the buffer at the specified logical index, or nullptr if empty. Like
+    // PeekNewestBuffer(), only meaningful while nobody is drawing from the queue.
     std::shared_ptr<LEDBuffer> operator[](size_t index) const;
 };
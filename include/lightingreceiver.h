@@ -0,0 +1,191 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        lightingreceiver.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Takes the pixel data show controllers send in the standard lighting
+//    protocols - DDP, E1.31 (sACN) and Art-Net - and writes it straight
+//    into the frames the channels' LEDBufferManagers reserve, so they need
+//    no proxy to translate them into our own wire format.
+//
+//    The channels' pixels are laid end to end, 3 bytes of RGB each:
+//
+//      DDP      The data offset is a byte offset into that whole span.
+//      E1.31    Each channel starts on a new universe, counting up from
+//      Art-Net  the start universe, and each universe carries 170 pixels
+//               (510 of its 512 slots), as xLights and Falcon controllers
+//               lay them out.
+//
+//    A frame is queued, stamped with the time it was completed, when:
+//
+//      DDP      a packet has the PUSH flag set; every channel written
+//               since the last one is queued together.
+//      E1.31    the channel's last universe arrives, as senders send them
+//               in order; or, when the data names a synchronization
+//               address, when a sync packet for that address does, for
+//               every channel waiting on it.
+//      Art-Net  the channel's last universe arrives; or, once the sender
+//               has been seen sending ArtSync, at the next ArtSync, until
+//               none has been seen for 4 seconds.
+//
+//    Channels a push or sync releases together are queued as one batch,
+//    with one due time, so the render task shows them on the same pass; see
+//    LEDBufferManager::CommitBuffers(). A universe that arrives twice before its
+//    frame is complete means one was lost, so what has arrived is queued
+//    and the new data starts the next frame. Pixels a frame isn't sent
+//    keep the last frame's colors. E1.31 and Art-Net sequence numbers are
+//    checked per universe, and older packets are dropped.
+//
+//    Nothing here touches a socket, so nd_bench replays captures through
+//    it on the host. It fills its own reservation on each channel across
+//    packets, which the other receivers never hand out, but reserving and
+//    committing must still be serialized against them and Reconfigure()
+//    with g_buffer_mutex, like ProcessIncomingData().
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class LEDBuffer;
+class LEDBufferManager;
+
+class LightingReceiver
+{
+  public:
+
+    enum class Protocol
+    {
+        DDP,
+        E131,
+        ArtNet
+    };
+
+    enum class Result
+    {
+        Staged,                                     // Written into a frame still being assembled
+        Presented,                                  // ... and it completed at least one frame, now queued
+        Ignored,                                    // Valid, but nothing for us: an unmapped universe, a poll, preview data
+        OutOfSequence,                              // Older than a packet already taken for its universe
+        Malformed                                   // Not a packet of the protocol it arrived on
+    };
+
+    static constexpr size_t   kMaxChannels = 16;                    // One per bit of a channel mask, as PixelBatch
+    static constexpr size_t   kPixelsPerUniverse = 170;
+    static constexpr uint32_t kArtSyncTimeoutMicros = 4 * MICROS_PER_SECOND;
+
+    LightingReceiver(LEDBufferManager * pManagers, size_t cManagers, uint16_t e131StartUniverse, uint16_t artNetStartUniverse);
+    ~LightingReceiver();
+
+    // Accept
+    //
+    // Takes one datagram received on the protocol's port. nowMicros is when it arrived on the local
+    // clock, and stamps any frame it completes.
+
+    Result Accept(Protocol protocol, const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros);
+
+    // UniverseCount
+    //
+    // How many universes a channel of ledCount pixels takes, for whoever lays out the sender
+
+    static uint16_t UniverseCount(size_t ledCount) { return (ledCount + kPixelsPerUniverse - 1) / kPixelsPerUniverse; }
+
+    // FirstUniverse
+    //
+    // The universe a channel starts on under the protocol, as the channels are configured now
+
+    uint16_t FirstUniverse(Protocol protocol, size_t iChannel) const;
+
+    uint32_t Packets()          const { return _packets.load(std::memory_order_relaxed); }
+    uint32_t FramesPresented()  const { return _framesPresented.load(std::memory_order_relaxed); }   // Per channel
+    uint32_t SyncPackets()      const { return _syncPackets.load(std::memory_order_relaxed); }
+    uint32_t OutOfSequence()    const { return _outOfSequence.load(std::memory_order_relaxed); }
+    uint32_t MalformedPackets() const { return _malformed.load(std::memory_order_relaxed); }
+
+  private:
+
+    // What a frame in progress on a channel waits for before it's queued
+
+    enum class Wait : uint8_t
+    {
+        Universes,                                  // Its last universe
+        E131Sync,                                   // An E1.31 sync packet for syncAddress
+        ArtSync                                     // The next ArtSync
+    };
+
+    struct Channel
+    {
+        std::shared_ptr<LEDBuffer> pFrame;          // Our reservation being filled, or null between frames
+        uint32_t                   generation = 0;  // The manager's when it was reserved
+        Wait                       wait       = Wait::Universes;
+        uint16_t                   syncAddress = 0;
+        Protocol                   protocol   = Protocol::DDP;      // Of the universes below
+        std::vector<uint8_t>       seen;            // Universes written into pFrame
+        std::vector<int16_t>       sequence;        // Last sequence taken per universe, -1 for none
+    };
+
+    Result AcceptDDP(const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros);
+    Result AcceptE131(const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros);
+    Result AcceptArtNet(const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros);
+
+    // AcceptUniverse
+    //
+    // The part of E1.31 and Art-Net they share: one universe's DMX slots into its channel's frame
+
+    Result AcceptUniverse(Protocol protocol, uint16_t universe, uint8_t sequence, const uint8_t * pData, size_t cbData,
+                          Wait wait, uint16_t syncAddress, uint64_t nowMicros);
+
+    bool Touch(size_t iChannel);
+    void Write(size_t iChannel, size_t byteOffset, const uint8_t * pData, size_t cbData);
+    bool Present(size_t iChannel, uint64_t nowMicros);
+
+    template <typename Selected>
+    bool PresentTogether(uint64_t nowMicros, Selected selected);
+    void Abandon(Channel & channel);
+
+    static void Count(std::atomic<uint32_t> & counter, uint32_t n = 1) { counter.fetch_add(n, std::memory_order_relaxed); }
+
+    LEDBufferManager *   _pManagers;
+    size_t               _cManagers;
+    uint16_t             _e131StartUniverse;
+    uint16_t             _artNetStartUniverse;
+    std::vector<Channel> _channels;
+    std::array<std::shared_ptr<LEDBuffer>, kMaxChannels> _frames;   // PresentTogether()'s batch, empty between calls
+    uint64_t             _lastArtSyncMicros = 0;
+    bool                 _artSyncActive     = false;
+
+    // Published for the statistics
+
+    std::atomic<uint32_t> _packets         { 0 };
+    std::atomic<uint32_t> _framesPresented { 0 };
+    std::atomic<uint32_t> _syncPackets     { 0 };
+    std::atomic<uint32_t> _outOfSequence   { 0 };
+    std::atomic<uint32_t> _malformed       { 0 };
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        lightingserver.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Listens on the standard ports for DDP (4048), E1.31 (5568) and
+//    Art-Net (6454) and hands every datagram to a LightingReceiver, which
+//    maps it onto the channels; see lightingreceiver.h. E1.31 is taken
+//    unicast, or multicast for the first universes the channels use.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <atomic>
+#include <memory>
+
+#include "itaskservice.h"
+#include "lightingreceiver.h"
+
+#if LIGHTING_PROTOCOLS_ENABLED
+
+class LightingServer : public ITaskService
+{
+  private:
+
+    static constexpr size_t kProtocols = 3;
+
+    std::atomic<int>                        _socket_fds[kProtocols] { {-1}, {-1}, {-1} };
+    allocated_unique_ptr<uint8_t []>        _pDatagram;
+    allocated_unique_ptr<LightingReceiver>  _pReceiver;
+
+    bool OpenSocket(size_t iProtocol, int port);
+    void JoinUniverses(int fd);
+
+  public:
+
+    // Bigger than any of the three protocols sends: DDP's largest is 1440 bytes of data and its header
+    static constexpr size_t kMaxDatagram = 1500;
+
+    LightingServer();
+    ~LightingServer() override { Stop(); }
+
+    // IService::Name
+    const char* Name() const override { return "LightingServer"; }
+
+    void release();
+    bool begin();
+
+    // Receiver
+    //
+    // Created once the buffer managers exist, as the task starts, so nullptr until then
+
+    const LightingReceiver * Receiver() const { return _pReceiver.get(); }
+
+  protected:
+    // ITaskService hooks
+    TaskConfig GetTaskConfig() const override;
+    void Run() override;
+    void OnBeforeWaitForStop() override;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        Arduino.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Minimal stand-in for the Arduino core used by the [env:native] host
+//    build. It only covers what the render core (GFXBase, effects,
+//    EffectManager, DeviceConfig) and its libraries touch: String, Print,
+//    Stream, Serial, ESP, timing, random and a handful of pin no-ops.
+//    Nothing in here is compiled into firmware; include/native is only on
+//    the include path of the native environment.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "esp_attr.h"
+
+using std::abs;
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+using ::round;
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+#define HIGH                0x1
+#define LOW                 0x0
+#define INPUT               0x01
+#define OUTPUT              0x03
+#define INPUT_PULLUP        0x05
+#define INPUT_PULLDOWN      0x09
+
+#define PI                  3.1415926535897932384626433832795
+#define HALF_PI             1.5707963267948966192313216916398
+#define TWO_PI              6.283185307179586476925286766559
+#define DEG_TO_RAD          0.017453292519943295769236907684886
+#define RAD_TO_DEG          57.295779513082320876798154814105
+
+#define PROGMEM
+#define PGM_P               const char *
+#define PSTR(s)             (s)
+#define F(s)                (s)
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define pgm_read_float(addr)    (*(const float *)(addr))
+#define pgm_read_ptr(addr)      (*(void * const *)(addr))
+#define pgm_read_pointer(addr)  (*(void * const *)(addr))
+#define strcpy_P            strcpy
+#define strlen_P            strlen
+#define sprintf_P           sprintf
+#define snprintf_P          snprintf
+#define memcpy_P            memcpy
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg)        ((deg) * DEG_TO_RAD)
+#define degrees(rad)        ((rad) * RAD_TO_DEG)
+#define sq(x)               ((x) * (x))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bit(b)              (1UL << (b))
+
+// Timing
+//
+// millis() and micros() count from the first call in the process, which is
+// close enough to "time since boot" for everything the render core does with them.
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Random
+//
+// Routed through the C library so nd_bench can reseed it for reproducible runs.
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// Pins are accepted and ignored; nothing on the host drives hardware.
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+
+#include "IPAddress.h"
+#include "Print.h"
+#include "Stream.h"
+#include "WString.h"
+
+// HardwareSerial
+//
+// Serial output goes to stdout so log lines and effect prints show up in the
+// terminal alongside nd_bench results; nothing is ever available to read.
+
+class HardwareSerial : public Stream
+{
+  public:
+    void begin(unsigned long, ...) {}
+    void end() {}
+    operator bool() const { return true; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override;
+};
+
+extern HardwareSerial Serial;
+
+// EspClass
+//
+// Heap figures come from the counters kept by the esp_heap_caps shim.
+
+class EspClass
+{
+  public:
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getPsramSize();
+    uint32_t getFreePsram();
+    uint32_t getMinFreePsram();
+    uint32_t getMaxAllocPsram();
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount() { return static_cast<uint32_t>(micros() * getCpuFreqMHz()); }
+    uint64_t getEfuseMac() { return 0x0000DEADBEEF0000ULL; }
+    const char* getChipModel() { return "native"; }
+    const char* getSdkVersion() { return "native"; }
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
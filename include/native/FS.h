@@ -0,0 +1,145 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        FS.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Arduino filesystem API for the native host build, backed by an
+//    in-memory file table. Persistence code in EffectManager, DeviceConfig
+//    and JSONWriter runs unchanged; nothing touches the host disk, so every
+//    nd_bench run starts from compiled defaults.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "Stream.h"
+
+#define FILE_READ       "r"
+#define FILE_WRITE      "w"
+#define FILE_APPEND     "a"
+
+namespace fs
+{
+    class File : public Stream
+    {
+        std::shared_ptr<std::string> _contents;
+        std::string _path;
+        size_t _position = 0;
+        bool _writable = false;
+
+      public:
+        File() = default;
+        File(std::shared_ptr<std::string> contents, std::string path, bool writable, bool append)
+            : _contents(std::move(contents)),
+              _path(std::move(path)),
+              _position(append ? _contents->size() : 0),
+              _writable(writable)
+        {
+        }
+
+        explicit operator bool() const { return !!_contents; }
+
+        size_t write(uint8_t c) override { return write(&c, 1); }
+        size_t write(const uint8_t *buffer, size_t size) override
+        {
+            if (!_contents || !_writable)
+                return 0;
+            _contents->replace(_position, std::min(size, _contents->size() - _position), reinterpret_cast<const char *>(buffer), size);
+            _position += size;
+            return size;
+        }
+        using Print::write;
+
+        int available() override { return _contents ? static_cast<int>(_contents->size() - _position) : 0; }
+        int read() override { return available() > 0 ? static_cast<uint8_t>((*_contents)[_position++]) : -1; }
+        int peek() override { return available() > 0 ? static_cast<uint8_t>((*_contents)[_position]) : -1; }
+        size_t readBytes(char *buffer, size_t length) override
+        {
+            const size_t count = std::min(length, static_cast<size_t>(available()));
+            if (count)
+                memcpy(buffer, _contents->data() + _position, count);
+            _position += count;
+            return count;
+        }
+        using Stream::readBytes;
+
+        bool seek(uint32_t position) { if (!_contents || position > _contents->size()) return false; _position = position; return true; }
+        size_t position() const { return _position; }
+        size_t size() const { return _contents ? _contents->size() : 0; }
+        const char* path() const { return _path.c_str(); }
+        const char* name() const { const auto slash = _path.rfind('/'); return _path.c_str() + (slash == std::string::npos ? 0 : slash + 1); }
+        bool isDirectory() const { return false; }
+        File openNextFile() { return File(); }
+        void close() { _contents.reset(); }
+    };
+
+    class FS
+    {
+        std::map<std::string, std::shared_ptr<std::string>> _files;
+
+      public:
+        File open(const char* path, const char* mode = FILE_READ, bool create = false)
+        {
+            const bool writing = mode && (mode[0] == 'w' || mode[0] == 'a');
+            auto entry = _files.find(path);
+            if (entry == _files.end())
+            {
+                if (!writing && !create)
+                    return File();
+                entry = _files.emplace(path, std::make_shared<std::string>()).first;
+            }
+            else if (mode && mode[0] == 'w')
+            {
+                entry->second->clear();
+            }
+            return File(entry->second, path, writing, mode && mode[0] == 'a');
+        }
+        File open(const String& path, const char* mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+
+        bool exists(const char* path) const { return _files.count(path) != 0; }
+        bool exists(const String& path) const { return exists(path.c_str()); }
+        bool remove(const char* path) { return _files.erase(path) != 0; }
+        bool remove(const String& path) { return remove(path.c_str()); }
+        bool rename(const char* from, const char* to)
+        {
+            auto entry = _files.find(from);
+            if (entry == _files.end())
+                return false;
+            _files[to] = entry->second;
+            _files.erase(entry);
+            return true;
+        }
+        bool mkdir(const char*) { return true; }
+        bool rmdir(const char*) { return true; }
+    };
+}
+
+using fs::File;
+using fs::FS;
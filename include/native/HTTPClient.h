@@ -0,0 +1,50 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        HTTPClient.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    HTTPClient for the native host build. The host has no network path,
+//    so every request fails the way an unreachable server would.
+//
+//---------------------------------------------------------------------------
+
+#include "WString.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTP_CODE_OK                    200
+#define HTTP_CODE_UNAUTHORIZED          401
+#define HTTP_CODE_NOT_FOUND             404
+
+class HTTPClient
+{
+  public:
+    bool begin(const String&) { return true; }
+    void end() {}
+    void setTimeout(uint16_t) {}
+    void addHeader(const String&, const String&) {}
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int POST(const String&) { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    String getString() { return String(); }
+    static String errorToString(int) { return "no network on native host"; }
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        IPAddress.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Arduino IPAddress for the native host build. Only needed so the
+//    nd_network declarations compile; the host never has an address.
+//
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstdio>
+
+#include "WString.h"
+
+class IPAddress
+{
+    uint8_t _bytes[4] = { 0, 0, 0, 0 };
+
+  public:
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes{ a, b, c, d } {}
+
+    uint8_t operator[](int index) const { return _bytes[index]; }
+    uint8_t& operator[](int index) { return _bytes[index]; }
+    bool operator==(const IPAddress& rhs) const { return _bytes[0] == rhs._bytes[0] && _bytes[1] == rhs._bytes[1]
+                                                      && _bytes[2] == rhs._bytes[2] && _bytes[3] == rhs._bytes[3]; }
+
+    String toString() const
+    {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+        return buffer;
+    }
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        Print.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Arduino Print base class for the native host build. Adafruit_GFX
+//    derives from it and ArduinoJson serializes into it.
+//
+//---------------------------------------------------------------------------
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "WString.h"
+
+class Print
+{
+  public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+            n += write(*buffer++);
+        return n;
+    }
+    virtual void flush() {}
+
+    size_t write(const char *str) { return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char stackBuffer[256];
+        va_list args;
+        va_start(args, format);
+        const int len = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+        va_end(args);
+        if (len < 0)
+            return 0;
+        if (static_cast<size_t>(len) < sizeof(stackBuffer))
+            return write(stackBuffer, len);
+
+        char *buffer = new char[len + 1];
+        va_start(args, format);
+        vsnprintf(buffer, len + 1, format, args);
+        va_end(args);
+        const size_t n = write(buffer, len);
+        delete[] buffer;
+        return n;
+    }
+
+    size_t print(const String &s)              { return write(s.c_str(), s.length()); }
+    size_t print(const char *s)                { return write(s); }
+    size_t print(char c)                       { return write(static_cast<uint8_t>(c)); }
+    size_t print(int n, int base = 10)         { return print(String(n, static_cast<unsigned char>(base))); }
+    size_t print(unsigned int n, int base = 10){ return print(String(n, static_cast<unsigned char>(base))); }
+    size_t print(long n, int base = 10)        { return print(String(n, static_cast<unsigned char>(base))); }
+    size_t print(unsigned long n, int base = 10) { return print(String(n, static_cast<unsigned char>(base))); }
+    size_t print(double n, int digits = 2)     { return print(String(n, static_cast<unsigned int>(digits))); }
+
+    size_t println()                           { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &value)             { return print(value) + println(); }
+    template <typename T>
+    size_t println(const T &value, int format) { return print(value, format) + println(); }
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        SD.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    SD card filesystem for the native host build. TJpg_Decoder includes it
+//    unconditionally; on the host it is just another empty in-memory FS.
+//
+//---------------------------------------------------------------------------
+
+#include "FS.h"
+#include "SPI.h"
+
+namespace fs
+{
+    class SDFS : public FS
+    {
+      public:
+        template <typename... Args>
+        bool begin(Args&&...) { return false; }
+        void end() {}
+    };
+}
+
+extern fs::SDFS SD;
@@ -0,0 +1,65 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        SPI.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    SPI bus declarations for the native host build. Adafruit GFX and its
+//    BusIO dependency reference these types; nothing on the host uses a bus.
+//
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+#define SPI_MODE0       0x00
+#define SPI_MODE1       0x01
+#define SPI_MODE2       0x02
+#define SPI_MODE3       0x03
+#define MSBFIRST        1
+#define LSBFIRST        0
+
+typedef uint8_t BitOrder;
+
+class SPISettings
+{
+  public:
+    SPISettings() = default;
+    SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass
+{
+  public:
+    void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t) { return 0; }
+    void transfer(void*, size_t) {}
+    void setFrequency(uint32_t) {}
+    void setDataMode(uint8_t) {}
+    void setBitOrder(uint8_t) {}
+};
+
+extern SPIClass SPI;
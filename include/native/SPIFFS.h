@@ -0,0 +1,49 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        SPIFFS.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    SPIFFS for the native host build: the in-memory fs::FS from FS.h with
+//    the mount and usage calls the firmware makes.
+//
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+
+#include "FS.h"
+
+namespace fs
+{
+    class SPIFFSFS : public FS
+    {
+      public:
+        bool begin(bool = false, const char* = "/spiffs", uint8_t = 10, const char* = nullptr) { return true; }
+        void end() {}
+        bool format() { return true; }
+        size_t totalBytes() const { return 1024 * 1024; }
+        size_t usedBytes() const { return 0; }
+    };
+}
+
+extern fs::SPIFFSFS SPIFFS;
@@ -0,0 +1,68 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        Stream.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Arduino Stream for the native host build. ArduinoJson deserializes
+//    from it; fs::File derives from it.
+//
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Print.h"
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long) {}
+
+    virtual size_t readBytes(char *buffer, size_t length)
+    {
+        size_t count = 0;
+        while (count < length)
+        {
+            const int c = read();
+            if (c < 0)
+                break;
+            *buffer++ = static_cast<char>(c);
+            count++;
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+
+    String readString()
+    {
+        String result;
+        for (int c = read(); c >= 0; c = read())
+            result += static_cast<char>(c);
+        return result;
+    }
+};
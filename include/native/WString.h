@@ -0,0 +1,137 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        WString.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Arduino String for the native host build, implemented on top of
+//    std::string. Only the members used by the render core, DeviceConfig
+//    and ArduinoJson's String adapter are provided.
+//
+//---------------------------------------------------------------------------
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <strings.h>
+
+class String
+{
+    std::string _str;
+
+    template <typename T>
+    static std::string Format(const char* fmt, T value)
+    {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), fmt, value);
+        return buffer;
+    }
+
+  public:
+    String() = default;
+    String(const char* s) : _str(s ? s : "") {}
+    String(const char* s, size_t length) : _str(s ? std::string(s, length) : std::string()) {}
+    String(const std::string& s) : _str(s) {}
+    String(char c) : _str(1, c) {}
+    String(int value, unsigned char base = 10) : _str(base == 16 ? Format("%x", value) : Format("%d", value)) {}
+    String(unsigned int value, unsigned char base = 10) : _str(base == 16 ? Format("%x", value) : Format("%u", value)) {}
+    String(long value, unsigned char base = 10) : _str(base == 16 ? Format("%lx", value) : Format("%ld", value)) {}
+    String(unsigned long value, unsigned char base = 10) : _str(base == 16 ? Format("%lx", value) : Format("%lu", value)) {}
+    String(long long value) : _str(Format("%lld", value)) {}
+    String(unsigned long long value) : _str(Format("%llu", value)) {}
+    String(float value, unsigned int decimals = 2) : _str(FormatFloat(value, decimals)) {}
+    String(double value, unsigned int decimals = 2) : _str(FormatFloat(value, decimals)) {}
+
+    static std::string FormatFloat(double value, unsigned int decimals)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+        return buffer;
+    }
+
+    const char* c_str() const { return _str.c_str(); }
+    unsigned int length() const { return static_cast<unsigned int>(_str.length()); }
+    bool isEmpty() const { return _str.empty(); }
+    bool reserve(unsigned int size) { _str.reserve(size); return true; }
+    void clear() { _str.clear(); }
+
+    bool concat(const String& s) { _str += s._str; return true; }
+    bool concat(const char* s) { if (s) _str += s; return true; }
+    bool concat(const char* s, unsigned int length) { if (s) _str.append(s, length); return true; }
+    bool concat(char c) { _str += c; return true; }
+
+    String& operator+=(const String& s) { concat(s); return *this; }
+    String& operator+=(const char* s) { concat(s); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+    template <typename T>
+    String& operator+=(T value) { concat(String(value)); return *this; }
+
+    friend String operator+(const String& lhs, const String& rhs) { String s(lhs); s += rhs; return s; }
+    friend String operator+(const String& lhs, const char* rhs) { String s(lhs); s += rhs; return s; }
+    friend String operator+(const char* lhs, const String& rhs) { String s(lhs); s += rhs; return s; }
+    template <typename T>
+    friend String operator+(const String& lhs, T rhs) { String s(lhs); s += String(rhs); return s; }
+
+    bool operator==(const String& rhs) const { return _str == rhs._str; }
+    bool operator==(const char* rhs) const { return _str == (rhs ? rhs : ""); }
+    bool operator!=(const String& rhs) const { return !(*this == rhs); }
+    bool operator!=(const char* rhs) const { return !(*this == rhs); }
+    bool operator<(const String& rhs) const { return _str < rhs._str; }
+    bool equals(const String& rhs) const { return *this == rhs; }
+    bool equalsIgnoreCase(const String& rhs) const { return strcasecmp(c_str(), rhs.c_str()) == 0; }
+
+    char operator[](unsigned int index) const { return index < _str.length() ? _str[index] : 0; }
+    char& operator[](unsigned int index) { return _str[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+
+    int indexOf(char c, unsigned int from = 0) const { auto p = _str.find(c, from); return p == std::string::npos ? -1 : static_cast<int>(p); }
+    int indexOf(const String& s, unsigned int from = 0) const { auto p = _str.find(s._str, from); return p == std::string::npos ? -1 : static_cast<int>(p); }
+    int lastIndexOf(char c) const { auto p = _str.rfind(c); return p == std::string::npos ? -1 : static_cast<int>(p); }
+    bool startsWith(const String& s) const { return _str.rfind(s._str, 0) == 0; }
+    bool endsWith(const String& s) const { return _str.length() >= s._str.length() && _str.compare(_str.length() - s._str.length(), s._str.length(), s._str) == 0; }
+
+    String substring(unsigned int from) const { return from < _str.length() ? String(_str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { return from < to && from < _str.length() ? String(_str.substr(from, to - from)) : String(); }
+
+    void trim()
+    {
+        const auto first = _str.find_first_not_of(" \t\r\n");
+        const auto last = _str.find_last_not_of(" \t\r\n");
+        _str = first == std::string::npos ? std::string() : _str.substr(first, last - first + 1);
+    }
+    void toUpperCase() { for (auto& c : _str) c = static_cast<char>(toupper(c)); }
+    void toLowerCase() { for (auto& c : _str) c = static_cast<char>(tolower(c)); }
+    void replace(const String& from, const String& to)
+    {
+        if (from._str.empty())
+            return;
+        for (size_t p = 0; (p = _str.find(from._str, p)) != std::string::npos; p += to._str.length())
+            _str.replace(p, from._str.length(), to._str);
+    }
+
+    long toInt() const { return strtol(_str.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(_str.c_str(), nullptr); }
+    double toDouble() const { return strtod(_str.c_str(), nullptr); }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        Wire.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    I2C bus declarations for the native host build, present only so
+//    Adafruit BusIO headers compile.
+//
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Stream.h"
+
+class TwoWire : public Stream
+{
+  public:
+    bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+    void end() {}
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission(bool = true) { return 4; }
+    uint8_t requestFrom(uint8_t, size_t, bool = true) { return 0; }
+    size_t write(uint8_t) override { return 0; }
+    size_t write(const uint8_t*, size_t) override { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,31 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        driver/adc.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Placeholder for the legacy IDF 4.4 ADC driver header. soundanalyzer.h
+//    includes it unconditionally, but the native build has ENABLE_AUDIO=0 so
+//    nothing from the driver is referenced.
+//
+//---------------------------------------------------------------------------
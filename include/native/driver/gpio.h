@@ -0,0 +1,39 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        driver/gpio.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    GPIO driver types for the native host build. DeviceConfig validates
+//    pin numbers against these; the ranges match the original ESP32.
+//
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+typedef int gpio_num_t;
+
+#define GPIO_NUM_NC                 (-1)
+#define GPIO_NUM_MAX                40
+#define GPIO_IS_VALID_GPIO(pin)         ((pin) >= 0 && (pin) < GPIO_NUM_MAX)
+#define GPIO_IS_VALID_OUTPUT_GPIO(pin)  (GPIO_IS_VALID_GPIO(pin) && (pin) < 34)
@@ -0,0 +1,38 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        esp_attr.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    ESP-IDF section attributes for the native host build. Placement in
+//    IRAM/DRAM/PSRAM has no meaning on the host, so they all expand to nothing.
+//
+//---------------------------------------------------------------------------
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+#define EXT_RAM_BSS_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define WORD_ALIGNED_ATTR   __attribute__((aligned(4)))
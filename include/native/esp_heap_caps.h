@@ -0,0 +1,69 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        esp_heap_caps.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    ESP-IDF capability-based heap API for the native host build. Every
+//    capability maps to the C heap, but allocations are counted so nd_bench
+//    can report heap traffic per frame and ESP.getFreeHeap() stays meaningful.
+//
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+#define MALLOC_CAP_EXEC             (1 << 0)
+#define MALLOC_CAP_32BIT            (1 << 1)
+#define MALLOC_CAP_8BIT             (1 << 2)
+#define MALLOC_CAP_DMA              (1 << 3)
+#define MALLOC_CAP_SPIRAM           (1 << 10)
+#define MALLOC_CAP_INTERNAL         (1 << 11)
+#define MALLOC_CAP_DEFAULT          (1 << 12)
+
+void*  heap_caps_malloc(size_t size, uint32_t caps);
+void*  heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void*  heap_caps_realloc(void* ptr, size_t size, uint32_t caps);
+void   heap_caps_free(void* ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+
+inline bool heap_caps_check_integrity_all(bool) { return true; }
+
+// HostHeapStats
+//
+// Running totals maintained by the host heap_caps_* functions and by the
+// global operator new/delete replacements in src/native/host_runtime.cpp.
+
+struct HostHeapStats
+{
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytesAllocated;
+    uint64_t bytesInUse;
+    uint64_t peakBytesInUse;
+};
+
+HostHeapStats HostGetHeapStats();
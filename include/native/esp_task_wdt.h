@@ -0,0 +1,37 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        esp_task_wdt.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Task watchdog for the native host build. There is no watchdog on the
+//    host, so subscribing, feeding and unsubscribing all succeed trivially.
+//
+//---------------------------------------------------------------------------
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+inline esp_err_t esp_task_wdt_add(TaskHandle_t) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
@@ -0,0 +1,54 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        freertos/FreeRTOS.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    FreeRTOS types and constants for the native host build. Tasks are
+//    backed by std::thread; see freertos/task.h and src/native/host_runtime.cpp.
+//
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+
+#define pdFALSE                     ((BaseType_t)0)
+#define pdTRUE                      ((BaseType_t)1)
+#define pdFAIL                      pdFALSE
+#define pdPASS                      pdTRUE
+#define portMAX_DELAY               ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ          1000
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS            portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms)           ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+#define configMAX_PRIORITIES        25
+#define tskIDLE_PRIORITY            ((UBaseType_t)0U)
+#define tskNO_AFFINITY              ((BaseType_t)0x7FFFFFFF)
+#define portNUM_PROCESSORS          2
@@ -0,0 +1,61 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        freertos/task.h (native host shim)
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    The slice of the FreeRTOS task API the render core's services use,
+//    implemented on std::thread for the native host build. Priorities and
+//    core affinity are recorded but not enforced.
+//
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "FreeRTOS.h"
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t entry,
+                                   const char* name,
+                                   uint32_t stackDepth,
+                                   void* parameter,
+                                   UBaseType_t priority,
+                                   TaskHandle_t* createdTask,
+                                   BaseType_t coreId);
+BaseType_t xTaskCreate(TaskFunction_t entry,
+                       const char* name,
+                       uint32_t stackDepth,
+                       void* parameter,
+                       UBaseType_t priority,
+                       TaskHandle_t* createdTask);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t cpu);
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core);
+BaseType_t xPortGetCoreID();
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+const char* pcTaskGetName(TaskHandle_t task);
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
@@ -57,7 +57,10 @@ enum NetworkPort : int
     IncomingWiFi      = 49152,
     VICESocketServer  = 25232,
     Telnet            = 23,
-    Webserver         = 80
+    Webserver         = 80,
+    DDP               = 4048,
+    E131              = 5568,
+    ArtNet            = 6454
 };
 
 namespace nd_network
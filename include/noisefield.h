@@ -0,0 +1,79 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        noisefield.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Line-at-a-time evaluation of FastLED's 3D Perlin noise, inoise16(),
+//    for GFXBase::FillGetNoise(). inoise16() starts every sample by
+//    splitting each coordinate into a lattice cell and an eased fraction
+//    and hashing the eight corners of its cube. Across a noise pool those
+//    are mostly repeats: z is the same for the whole frame, x for a whole
+//    column, and neighbouring samples share a cell until the coordinate
+//    crosses the next multiple of 65536. Here each coordinate is split
+//    once (an Axis), and SampleLine() walks a column re-hashing the corners
+//    only when the sample moves into a new cell, leaving just the gradients
+//    and the seven fixed-point lerps per sample.
+//
+//    The arithmetic is FastLED's own (permutation table, ease16InOutQuad,
+//    avg15 gradients, lerp15by16, the final 440/256 stretch), so Sample()
+//    returns exactly what inoise16() does; "nd_bench --suite noise" checks
+//    that against the library on the host.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <cstddef>
+#include <cstdint>
+
+class NoiseField
+{
+  public:
+
+    // One noise coordinate split the way inoise16() splits it: the lattice cell, the eased
+    // fraction the lerps use and the halved fraction the gradients use
+
+    struct Axis
+    {
+        uint8_t  cell;
+        uint16_t ease;
+        int16_t  offset;
+
+        static Axis From(uint32_t coordinate);
+    };
+
+    // inoise16(x, y, z)
+
+    static uint16_t Sample(const Axis& x, const Axis& y, const Axis& z);
+
+    static uint16_t Sample(uint32_t x, uint32_t y, uint32_t z)
+    {
+        return Sample(Axis::From(x), Axis::From(y), Axis::From(z));
+    }
+
+    // out[j] = inoise16(x, ys[j], z) >> 8 for each of the count samples of a line of constant x
+    // and z. Runs of ys in the same lattice cell share one set of corner hashes.
+
+    static void SampleLine(uint8_t* out, const Axis& x, const Axis* ys, size_t count, const Axis& z);
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        outputservice.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    OutputService moves strip Show() off the render task. PostProcessFrame
+//    copies the finished frame into one of a small pool of frame buffers
+//    and posts it; the service's task, pinned to OUTPUT_CORE, shows posted
+//    frames in order through the strip output manager, and the render task
+//    goes straight on to draw the next frame. On a long strip that turns
+//    the wire time from a floor under every frame into time the next
+//    Draw() runs in.
+//
+//    The pool is a single-producer, single-consumer ring: the render task
+//    is the only one that posts and the output task the only one that
+//    shows. When every pooled frame is still waiting to be shown the
+//    render task blocks in Post() until the output task frees one, so it
+//    can never get more than the pool's worth of frames ahead of the
+//    strip. Time spent there is recorded as RenderStage::OutputWait, the
+//    copy as Snapshot, and each frame's time in the pool as OutputQueue.
+//
+//    Built only with ASYNC_STRIP_OUTPUT; with it off, or with the service
+//    stopped, PostProcessFrame calls Show() itself as it always has.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#if USE_STRIP && ASYNC_STRIP_OUTPUT
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "interfaces.h"
+#include "itaskservice.h"
+#include "stripoutputmanager.h"
+
+// OUTPUT_FRAME_POOL: frames the render task may have posted and not yet seen
+// shown, counting the one on its way out. Two lets one frame be drawn while
+// the last one is shown; each more adds a frame of latency.
+
+#ifndef OUTPUT_FRAME_POOL
+    #define OUTPUT_FRAME_POOL 2
+#endif
+
+class OutputService : public ITaskService
+{
+  public:
+    static constexpr size_t kPoolSize = OUTPUT_FRAME_POOL;
+
+    explicit OutputService(IStripOutputManager& output) : _output(output) {}
+    ~OutputService() override { Stop(); }
+
+    const char* Name() const override { return "OutputService"; }
+
+    // Copies the devices' buffers into a free frame and queues it to be shown, waiting
+    // for one to free up if need be. Called only from the render task. Returns false,
+    // having posted nothing, if the service isn't running; the caller then shows the
+    // frame itself.
+
+    bool Post(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader);
+
+    // Waits until every posted frame has been shown. ApplyRuntimeConfiguration() calls it, holding the
+    // render task off, before it changes the transport.
+
+    void Flush();
+
+    size_t Depth() const { return _posted.load() - _shown.load(); }
+    uint32_t FramesShown() const { return _shown.load(); }
+
+  protected:
+    TaskConfig GetTaskConfig() const override;
+    void Run() override;
+    void OnBeforeWaitForStop() override { WakeTask(); }
+    void OnAfterStop() override { _shown.store(_posted.load()); }      // Frames still queued are dropped
+
+  private:
+    struct Frame
+    {
+        std::vector<CRGB, psram_allocator<CRGB>>   leds;
+        std::vector<CRGBW, psram_allocator<CRGBW>> whites;
+        std::array<ChannelPlanes, NUM_CHANNELS>    planes {};
+        size_t   channelCount = 0;
+        uint16_t pixelsDrawn  = 0;
+        uint8_t  brightness   = 0;
+        uint8_t  fader        = 0;
+        uint32_t postedMicros = 0;
+    };
+
+    bool WaitForShown(uint32_t target);
+    void Snapshot(Frame& frame, const std::vector<std::shared_ptr<GFXBase>>& devices);
+
+    IStripOutputManager&        _output;
+    std::array<Frame, kPoolSize> _pool;
+    std::atomic<uint32_t>       _posted { 0 };          // Written only by the render task
+    std::atomic<uint32_t>       _shown  { 0 };          // Written by the output task, and by Stop() once it has exited
+    std::atomic<TaskHandle_t>   _waiter { nullptr };    // The task blocked in Post() or Flush(), if any
+};
+
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        pixelbatch.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    WIFI_COMMAND_PIXELBATCH64 carries a frame for each of several channels
+//    in one packet, under one timestamp, so a multi-channel controller pays
+//    for one header, one lock and one response per frame rather than one
+//    per channel, and its channels stay frame-locked. All fields are
+//    little-endian:
+//
+//      0   uint16  WIFI_COMMAND_PIXELBATCH64
+//      2   uint16  entry count, one per channel from channel 0, at most 16
+//      4   uint32  pixels of data after the table, shared by the entries
+//      8   uint64  seconds
+//      16  uint64  microseconds
+//      24  entries uint32 offset into the data and uint32 LEDs, in pixels;
+//                  0 LEDs leaves the channel alone
+//          pixels  3 bytes each
+//
+//    Entries may share or skip pixels; when those in use run in order of
+//    offset without overlapping, the socket server reads each straight
+//    into its channel's buffer. Channels this device doesn't have are
+//    ignored. The frames are queued as one, with one due time, so the
+//    render task shows all of them on the same pass or none.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include "ledbuffer.h"
+
+class PixelBatch
+{
+  public:
+
+    static constexpr size_t kHeaderSize = LEDBuffer::kWireHeaderSize;
+    static constexpr size_t kEntrySize  = 8;
+    static constexpr size_t kMaxEntries = 16;                   // One per bit of a channel mask
+
+    static constexpr size_t TableSize(uint16_t entryCount) { return entryCount * kEntrySize; }
+
+    // CheckedPacketSize
+    //
+    // The size of a whole batch packet from its header's fields, or false if it's not a valid one
+
+    static bool CheckedPacketSize(uint16_t entryCount, uint32_t pixelCount, size_t & packetSize);
+
+    // CheckTable
+    //
+    // Check every entry lies within the pixelCount pixels after the table, and whether the ones in use
+    // run in order of offset without overlapping, so they can be read off a socket one after another
+
+    static bool CheckTable(const uint8_t * pTable, uint16_t entryCount, uint32_t pixelCount, bool & inOrder);
+
+    static void Entry(const uint8_t * pTable, size_t iEntry, uint32_t & offset, uint32_t & count);
+
+    // The batch fills the managers' reservation for the receiver it's given
+
+    PixelBatch(LEDBufferManager * pManagers, size_t cManagers, BufferReservation reservation);
+
+    // Reserve
+    //
+    // Reserve a buffer on every channel an entry gives pixels to, or return false if one of them has
+    // fewer LEDs than its entry. Caller holds g_buffer_mutex.
+
+    bool Reserve(const uint8_t * pTable, uint16_t entryCount);
+
+    // Target
+    //
+    // Where channel iChannel's pixels go, or nullptr if the batch leaves it alone or it isn't here
+
+    CRGB * Target(size_t iChannel) const;
+
+    // Fill
+    //
+    // Copy every reserved channel's pixels out of pPixels, the data after the table
+
+    void Fill(const uint8_t * pTable, const uint8_t * pPixels);
+
+    // Commit
+    //
+    // Stamp every reserved frame and queue them as one; see LEDBufferManager::CommitBuffers(). Returns
+    // the first channel queued, or -1 if none were. Caller holds g_buffer_mutex.
+
+    int Commit(uint64_t seconds, uint64_t micros, uint64_t arrivalMicros);
+
+  private:
+
+    LEDBufferManager *                                  _pManagers;
+    size_t                                              _cManagers;
+    BufferReservation                                   _reservation;
+    std::array<std::shared_ptr<LEDBuffer>, kMaxEntries> _targets;
+    std::array<uint32_t, kMaxEntries>                   _counts {};
+};
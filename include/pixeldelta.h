@@ -0,0 +1,123 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        pixeldelta.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    WIFI_COMMAND_PIXELDELTA64 carries only the pixels that changed since
+//    the sender's previous frame on the same channels, so mostly-static
+//    content costs a fraction of a full WIFI_COMMAND_PIXELDATA64 frame.
+//    All fields are little-endian:
+//
+//      0   uint16  WIFI_COMMAND_PIXELDELTA64
+//      2   uint16  channel mask, as for WIFI_COMMAND_PIXELDATA64
+//      4   uint32  LEDs in the frame
+//      8   uint64  seconds
+//      16  uint64  microseconds
+//      24  uint32  sequence number, one more than the sender's last frame
+//      28  uint16  flags; kKeyframe means the runs apply to a black frame
+//      30  uint16  run count
+//      32  runs    uint16 unchanged pixels to skip, uint16 pixels that follow
+//          pixels  every changed pixel, 3 bytes each, in run order
+//
+//    Anything but a keyframe applies to the frame the stream last queued,
+//    which must still be the newest one on the channel and carry the
+//    previous sequence number. When it isn't - a frame was lost or
+//    dropped, or something else drew on the channel - deltas are skipped
+//    until the next keyframe, which senders send every so often to bound
+//    how long that takes. tools/pixeldelta.py is the reference encoder.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "ledbuffer.h"
+
+class PixelDelta
+{
+  public:
+
+    static constexpr size_t   kHeaderSize = LEDBuffer::kWireHeaderSize + 8;    // Up to and including the run count
+    static constexpr size_t   kRunSize    = 4;
+    static constexpr uint16_t kKeyframe   = 0x0001;
+
+    // CheckRuns
+    //
+    // Check a run table covers no more than pixelCount pixels, and count the changed pixels that follow it
+
+    static bool CheckRuns(const uint8_t * pRuns, uint16_t runCount, uint32_t pixelCount, size_t & changedPixels);
+
+    // Scatters the changed pixels into pPixels as they arrive, in pieces of any size. The run table
+    // must have passed CheckRuns() and stay put until the last pixel has been fed.
+
+    PixelDelta(const uint8_t * pRuns, uint16_t runCount, CRGB * pPixels);
+
+    void Feed(const uint8_t * pData, size_t cb);
+
+  private:
+
+    void NextRun();
+
+    const uint8_t * _pRuns;
+    uint16_t        _runsLeft;
+    uint8_t *       _pDest;
+    size_t          _cbLeftInRun = 0;
+};
+
+// DeltaSequence
+//
+// Which frame a stream's next delta applies to. The socket server keeps one per connection; all of
+// its calls are made with g_buffer_mutex held. It keeps its own copy of that frame's pixels, as the
+// buffer it was queued in goes back to the pool once drawn, and any receiver may be handed it there.
+
+class DeltaSequence
+{
+  public:
+
+    // PrepareBase
+    //
+    // Fill target, reserved from manager, with what a delta applies to: black for a keyframe, else the
+    // frame this stream queued last. False if the delta can't be applied, in which case
+    // every delta is refused until a keyframe arrives.
+
+    bool PrepareBase(const LEDBufferManager & manager, uint16_t channel16, uint32_t sequence, uint16_t flags, uint32_t pixelCount, LEDBuffer & target);
+
+    // Committed
+    //
+    // Note frame, just committed to manager, as the one the next delta applies to
+
+    void Committed(const LEDBufferManager & manager, uint16_t channel16, uint32_t sequence, const LEDBuffer & frame);
+
+    void Reset();
+
+  private:
+
+    bool     _valid      = false;
+    uint16_t _channel16  = 0;
+    uint32_t _sequence   = 0;
+    uint32_t _generation = 0;
+    std::vector<CRGB, psram_allocator<CRGB>> _base;     // The pixels of the frame committed last
+};
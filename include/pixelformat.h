@@ -29,8 +29,18 @@
 //                      W is synthesized from RGB shared-portion + summed
 //                      with effect-explicit (cw, ww) from the whites plane.
 //
-//     [future] Sm16825Format / Ws2805Format - 5 bytes/pixel. CW and WW
-//                      emitted directly as separate channels.
+//     Ws2805Format   - 5 bytes/pixel.  CW and WW emitted directly as
+//                      separate channels; synthesized white is split
+//                      between them by cctKelvin.
+//
+//   Pack() is the readable per-pixel definition of each format. Show()
+//   doesn't call it: at ApplyConfig time the format hands out a PackKernel
+//   specialized for the color order, which does the same work from
+//   tables in a PackParams - one scale table per frame folding brightness,
+//   fader and optional gamma together, and the white-extraction tables per
+//   configuration - and stores whole 32-bit words. The kernels live in
+//   pixelformat.cpp and must match Pack() byte for byte; nd_bench --suite
+//   pack checks that they do.
 //
 //   All formats currently use the same WS281x family bit timings (800 kHz
 //   NRZ). Future 5-channel formats will need different timings; when that
@@ -42,6 +52,7 @@
 #include "globals.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -49,6 +60,66 @@
 #include "deviceconfig.h"   // DeviceConfig::WS281xColorOrder
 #include "pixeltypes.h"     // FastLED CRGB
 
+// ---------------------------------------------------------------------
+// Pack kernels
+// ---------------------------------------------------------------------
+
+// PackParams
+//
+// The per-pixel arithmetic of Pack(), done once into tables. SetScale()
+// runs every frame; SetWhitePolicy() only when the white knobs change.
+
+struct PackParams
+{
+    std::array<uint8_t, 256> scale {};       // Output byte for a channel value: brightness, fader, gamma
+    std::array<uint8_t, 256> pull {};        // Shared white pulled out of RGB, by min(R, G, B)
+    std::array<uint8_t, 256> coolShare {};   // CW part of a pulled white at cctKelvin; WW gets the rest
+    uint8_t ambientWhite = 0;                // ambientCw + ambientWw, for single-white formats
+    uint8_t ambientCw = 0;
+    uint8_t ambientWw = 0;
+
+    // Brightness and fader as Pack() applies them, after gamma[value] if a
+    // 256-entry gamma table is given
+    void SetScale(uint8_t brightness, uint8_t fader, const uint8_t* gamma = nullptr);
+
+    void SetWhitePolicy(uint16_t cctKelvin, uint8_t ambientCw, uint8_t ambientWw, uint8_t whiteExtractRatio);
+};
+
+// PackSums
+//
+// What a kernel packed, before the scale table: each channel's values
+// summed over the pixels it wrote. The power limiter works from these
+// rather than making a pass of its own over the frame.
+
+struct PackSums
+{
+    uint32_t red = 0;
+    uint32_t green = 0;
+    uint32_t blue = 0;
+    uint32_t white = 0;                      // W, or CW + WW, after extraction and the ambient floor
+    uint32_t pixels = 0;                     // LEDs packed, lit or not
+
+    PackSums& operator+=(const PackSums& other)
+    {
+        red    += other.red;
+        green  += other.green;
+        blue   += other.blue;
+        white  += other.white;
+        pixels += other.pixels;
+        return *this;
+    }
+};
+
+// A format's Pack() for one color order, taking its parameters from a
+// PackParams, and returning what it packed. `output` must be 4-byte
+// aligned; the channel buffers come from heap_caps_malloc, which always is.
+using PackKernel = PackSums (*)(uint8_t* output,
+                                const CRGB* leds,
+                                const CRGBW* whites,                 // may be nullptr
+                                size_t activeLedCount,
+                                size_t pixelsToShow,
+                                const PackParams& params);
+
 // ---------------------------------------------------------------------
 // Abstract base
 // ---------------------------------------------------------------------
@@ -62,6 +133,10 @@ public:
     // RGB chips, 4 for RGBW, 5 for RGBCCW.
     virtual size_t BytesPerPixel() const = 0;
 
+    // The kernel that does what Pack() does for this color order. Picked
+    // once per configuration so the per-frame path never switches on it.
+    virtual PackKernel SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const = 0;
+
     // Pack `activeLedCount` pixels into `output`. Pixels at index >=
     // pixelsToShow are written as black. `whites` may be nullptr (which
     // is the normal case for plain CRGB effects) - in that case the
@@ -161,6 +236,7 @@ class Ws2812Format final : public PixelFormat
 {
 public:
     size_t BytesPerPixel() const override { return 3; }
+    PackKernel SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const override;
 
     void Pack(uint8_t* output,
               const CRGB* leds,
@@ -217,6 +293,7 @@ class Sk6812Format final : public PixelFormat
 {
 public:
     size_t BytesPerPixel() const override { return 4; }
+    PackKernel SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const override;
 
     void Pack(uint8_t* output,
               const CRGB* leds,
@@ -289,3 +366,60 @@ public:
         }
     }
 };
+
+// ---------------------------------------------------------------------
+// Ws2805Format - 5 bytes per pixel (RGB + cool white + warm white)
+// ---------------------------------------------------------------------
+//
+// WS2805 strips carry separate cool and warm white LEDs, so the (cw, ww)
+// intent goes out as it is: RGB in the configured color order, then CW,
+// then WW. Shared white pulled out of RGB is split between the two at
+// cctKelvin with SplitByCct(), and the ambient floors apply per channel.
+
+class Ws2805Format final : public PixelFormat
+{
+public:
+    size_t BytesPerPixel() const override { return 5; }
+    PackKernel SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const override;
+
+    void Pack(uint8_t* output,
+              const CRGB* leds,
+              const CRGBW* whites,
+              size_t activeLedCount,
+              size_t pixelsToShow,
+              uint8_t brightness,
+              uint8_t fader,
+              DeviceConfig::WS281xColorOrder colorOrder,
+              uint16_t cctKelvin,
+              uint8_t ambientCw,
+              uint8_t ambientWw,
+              uint8_t whiteExtractRatio) const override
+    {
+        const auto idx = PixelFormatHelpers::IndicesFor(colorOrder);
+        const uint16_t ratio = static_cast<uint16_t>(whiteExtractRatio);
+
+        for (size_t i = 0; i < activeLedCount; ++i)
+        {
+            CRGB color = (i < pixelsToShow) ? leds[i] : CRGB::Black;
+            CRGBW white = whites ? whites[i] : CRGBW::Black();
+
+            // As on SK6812, explicit whites are additive and suppress the pull
+            if (white.isZero())
+            {
+                const uint8_t shared = std::min(color.r, std::min(color.g, color.b));
+                const uint8_t pull = static_cast<uint8_t>((static_cast<uint16_t>(shared) * ratio + 127) / 255);
+                color.r -= pull;
+                color.g -= pull;
+                color.b -= pull;
+                white = SplitByCct(cctKelvin, pull);
+            }
+
+            const size_t off = i * 5;
+            output[off + idx.rIdx] = PixelFormatHelpers::Scale(color.r, brightness, fader);
+            output[off + idx.gIdx] = PixelFormatHelpers::Scale(color.g, brightness, fader);
+            output[off + idx.bIdx] = PixelFormatHelpers::Scale(color.b, brightness, fader);
+            output[off + 3]        = PixelFormatHelpers::Scale(std::max(white.cw, ambientCw), brightness, fader);
+            output[off + 4]        = PixelFormatHelpers::Scale(std::max(white.ww, ambientWw), brightness, fader);
+        }
+    }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        pixelmap.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Lookup-table pixel mapping for physical layouts that aren't a single
+//    serpentine or linear matrix: panels chained in blocks, rotated tiles,
+//    grid cells with no LED behind them. The table holds one uint16_t LED
+//    index per logical pixel (row-major), so GFXBase::xy() becomes a single
+//    load no matter how the panels are wired.
+//
+//    In builds with USE_PIXEL_MAP, GFXBase::ConfigureTopology() looks for a
+//    map on SPIFFS, in order:
+//
+//      /pixelmap.bin   Compact binary table, as written by tools/pixelmap.py
+//      /pixelmap.json  Layout description, built into a table on the device
+//
+//    A map only applies when its width and height match the topology being
+//    configured; otherwise the device keeps its plain serpentine/linear xy().
+//
+//    Layout description:
+//
+//      {
+//        "width": 32, "height": 16,
+//        "tiles": [
+//          { "x": 0,  "y": 0, "width": 16, "height": 16, "rotation": 0,   "serpentine": true },
+//          { "x": 16, "y": 0, "width": 16, "height": 16, "rotation": 180, "serpentine": true, "skip": 2 }
+//        ]
+//      }
+//
+//    Tiles are listed in chain order. Within a tile the LEDs run in columns
+//    of the tile's height (odd columns reversed when serpentine), the same
+//    convention as GFXBase::xy(), and "rotation" turns that wiring clockwise
+//    by 0, 90, 180 or 270 degrees. "skip" is the number of LEDs in the chain
+//    ahead of the tile that aren't part of the grid. Grid cells no tile
+//    covers are parked on those skipped LEDs, then on the indices past the
+//    end of the chain, so the chain plus its skips must fit in
+//    width * height LEDs.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <utility>
+#include <vector>
+
+#define PIXEL_MAP_FILE              "/pixelmap.bin"
+#define PIXEL_LAYOUT_FILE           "/pixelmap.json"
+
+class PixelMap
+{
+  public:
+    // Logical (row-major) pixel -> LED index. Empty means "no map"
+    using Table = std::vector<uint16_t>;
+
+    struct Tile
+    {
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        uint16_t rotation = 0;          // Clockwise degrees: 0, 90, 180 or 270
+        bool     serpentine = true;
+        uint16_t skip = 0;              // Unmapped chain LEDs ahead of this tile
+    };
+
+    // Binary file layout, all little-endian: magic, version, reserved byte, width, height, then
+    // width * height uint16_t LED indices in row-major order
+    static constexpr char     kMagic[4] = { 'N', 'D', 'P', 'M' };
+    static constexpr uint8_t  kVersion = 1;
+    static constexpr size_t   kHeaderSize = 10;
+
+    // Each returns { true, "" } and fills table on success, or { false, reason } and leaves it empty
+
+    static std::pair<bool, String> FromTiles(const std::vector<Tile>& tiles, size_t width, size_t height, Table& table);
+    static std::pair<bool, String> FromLayout(JsonObjectConst layout, size_t width, size_t height, Table& table);
+    static std::pair<bool, String> FromBinary(const uint8_t* data, size_t size, size_t width, size_t height, Table& table);
+
+    static std::vector<uint8_t> ToBinary(const Table& table, size_t width, size_t height);
+
+    // Loads whichever map file is on SPIFFS for this topology. Returns an empty table when there
+    // is none, or when it doesn't fit; the reason is logged.
+    static Table Load(size_t width, size_t height);
+};
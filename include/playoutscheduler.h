@@ -0,0 +1,136 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        playoutscheduler.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Decides when each frame that arrives over WiFi should be shown. The
+//    sender stamps every frame with the time it wants it on the LEDs; the
+//    scheduler watches how far the arrival times sit from those stamps to
+//    estimate the clock offset between sender and receiver, how that
+//    offset drifts, and how much the network jitters, and from those keeps
+//    a playout delay that puts frames on the LEDs at the sender's cadence
+//    rather than whenever WiFi happened to deliver them.
+//
+//    With both clocks on NTP the delay is never negative, so a sender that
+//    stamps frames far enough ahead has them shown exactly on time, as
+//    before; the delay only grows when frames start arriving after their
+//    stamps. If the two clocks are clearly not on the same time, as before
+//    NTP has set the local one, the stamps are only used for their spacing
+//    and frames are shown as soon after arrival as the jitter allows.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <atomic>
+#include <cstdint>
+
+class PlayoutScheduler
+{
+  public:
+
+    // Sender and receiver clocks further apart than this are not both on NTP time
+    static constexpr int64_t kUnsyncedOffset   = 30 * (int64_t) MICROS_PER_SECOND;
+
+    // A jump in transit time bigger than this is a clock step or a new stream, not jitter
+    static constexpr int64_t kResyncStep       = 2 * (int64_t) MICROS_PER_SECOND;
+
+    // Sender time over which the fastest transit is taken as one sample of the clock offset
+    static constexpr int64_t kFloorWindow      = 2 * (int64_t) MICROS_PER_SECOND;
+
+    // Buffering kept on top of the fastest transit: this many times the jitter, plus a margin
+    static constexpr int64_t kJitterMultiplier = 4;
+    static constexpr int64_t kMargin           = 2000;
+    static constexpr int64_t kMaxBuffering     = (int64_t) MICROS_PER_SECOND / 2;
+
+    // The delay moves towards its target by at most this fraction of each frame's interval, so
+    // frames are never bunched or spread by more than that
+    static constexpr int64_t kGrowDivisor      = 16;
+    static constexpr int64_t kShrinkDivisor    = 64;
+
+    // Schedule
+    //
+    // Takes a frame's sender stamp and the local time it arrived, both in microseconds, and returns
+    // the local time it should be shown. A frame stamped 0 is shown on arrival. For the socket task.
+
+    int64_t Schedule(int64_t stamp, int64_t arrival);
+
+    // CountDropped
+    //
+    // Frames that were queued but never shown: pushed out of a full queue, or skipped because a newer
+    // frame was already due. Safe from any task.
+
+    void CountDropped(uint32_t frames = 1);
+
+    // CountOverwritten
+    //
+    // A frame pushed out of a full queue, which is counted as dropped too. Safe from any task.
+
+    void CountOverwritten();
+
+    // Reset
+    //
+    // Forgets the estimates, keeping the counters. Neither task may be using the scheduler.
+
+    void Reset();
+
+    uint32_t LateFrames() const;                // Arrived after the time they should have been shown
+    uint32_t DroppedFrames() const;
+    uint32_t OverwrittenFrames() const;         // Of the dropped ones, those a full queue pushed out
+    int32_t  PlayoutDelay() const;              // Microseconds of buffering on top of the fastest transit
+    int32_t  Jitter() const;                    // Microseconds, smoothed as in RFC 3550
+    int32_t  ClockDriftPPM() const;             // How fast the receiver's clock gains on the sender's
+    bool     IsSenderClockTrusted() const;      // Both clocks are on the same time, so stamps are honored
+
+  private:
+
+    int64_t FloorAt(int64_t stamp) const;
+    void    Publish(int64_t floor);
+
+    // The estimate, kept by the socket task alone
+
+    bool    _started       = false;
+    int64_t _lastStamp     = 0;
+    int64_t _lastTransit   = 0;
+    int64_t _delay         = 0;                 // Applied: a frame stamped t is shown at t + _delay
+    double  _jitter        = 0;
+
+    int64_t _windowStart   = 0;                 // Sender time the current floor window opened
+    int64_t _windowMin     = 0;                 // Fastest transit seen in it so far
+    int64_t _windowMinStamp = 0;
+    bool    _hasFloor      = false;
+    int64_t _floor         = 0;                 // Fastest transit of the last whole window,
+    int64_t _floorStamp    = 0;                 //   and the stamp of the frame that had it
+    double  _drift         = 0;                 // Change in transit per microsecond of sender time
+
+    // Published for the statistics
+
+    std::atomic<uint32_t> _lateFrames    { 0 };
+    std::atomic<uint32_t> _droppedFrames { 0 };
+    std::atomic<uint32_t> _overwrittenFrames { 0 };
+    std::atomic<int32_t>  _playoutDelay  { 0 };
+    std::atomic<int32_t>  _jitterMicros  { 0 };
+    std::atomic<int32_t>  _driftPPM      { 0 };
+    std::atomic<bool>     _trusted       { false };
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        polarlut.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Precomputed polar coordinates for the radial effects (RadialFire,
+//    RadialWave, Colorspin, Hypnosis, Crystallize), so none of them does
+//    atan2/hypot per pixel per frame or keeps its own table.
+//
+//    A map is built the first time someone asks for a given topology,
+//    center and radius scale, and is shared by every effect that asks for
+//    the same ones. When a different width or height is asked for (the
+//    topology changed) the maps for the old size are dropped from the cache;
+//    an effect still holding one keeps it alive until it lets go.
+//
+//    Maps are indexed [x][y] like the old GFXBase::getPolarMap() array,
+//    one 4-byte Entry per pixel, in PSRAM when the board has it.
+//    BytesInUse() reports what the cache holds, and /statistics shows it
+//    as POLAR_LUT_BYTES.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <memory>
+#include <vector>
+
+#include "interfaces.h"
+
+class PolarLUT
+{
+  public:
+
+    struct Entry
+    {
+        uint8_t angle;              // 0-255 around the center, 0 along +x, 64 along +y
+        uint8_t scaled_radius;      // Distance from the center times Params::radiusScale
+        uint8_t unscaled_radius;    // Distance from the center in pixels
+        uint8_t squared_radius;     // Low byte of dx*dx + dy*dy, offsets truncated toward the center
+    };
+
+    // Where a map is centered, in pixel coordinates, and how scaled_radius is scaled
+
+    struct Params
+    {
+        uint16_t width;
+        uint16_t height;
+        float    centerX;
+        float    centerY;
+        float    radiusScale;
+
+        bool operator==(const Params& other) const
+        {
+            return width == other.width && height == other.height
+                && centerX == other.centerX && centerY == other.centerY
+                && radiusScale == other.radiusScale;
+        }
+
+        // Centered on pixel (width / 2, height / 2), with scaled_radius spanning 255 per matrix
+        // width; the layout getPolarMap() always had
+        static Params Centered(uint16_t width, uint16_t height)
+        {
+            return { width, height, static_cast<float>(width / 2), static_cast<float>(height / 2), 255.0f / width };
+        }
+
+        // Centered between the middle pixels, so an even-sized matrix is symmetric about it
+        static Params Geometric(uint16_t width, uint16_t height)
+        {
+            return { width, height, (width - 1) * 0.5f, (height - 1) * 0.5f, 255.0f / width };
+        }
+    };
+
+    // The shared map for params, built on first use
+    static std::shared_ptr<const PolarLUT> Get(const Params& params);
+
+    // Bytes of map data the cache is currently holding
+    static size_t BytesInUse();
+
+    const Params& GetParams() const
+    {
+        return _params;
+    }
+
+    uint16_t width() const
+    {
+        return _params.width;
+    }
+
+    uint16_t height() const
+    {
+        return _params.height;
+    }
+
+    const Entry& at(uint16_t x, uint16_t y) const
+    {
+        return _entries[x * _params.height + y];
+    }
+
+    // The column at x, so map[x][y] reads like the old array
+    const Entry* operator[](uint16_t x) const
+    {
+        return &_entries[x * _params.height];
+    }
+
+    explicit PolarLUT(const Params& params);
+
+  private:
+
+    Params _params;
+    std::vector<Entry, psram_allocator<Entry>> _entries;
+};
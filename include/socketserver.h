@@ -39,6 +39,9 @@
 #include <sys/socket.h>
 
 #include "itaskservice.h"
+#include "pixeldelta.h"
+
+class Inflater;
 
 #define STANDARD_DATA_HEADER_SIZE   24                                             // Size of the header for expanded data
 #define COMPRESSED_HEADER_SIZE      16                                             // Size of the header for compressed data
@@ -71,7 +74,9 @@ bool ProcessIncomingData(allocated_unique_ptr<uint8_t []> & payloadData, size_t
 
 // SocketResponse
 //
-// Response data sent back to server every time we receive a packet
+// Response data sent back to server every time we receive a packet. The fields after watts describe
+// the queue of the channel the frame went to, so a sender can pace itself to keep it from running dry
+// or overflowing; size tells a sender which of them this firmware sends.
 struct SocketResponse
 {
     uint32_t    size;              // 4
@@ -86,6 +91,13 @@ struct SocketResponse
     uint32_t    bufferPos;         // 4
     uint32_t    fpsDrawing;        // 4
     uint32_t    watts;             // 4
+    double      oldestDue;         // 8    Seconds until the oldest queued frame is shown, negative if overdue
+    double      newestDue;         // 8    ... and the newest; both 0 if the queue is empty
+    uint32_t    droppedFrames;     // 4    Queued but never shown, since boot
+    uint32_t    overwrittenFrames; // 4    Of those, pushed out of a full queue
+    uint32_t    lateFrames;        // 4    Arrived after they were due
+    int32_t     playoutDelay;      // 4    Microseconds of buffering the device adds for jitter
+    uint32_t    channel;           // 4    The channel whose queue bufferSize and the fields above describe
 } __attribute__((packed));
 
 static_assert(sizeof(double) == 8);             // SocketResponse on wire uses 8 byte doubles
@@ -96,7 +108,7 @@ static_assert(sizeof(float)  == 4);             // PeakData on wire uses 4 byte
 // floats land on byte multiples of 8, otherwise you'll get packing bytes inserted.  Welcome to my world! Once upon
 // a time, I ported about a billion lines of x86 'pragma_pack(1)' code to the MIPS (davepl)!
 
-static_assert( sizeof(SocketResponse) == 72, "SocketResponse struct size is not what is expected - check alignment and float size" );
+static_assert( sizeof(SocketResponse) == 108, "SocketResponse struct size is not what is expected - check alignment and float size" );
 
 // SocketServer
 //
@@ -121,6 +133,9 @@ private:
     struct sockaddr_in          _address;
     allocated_unique_ptr<uint8_t []> _pBuffer;
     allocated_unique_ptr<uint8_t []> _abOutputBuffer;
+    allocated_unique_ptr<Inflater> _pInflater;
+    DeltaSequence               _deltaSequence;
+    size_t                      _responseChannel = 0;   // First channel the last frame went to
 
 public:
 
@@ -152,18 +167,55 @@ public:
 
     bool ReadUntilNBytesReceived(size_t socket, size_t cbNeeded);
 
+    // ReadExactly
+    //
+    // Read exactly cbNeeded bytes from the socket into pDest, bypassing the read buffer
+
+    bool ReadExactly(size_t socket, uint8_t * pDest, size_t cbNeeded);
+
+    // SkipBytes
+    //
+    // Read and throw away cbSkip bytes from the socket, to keep the stream in sync past data with nowhere to go
+
+    bool SkipBytes(size_t socket, size_t cbSkip);
+
+    // ReceivePixelData
+    //
+    // Reads the pixels of a WIFI_COMMAND_PIXELDATA64 packet, whose header has already been read and
+    // size-checked, straight into the first selected channel's reserved LEDBuffer and queues it.
+    // The other selected channels get a copy; a single-channel packet is never copied at all.
+
+    bool ReceivePixelData(size_t socket, uint16_t channel16, uint32_t length32, uint64_t seconds, uint64_t micros);
+
+    // ReceiveCompressedData
+    //
+    // Inflates a compressed packet, whose 16-byte header has already been read and size-checked along with
+    // the start of its zlib stream, as the rest of it arrives. Pixel data is expanded straight into the first selected channel's reserved
+    // LEDBuffer and queued like ReceivePixelData's; anything else goes through ProcessIncomingData.
+
+    bool ReceiveCompressedData(size_t socket, uint32_t expandedSize);
+
+    // ReceivePixelDelta
+    //
+    // Reads a WIFI_COMMAND_PIXELDELTA64 packet, whose standard header has already been read and size-checked,
+    // applying its changed pixels to a copy of the stream's previous frame and queueing the result
+    // like ReceivePixelData's. Deltas that don't follow on are read and dropped until a keyframe.
+
+    bool ReceivePixelDelta(size_t socket, uint16_t channel16, uint32_t length32, uint64_t seconds, uint64_t micros);
+
+    // ReceivePixelBatch
+    //
+    // Reads a WIFI_COMMAND_PIXELBATCH64 packet, whose standard header has already been read and size-checked,
+    // into a reserved LEDBuffer on each channel it has pixels for and queues them all under one due time.
+
+    bool ReceivePixelBatch(size_t socket, uint16_t entryCount, uint32_t length32, uint64_t seconds, uint64_t micros);
+
     // ProcessIncomingConnectionsLoop
     //
     // Socket server main ProcessIncomingConnectionsLoop - accepts new connections and reads from them, dispatching
     // data packets into our buffer and closing the socket if anything goes weird.
 
     bool ProcessIncomingConnectionsLoop();
-
-    // DecompressBuffer
-    //
-    // Use unzlib to decompress a memory buffer
-
-    static bool DecompressBuffer(const uint8_t * pBuffer, size_t cBuffer, uint8_t * pOutput, size_t expectedOutputSize);
 };
 
 #endif
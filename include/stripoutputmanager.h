@@ -25,11 +25,26 @@
 
 #include <WString.h>
 
+#include "crgbw.h"
+#include "pixelformat.h"
 #include "types.h"
 
 class GFXBase;
 class DeviceConfig;
 
+// ChannelPlanes
+//
+// The pixels one channel is to show: a device's own leds/whites for a
+// synchronous Show(), or a copy of them that OutputService queued. whites
+// is null when the channel has no white plane.
+
+struct ChannelPlanes
+{
+    const CRGB*  leds     = nullptr;
+    const CRGBW* whites   = nullptr;
+    size_t       ledCount = 0;
+};
+
 class IStripOutputManager
 {
   public:
@@ -38,15 +53,34 @@ class IStripOutputManager
     virtual SuccessResultWithMessage ApplyConfig(const DeviceConfig& config,
                                                  const std::vector<std::shared_ptr<GFXBase>>& devices) = 0;
 
-    virtual void Show(const std::vector<std::shared_ptr<GFXBase>>& devices,
-                      uint16_t pixelsDrawn,
-                      uint8_t brightness,
-                      uint8_t fader) = 0;
+    // Shows each device's current buffers; a thin wrapper over ShowPlanes()
+
+    void Show(const std::vector<std::shared_ptr<GFXBase>>& devices,
+              uint16_t pixelsDrawn,
+              uint8_t brightness,
+              uint8_t fader);
+
+    // Shows one set of planes per channel. A channel whose planes are missing
+    // or shorter than the active LED count (a frame queued before a
+    // reconfigure) is left as it is.
+
+    virtual void ShowPlanes(const ChannelPlanes* channels,
+                            size_t channelCount,
+                            uint16_t pixelsDrawn,
+                            uint8_t brightness,
+                            uint8_t fader) = 0;
 
     virtual void Reset() = 0;
 
     virtual size_t GetActiveChannelCount() const = 0;
     virtual size_t GetActiveLEDCount() const = 0;
+
+    // What the last frame shown packed across every active channel, for
+    // limiting the next frame's power without a pass over its pixels. False
+    // where the manager doesn't keep it, or nothing has been shown since the
+    // last ApplyConfig().
+
+    virtual bool GetLastFrameSums(PackSums& /*sums*/) const { return false; }
 };
 
 #endif
@@ -48,11 +48,14 @@ class TaskManager;
 class RemoteControl;
 class Screen;
 class SocketServer;
+class UdpServer;
+class LightingServer;
 class WebSocketServer;
 class CWebServer;
 class WS281xOutputManager;
 class APA102OutputManager;
 class IStripOutputManager;
+class OutputService;
 class AudioService;
 class AudioSerialBridge;
 class DebugConsole;
@@ -96,10 +99,22 @@ class SystemContainer
         allocated_unique_ptr<SocketServer> _ptrSocketServer;
     #endif
 
+    #if UDP_PIXEL_SERVER_ENABLED
+        allocated_unique_ptr<UdpServer> _ptrUdpServer;
+    #endif
+
+    #if LIGHTING_PROTOCOLS_ENABLED
+        allocated_unique_ptr<LightingServer> _ptrLightingServer;
+    #endif
+
     #if USE_STRIP
         allocated_unique_ptr<IStripOutputManager> _ptrStripOutputManager;
     #endif
 
+    #if USE_STRIP && ASYNC_STRIP_OUTPUT
+        allocated_unique_ptr<OutputService> _ptrOutputService;
+    #endif
+
     #if WEB_SOCKETS_ANY_ENABLED
         allocated_unique_ptr<WebSocketServer> _ptrWebSocketServer;
     #endif
@@ -186,12 +201,33 @@ class SystemContainer
         SocketServer& GetSocketServer() const;
     #endif
 
+    #if UDP_PIXEL_SERVER_ENABLED
+        UdpServer& SetupUdpServer(NetworkPort port);
+        bool HasUdpServer() const { return !!_ptrUdpServer; }
+        UdpServer& GetUdpServer() const;
+    #endif
+
+    #if LIGHTING_PROTOCOLS_ENABLED
+        LightingServer& SetupLightingServer();
+        bool HasLightingServer() const { return !!_ptrLightingServer; }
+        LightingServer& GetLightingServer() const;
+    #endif
+
     #if USE_STRIP
         IStripOutputManager& SetupStripOutputManager();
         bool HasStripOutputManager() const { return !!_ptrStripOutputManager; }
         IStripOutputManager& GetStripOutputManager() const;
     #endif
 
+    // OutputService shows strip frames from its own task; see outputservice.h. Created
+    // stopped, over the strip output manager.
+
+    #if USE_STRIP && ASYNC_STRIP_OUTPUT
+        OutputService& SetupOutputService();
+        bool HasOutputService() const { return nullptr != _ptrOutputService; }
+        OutputService& GetOutputService() const;
+    #endif
+
     #if WEB_SOCKETS_ANY_ENABLED
         WebSocketServer& SetupWebSocketServer(CWebServer& webServer);
         bool HasWebSocketServer() const { return !!_ptrWebSocketServer; }
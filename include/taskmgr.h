@@ -65,6 +65,7 @@ class LEDStripEffect;
 #define SOCKET_STACK_SIZE  4096
 #define NET_STACK_SIZE     8192
 #define COLORDATA_STACK_SIZE 4096
+#define OUTPUT_STACK_SIZE  4096
 #define DEBUG_STACK_SIZE   8192                 // Needs a lot of stack for output if UpdateClockFromWeb is called from debugger
 #define REMOTE_STACK_SIZE  4096
 #define SCREEN_STACK_SIZE  8192
@@ -0,0 +1,146 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        udpassembler.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Reassembles the packets the UDP server receives. A sender splits each
+//    packet it would have written to the TCP socket - WIFI_COMMAND_PIXELDATA64
+//    or a compressed "DAVE" packet, unchanged - across as many datagrams as
+//    it needs, each starting with this fragment header (little-endian, like
+//    the rest of the protocol):
+//
+//       0  uint32  UDP_FRAGMENT_HEADER, ASCII "UDPF"
+//       4  uint32  frame sequence, one more for every packet the sender sends
+//       8  uint16  fragment index
+//      10  uint16  fragment count
+//      12  uint32  offset of this fragment's bytes in the packet
+//      16  uint32  size of the whole packet
+//      20  ...     the fragment's bytes
+//
+//    Fragments can arrive in any order and more than once. Two frames are
+//    assembled at a time, so the first fragments of one frame can overtake
+//    the last of the one before; a third evicts the older. Once a frame is
+//    complete, anything older is late, and its fragments are dropped rather
+//    than waited for, so a lost datagram costs one frame instead of holding
+//    up every frame behind it the way a TCP retransmit does.
+//
+//    Nothing here touches a socket, so nd_bench runs it on the host.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#define UDP_FRAGMENT_HEADER      (0x46504455)                                      // ASCII "UDPF" as header
+#define UDP_FRAGMENT_HEADER_SIZE 20                                                // Size of the fragment header
+
+class UdpFrameAssembler
+{
+  public:
+
+    // Fragments a packet may be split into; far more than the biggest packet needs at any sane MTU
+    static constexpr uint16_t kMaxFragments = 1024;
+
+    // A sequence further behind the last frame than this is a sender that started over, not a straggler
+    static constexpr uint32_t kResyncWindow = 256;
+
+    enum class Result
+    {
+        Incomplete,                                 // Taken; the frame still needs more fragments
+        Complete,                                   // Taken, and it finished the frame: see Packet()
+        Duplicate,                                  // Already had this fragment
+        Late,                                       // Its frame was finished, evicted or overtaken already
+        Malformed                                   // Not a fragment, or doesn't agree with its frame
+    };
+
+    // The largest packet that can be reassembled; the two frames in progress take this much each
+    explicit UdpFrameAssembler(size_t maxPacketSize);
+
+    // Accept
+    //
+    // Takes one datagram. When it completes a frame, Packet() and PacketSize() hold the reassembled
+    // packet until the next call.
+
+    Result Accept(const uint8_t * pDatagram, size_t cbDatagram);
+
+    allocated_unique_ptr<uint8_t []> & Packet() { return _slots[_completed].packet; }
+    size_t PacketSize() const { return _slots[_completed].size; }
+    uint32_t PacketSequence() const { return _slots[_completed].sequence; }
+
+    // Reset
+    //
+    // Abandons frames in progress and forgets the sequence, keeping the counters
+
+    void Reset();
+
+    // WriteHeader
+    //
+    // Fills in a fragment header at pHeader, for senders
+
+    static void WriteHeader(uint8_t * pHeader, uint32_t sequence, uint16_t index, uint16_t count, uint32_t offset, uint32_t size);
+
+    uint32_t FramesCompleted()    const { return _framesCompleted.load(std::memory_order_relaxed); }
+    uint32_t FramesDropped()      const { return _framesDropped.load(std::memory_order_relaxed); }   // Numbered by the sender, never completed
+    uint32_t LateFragments()      const { return _lateFragments.load(std::memory_order_relaxed); }
+    uint32_t DuplicateFragments() const { return _duplicateFragments.load(std::memory_order_relaxed); }
+    uint32_t MalformedDatagrams() const { return _malformedDatagrams.load(std::memory_order_relaxed); }
+
+  private:
+
+    struct Slot
+    {
+        bool                             active    = false;
+        uint32_t                         sequence  = 0;
+        uint32_t                         size      = 0;
+        uint16_t                         count     = 0;
+        uint16_t                         received  = 0;
+        size_t                           bytes     = 0;
+        std::array<uint32_t, kMaxFragments / 32> have {};
+        allocated_unique_ptr<uint8_t []> packet;
+    };
+
+    static bool IsNewer(uint32_t sequence, uint32_t than) { return static_cast<int32_t>(sequence - than) > 0; }
+
+    static void Count(std::atomic<uint32_t> & counter, uint32_t n = 1) { counter.fetch_add(n, std::memory_order_relaxed); }
+
+    Slot * FindSlot(uint32_t sequence, uint32_t size, uint16_t count, Result & result);
+
+    size_t   _maxPacketSize;
+    Slot     _slots[2];
+    size_t   _completed       = 0;
+    bool     _hasLast         = false;
+    uint32_t _lastSequence    = 0;                  // The newest frame completed
+
+    // Published for the statistics
+
+    std::atomic<uint32_t> _framesCompleted    { 0 };
+    std::atomic<uint32_t> _framesDropped      { 0 };
+    std::atomic<uint32_t> _lateFragments      { 0 };
+    std::atomic<uint32_t> _duplicateFragments { 0 };
+    std::atomic<uint32_t> _malformedDatagrams { 0 };
+};
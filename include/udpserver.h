@@ -0,0 +1,89 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        udpserver.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Listens for LED data over UDP on the same port number the socket
+//    server uses for TCP. Senders fragment the same WIFI_COMMAND_PIXELDATA64
+//    and compressed packets across datagrams as udpassembler.h describes;
+//    frames are queued as soon as they're whole, and a frame that loses a
+//    datagram is dropped instead of stalling the ones behind it.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <atomic>
+#include <memory>
+
+#include "itaskservice.h"
+#include "udpassembler.h"
+
+#if UDP_PIXEL_SERVER_ENABLED
+
+// UdpServer
+//
+// Receives fragmented pixel packets and hands each one, once reassembled, to ProcessIncomingData
+// just as the socket server would have read it.
+
+class UdpServer : public ITaskService
+{
+  private:
+
+    int                              _port;
+    std::atomic<int>                 _socket_fd{-1};   // atomic for the same reason as SocketServer::_server_fd
+    allocated_unique_ptr<uint8_t []> _pDatagram;
+    allocated_unique_ptr<uint8_t []> _abOutputBuffer;
+    allocated_unique_ptr<UdpFrameAssembler> _pAssembler;
+
+  public:
+
+    // Biggest datagram IP can carry; fragments are meant to fit one MTU, but anything up to this is taken
+    static constexpr size_t kMaxDatagram = 65507;
+
+    explicit UdpServer(int port);
+    ~UdpServer() override { Stop(); }
+
+    // IService::Name
+    const char* Name() const override { return "UdpServer"; }
+
+    void release();
+    bool begin();
+
+    // ProcessPacket
+    //
+    // Queues a reassembled packet, inflating it first if it's compressed
+
+    bool ProcessPacket(allocated_unique_ptr<uint8_t []> & packet, size_t cbPacket);
+
+    const UdpFrameAssembler & Assembler() const { return *_pAssembler; }
+
+  protected:
+    // ITaskService hooks
+    TaskConfig GetTaskConfig() const override;
+    void Run() override;
+    void OnBeforeWaitForStop() override;
+};
+
+#endif
@@ -140,6 +140,11 @@ class HexagonGFX : public WS281xGFX
         }
     }
 
+    XYLayout GetXYLayout() const noexcept override
+    {
+        return XYLayout::Custom;
+    }
+
     // filHexRing
     //
     // Fills a ring around the hexagon, inset by the indent specified and in the color provided
@@ -18,14 +18,28 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "deviceconfig.h"
+#include "pixelformat.h"
 #include "stripoutputmanager.h"
 
+// WS281X_PIPELINED_SHOW: 1 packs each channel into the buffer that isn't on
+// the wire, starts it transmitting as soon as it's packed, and returns from
+// Show() without waiting for the wire, so the next frame's Draw() overlaps
+// this frame's transmission. Each channel then has two packed buffers, so
+// the DMA-capable internal RAM the strips take doubles (24 or 32 bits per
+// LED, per buffer), and each strip starts one channel's pack time after the
+// one before it rather than all together. Boards opt in; 0 is the original
+// pack-all, send-all, wait-all Show().
+
+#ifndef WS281X_PIPELINED_SHOW
+    #define WS281X_PIPELINED_SHOW 0
+#endif
+
 class GFXBase;
 class Transport;
-class PixelFormat;
 
 class WS281xOutputManager : public IStripOutputManager
 {
@@ -36,7 +50,9 @@ class WS281xOutputManager : public IStripOutputManager
         size_t byteCount = 0;
         bool installed = false;
         bool active = false;
-        std::unique_ptr<uint8_t[]> outputBytes;
+        bool inFlight = false;                                  // The buffer before `back` may still be on the wire
+        uint8_t back = 0;                                       // The buffer the next frame is packed into
+        std::array<std::unique_ptr<uint8_t[]>, 2> outputBytes;  // The second only when pipelined
     };
 
     std::array<ChannelState, NUM_CHANNELS> _channels{};
@@ -45,20 +61,62 @@ class WS281xOutputManager : public IStripOutputManager
     DeviceConfig::WS281xColorOrder _colorOrder = DeviceConfig::GetCompiledWS281xColorOrder();
     std::unique_ptr<Transport>    _transport;
     std::unique_ptr<PixelFormat>  _format;          // picked at construction by chip-type flag
+    PackKernel                    _pack = nullptr;  // _format's kernel for _colorOrder
+    PackParams                    _packParams;
+    bool                          _pipelined;
+    mutable std::mutex            _sumsMutex;       // Guards the two below; Show() may be on the output task
+    PackSums                      _lastSums;
+    bool                          _haveLastSums = false;
 
     SuccessResultWithMessage RecreateChannel(size_t channelIndex, int8_t pin, size_t ledCount);
     void ReleaseChannel(size_t channelIndex);
+    void SelectPackKernel();
+    bool CanShow(size_t channelIndex, const ChannelPlanes* channels, size_t channelCount) const;
+    void ForgetLastFrameSums();
+    PackSums ShowPipelined(const ChannelPlanes* channels, size_t channelCount, size_t pixelsToShow);
+    PackSums ShowSynchronous(const ChannelPlanes* channels, size_t channelCount, size_t pixelsToShow);
 
   public:
-    WS281xOutputManager();
+    explicit WS281xOutputManager(bool pipelined = WS281X_PIPELINED_SHOW);
     ~WS281xOutputManager() override;
 
     SuccessResultWithMessage ApplyConfig(const DeviceConfig& config, const std::vector<std::shared_ptr<GFXBase>>& devices) override;
-    void Show(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader) override;
+    void ShowPlanes(const ChannelPlanes* channels, size_t channelCount, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader) override;
     void Reset() override;
 
     size_t GetActiveChannelCount() const override { return _activeChannelCount; }
     size_t GetActiveLEDCount() const override { return _activeLEDCount; }
+    bool GetLastFrameSums(PackSums& sums) const override;
+
+#if HOST_BUILD
+    // WireFrame
+    //
+    // One frame as the host transport clocked it out of one channel: the exact
+    // bytes, and when and for how long they were on the wire. Nanoseconds
+    // count from when capturing started.
+
+    struct WireFrame
+    {
+        size_t   channel = 0;
+        int8_t   pin = -1;
+        size_t   sequence = 0;                  // This channel's frame count; equal across channels for one Show()
+        uint64_t startNanos = 0;                // First bit out
+        uint64_t wireNanos = 0;                 // Every bit's high and low time, then the reset latch
+        std::vector<uint8_t> bytes;
+    };
+
+    // nd_bench hooks: hold each frame on a simulated wire for as long as a real
+    // strip would take to clock it out, and count frames whose bytes changed
+    // before they had finished going out
+    void SimulateWireTime(bool enabled);
+    size_t GetFramesOverwrittenOnWire() const;
+
+    // Keep a copy of up to maxFrames frames as they're transmitted, the
+    // oldest first; 0 stops capturing and drops whatever was kept. Capturing
+    // restarts each channel's sequence and the clock.
+    void CaptureFrames(size_t maxFrames);
+    std::vector<WireFrame> TakeCapturedFrames();
+#endif
 };
 
 #endif
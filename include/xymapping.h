@@ -0,0 +1,109 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        xymapping.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Compile-time (x, y) -> LED index mappers. GFXBase::xy() is virtual so
+//    that devices and runtime topologies can override it, but that also
+//    means it can't be inlined into per-pixel loops. The StaticXY mappers
+//    here bake the width, height and wiring into the type so the index math
+//    folds down to a shift/add, and GFXBase::WithXY() hands one to an
+//    effect when the live topology matches what was compiled in.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+// XYLayout
+//
+// How a device's LEDs are wired, as far as xy() is concerned. Anything that isn't one of the
+// simple grids reports Custom and always goes through the virtual xy().
+
+enum class XYLayout : uint8_t
+{
+    ColumnLinear,       // Columns of _height LEDs, all running the same direction
+    ColumnSerpentine,   // Columns of _height LEDs, odd columns running backwards (GFXBase default)
+    RowMajor,           // Rows of _width pixels, as on HUB75 panels
+    Table,              // Arbitrary wiring described by a PixelMap lookup table
+    Custom              // Device-specific xy() override; no static fast path
+};
+
+// StaticXY
+//
+// Index math for a fixed width, height and layout. Coordinates must already be in range; like
+// leds[] itself, there's no bounds check on this path.
+
+template <uint16_t Width, uint16_t Height, XYLayout Layout>
+struct StaticXY
+{
+    static_assert(Layout != XYLayout::Custom && Layout != XYLayout::Table, "Custom and Table layouts have no static mapping");
+
+    static constexpr uint16_t kWidth  = Width;
+    static constexpr uint16_t kHeight = Height;
+
+    __attribute__((always_inline))
+    constexpr uint16_t operator()(uint16_t x, uint16_t y) const noexcept
+    {
+        if constexpr (Layout == XYLayout::RowMajor)
+            return y * Width + x;
+        else if constexpr (Layout == XYLayout::ColumnSerpentine)
+            return x * Height + ((x & 0x01) ? (Height - 1) - y : y);
+        else
+            return x * Height + y;
+    }
+};
+
+// TableXY
+//
+// Mapper over a PixelMap table (row-major, one LED index per pixel). Still a runtime lookup, but
+// a plain load the compiler can inline instead of a virtual call per pixel.
+
+struct TableXY
+{
+    const uint16_t* table;
+    uint16_t width;
+
+    __attribute__((always_inline))
+    uint16_t operator()(uint16_t x, uint16_t y) const noexcept
+    {
+        return table[y * width + x];
+    }
+};
+
+// RuntimeXY
+//
+// Fallback mapper for topologies that don't match the compiled-in size or use a Custom layout.
+// Same call shape as StaticXY, so an effect's loop body is written once.
+
+template <typename Device>
+struct RuntimeXY
+{
+    const Device& device;
+
+    __attribute__((always_inline))
+    uint16_t operator()(uint16_t x, uint16_t y) const noexcept
+    {
+        return device.xy(x, y);
+    }
+};
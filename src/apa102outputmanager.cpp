@@ -267,7 +267,7 @@ SuccessResultWithMessage APA102OutputManager::ApplyConfig(const DeviceConfig& co
 }
 
 //
-// Show()
+// ShowPlanes()
 //
 // Render the given pixel data to the LED strip(s) using the APA102 protocol over hardware SPI + DMA.
 // Caller must already hold the transport mutex (or rely on the one we acquire here). The pre-built
@@ -275,7 +275,7 @@ SuccessResultWithMessage APA102OutputManager::ApplyConfig(const DeviceConfig& co
 // padding); we only fill the per-pixel bytes between them, then hand the whole buffer to the SPI
 // master in a single transaction.
 //
-void APA102OutputManager::Show(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader)
+void APA102OutputManager::ShowPlanes(const ChannelPlanes* channels, size_t channelCount, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader)
 {
     std::lock_guard guard(WS281xGFX::TransportMutex());
 
@@ -285,20 +285,20 @@ void APA102OutputManager::Show(const std::vector<std::shared_ptr<GFXBase>>& devi
     const size_t pixelsToShow = std::min(static_cast<size_t>(pixelsDrawn), _activeLEDCount);
     const auto showStartMicros = micros();
 
-    for (size_t channelIndex = 0; channelIndex < _activeChannelCount && channelIndex < devices.size(); ++channelIndex)
+    for (size_t channelIndex = 0; channelIndex < _activeChannelCount && channelIndex < channelCount; ++channelIndex)
     {
         auto& state = _channels[channelIndex];
-        if (!state.active || !state.device || !state.buffer)
+        const auto& planes = channels[channelIndex];
+        if (!state.active || !state.device || !state.buffer || !planes.leds || planes.ledCount < _activeLEDCount)
             continue;
 
-        auto& device = devices[channelIndex];
-        const size_t ledCount = std::min(state.ledCount, device->GetLEDCount());
+        const size_t ledCount = std::min(state.ledCount, planes.ledCount);
         const auto indices = PixelFormatHelpers::IndicesFor(_colorOrder);
 
         uint8_t* p = state.buffer + kStartFrameBytes;
         for (size_t i = 0; i < ledCount; ++i)
         {
-            CRGB color = (i < pixelsToShow) ? device->leds[i] : CRGB::Black;
+            CRGB color = (i < pixelsToShow) ? planes.leds[i] : CRGB::Black;
             uint8_t wire[3] = {};
             wire[indices.rIdx] = PixelFormatHelpers::Scale(color.r, brightness, fader);
             wire[indices.gIdx] = PixelFormatHelpers::Scale(color.g, brightness, fader);
@@ -47,6 +47,7 @@
 #include "debug_cli.h"
 #include "deviceconfig.h"
 #include "effectmanager.h"
+#include "frametiming.h"
 #include "gfxbase.h"
 #include "ledstripeffect.h"
 #include "nd_network.h"
@@ -640,6 +641,27 @@ void DoUptime(const cli_argv &)
     cli_printf("Last boot reason: (%d): %s\n", reason, reason_text);
 }
 
+// Show the render loop's stage latencies, or start them over with "timings reset"
+static void DoTimings(const cli_argv &argv)
+{
+    if (argv.size() > 1 && StringCompareInsensitive(argv[1], "reset"))
+    {
+        g_FrameTimings.Reset();
+        cli_printf("Frame timings reset\n");
+        return;
+    }
+
+    cli_printf("%-14s %8s %8s %8s %8s\n", "Stage", "Count", "p50 us", "p95 us", "p99 us");
+    for (size_t i = 0; i < static_cast<size_t>(RenderStage::Count); i++)
+    {
+        const auto stage = static_cast<RenderStage>(i);
+        const auto& histogram = g_FrameTimings.Stage(stage);
+        cli_printf("%-14s %8lu %8lu %8lu %8lu\n", FrameTimings::StageName(stage), (unsigned long)histogram.Count(),
+                   (unsigned long)histogram.Percentile(50), (unsigned long)histogram.Percentile(95),
+                   (unsigned long)histogram.Percentile(99));
+    }
+}
+
 static const command core_commands[] = {
     {"cat", "Display file content", "Printing file...", DoCat},
     {"reboot", "Reboot system", "Rebooting. Please stand by...", [](const cli_argv &) { esp_restart(); }},
@@ -738,6 +760,7 @@ static const command core_commands[] = {
         cli_printf("Brightness: %d\n", val);
     }},
     {"uptime", "Show system uptime", "Showing uptime...", DoUptime},
+    {"timings", "[reset] Show/reset render stage latencies", "Frame timings:", DoTimings},
     {"color", "[on|off] | [r g b | hex] Set or show colors", "Global Color:",
      [](const cli_argv &argv) {
          if (argv.size() > 1)
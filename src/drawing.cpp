@@ -32,15 +32,16 @@
 #include "globals.h"
 
 #include <algorithm>
+#include <array>
 #include <ArduinoOTA.h>
 #include <cmath>
 #include <limits>
 #include <mutex>
 
 #include "colordata.h"
+#include "frametiming.h"
 #include "ledbuffer.h"
 #include "nd_network.h"
-#include "ntptimeclient.h"
 #include "renderservice.h"
 #include "systemcontainer.h"
 #include "taskmgr.h"   // DRAWING_STACK_SIZE / DRAWING_PRIORITY / DRAWING_CORE
@@ -53,6 +54,9 @@ static DRAM_ATTR bool l_WiFiActivityActive = false;
 static uint32_t l_FrameCountThisSecond = 0;
 static uint32_t l_LastSecondBoundaryMs = 0;
 
+// The most channels WiFiDraw() takes frames for; channel masks on the wire are 16 bits
+static constexpr size_t kMaxWiFiChannels = 16;
+
 static uint32_t MicrosSinceLastWifiDraw()
 {
     return micros() - static_cast<uint32_t>(l_usLastWifiDraw);
@@ -105,9 +109,6 @@ static void SetWiFiActivityPin(bool)
 }
 #endif
 
-// The g_buffer_mutex is a global mutex used to protect access while adding or removing frames
-// from the led buffer.
-
 std::shared_ptr<LEDStripEffect> GetSpectrumAnalyzer(CRGB color);    // Defined in effectmanager.cpp
 
 // WiFiDraw
@@ -121,47 +122,36 @@ uint16_t WiFiDraw()
     if (!g_ptrSystem->HasBufferManagers())
         return 0;
 
-    std::lock_guard guard(g_buffer_mutex);
+    // LEDBufferManager hands frames over from the socket task without a lock, and the g_render_mutex
+    // held around this keeps Reconfigure() away. g_publish_mutex is held only while the due frames are
+    // taken, against one clock reading, so frames a batch queued together are drawn together.
 
-    uint16_t pixelsDrawn = 0;
-    for (auto& bufferManager : g_ptrSystem->GetBufferManagers())
+    auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+    std::array<std::shared_ptr<LEDBuffer>, kMaxWiFiChannels> dueBuffers;
+    const size_t cChannels = std::min(bufferManagers.size(), dueBuffers.size());
     {
+        std::lock_guard guard(g_publish_mutex);
+        const uint64_t now = LEDBufferManager::ClockMicros();
+
+        // Each frame was given its due time as it arrived, by the manager's PlayoutScheduler, so this
+        // catches up to now and keeps the newest frame that's due
+        for (size_t i = 0; i < cChannels; i++)
+            if (false == bufferManagers[i].IsEmpty())
+                dueBuffers[i] = bufferManagers[i].GetDueBuffer(now);
+    }
 
-        timeval tv;
-        gettimeofday(&tv, nullptr);
-
-        // Pull buffers out of the queue.
-
-        if (false == bufferManager.IsEmpty())
+    uint16_t pixelsDrawn = 0;
+    for (size_t i = 0; i < cChannels; i++)
+    {
+        auto& pBuffer = dueBuffers[i];
+        if (pBuffer)
         {
-            std::shared_ptr<LEDBuffer> pBuffer;
-            #if ENABLE_NTP
-            if (NTPTimeClient::HasClockBeenSet() == false)
-            {
-                pBuffer = bufferManager.GetOldestBuffer();
-            }
-            else
-            {
-                // Using a 'while' rather than an 'if' causes it to pull frames until it's caught up
-                // written as 'while' it will pull frames until it gets one that is current.
-                // Chew through ALL frames older than now, ignoring all but the last of them
-
-                while (!bufferManager.IsEmpty() && bufferManager.PeekOldestBuffer()->IsBufferOlderThan(tv))
-                    pBuffer = bufferManager.GetOldestBuffer();
-            }
-            #else
-            pBuffer = bufferManager.GetOldestBuffer();
-            #endif
-
-            if (pBuffer)
-            {
-                l_usLastWifiDraw = micros();
-                debugV("Calling LEDBuffer::Draw from wire with %d/%zu pixels.", pixelsDrawn, pBuffer->_pStrand->GetLEDCount());
-                pBuffer->DrawBuffer();
-                // In case we drew some pixels and then drew 0 due a failure, we want to return a positive
-                // number of pixels drawn so the caller knows we did in fact render.
-                pixelsDrawn += pBuffer->Length();
-            }
+            l_usLastWifiDraw = micros();
+            debugV("Calling LEDBuffer::Draw from wire with %d/%zu pixels.", pixelsDrawn, pBuffer->_pStrand->GetLEDCount());
+            pBuffer->DrawBuffer();
+            // In case we drew some pixels and then drew 0 due a failure, we want to return a positive
+            // number of pixels drawn so the caller knows we did in fact render.
+            pixelsDrawn += pBuffer->Length();
         }
     }
     debugV("WifIDraw claims to have drawn %d pixels", pixelsDrawn);
@@ -254,23 +244,18 @@ int CalcDelayUntilNextFrame(double frameStartTime, uint16_t localPixelsDrawn, ui
         double t = std::numeric_limits<double>::max();
         bool bFoundFrame = false;
 
-        {
-            // The socket task can add frames while the render task is
-            // calculating its next sleep. Protect this read-only peek with the
-            // same mutex used by enqueue/dequeue so the ring indices and
-            // timestamps are sampled consistently.
+        // The socket task can add frames while the render task is calculating its next sleep;
+        // PeekOldestDue() reads a due time that belonged to the oldest frame as it was queued
 
-            std::lock_guard guard(g_buffer_mutex);
-            for (auto& bufferManager : g_ptrSystem->GetBufferManagers())
+        const uint64_t now = LEDBufferManager::ClockMicros();
+        for (auto& bufferManager : g_ptrSystem->GetBufferManagers())
+        {
+            uint64_t dueMicros;
+            if (bufferManager.PeekOldestDue(dueMicros))
             {
-                auto pOldest = bufferManager.PeekOldestBuffer();
-                if (pOldest)
-                {
-                    // TimeTillDue() should be non-negative for future-due frames; if negative (stale), treat as now.
-                    // Note I'm not using clamp since clamp can return nan if TimeTillDue does, whereas this guards against that.
-                    t = std::min(t, std::max(0.0, pOldest->TimeTillDue()));
-                    bFoundFrame = true;
-                }
+                // A frame already due (or overdue) is due now
+                t = std::min(t, dueMicros > now ? (dueMicros - now) / (double) MICROS_PER_SECOND : 0.0);
+                bFoundFrame = true;
             }
         }
         // Bound the delay to at most 1 second to avoid pathological multi-second sleeps.
@@ -398,18 +383,34 @@ void IRAM_ATTR RenderService::Run()
             // the first API call -- which manifests as total loss of network
             // connectivity even though WiFi association is still up.
 
+            // Stage timings only count passes that actually did the work, so frames where WiFi data
+            // pre-empted the local effect (or vice versa) don't drag the percentiles toward zero.
+
+            uint32_t stageStart = ESP.getCycleCount();
             std::scoped_lock renderGuard(g_render_mutex, g_effect_manager_mutex);
+            g_FrameTimings.Record(RenderStage::Lock, stageStart, ESP.getCycleCount());
+
             auto& graphics = *g_ptrSystem->GetDevices()[0];
 
             graphics.PrepareFrame();
 
             if (nd_network::IsWiFiConnected())
+            {
+                stageStart = ESP.getCycleCount();
                 wifiPixelsDrawn = WiFiDraw();
+                if (wifiPixelsDrawn > 0)
+                    g_FrameTimings.Record(RenderStage::WiFiDraw, stageStart, ESP.getCycleCount());
+            }
 
             // If we didn't draw now, and it's been a while since we did, and we have at least one local effect, then draw the local effect instead
 
             if (wifiPixelsDrawn == 0 && localPixelsDrawn == 0)
+            {
+                stageStart = ESP.getCycleCount();
                 localPixelsDrawn = LocalDraw();
+                if (localPixelsDrawn > 0)
+                    g_FrameTimings.Record(RenderStage::LocalDraw, stageStart, ESP.getCycleCount());
+            }
 
             // If we drew any pixels by any method, we'll call that a frame and track it for FPS purposes.  We also notify the
             // color data thread that a new frame is available and can be transmitted to clients
@@ -439,14 +440,21 @@ void IRAM_ATTR RenderService::Run()
                 l_LastSecondBoundaryMs += MILLIS_PER_SECOND;
             }
 
+            stageStart = ESP.getCycleCount();
             graphics.PostProcessFrame(localPixelsDrawn, wifiPixelsDrawn);
+            if (wifiPixelsDrawn + localPixelsDrawn > 0)
+                g_FrameTimings.Record(RenderStage::PostProcess, stageStart, ESP.getCycleCount());
+
             UpdateWiFiActivityPin(wifiPixelsDrawn, localPixelsDrawn);
         }
 
         // Delay at least 2ms and not more than 1s until next frame is due
 
         constexpr auto minimumDelay = 5;
-        delay( std::max(minimumDelay, CalcDelayUntilNextFrame(frameStartTime, localPixelsDrawn, wifiPixelsDrawn) ));
+        {
+            FrameTimings::ScopedStage sleepStage(g_FrameTimings, RenderStage::Sleep);
+            delay( std::max(minimumDelay, CalcDelayUntilNextFrame(frameStartTime, localPixelsDrawn, wifiPixelsDrawn) ));
+        }
 
         // Once an OTA flash update has started, we don't want to hog the CPU or it goes quite slowly,
         // so we'll slow down to share the CPU a bit once the update has begun
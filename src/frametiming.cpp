@@ -0,0 +1,105 @@
+//+--------------------------------------------------------------------------
+//
+// File:        frametiming.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Render stage histograms: percentile queries and the global instance.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "frametiming.h"
+
+DRAM_ATTR FrameTimings g_FrameTimings;
+
+uint32_t StageHistogram::Count() const
+{
+    uint32_t total = 0;
+    for (const auto& bucket : _buckets)
+        total += bucket.load(std::memory_order_relaxed);
+    return total;
+}
+
+void StageHistogram::Reset()
+{
+    for (auto& bucket : _buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+uint32_t StageHistogram::Percentile(float percentile) const
+{
+    // Snapshot first so the rank and the walk agree even if a task records mid-query
+
+    std::array<uint32_t, kBucketCount> counts;
+    uint32_t total = 0;
+    for (size_t i = 0; i < kBucketCount; i++)
+        total += counts[i] = _buckets[i].load(std::memory_order_relaxed);
+
+    if (total == 0)
+        return 0;
+
+    const uint32_t rank = std::max<uint32_t>(1, static_cast<uint32_t>(ceilf(total * std::clamp(percentile, 0.0f, 100.0f) / 100.0f)));
+    uint32_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return BucketUpperBound(i);
+    }
+    return BucketUpperBound(kBucketCount - 1);
+}
+
+const char* FrameTimings::StageName(RenderStage stage)
+{
+    switch (stage)
+    {
+        case RenderStage::Lock:         return "LOCK";
+        case RenderStage::WiFiDraw:     return "WIFI_DRAW";
+        case RenderStage::LocalDraw:    return "LOCAL_DRAW";
+        case RenderStage::PostProcess:  return "POST_PROCESS";
+        case RenderStage::Show:         return "SHOW";
+        case RenderStage::Snapshot:     return "SNAPSHOT";
+        case RenderStage::OutputWait:   return "OUTPUT_WAIT";
+        case RenderStage::OutputQueue:  return "OUTPUT_QUEUE";
+        case RenderStage::Sleep:        return "SLEEP";
+        default:                        return "UNKNOWN";
+    }
+}
+
+void FrameTimings::Reset()
+{
+    for (auto& stage : _stages)
+        stage.Reset();
+}
+
+void IRAM_ATTR FrameTimings::Record(RenderStage stage, uint32_t startCycles, uint32_t endCycles)
+{
+    // The cycle counter is 32 bits and wraps every ~18s at 240MHz; unsigned subtraction handles
+    // a single wrap, which is all a stage that's bounded by the 1s frame delay cap can see.
+
+    static const uint32_t cyclesPerMicro = std::max<uint32_t>(1, ESP.getCpuFreqMHz());
+    _stages[static_cast<size_t>(stage)].Record((endCycles - startCycles) / cyclesPerMicro);
+}
@@ -39,9 +39,11 @@
 #include <stdexcept>
 #include <unordered_map>
 
+#include "blurkernels.h"
 #include "effectmanager.h"
 #include "effects/matrix/Boid.h"
 #include "gfxbase.h"
+#include "pixelmap.h"
 #include "systemcontainer.h"
 
 // 32 Entries in the 5-bit gamma table
@@ -366,6 +368,40 @@ void GFXBase::fadePixelToBlackBy(int16_t i, uint8_t fadeValue) noexcept
     FadePixelInPlace(leds[i], fadeValue);
 }
 
+void GFXBase::fillSpan(SpanAxis axis, int x, int y, int count, CRGB color)
+{
+    ForEachInSpan(axis, x, y, count, [color](CRGB& pixel, int) { pixel = color; });
+}
+
+void GFXBase::fadeSpanToBlackBy(SpanAxis axis, int x, int y, int count, uint8_t fadeValue)
+{
+    ForEachInSpan(axis, x, y, count, [fadeValue](CRGB& pixel, int) { FadePixelInPlace(pixel, fadeValue); });
+}
+
+void GFXBase::addSpan(SpanAxis axis, int x, int y, int count, CRGB color)
+{
+    ForEachInSpan(axis, x, y, count, [color](CRGB& pixel, int) { pixel += color; });
+}
+
+void GFXBase::blendSpan(SpanAxis axis, int x, int y, int count, CRGB color, fract8 amount)
+{
+    ForEachInSpan(axis, x, y, count, [color, amount](CRGB& pixel, int) { nblend(pixel, color, amount); });
+}
+
+void GFXBase::copySpan(SpanAxis axis, int x, int y, int count, const CRGB* colors)
+{
+    ForEachInSpan(axis, x, y, count, [colors](CRGB& pixel, int i) { pixel = colors[i]; });
+}
+
+void GFXBase::paletteSpan(SpanAxis axis, int x, int y, int count, const CRGBPalette16& palette, uint8_t startIndex, uint8_t indexStep,
+                          uint8_t brightness, TBlendType blendType)
+{
+    ForEachInSpan(axis, x, y, count, [&](CRGB& pixel, int i)
+    {
+        pixel = ColorFromPalette(palette, static_cast<uint8_t>(startIndex + i * indexStep), brightness, blendType);
+    });
+}
+
 void GFXBase::DrawSafeCircle(int centerX, int centerY, int radius, CRGB color) noexcept
 {
     int x = radius;
@@ -543,52 +579,38 @@ CRGBW GFXBase::MaximumWhiteForKelvin(uint16_t kelvin, uint8_t brightness)
     return split;
 }
 
+// blurRows/blurColumns run FastLED's blur1d over every row or column, several lines at once through
+// the packed kernels in blurkernels.h. Custom layouts go one line at a time, in order, since their
+// lines may not be disjoint.
+
 void GFXBase::blurRows(CRGB *leds, uint16_t width, uint16_t height, uint16_t first, fract8 blur_amount)
 {
-    // blur rows same as columns, for irregular matrix
-    uint8_t keep = 255 - blur_amount;
-    uint8_t seep = blur_amount >> 1;
-    for (uint16_t row = 0; row < height; row++)
+    if (GetXYLayout() == XYLayout::Custom)
     {
-        CRGB carryover = CRGB::Black;
-        for (uint16_t i = first; i < width; i++)
-        {
-            CRGB cur = leds[XY(i, row)];
-            CRGB part = cur;
-            part.nscale8(seep);
-            cur.nscale8(keep);
-            cur += carryover;
-            if (i)
-                leds[XY(i - 1, row)] += part;
-            leds[XY(i, row)] = cur;
-            carryover = part;
-        }
+        BlurLines<BlurLanesScalar>(leds, height, width, first, blur_amount, [this](uint16_t row, uint16_t i) { return xy(i, row); });
+        return;
     }
+
+    WithXY([&](auto mapXY)
+    {
+        BlurLines<BlurLanesNative>(leds, height, width, first, blur_amount, [mapXY](uint16_t row, uint16_t i) { return mapXY(i, row); });
+    });
 }
 
 // blurColumns: perform a blur1d on each column of a rectangular matrix
 
 void GFXBase::blurColumns(CRGB *leds, uint16_t width, uint16_t height, uint16_t first, fract8 blur_amount)
 {
-    // blur columns
-    uint8_t keep = 255 - blur_amount;
-    uint8_t seep = blur_amount >> 1;
-    for (uint16_t col = 0; col < width; ++col)
+    if (GetXYLayout() == XYLayout::Custom)
     {
-        CRGB carryover = CRGB::Black;
-        for (uint16_t i = first; i < height; ++i)
-        {
-            CRGB cur = leds[XY(col, i)];
-            CRGB part = cur;
-            part.nscale8(seep);
-            cur.nscale8(keep);
-            cur += carryover;
-            if (i)
-                leds[XY(col, i - 1)] += part;
-            leds[XY(col, i)] = cur;
-            carryover = part;
-        }
+        BlurLines<BlurLanesScalar>(leds, width, height, first, blur_amount, [this](uint16_t col, uint16_t i) { return xy(col, i); });
+        return;
     }
+
+    WithXY([&](auto mapXY)
+    {
+        BlurLines<BlurLanesNative>(leds, width, height, first, blur_amount, [mapXY](uint16_t col, uint16_t i) { return mapXY(col, i); });
+    });
 }
 
 void GFXBase::blur2d(CRGB *leds, uint16_t width, uint16_t firstColumn, uint16_t height, uint16_t firstRow, fract8 blur_amount)
@@ -646,6 +668,14 @@ void GFXBase::ConfigureTopology(size_t width, size_t height, bool serpentine)
 
     Adafruit_GFX::_width = width;
     Adafruit_GFX::_height = height;
+
+    // HUB75 panels are always row-major, so a pixel map only means something on addressable strips
+    #if USE_PIXEL_MAP && !USE_HUB75
+    _xyTable = PixelMap::Load(width, height);
+    #endif
+
+    // Let go of the old size's polar map; GetPolarLUT() fetches the new one on the next frame
+    _polarLUT.reset();
 }
 
 #if USE_NOISE
@@ -681,44 +711,3 @@ uint16_t XY(uint16_t x, uint16_t y)
     auto& g = g_ptrSystem->GetEffectManager().g();
     return g.xy(x, y);
 }
-
-const GFXBase::PolarMapArray& GFXBase::getPolarMap()
-{
-    // C++11 magic static keeps initialization thread-safe and lazy.
-    static const PolarMapArray* pMap = []()
-    {
-        auto p = make_unique_psram<PolarMapArray>();
-        auto& rMap = *p;
-        const uint16_t C_X = kMatrixWidth / 2;
-        const uint16_t C_Y = kMatrixHeight / 2;
-        const float mapp = 255.0f / kMatrixWidth;
-
-        for (int16_t x = -C_X; x < C_X + (kMatrixWidth % 2); x++)
-        {
-            for (int16_t y = -C_Y; y < C_Y + (kMatrixHeight% 2); y++)
-            {
-                float angle_rad = atan2f(static_cast<float>(y), static_cast<float>(x));
-                float radius_float = hypotf(static_cast<float>(x), static_cast<float>(y));
-
-                rMap[x + C_X][y + C_Y].angle = 128.0f * (angle_rad / (float)M_PI);
-                rMap[x + C_X][y + C_Y].scaled_radius = radius_float * mapp;
-                rMap[x + C_X][y + C_Y].unscaled_radius = radius_float;
-            }
-        }
-
-        // A note on the radius calculations:
-        //
-        // `unscaled_radius` is the true geometric distance from the center of the
-        // matrix to the pixel. This is useful for effects that need the real
-        // physical distance.
-        //
-        // `scaled_radius` maps the geometric radius to a range that is more
-        // suitable for use with 8-bit FastLED functions (like inoise8).
-        // The scaling is normalized by the matrix width, which is a common
-        // technique to make radial effects work consistently across different
-        // matrix sizes.
-        return p.release();
-    }();
-
-    return *pMap;
-}
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <gfxfont.h>
 #include <memory>
 #include <stdexcept>
@@ -20,6 +21,7 @@
 #include "effectmanager.h"
 #include "effects/matrix/Boid.h"
 #include "gfxbase.h"
+#include "noisefield.h"
 #include "systemcontainer.h"
 
 #if USE_NOISE
@@ -36,28 +38,134 @@
         _ptrNoise->noise_scale_y = sy;
     }
 
+    // How many whole samples a coordinate has slid since the field was last sampled, when it moved
+    // by an exact multiple of the sample spacing and by less than the extent of the field
+
+    static bool WholeSampleStep(uint32_t from, uint32_t to, uint32_t scale, size_t extent, int32_t& step)
+    {
+        const int32_t delta = static_cast<int32_t>(to - from);
+        if (delta == 0)
+        {
+            step = 0;
+            return true;
+        }
+        // A spacing so wide the field spans half the coordinate space could alias a wrapped step
+        if (scale == 0 || static_cast<uint64_t>(scale) * extent > INT32_MAX || delta % static_cast<int32_t>(scale) != 0)
+            return false;
+
+        step = delta / static_cast<int32_t>(scale);
+        return static_cast<size_t>(abs(step)) < extent;
+    }
+
     // Internal implementation: assumes _ptrNoise is already initialized.
     // Must NOT call EnsureNoise() — this is invoked from within EnsureNoise()'s
     // call_once lambda, and a recursive call_once on the same flag is UB.
     void GFXBase::FillGetNoiseImpl() const
     {
+        Noise& noise = *_ptrNoise;
+
+        // If only noise_x/noise_y moved, and by whole samples, most of the last field is still good:
+        // slide it over and sample just the columns and rows that scrolled in. If nothing moved at
+        // all (SMSmoke refreshes without changing anything) nothing needs sampling.
+        int32_t stepX = 0, stepY = 0;
+        const bool slid = noise.field_valid
+                       && noise.field_z == noise.noise_z
+                       && noise.field_scale_x == noise.noise_scale_x
+                       && noise.field_scale_y == noise.noise_scale_y
+                       && noise.field_width == _width
+                       && noise.field_height == _height
+                       && WholeSampleStep(noise.field_x, noise.noise_x, noise.noise_scale_x, _width, stepX)
+                       && WholeSampleStep(noise.field_y, noise.noise_y, noise.noise_scale_y, _height, stepY);
+
+        // Columns [firstColumn, endColumn) are sampled top to bottom; the other columns only need
+        // rows [firstRow, endRow)
+        size_t firstColumn = 0, endColumn = _width;
+        size_t firstRow = 0, endRow = 0;
+
+        if (slid)
+        {
+            if (stepX > 0)
+            {
+                memmove(noise.field[0], noise.field[stepX], (_width - stepX) * MATRIX_HEIGHT);
+                firstColumn = _width - stepX;
+            }
+            else if (stepX < 0)
+            {
+                memmove(noise.field[-stepX], noise.field[0], (_width + stepX) * MATRIX_HEIGHT);
+                endColumn = -stepX;
+            }
+            else
+            {
+                endColumn = 0;
+            }
+
+            if (stepY > 0)
+            {
+                firstRow = _height - stepY;
+                endRow = _height;
+            }
+            else if (stepY < 0)
+            {
+                endRow = -stepY;
+            }
+
+            if (stepY != 0)
+            {
+                for (size_t i = 0; i < _width; i++)
+                {
+                    if (i >= firstColumn && i < endColumn)
+                        continue;
+                    if (stepY > 0)
+                        memmove(&noise.field[i][0], &noise.field[i][stepY], _height - stepY);
+                    else
+                        memmove(&noise.field[i][-stepY], &noise.field[i][0], _height + stepY);
+                }
+            }
+        }
+
         // Subtracting the center offset before scaling ensures the noise pattern radiates
-        // outwards from the center of the display (exactly as #803 intended).
-        //
-        // We use uint32_t for the indices as it's the native register size for the ESP32,
-        // avoiding the unnecessary overhead of masking/extending smaller types.
-        for (uint32_t i = 0; i < _width; i++)
+        // outwards from the center of the display (exactly as #803 intended). Each row's y and the
+        // frame's z are split into lattice terms once, rather than once per sample.
+        if (endColumn > firstColumn || endRow > firstRow)
         {
-            int32_t ioffset = _ptrNoise->noise_scale_x * (int32_t)(i - (_width / 2));
+            const NoiseField::Axis z = NoiseField::Axis::From(noise.noise_z);
+            NoiseField::Axis rows[MATRIX_HEIGHT];
+            for (uint32_t j = 0; j < _height; j++)
+            {
+                int32_t joffset = noise.noise_scale_y * (int32_t)(j - (_height / 2));
+                rows[j] = NoiseField::Axis::From(noise.noise_y + joffset);
+            }
+
+            for (uint32_t i = 0; i < _width; i++)
+            {
+                int32_t ioffset = noise.noise_scale_x * (int32_t)(i - (_width / 2));
+                const NoiseField::Axis x = NoiseField::Axis::From(noise.noise_x + ioffset);
+
+                if (i >= firstColumn && i < endColumn)
+                    NoiseField::SampleLine(noise.field[i], x, rows, _height, z);
+                else if (endRow > firstRow)
+                    NoiseField::SampleLine(noise.field[i] + firstRow, x, rows + firstRow, endRow - firstRow, z);
+            }
+        }
+
+        noise.field_x       = noise.noise_x;
+        noise.field_y       = noise.noise_y;
+        noise.field_z       = noise.noise_z;
+        noise.field_scale_x = noise.noise_scale_x;
+        noise.field_scale_y = noise.noise_scale_y;
+        noise.field_width   = _width;
+        noise.field_height  = _height;
+        noise.field_valid   = true;
 
+        for (uint32_t i = 0; i < _width; i++)
+        {
             for (uint32_t j = 0; j < _height; j++)
             {
-                int32_t joffset = _ptrNoise->noise_scale_y * (int32_t)(j - (_height / 2));
-                uint8_t data    = inoise16(_ptrNoise->noise_x + ioffset, _ptrNoise->noise_y + joffset, _ptrNoise->noise_z) >> 8;
-                uint8_t olddata = _ptrNoise->noise[i][j];
-                uint8_t newdata = scale8(olddata, _ptrNoise->noisesmoothing) + scale8(data, 256 - _ptrNoise->noisesmoothing);
+                uint8_t data    = noise.field[i][j];
+                uint8_t olddata = noise.noise[i][j];
+                uint8_t newdata = scale8(olddata, noise.noisesmoothing) + scale8(data, 256 - noise.noisesmoothing);
 
-                _ptrNoise->noise[i][j] = newdata;
+                noise.noise[i][j] = newdata;
             }
         }
     }
@@ -74,50 +182,53 @@
         EnsureNoise();
         std::unique_ptr<CRGB[]> ledsTemp = std::make_unique<CRGB[]>(_ledcount);
 
-        // move delta pixelwise
-        for (uint32_t y = 0; y < _height; y++)
+        WithXY([&](auto mapXY)
         {
-            uint16_t amount = _ptrNoise->noise[0][y] * amt;
-            uint8_t delta = _width - 1 - (amount / 256);
+            // move delta pixelwise
+            for (uint32_t y = 0; y < _height; y++)
+            {
+                uint16_t amount = _ptrNoise->noise[0][y] * amt;
+                uint8_t delta = _width - 1 - (amount / 256);
 
-            // Process up to the end less the delta
-            for (uint32_t x = 0; x < _width - delta; x++)
-                ledsTemp[XY(x, y)] = leds[XY(x + delta, y)];
+                // Process up to the end less the delta
+                for (uint32_t x = 0; x < _width - delta; x++)
+                    ledsTemp[mapXY(x, y)] = leds[mapXY(x + delta, y)];
 
-            // Do the tail portion while wrapping around
-            for (uint32_t x = _width - delta; x < _width; x++)
-                ledsTemp[XY(x, y)] = leds[XY(x + delta - _width, y)];
-        }
+                // Do the tail portion while wrapping around
+                for (uint32_t x = _width - delta; x < _width; x++)
+                    ledsTemp[mapXY(x, y)] = leds[mapXY(x + delta - _width, y)];
+            }
 
-        // move fractions
-        CRGB PixelA;
-        CRGB PixelB;
+            // move fractions
+            CRGB PixelA;
+            CRGB PixelB;
 
-        for (uint32_t y = 0; y < _height; y++)
-        {
-            uint16_t amount = _ptrNoise->noise[0][y] * amt;
-            uint8_t delta = _width - 1 - (amount / 256);
-            uint8_t fractions = amount - (delta * 256);
-
-            for (uint32_t x = 1; x < _width; x++)
+            for (uint32_t y = 0; y < _height; y++)
             {
-                PixelA = ledsTemp[XY(x, y)];
-                PixelB = ledsTemp[XY(x - 1, y)];
+                uint16_t amount = _ptrNoise->noise[0][y] * amt;
+                uint8_t delta = _width - 1 - (amount / 256);
+                uint8_t fractions = amount - (delta * 256);
 
-                PixelA %= 255 - fractions;
-                PixelB %= fractions;
+                for (uint32_t x = 1; x < _width; x++)
+                {
+                    PixelA = ledsTemp[mapXY(x, y)];
+                    PixelB = ledsTemp[mapXY(x - 1, y)];
 
-                leds[XY(x, y)] = PixelA + PixelB;
-            }
+                    PixelA %= 255 - fractions;
+                    PixelB %= fractions;
 
-            PixelA = ledsTemp[XY(0, y)];
-            PixelB = ledsTemp[XY(_width - 1, y)];
+                    leds[mapXY(x, y)] = PixelA + PixelB;
+                }
 
-            PixelA %= 255 - fractions;
-            PixelB %= fractions;
+                PixelA = ledsTemp[mapXY(0, y)];
+                PixelB = ledsTemp[mapXY(_width - 1, y)];
 
-            leds[XY(0, y)] = PixelA + PixelB;
-        }
+                PixelA %= 255 - fractions;
+                PixelB %= fractions;
+
+                leds[mapXY(0, y)] = PixelA + PixelB;
+            }
+        });
     }
 
     template<>
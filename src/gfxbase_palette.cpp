@@ -82,8 +82,22 @@ void GFXBase::PausePalette(bool bPaused)
 void GFXBase::UpdatePaletteCycle()
 {
     ChangePalettePeriodically();
+
+    // Once the blend has converged this runs every frame without changing anything, so only
+    // throw the cache away when it actually moved the palette
+    if (_currentPalette == _targetPalette)
+        return;
+
     uint8_t maxChanges = 24;
     nblendPaletteTowardPalette(_currentPalette, _targetPalette, maxChanges);
+    _paletteCacheValid = false;
+}
+
+void GFXBase::RebuildPaletteCache() const
+{
+    for (int i = 0; i < 256; i++)
+        _paletteCache[i] = ColorFromPalette(_currentPalette, i, 255, _currentBlendType);
+    _paletteCacheValid = true;
 }
 
 void GFXBase::RandomPalette()
@@ -103,6 +117,7 @@ void GFXBase::setPalette(const CRGBPalette16& palette)
     _currentPalette = palette;
     _targetPalette = palette;
     _currentPaletteName = "Custom";
+    _paletteCacheValid = false;
 }
 
 // loadPalette
@@ -164,6 +179,7 @@ void GFXBase::loadPalette(int index)
         break;
     }
     _currentPalette = _targetPalette;
+    _paletteCacheValid = false;
 }
 
 void GFXBase::setPalette(const String& paletteName)
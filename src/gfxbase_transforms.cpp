@@ -89,29 +89,35 @@ void GFXBase::MoveOutwardsX(int startY, int endY)
 
 void GFXBase::MoveX(uint8_t delta) const
 {
-    for (int y = 0; y < (int)_height; y++)
+    WithXY([&](auto mapXY)
     {
-        for (int x = 0; x < (int)_width - delta; x++)
-            leds[XY(x, y)] = leds[XY(x + delta, y)];
-        for (int x = (int)_width - delta; x < (int)_width; x++)
-            leds[XY(x, y)] = leds[XY(x + delta - (int)_width, y)];
-    }
+        for (int y = 0; y < (int)_height; y++)
+        {
+            for (int x = 0; x < (int)_width - delta; x++)
+                leds[mapXY(x, y)] = leds[mapXY(x + delta, y)];
+            for (int x = (int)_width - delta; x < (int)_width; x++)
+                leds[mapXY(x, y)] = leds[mapXY(x + delta - (int)_width, y)];
+        }
+    });
 }
 
 void GFXBase::MoveY(uint8_t delta) const
 {
-    CRGB tmp = 0;
-    for (int x = 0; x < (int)_width; x++)
+    WithXY([&](auto mapXY)
     {
-        tmp = leds[XY(x, 0)];
-        for (int m = 0; m < delta; m++)
+        CRGB tmp = 0;
+        for (int x = 0; x < (int)_width; x++)
         {
-            for (int y = 0; y < (int)_height - 1; y++)
-                leds[XY(x, y)] = leds[XY(x, y + 1)];
+            tmp = leds[mapXY(x, 0)];
+            for (int m = 0; m < delta; m++)
+            {
+                for (int y = 0; y < (int)_height - 1; y++)
+                    leds[mapXY(x, y)] = leds[mapXY(x, y + 1)];
 
-            leds[XY(x, (int)_height - 1)] = tmp;
+                leds[mapXY(x, (int)_height - 1)] = tmp;
+            }
         }
-    }
+    });
 }
 
 // All the Caleidoscope functions work directly within the screenbuffer (leds array).
@@ -516,11 +522,6 @@ void GFXBase::DimAll(uint8_t value)
         fadePixelToBlackBy(i, 255 - value);
 }
 
-CRGB GFXBase::ColorFromCurrentPalette(uint8_t index, uint8_t brightness, TBlendType blendType) const
-{
-    return ColorFromPalette(_currentPalette, index, brightness, _currentBlendType);
-}
-
 CRGB GFXBase::HsvToRgb(uint8_t h, uint8_t s, uint8_t v)
 {
     CHSV hsv = CHSV(h, s, v);
@@ -19,6 +19,7 @@
 
 #include "deviceconfig.h"
 #include "effectmanager.h"
+#include "frametiming.h"
 #include "hub75gfx.h"
 #include "ledstripeffect.h"
 #include "soundanalyzer.h"
@@ -230,7 +231,10 @@ void HUB75GFX::PostProcessFrame(uint16_t localPixelsDrawn, uint16_t wifiPixelsDr
     pMatrix.SetBrightness(targetBrightness);
 
     const bool requiresDoubleBuffering = effectManager.HasCurrentEffect() && effectManager.GetCurrentEffect().RequiresDoubleBuffering();
-    MatrixSwapBuffers(wifiPixelsDrawn > 0 || requiresDoubleBuffering || showCaption);
+    {
+        FrameTimings::ScopedStage showStage(g_FrameTimings, RenderStage::Show);
+        MatrixSwapBuffers(wifiPixelsDrawn > 0 || requiresDoubleBuffering || showCaption);
+    }
     FastLED.countFPS();
 }
 
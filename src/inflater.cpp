@@ -0,0 +1,233 @@
+//+--------------------------------------------------------------------------
+//
+// File:        inflater.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Decompression of the socket server's compressed packets; see inflater.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+#include <unistd.h>
+
+#include "byte_utils.h"
+#include "inflater.h"
+
+static_assert(std::is_standard_layout_v<Inflater>, "ReadSource casts the uzlib state back to its Inflater");
+
+// DecompressBuffer
+//
+// Use uzlib to decompress a memory buffer
+
+bool Inflater::DecompressBuffer(const uint8_t * pBuffer, size_t cBuffer, uint8_t * pOutput, size_t expectedOutputSize)
+{
+    if (pBuffer == nullptr || pOutput == nullptr || cBuffer < 4)
+    {
+        debugE("Compressed packet too short to decompress: %zu bytes", cBuffer);
+        return false;
+    }
+
+    debugV("Compressed Data: %02X %02X %02X %02X...", pBuffer[0], pBuffer[1], pBuffer[2], pBuffer[3]);
+
+    struct uzlib_uncomp d = { 0 };
+    uzlib_uncompress_init(&d, nullptr, 0);
+
+    d.source         = pBuffer;
+    d.source_limit   = pBuffer + cBuffer;
+    d.source_read_cb = nullptr;
+    d.dest_start     = pOutput;
+    d.dest           = pOutput;
+
+    // There's an "off by one" bug/feature in uzlib that reaches one byte past the end.  Took forever
+    // to find it...
+
+    d.dest_limit     = pOutput + expectedOutputSize + 1;
+
+    int res = uzlib_zlib_parse_header(&d);
+    if (res < 0)
+    {
+        debugE("ERROR: Cannot parse zlib data header\n");
+        return false;
+    }
+
+    res = uzlib_uncompress_chksum(&d);                                          // Expand the data
+
+    if (res != TINF_DONE) {
+        debugE("Error during decompression after producing %zu bytes: %d\n", (size_t)(d.dest - pOutput), res);
+        return false;
+    }
+
+    if ((size_t)(d.dest - pOutput) != expectedOutputSize)
+    {
+        debugE("Expected it to to decompress to %zu but got %zu instead\n", expectedOutputSize, (size_t)(d.dest - pOutput));
+        return false;
+    }
+
+    return true;
+}
+
+
+// ReadSource
+//
+// uzlib's source callback: refill the chunk from the socket with whatever has arrived, up to the end of
+// this packet, and hand back its first byte. -1 is end of stream to uzlib.
+
+int Inflater::ReadSource(uzlib_uncomp * pState)
+{
+    auto pInflater = reinterpret_cast<Inflater *>(pState);
+    if (pInflater->_remaining == 0)
+        return -1;
+
+    int cbRead = 0;
+    do
+    {
+        cbRead = read(pInflater->_socket, pInflater->_chunk, std::min(pInflater->_remaining, sizeof(pInflater->_chunk)));
+    } while (cbRead < 0 && errno == EINTR);
+
+    if (cbRead <= 0)
+    {
+        debugE("ERROR: %d bytes read inflating a packet with %zu compressed bytes to go\n", cbRead, pInflater->_remaining);
+        pInflater->_readFailed = true;
+        return -1;
+    }
+
+    pInflater->_remaining -= cbRead;
+    pState->source       = pInflater->_chunk + 1;
+    pState->source_limit = pInflater->_chunk + cbRead;
+    return pInflater->_chunk[0];
+}
+
+// Begin
+//
+// Set uzlib up to pull from the prefix, then the socket, and read the zlib header
+
+bool Inflater::Begin(int socket, const uint8_t * pPrefix, size_t cbPrefix, size_t compressedSize)
+{
+    cbPrefix = std::min(cbPrefix, compressedSize);
+
+    memset(&_state, 0, sizeof(_state));
+    uzlib_uncompress_init(&_state, nullptr, 0);
+    _state.source         = pPrefix;
+    _state.source_limit   = pPrefix + cbPrefix;
+    _state.source_read_cb = ReadSource;
+
+    _socket     = socket;
+    _remaining  = compressedSize - cbPrefix;
+    _done       = false;
+    _readFailed = false;
+
+    if (uzlib_zlib_parse_header(&_state) < 0 || _state.eof)
+    {
+        debugE("ERROR: Cannot parse zlib data header\n");
+        return false;
+    }
+    return true;
+}
+
+// BeginPacket
+//
+// The bytes read past the header are the start of the stream, so they go to Begin() as its prefix
+
+bool Inflater::BeginPacket(int socket, const uint8_t * pReceived, size_t cbReceived)
+{
+    if (cbReceived < kHeaderSize)
+    {
+        debugE("Only %zu bytes of the compressed header have been read\n", cbReceived);
+        return false;
+    }
+    return Begin(socket, pReceived + kHeaderSize, cbReceived - kHeaderSize, DWORDFromMemory(pReceived + 4));
+}
+
+// Inflate
+//
+// Expand the next cb bytes. uzlib stops as soon as the output is full, so the end of the stream can
+// still be pending after the last byte; Finish() picks that up.
+
+bool Inflater::Inflate(uint8_t * pWindow, uint8_t * pDest, size_t cb)
+{
+    if (cb == 0)
+        return true;                                                            // uzlib always produces at least one byte
+
+    if (_done)
+    {
+        debugE("Compressed stream ended %zu bytes early\n", cb);
+        return false;
+    }
+
+    _state.dest_start = pWindow;
+    _state.dest       = pDest;
+    _state.dest_limit = pDest + cb;
+
+    const int res = uzlib_uncompress_chksum(&_state);
+    _done = (res == TINF_DONE);
+
+    if ((res != TINF_OK && res != TINF_DONE) || _state.eof)
+    {
+        debugE("Error during decompression after producing %zu bytes: %d%s\n",
+               (size_t)(_state.dest - pWindow), res, _readFailed ? " (socket read failed)" : "");
+        return false;
+    }
+
+    if (_state.dest != pDest + cb)
+    {
+        debugE("Compressed stream ended %zu bytes early\n", (size_t)(pDest + cb - _state.dest));
+        return false;
+    }
+    return true;
+}
+
+// Finish
+//
+// Run uzlib on into a one-byte sink: it must reach the end of the stream without writing to it
+
+bool Inflater::Finish()
+{
+    if (!_done)
+    {
+        uint8_t sink = 0;
+        _state.dest_start = &sink;
+        _state.dest       = &sink;
+        _state.dest_limit = &sink + 1;
+
+        const int res = uzlib_uncompress_chksum(&_state);
+        if (res != TINF_DONE || _state.dest != &sink || _state.eof)
+        {
+            debugE("Compressed stream didn't end with the packet: %d\n", res);
+            return false;
+        }
+        _done = true;
+    }
+
+    // Anything the sender put after the checksum is ignored, as it always was, but still has to come off
+    // the socket
+    while (_remaining > 0)
+    {
+        if (ReadSource(&_state) < 0)
+            return false;
+    }
+    return true;
+}
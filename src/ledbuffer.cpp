@@ -3,7 +3,10 @@
 #include "ledbuffer.h"
 #include "values.h"
 
+#include <algorithm>
+#include <cassert>
 #include <limits>
+#include <mutex>
 
 // LEDBuffer
 //
@@ -17,7 +20,7 @@ LEDBuffer::LEDBuffer(std::shared_ptr<GFXBase> pStrand) :
              _timeStampMicroseconds(0),
              _timeStampSeconds(0)
 {
-    _leds = make_unique_psram<CRGB[]>(_pStrand->GetLEDCount());
+    _leds = make_unique_psram<CRGB[]>(kHeaderPixels + _pStrand->GetLEDCount());
 }
 
 uint64_t LEDBuffer::Seconds()      const  { return _timeStampSeconds;      }
@@ -26,16 +29,26 @@ uint32_t LEDBuffer::Length()       const  { return _pixelCount;            }
 
 double LEDBuffer::TimeTillDue() const
 {
-    return _timeStampSeconds + (_timeStampMicroseconds / (double) MICROS_PER_SECOND) - g_Values.AppTime.CurrentTime();
+    return TimeTillDue(_timeStampSeconds, _timeStampMicroseconds);
 }
 
 bool LEDBuffer::IsBufferOlderThan(const timeval & tv) const
 {
-    if (Seconds() < tv.tv_sec)
+    return IsOlderThan(Seconds(), MicroSeconds(), tv);
+}
+
+double LEDBuffer::TimeTillDue(uint64_t seconds, uint64_t micros)
+{
+    return seconds + (micros / (double) MICROS_PER_SECOND) - g_Values.AppTime.CurrentTime();
+}
+
+bool LEDBuffer::IsOlderThan(uint64_t seconds, uint64_t micros, const timeval & tv)
+{
+    if (seconds < tv.tv_sec)
         return true;
 
-    if (Seconds() == tv.tv_sec)
-        if (MicroSeconds() < tv.tv_usec)
+    if (seconds == tv.tv_sec)
+        if (micros < tv.tv_usec)
             return true;
 
     return false;
@@ -129,10 +142,45 @@ bool LEDBuffer::UpdateFromWire(const uint8_t* payloadData, size_t payloadLength)
     _timeStampMicroseconds = micros;
     _pixelCount            = length32;
 
-    memcpy(_leds.get(), pRGB, payloadBytes);
+    memcpy(Pixels(), pRGB, payloadBytes);
     debugV("seconds, micros: %llu.%llu", seconds, micros);
     if (length32 > 0)
-        debugV("Color0: %08lx", (unsigned long)(uint32_t) _leds[0]);
+        debugV("Color0: %08lx", (unsigned long)(uint32_t) Pixels()[0]);
+    return true;
+}
+
+CRGB* LEDBuffer::Pixels()
+{
+    return _leds.get() + kHeaderPixels;
+}
+
+const CRGB* LEDBuffer::Pixels() const
+{
+    return _leds.get() + kHeaderPixels;
+}
+
+uint8_t* LEDBuffer::WirePacket()
+{
+    return reinterpret_cast<uint8_t *>(_leds.get());
+}
+
+void LEDBuffer::SetFrame(uint64_t seconds, uint64_t micros, uint32_t pixelCount)
+{
+    _timeStampSeconds      = seconds;
+    _timeStampMicroseconds = micros;
+    _pixelCount            = pixelCount;
+}
+
+bool LEDBuffer::CopyFrameFrom(const LEDBuffer& source)
+{
+    if (!_pStrand || source._pixelCount > _pStrand->GetLEDCount())
+    {
+        debugW("Frame of %lu LEDs doesn't fit this buffer", (unsigned long)source._pixelCount);
+        return false;
+    }
+
+    memcpy(Pixels(), source.Pixels(), source._pixelCount * sizeof(CRGB));
+    SetFrame(source._timeStampSeconds, source._timeStampMicroseconds, source._pixelCount);
     return true;
 }
 
@@ -140,7 +188,7 @@ void LEDBuffer::DrawBuffer()
 {
     _timeStampMicroseconds = 0;
     _timeStampSeconds      = 0;
-    _pStrand->fillLeds(_leds.get());
+    _pStrand->fillLeds(Pixels());
 }
 
 void LEDBuffer::Reconfigure(std::shared_ptr<GFXBase> pStrand)
@@ -154,7 +202,7 @@ void LEDBuffer::Reconfigure(std::shared_ptr<GFXBase> pStrand)
     // actual LED count changes; otherwise just retarget the buffer to the new strand config.
     if (nextLedCount != currentLedCount)
     {
-        _leds = make_unique_psram<CRGB[]>(nextLedCount);
+        _leds = make_unique_psram<CRGB[]>(kHeaderPixels + nextLedCount);
     }
 
     _pixelCount = 0;
@@ -164,47 +212,177 @@ void LEDBuffer::Reconfigure(std::shared_ptr<GFXBase> pStrand)
 
 // LEDBufferManager
 //
-// Manages a circular buffer of LEDBuffer objects.  The buffer itself is an array of shared_ptrs to
-// LEDBuffer objects.  The buffer is managed through a unique_ptr.  The LEDBuffer objects are managed
-// through shared_ptrs as they are also returned to callers.
+// Manages a circular queue of LEDBuffer objects handed between the socket and render tasks without a
+// lock; see ledbuffer.h for the protocol. The buffers themselves live in a pool of shared_ptrs, as
+// they are also returned to callers, and the queue's slots refer to them by index.
+
+LEDBufferManager::Ring::Ring(uint32_t cSlots, uint32_t cPool)
+ : wrap(cSlots ? 0x10000 - 0x10000 % cSlots : 1),
+   slots(std::make_unique<Slot[]>(std::max<uint32_t>(cSlots, 1))),
+   returned(std::make_unique<uint16_t[]>(cPool + 1)),
+   cReturned(cPool + 1)
+{
+}
 
 LEDBufferManager::LEDBufferManager(uint32_t cBuffers, const std::shared_ptr<GFXBase>& pGFX)
- : _ppBuffers(std::make_unique<std::vector<std::shared_ptr<LEDBuffer>>>()), // Create the circular array of ptrs
-   _iNextBuffer(0),
-   _iLastBuffer(0),
-   _cQueuedBuffers(0),
+ : _ppBuffers(std::make_unique<std::vector<std::shared_ptr<LEDBuffer>>>()), // Create the pool of buffer ptrs
+   _pRing(std::make_unique<Ring>(cBuffers, cBuffers + kReservations + 1)),
+   _pScheduler(std::make_unique<PlayoutScheduler>()),
    _cBuffers(cBuffers)
 {
+    // Head and tail are packed into 16 bits each, and pool indices must stay clear of kNoBuffer
+    assert(cBuffers < 0x8000);
+
+    _iSpares.fill(kNoBuffer);
+
     // The initializer creates a uniquely owned table of shared pointers.
     // We exclusively can see the table, but the buffer objects it contains
     // are returned back out to callers so they must be shared pointers.
 
-    for (uint32_t i = 0; i < _cBuffers; i++)
+    for (uint32_t i = 0; i < _cBuffers + kReservations + 1; i++)
         _ppBuffers->push_back(make_shared_psram<LEDBuffer>(pGFX));
+
+    ResetQueue();
 }
 
-double LEDBufferManager::AgeOfOldestBuffer() const
+uint64_t LEDBufferManager::ClockMicros()
+{
+    timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec * (uint64_t) MICROS_PER_SECOND + tv.tv_usec;
+}
+
+// The queue state word: head in the top 16 bits, tail in the bottom, each counting modulo wrap
+
+uint32_t LEDBufferManager::Head(uint32_t state) const  { return state >> 16; }
+uint32_t LEDBufferManager::Tail(uint32_t state) const  { return state & 0xFFFF; }
+uint32_t LEDBufferManager::Count(uint32_t state) const { return (Head(state) + _pRing->wrap - Tail(state)) % _pRing->wrap; }
+uint32_t LEDBufferManager::Next(uint32_t position) const { return position + 1 == _pRing->wrap ? 0 : position + 1; }
+uint32_t LEDBufferManager::Pack(uint32_t head, uint32_t tail) const { return head << 16 | tail; }
+
+// ResetQueue
+//
+// Empties the queue and puts every buffer but the reservations in the pool. Neither side may be using
+// the manager.
+
+void LEDBufferManager::ResetQueue()
+{
+    auto& ring = *_pRing;
+
+    _iDrawing = kNoBuffer;
+
+    ring.state.store(0, std::memory_order_relaxed);
+    ring.returnedHead.store(0, std::memory_order_relaxed);
+    ring.returnedTail.store(0, std::memory_order_relaxed);
+    for (uint16_t i = 0; i < _ppBuffers->size(); i++)
+        if (std::find(_iSpares.begin(), _iSpares.end(), i) == _iSpares.end())
+            ReturnBuffer(i);
+
+    _pLastBufferAdded.reset();
+    _newestSeconds = 0;
+    _newestMicros  = 0;
+    _generation++;
+
+    _pScheduler->Reset();
+}
+
+// ReturnBuffer
+//
+// Hands a buffer the render task is done with back to the receivers
+
+void LEDBufferManager::ReturnBuffer(uint16_t iBuffer)
 {
-    auto pOldest = PeekOldestBuffer();
-    if (pOldest) {
-        return (pOldest->Seconds() + pOldest->MicroSeconds() / (float)MICROS_PER_SECOND) - g_Values.AppTime.CurrentTime();
+    auto& ring = *_pRing;
+    const uint32_t head = ring.returnedHead.load(std::memory_order_relaxed);
+    const uint32_t next = (head + 1) % ring.cReturned;
+
+    // Every buffer is in exactly one place, so this only fires if that bookkeeping is broken
+    if (next == ring.returnedTail.load(std::memory_order_acquire))
+    {
+        debugE("LEDBufferManager has more buffers returned than it owns");
+        return;
     }
-    else
+
+    ring.returned[head] = iBuffer;
+    ring.returnedHead.store(next, std::memory_order_release);
+}
+
+// TakeFreeBuffer
+//
+// A buffer for a receiver to fill: one the render task has returned, or failing that the oldest queued
+// frame. The pool holds one buffer more than the queue has slots and reservations, so when none have
+// been returned and the other receivers hold theirs, the queue is full, or one short of it with the
+// render task between taking a frame and returning the previous one; either way there is a frame to
+// take back.
+
+uint16_t LEDBufferManager::TakeFreeBuffer()
+{
+    auto& ring = *_pRing;
+
+    for (;;)
     {
-        return 0.0;
+        const uint32_t tail = ring.returnedTail.load(std::memory_order_relaxed);
+        if (tail != ring.returnedHead.load(std::memory_order_acquire))
+        {
+            const uint16_t iBuffer = ring.returned[tail];
+            ring.returnedTail.store((tail + 1) % ring.cReturned, std::memory_order_release);
+            return iBuffer;
+        }
+
+        uint32_t state = ring.state.load(std::memory_order_acquire);
+        if (Count(state) == 0)
+            continue;
+
+        const uint16_t iOldest = ring.slots[Tail(state) % _cBuffers].buffer.load(std::memory_order_relaxed);
+        if (ring.state.compare_exchange_weak(state, Pack(Head(state), Next(Tail(state))), std::memory_order_acq_rel, std::memory_order_relaxed))
+            return iOldest;
     }
 }
 
-double LEDBufferManager::AgeOfNewestBuffer() const
+// PeekSlotTime
+//
+// Reads the timestamp, or the due time, in the oldest or newest slot, retrying if the queue moved
+// underneath, so the pair read always belongs to one frame that was queued at the time
+
+bool LEDBufferManager::PeekSlotTime(bool newest, bool due, uint64_t & seconds, uint64_t & micros) const
 {
-    auto pNewest = PeekNewestBuffer();
-    if (pNewest) {
-        return (pNewest->Seconds() + pNewest->MicroSeconds() / (float)MICROS_PER_SECOND) - g_Values.AppTime.CurrentTime();
+    if (_cBuffers == 0)
+        return false;
+
+    auto& ring = *_pRing;
+    for (;;)
+    {
+        const uint32_t state = ring.state.load(std::memory_order_acquire);
+        if (Count(state) == 0)
+            return false;
+
+        const uint32_t position = newest ? (Head(state) + ring.wrap - 1) % ring.wrap : Tail(state);
+        const auto& slot = ring.slots[position % _cBuffers];
+        seconds = (due ? slot.dueSeconds : slot.seconds).load(std::memory_order_relaxed);
+        micros  = (due ? slot.dueMicros : slot.micros).load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (ring.state.load(std::memory_order_relaxed) == state)
+            return true;
     }
+}
+
+double LEDBufferManager::AgeOfOldestBuffer() const
+{
+    uint64_t seconds, micros;
+    if (PeekOldestTime(seconds, micros))
+        return (seconds + micros / (float)MICROS_PER_SECOND) - g_Values.AppTime.CurrentTime();
+    else
+        return 0.0;
+}
+
+double LEDBufferManager::AgeOfNewestBuffer() const
+{
+    uint64_t seconds, micros;
+    if (PeekNewestTime(seconds, micros))
+        return (seconds + micros / (float)MICROS_PER_SECOND) - g_Values.AppTime.CurrentTime();
     else
-    {
         return 0.0;
-    }
 }
 
 // BufferCount
@@ -233,12 +411,47 @@ size_t LEDBufferManager::LEDCount() const
 
 size_t LEDBufferManager::Depth() const
 {
-    return _cQueuedBuffers;
+    return _cBuffers ? Count(_pRing->state.load(std::memory_order_acquire)) : 0;
 }
 
 bool LEDBufferManager::IsEmpty() const
 {
-    return _cQueuedBuffers == 0;
+    return Depth() == 0;
+}
+
+bool LEDBufferManager::PeekOldestTime(uint64_t & seconds, uint64_t & micros) const
+{
+    return PeekSlotTime(false, false, seconds, micros);
+}
+
+bool LEDBufferManager::PeekNewestTime(uint64_t & seconds, uint64_t & micros) const
+{
+    return PeekSlotTime(true, false, seconds, micros);
+}
+
+bool LEDBufferManager::PeekOldestDue(uint64_t & dueMicros) const
+{
+    uint64_t seconds, micros;
+    if (!PeekSlotTime(false, true, seconds, micros))
+        return false;
+
+    dueMicros = seconds * MICROS_PER_SECOND + micros;
+    return true;
+}
+
+bool LEDBufferManager::PeekNewestDue(uint64_t & dueMicros) const
+{
+    uint64_t seconds, micros;
+    if (!PeekSlotTime(true, true, seconds, micros))
+        return false;
+
+    dueMicros = seconds * MICROS_PER_SECOND + micros;
+    return true;
+}
+
+const PlayoutScheduler& LEDBufferManager::Scheduler() const
+{
+    return *_pScheduler;
 }
 
 // PeekNewestBuffer
@@ -252,71 +465,255 @@ std::shared_ptr<LEDBuffer> LEDBufferManager::PeekNewestBuffer() const
     return _pLastBufferAdded;
 }
 
-// GetNewBuffer
+// PeekLastBuffer
 //
-// Grabs the next buffer in the circle, advancing the tail pointer as well if we've
-// 'caught up' to the head pointer, which effective throws away that buffer via reuse
+// The most recently queued buffer, drawn or not
 
-std::shared_ptr<LEDBuffer> LEDBufferManager::GetNewBuffer()
+std::shared_ptr<LEDBuffer> LEDBufferManager::PeekLastBuffer() const
+{
+    return _pLastBufferAdded;
+}
+
+uint32_t LEDBufferManager::Generation() const
+{
+    return _generation;
+}
+
+// GetOldestBuffer
+//
+// Takes the oldest frame, returning the one handed out last time to the pool
+
+std::shared_ptr<LEDBuffer> LEDBufferManager::GetOldestBuffer()
 {
     if (_cBuffers == 0)
         return nullptr;
 
-    auto pResult = (*_ppBuffers)[_iNextBuffer];
+    auto& ring = *_pRing;
+    uint32_t state = ring.state.load(std::memory_order_acquire);
+    for (;;)
+    {
+        if (Count(state) == 0)
+            return nullptr;
+
+        // The slot only changes after the state does, so if the swap succeeds the index read is the frame taken
+        const uint16_t iBuffer = ring.slots[Tail(state) % _cBuffers].buffer.load(std::memory_order_relaxed);
+        if (ring.state.compare_exchange_weak(state, Pack(Head(state), Next(Tail(state))), std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            if (_iDrawing != kNoBuffer)
+                ReturnBuffer(_iDrawing);
+            _iDrawing = iBuffer;
+            return (*_ppBuffers)[iBuffer];
+        }
+    }
+}
 
-    // Full and empty used to be represented by the same head/tail indices, so
-    // an exact fill at the wrap point made the whole queue look empty. Track
-    // depth explicitly and advance the tail only when a real overwrite occurs.
-    _iNextBuffer = (_iNextBuffer + 1) % _cBuffers;
-    if (_cQueuedBuffers == _cBuffers)
-        _iLastBuffer = (_iLastBuffer + 1) % _cBuffers;
-    else
-        ++_cQueuedBuffers;
+// GetDueBuffer
+//
+// Catches up to nowMicros, keeping only the newest frame that's due
 
-    _pLastBufferAdded = pResult;
+std::shared_ptr<LEDBuffer> LEDBufferManager::GetDueBuffer(uint64_t nowMicros)
+{
+    std::shared_ptr<LEDBuffer> pBuffer;
+    uint64_t dueMicros;
+
+    while (PeekOldestDue(dueMicros) && dueMicros <= nowMicros)
+    {
+        auto pNext = GetOldestBuffer();
+        if (!pNext)
+            break;
 
-    return pResult;
+        if (pBuffer)
+            _pScheduler->CountDropped();
+        pBuffer = std::move(pNext);
+    }
+    return pBuffer;
 }
 
-// GetOldestBuffer
+// ReserveBuffer
 //
-// Return a pointer to the very oldest buffer, or nullptr if empty
+// Hands out a receiver's buffer for a zero-copy receive
 
-std::shared_ptr<LEDBuffer> LEDBufferManager::GetOldestBuffer()
+std::shared_ptr<LEDBuffer> LEDBufferManager::ReserveBuffer(BufferReservation reservation)
 {
-    if (IsEmpty())
+    if (_cBuffers == 0)
         return nullptr;
 
-    auto pResult = (*_ppBuffers)[_iLastBuffer];
-    _iLastBuffer = (_iLastBuffer + 1) % _cBuffers;
-    --_cQueuedBuffers;
+    assert(ReservationIndex(reservation) < kReservations);
 
-    return pResult;
+    auto& iSpare = _iSpares[ReservationIndex(reservation)];
+    if (iSpare == kNoBuffer)
+        iSpare = TakeFreeBuffer();
+    return (*_ppBuffers)[iSpare];
 }
 
-// PeekOldestBuffer
+// CommitBuffer
 //
-// Take a "peek" at the newest buffer, or nullptr if empty
+// Puts a filled reservation in the queue, due when the scheduler says
 
-std::shared_ptr<LEDBuffer> LEDBufferManager::PeekOldestBuffer() const
+bool LEDBufferManager::CommitBuffer(const std::shared_ptr<LEDBuffer>& pBuffer)
 {
-    if (IsEmpty())
-        return nullptr;
+    return CommitBuffer(pBuffer, ClockMicros());
+}
+
+bool LEDBufferManager::CommitBuffer(const std::shared_ptr<LEDBuffer>& pBuffer, uint64_t arrivalMicros)
+{
+    size_t iReservation;
+    if (!IsReservation(pBuffer, iReservation))
+        return false;
+
+    Enqueue(pBuffer, iReservation, Schedule(*pBuffer, arrivalMicros));
+    return true;
+}
+
+// CommitBuffers
+//
+// Every scheduler sees its channel's frame so its estimates stay current, but the frames all go in the
+// queues with the first one's due time, and go in together under g_publish_mutex
+
+size_t LEDBufferManager::CommitBuffers(LEDBufferManager * pManagers, size_t cManagers, const std::shared_ptr<LEDBuffer> * pBuffers, uint64_t arrivalMicros)
+{
+    bool scheduled = false;
+    uint64_t due = 0;
+    for (size_t i = 0; i < cManagers; i++)
+    {
+        size_t iReservation;
+        if (!pManagers[i].IsReservation(pBuffers[i], iReservation))
+            continue;
+
+        const uint64_t channelDue = pManagers[i].Schedule(*pBuffers[i], arrivalMicros);
+        if (!scheduled)
+        {
+            due = channelDue;
+            scheduled = true;
+        }
+    }
+    if (!scheduled)
+        return 0;
+
+    size_t committed = 0;
+    std::lock_guard guard(g_publish_mutex);
+    for (size_t i = 0; i < cManagers; i++)
+    {
+        size_t iReservation;
+        if (pManagers[i].IsReservation(pBuffers[i], iReservation))
+        {
+            pManagers[i].Enqueue(pBuffers[i], iReservation, due);
+            committed++;
+        }
+    }
+    return committed;
+}
+
+// IsReservation
+//
+// Whether pBuffer is one of the receivers' reservations, and whose. Reconfigure() replaces them, so a
+// receive that straddled it is holding a buffer sized for the old topology.
 
-    return (*_ppBuffers)[_iLastBuffer];
+bool LEDBufferManager::IsReservation(const std::shared_ptr<LEDBuffer>& pBuffer, size_t & iReservation) const
+{
+    if (_cBuffers == 0 || !pBuffer)
+        return false;
+
+    for (iReservation = 0; iReservation < kReservations; iReservation++)
+        if (_iSpares[iReservation] != kNoBuffer && pBuffer == (*_ppBuffers)[_iSpares[iReservation]])
+            return true;
+    return false;
+}
+
+// Schedule
+//
+// When the channel's scheduler says a frame that arrived at arrivalMicros is due on the local clock
+
+uint64_t LEDBufferManager::Schedule(const LEDBuffer& buffer, uint64_t arrivalMicros)
+{
+    const int64_t stamp = buffer.Seconds() * MICROS_PER_SECOND + buffer.MicroSeconds();
+    return _pScheduler->Schedule(stamp, arrivalMicros);
+}
+
+// Enqueue
+//
+// Puts reservation iReservation in the queue, due at dueMicros on the local clock. The render task only
+// ever moves the tail, so the receiver can claim the slot it writes - the next one, the newest frame's
+// or the oldest frame's - and then publish it by moving the head. Whatever frame it displaces becomes
+// that receiver's next reservation.
+
+void LEDBufferManager::Enqueue(const std::shared_ptr<LEDBuffer>& pBuffer, size_t iReservation, uint64_t dueMicros)
+{
+    auto& ring = *_pRing;
+    auto& iSpare = _iSpares[iReservation];
+    const uint16_t iBuffer = iSpare;
+    const uint64_t seconds = pBuffer->Seconds();
+    const uint64_t micros  = pBuffer->MicroSeconds();
+    const bool sameFrame   = micros != 0 && micros == _newestMicros && seconds == _newestSeconds;
+
+    uint32_t head;
+    uint32_t state = ring.state.load(std::memory_order_acquire);
+    for (;;)
+    {
+        const uint32_t count = Count(state);
+
+        if (sameFrame && count > 0)
+        {
+            // Take the newest frame back, unless the render task gets to it first
+            head = (Head(state) + ring.wrap - 1) % ring.wrap;
+            if (ring.state.compare_exchange_weak(state, Pack(head, Tail(state)), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                iSpare = ring.slots[head % _cBuffers].buffer.load(std::memory_order_relaxed);
+                break;
+            }
+        }
+        else if (count == _cBuffers)
+        {
+            // Full, so drop the oldest frame; its slot is the one the head points at
+            head = Head(state);
+            if (ring.state.compare_exchange_weak(state, Pack(head, Next(Tail(state))), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                iSpare = ring.slots[head % _cBuffers].buffer.load(std::memory_order_relaxed);
+                _pScheduler->CountOverwritten();
+                break;
+            }
+        }
+        else
+        {
+            head = Head(state);
+            iSpare = kNoBuffer;
+            break;
+        }
+    }
+
+    auto& slot = ring.slots[head % _cBuffers];
+    slot.buffer.store(iBuffer, std::memory_order_relaxed);
+    slot.seconds.store(static_cast<uint32_t>(seconds), std::memory_order_relaxed);
+    slot.micros.store(static_cast<uint32_t>(micros), std::memory_order_relaxed);
+    slot.dueSeconds.store(static_cast<uint32_t>(dueMicros / MICROS_PER_SECOND), std::memory_order_relaxed);
+    slot.dueMicros.store(static_cast<uint32_t>(dueMicros % MICROS_PER_SECOND), std::memory_order_relaxed);
+
+    // Only the tail can have moved since; publish the slot with the head
+    state = ring.state.load(std::memory_order_relaxed);
+    while (!ring.state.compare_exchange_weak(state, Pack(Next(head), Tail(state)), std::memory_order_release, std::memory_order_relaxed))
+        ;
+
+    _pLastBufferAdded = pBuffer;
+    _newestSeconds    = seconds;
+    _newestMicros     = micros;
+    _generation++;
 }
 
 void LEDBufferManager::Reconfigure(const std::shared_ptr<GFXBase>& pGFX)
 {
     // Runtime topology changes should not leave stale-sized WiFi buffers behind. Resetting the circular
     // queue here makes the active transport size match the active graphics context immediately.
-    for (auto& buffer : *_ppBuffers)
-        buffer->Reconfigure(pGFX);
+    // The reservations are replaced rather than reconfigured: a receiver may be filling one right now,
+    // and CommitBuffer() turns it away when it arrives
+    for (uint16_t i = 0; i < _ppBuffers->size(); i++)
+    {
+        if (std::find(_iSpares.begin(), _iSpares.end(), i) != _iSpares.end())
+            (*_ppBuffers)[i] = make_shared_psram<LEDBuffer>(pGFX);
+        else
+            (*_ppBuffers)[i]->Reconfigure(pGFX);
+    }
 
-    _iNextBuffer = 0;
-    _iLastBuffer = 0;
-    _cQueuedBuffers = 0;
-    _pLastBufferAdded.reset();
+    ResetQueue();
 }
 
 // operator[]
@@ -324,8 +721,9 @@ void LEDBufferManager::Reconfigure(const std::shared_ptr<GFXBase>& pGFX)
 // Returns a pointer to the buffer at the specified logical index, or nullptr if empty
 std::shared_ptr<LEDBuffer> LEDBufferManager::operator[](size_t index) const
 {
-    if (IsEmpty() || index >= _cQueuedBuffers)
+    const uint32_t state = _cBuffers ? _pRing->state.load(std::memory_order_acquire) : 0;
+    if (index >= Count(state))
         return nullptr;
-    size_t i = (_iLastBuffer + index) % _cBuffers;
-    return (*_ppBuffers)[i];
+    const uint32_t position = (Tail(state) + index) % _pRing->wrap;
+    return (*_ppBuffers)[_pRing->slots[position % _cBuffers].buffer.load(std::memory_order_relaxed)];
 }
@@ -0,0 +1,474 @@
+//+--------------------------------------------------------------------------
+//
+// File:        lightingreceiver.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    DDP, E1.31 and Art-Net packets into LEDBufferManager frames; see
+//    lightingreceiver.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "byte_utils.h"
+#include "ledbuffer.h"
+#include "lightingreceiver.h"
+
+static_assert(sizeof(CRGB) == 3, "Pixels are written as the protocols' RGB byte triples");
+
+namespace
+{
+    // DDP (www.3waylabs.com/ddp): a 10-byte header, 14 with a timecode
+
+    constexpr size_t  kDDPHeaderSize         = 10;
+    constexpr size_t  kDDPTimecodeSize       = 4;
+    constexpr uint8_t kDDPVersionMask        = 0xC0;
+    constexpr uint8_t kDDPVersion1           = 0x40;
+    constexpr uint8_t kDDPFlagTimecode       = 0x10;
+    constexpr uint8_t kDDPFlagReply          = 0x04;
+    constexpr uint8_t kDDPFlagQuery          = 0x02;
+    constexpr uint8_t kDDPFlagPush           = 0x01;
+    constexpr uint8_t kDDPTypeUndefined      = 0;
+    constexpr uint8_t kDDPTypeRGB            = 1;
+    constexpr uint8_t kDDPIdControl          = 246;                 // 246 and up are JSON control, config, status and DMX
+    constexpr uint8_t kDDPIdAll              = 255;
+
+    // E1.31 (ANSI E1.31-2018): root layer, framing layer, then DMP layer with the DMX slots
+
+    constexpr uint8_t  kAcnPacketIdentifier[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+    constexpr uint32_t kE131RootData         = 0x00000004;
+    constexpr uint32_t kE131RootExtended     = 0x00000008;
+    constexpr uint32_t kE131FramingData      = 0x00000002;
+    constexpr uint32_t kE131ExtendedSync     = 0x00000001;
+    constexpr uint8_t  kE131DmpSetProperty   = 0x02;
+    constexpr uint8_t  kE131AddressType      = 0xA1;
+    constexpr uint8_t  kE131OptionPreview    = 0x80;
+    constexpr uint8_t  kE131OptionTerminated = 0x40;
+    constexpr size_t   kE131RootSize         = 38;                  // Through the CID
+    constexpr size_t   kE131SyncSize         = 49;
+    constexpr size_t   kE131DataHeaderSize   = 126;                 // Through the start code
+    constexpr size_t   kE131MaxSlots         = 513;                 // Start code and 512 slots
+
+    // Art-Net 4: ArtDmx and ArtSync
+
+    constexpr uint8_t  kArtNetId[8]          = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+    constexpr uint16_t kArtOpDmx             = 0x5000;
+    constexpr uint16_t kArtOpSync            = 0x5200;
+    constexpr uint16_t kArtProtocolVersion   = 14;
+    constexpr size_t   kArtDmxHeaderSize     = 18;
+    constexpr size_t   kArtSyncSize          = 14;
+
+    // A sequence number this far behind the last one is a sender that restarted, as E1.31 6.7.2 says
+
+    constexpr int kSequenceRestart = -20;
+}
+
+LightingReceiver::LightingReceiver(LEDBufferManager * pManagers, size_t cManagers, uint16_t e131StartUniverse, uint16_t artNetStartUniverse) :
+    _pManagers(pManagers),
+    _cManagers(std::min(cManagers, kMaxChannels)),
+    _e131StartUniverse(e131StartUniverse),
+    _artNetStartUniverse(artNetStartUniverse),
+    _channels(_cManagers)
+{
+}
+
+LightingReceiver::~LightingReceiver() = default;
+
+uint16_t LightingReceiver::FirstUniverse(Protocol protocol, size_t iChannel) const
+{
+    uint32_t universe = protocol == Protocol::ArtNet ? _artNetStartUniverse : _e131StartUniverse;
+    for (size_t i = 0; i < iChannel && i < _cManagers; i++)
+        universe += UniverseCount(_pManagers[i].LEDCount());
+    return universe;
+}
+
+LightingReceiver::Result LightingReceiver::Accept(Protocol protocol, const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros)
+{
+    Count(_packets);
+
+    Result result;
+    switch (protocol)
+    {
+        case Protocol::DDP:    result = AcceptDDP(pPacket, cbPacket, nowMicros);    break;
+        case Protocol::E131:   result = AcceptE131(pPacket, cbPacket, nowMicros);   break;
+        case Protocol::ArtNet: result = AcceptArtNet(pPacket, cbPacket, nowMicros); break;
+        default:               result = Result::Malformed;                          break;
+    }
+
+    if (result == Result::Malformed)
+        Count(_malformed);
+    else if (result == Result::OutOfSequence)
+        Count(_outOfSequence);
+    return result;
+}
+
+// Touch
+//
+// Makes sure a channel has a frame in progress in the receiver's own reservation, starting one from the
+// last frame queued if not. A frame that a Reconfigure() invalidated, or that another receiver has
+// queued over so the pixels it copied are stale, is started over.
+
+bool LightingReceiver::Touch(size_t iChannel)
+{
+    auto& channel = _channels[iChannel];
+    auto& manager = _pManagers[iChannel];
+
+    if (channel.pFrame && channel.generation == manager.Generation())
+        return true;
+    if (channel.pFrame)
+        Abandon(channel);
+
+    channel.pFrame = manager.ReserveBuffer(BufferReservation::Lighting);
+    if (!channel.pFrame)
+        return false;
+
+    // Whatever this frame isn't sent stays as it was
+    const size_t leds = manager.LEDCount();
+    auto pLast = manager.PeekLastBuffer();
+    if (pLast && pLast != channel.pFrame && pLast->Length() == leds)
+        memcpy(channel.pFrame->Pixels(), pLast->Pixels(), leds * sizeof(CRGB));
+    else
+        std::fill_n(channel.pFrame->Pixels(), leds, CRGB::Black);
+
+    channel.generation = manager.Generation();
+    channel.seen.assign(UniverseCount(leds), 0);
+    return true;
+}
+
+void LightingReceiver::Write(size_t iChannel, size_t byteOffset, const uint8_t * pData, size_t cbData)
+{
+    const size_t cbChannel = _pManagers[iChannel].LEDCount() * sizeof(CRGB);
+    if (byteOffset >= cbChannel)
+        return;
+
+    auto pPixels = reinterpret_cast<uint8_t *>(_channels[iChannel].pFrame->Pixels());
+    memcpy(pPixels + byteOffset, pData, std::min(cbData, cbChannel - byteOffset));
+}
+
+// Present
+//
+// Queues a channel's frame in progress, stamped nowMicros
+
+bool LightingReceiver::Present(size_t iChannel, uint64_t nowMicros)
+{
+    auto& channel = _channels[iChannel];
+    auto& manager = _pManagers[iChannel];
+    if (!channel.pFrame)
+        return false;
+
+    channel.pFrame->SetFrame(nowMicros / MICROS_PER_SECOND, nowMicros % MICROS_PER_SECOND, manager.LEDCount());
+    const bool queued = manager.CommitBuffer(channel.pFrame, nowMicros);
+    if (queued)
+        Count(_framesPresented);
+    else
+        debugW("Lighting frame for channel %zu was not queued", iChannel);
+
+    Abandon(channel);
+    return queued;
+}
+
+// PresentTogether
+//
+// Queues the frames in progress on every channel selected as one, so a push or sync shows them all on
+// the same pass; see LEDBufferManager::CommitBuffers(). The frames are gathered in _frames, which is
+// left empty again for the next push or sync.
+
+template <typename Selected>
+bool LightingReceiver::PresentTogether(uint64_t nowMicros, Selected selected)
+{
+    size_t cFrames = 0;
+    for (size_t i = 0; i < _cManagers; i++)
+    {
+        auto& channel = _channels[i];
+        if (!channel.pFrame || !selected(channel))
+            continue;
+
+        channel.pFrame->SetFrame(nowMicros / MICROS_PER_SECOND, nowMicros % MICROS_PER_SECOND, _pManagers[i].LEDCount());
+        _frames[i] = channel.pFrame;
+        cFrames++;
+    }
+    if (cFrames == 0)
+        return false;
+
+    const size_t queued = LEDBufferManager::CommitBuffers(_pManagers, _cManagers, _frames.data(), nowMicros);
+    Count(_framesPresented, queued);
+    if (queued < cFrames)
+        debugW("%zu of %zu lighting frames were not queued", cFrames - queued, cFrames);
+
+    for (size_t i = 0; i < _cManagers; i++)
+    {
+        if (_frames[i])
+        {
+            Abandon(_channels[i]);
+            _frames[i].reset();
+        }
+    }
+    return queued > 0;
+}
+
+// Abandon
+//
+// Forgets the frame in progress. The reservation stays the receiver's, with the manager, for the next one.
+
+void LightingReceiver::Abandon(Channel & channel)
+{
+    channel.pFrame.reset();
+    channel.wait        = Wait::Universes;
+    channel.syncAddress = 0;
+    std::fill(channel.seen.begin(), channel.seen.end(), 0);
+}
+
+// AcceptDDP
+//
+// The data offset is into every channel's pixels end to end, so one packet may cover the end of one
+// channel and the start of the next
+
+LightingReceiver::Result LightingReceiver::AcceptDDP(const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros)
+{
+    if (cbPacket < kDDPHeaderSize || (pPacket[0] & kDDPVersionMask) != kDDPVersion1)
+        return Result::Malformed;
+
+    const uint8_t flags = pPacket[0];
+    const size_t cbHeader = kDDPHeaderSize + ((flags & kDDPFlagTimecode) ? kDDPTimecodeSize : 0);
+    if (cbPacket < cbHeader)
+        return Result::Malformed;
+
+    const uint32_t offset = DWORDFromMemoryBE(&pPacket[4]);
+    const uint16_t length = WORDFromMemoryBE(&pPacket[8]);
+    if (length > cbPacket - cbHeader)
+        return Result::Malformed;
+
+    // Queries want a reply, and other data types and destinations aren't pixels we can show
+    const uint8_t type = (pPacket[2] >> 3) & 0x07;
+    const uint8_t id   = pPacket[3];
+    if ((flags & (kDDPFlagQuery | kDDPFlagReply)) ||
+        (type != kDDPTypeUndefined && type != kDDPTypeRGB) ||
+        (id >= kDDPIdControl && id != kDDPIdAll))
+    {
+        return Result::Ignored;
+    }
+
+    bool written = false;
+    size_t base = 0;
+    for (size_t i = 0; i < _cManagers; i++)
+    {
+        const size_t cbChannel = _pManagers[i].LEDCount() * sizeof(CRGB);
+        const size_t start = std::max<size_t>(offset, base);
+        const size_t end   = std::min<size_t>(size_t(offset) + length, base + cbChannel);
+        if (start < end)
+        {
+            if (Touch(i))
+            {
+                _channels[i].protocol = Protocol::DDP;
+                Write(i, start - base, pPacket + cbHeader + (start - offset), end - start);
+                written = true;
+            }
+        }
+        base += cbChannel;
+    }
+
+    if (!(flags & kDDPFlagPush))
+        return written ? Result::Staged : Result::Ignored;
+
+    // Everything written since the last push is shown together
+    const bool presented = PresentTogether(nowMicros, [](const Channel& channel) { return channel.protocol == Protocol::DDP; });
+
+    return presented ? Result::Presented : written ? Result::Staged : Result::Ignored;
+}
+
+// AcceptE131
+//
+// Data packets for a universe, and the sync packets that release the universes waiting on them
+
+LightingReceiver::Result LightingReceiver::AcceptE131(const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros)
+{
+    if (cbPacket < kE131RootSize ||
+        WORDFromMemoryBE(&pPacket[0]) != 0x0010 ||                                  // Preamble size
+        WORDFromMemoryBE(&pPacket[2]) != 0x0000 ||                                  // Postamble size
+        memcmp(&pPacket[4], kAcnPacketIdentifier, sizeof(kAcnPacketIdentifier)) != 0)
+    {
+        return Result::Malformed;
+    }
+
+    const uint32_t rootVector = DWORDFromMemoryBE(&pPacket[18]);
+    if (rootVector == kE131RootExtended)
+    {
+        // Universe discovery is the other extended packet, and is only of use to other controllers
+        if (cbPacket < kE131SyncSize || DWORDFromMemoryBE(&pPacket[40]) != kE131ExtendedSync)
+            return Result::Ignored;
+
+        Count(_syncPackets);
+        const uint16_t syncAddress = WORDFromMemoryBE(&pPacket[45]);
+
+        const bool presented = PresentTogether(nowMicros, [syncAddress](const Channel& channel)
+        {
+            return channel.wait == Wait::E131Sync && channel.syncAddress == syncAddress;
+        });
+        return presented ? Result::Presented : Result::Ignored;
+    }
+
+    if (rootVector != kE131RootData)
+        return Result::Ignored;
+
+    if (cbPacket < kE131DataHeaderSize ||
+        DWORDFromMemoryBE(&pPacket[40]) != kE131FramingData ||
+        pPacket[117] != kE131DmpSetProperty ||
+        pPacket[118] != kE131AddressType ||
+        WORDFromMemoryBE(&pPacket[119]) != 0 ||                                     // First property address
+        WORDFromMemoryBE(&pPacket[121]) != 1)                                       // Address increment
+    {
+        return Result::Malformed;
+    }
+
+    const uint16_t syncAddress = WORDFromMemoryBE(&pPacket[109]);
+    const uint8_t  sequence    = pPacket[111];
+    const uint8_t  options     = pPacket[112];
+    const uint16_t universe    = WORDFromMemoryBE(&pPacket[113]);
+    const uint16_t slots       = WORDFromMemoryBE(&pPacket[123]);
+
+    if (slots < 1 || slots > kE131MaxSlots || kE131DataHeaderSize - 1 + slots > cbPacket)
+        return Result::Malformed;
+
+    // Preview data is for visualizers, a terminated stream's last packets carry nothing to show, and a
+    // start code other than 0 isn't levels (0xDD is per-slot priority)
+    if ((options & (kE131OptionPreview | kE131OptionTerminated)) || pPacket[125] != 0)
+        return Result::Ignored;
+
+    return AcceptUniverse(Protocol::E131, universe, sequence, &pPacket[kE131DataHeaderSize], slots - 1,
+                          syncAddress ? Wait::E131Sync : Wait::Universes, syncAddress, nowMicros);
+}
+
+// AcceptArtNet
+//
+// ArtDmx for a universe, and ArtSync. ArtPoll isn't answered, so the device has to be added to the
+// controller by address rather than discovered.
+
+LightingReceiver::Result LightingReceiver::AcceptArtNet(const uint8_t * pPacket, size_t cbPacket, uint64_t nowMicros)
+{
+    if (cbPacket < 10 || memcmp(pPacket, kArtNetId, sizeof(kArtNetId)) != 0)
+        return Result::Malformed;
+
+    const uint16_t opcode = WORDFromMemory(&pPacket[8]);                         // The one little-endian field
+    if (opcode == kArtOpSync)
+    {
+        if (cbPacket < kArtSyncSize)
+            return Result::Malformed;
+
+        Count(_syncPackets);
+        _artSyncActive     = true;
+        _lastArtSyncMicros = nowMicros;
+
+        // ArtSync carries no address, so it ends whatever Art-Net frames are in progress
+        const bool presented = PresentTogether(nowMicros, [](const Channel& channel) { return channel.protocol == Protocol::ArtNet; });
+        return presented ? Result::Presented : Result::Ignored;
+    }
+
+    if (opcode != kArtOpDmx)
+        return Result::Ignored;
+
+    if (cbPacket < kArtDmxHeaderSize || WORDFromMemoryBE(&pPacket[10]) < kArtProtocolVersion)
+        return Result::Malformed;
+
+    const uint8_t  sequence = pPacket[12];
+    const uint16_t universe = pPacket[14] | (pPacket[15] & 0x7F) << 8;            // Net, Sub-Net and Universe: the 15-bit Port-Address
+    const uint16_t length   = WORDFromMemoryBE(&pPacket[16]);
+    if (length < 2 || length > 512 || kArtDmxHeaderSize + length > cbPacket)
+        return Result::Malformed;
+
+    // A sender that stops sending ArtSync goes back to showing universes as they arrive
+    if (_artSyncActive && nowMicros - _lastArtSyncMicros > kArtSyncTimeoutMicros)
+    {
+        _artSyncActive = false;
+        for (auto& channel : _channels)
+            if (channel.wait == Wait::ArtSync)
+                channel.wait = Wait::Universes;
+    }
+
+    return AcceptUniverse(Protocol::ArtNet, universe, sequence, &pPacket[kArtDmxHeaderSize], length,
+                          _artSyncActive ? Wait::ArtSync : Wait::Universes, 0, nowMicros);
+}
+
+LightingReceiver::Result LightingReceiver::AcceptUniverse(Protocol protocol, uint16_t universe, uint8_t sequence, const uint8_t * pData, size_t cbData,
+                                                          Wait wait, uint16_t syncAddress, uint64_t nowMicros)
+{
+    // Find the channel, and which of its universes this is
+    const uint16_t start = protocol == Protocol::ArtNet ? _artNetStartUniverse : _e131StartUniverse;
+    if (universe < start)
+        return Result::Ignored;
+
+    size_t iChannel = 0;
+    size_t iUniverse = universe - start;
+    size_t cUniverses = 0;
+    for (; iChannel < _cManagers; iChannel++)
+    {
+        cUniverses = UniverseCount(_pManagers[iChannel].LEDCount());
+        if (iUniverse < cUniverses)
+            break;
+        iUniverse -= cUniverses;
+    }
+    if (iChannel == _cManagers)
+        return Result::Ignored;
+
+    auto& channel = _channels[iChannel];
+    if (channel.protocol != protocol || channel.sequence.size() != cUniverses)
+    {
+        channel.protocol = protocol;
+        channel.sequence.assign(cUniverses, -1);
+    }
+
+    // Art-Net sends a sequence of 0 when it isn't numbering packets
+    if (protocol == Protocol::E131 || sequence != 0)
+    {
+        int16_t & last = channel.sequence[iUniverse];
+        if (last >= 0)
+        {
+            const int diff = static_cast<int8_t>(sequence - static_cast<uint8_t>(last));
+            if (diff <= 0 && diff > kSequenceRestart)
+                return Result::OutOfSequence;
+        }
+        last = sequence;
+    }
+
+    // Seeing a universe again before its frame is complete means the rest of that frame was lost, or
+    // its sync was; show what did arrive and start the next
+    bool presented = false;
+    if (channel.pFrame && iUniverse < channel.seen.size() && channel.seen[iUniverse])
+        presented = Present(iChannel, nowMicros);
+
+    if (!Touch(iChannel))
+        return Result::Ignored;
+
+    channel.wait        = wait;
+    channel.syncAddress = syncAddress;
+    Write(iChannel, iUniverse * kPixelsPerUniverse * sizeof(CRGB), pData, std::min(cbData, kPixelsPerUniverse * sizeof(CRGB)));
+    channel.seen[iUniverse] = 1;
+
+    // Universes without sync come in order, so the last one ends the frame whether or not the others
+    // all made it
+    if (wait == Wait::Universes && iUniverse + 1 == cUniverses)
+        presented = Present(iChannel, nowMicros) || presented;
+
+    return presented ? Result::Presented : Result::Staged;
+}
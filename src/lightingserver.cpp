@@ -0,0 +1,255 @@
+//+--------------------------------------------------------------------------
+//
+// File:        lightingserver.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Receives DDP, E1.31 and Art-Net over UDP; see lightingserver.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+#include "ledbuffer.h"
+#include "lightingserver.h"
+#include "nd_network.h"
+#include "systemcontainer.h"
+#include "taskmgr.h"   // SOCKET_STACK_SIZE / SOCKET_PRIORITY / SOCKET_CORE
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#if LIGHTING_PROTOCOLS_ENABLED
+
+namespace
+{
+    using Protocol = LightingReceiver::Protocol;
+
+    constexpr Protocol   kProtocols[] = { Protocol::DDP, Protocol::E131, Protocol::ArtNet };
+    constexpr NetworkPort kPorts[]    = { NetworkPort::DDP, NetworkPort::E131, NetworkPort::ArtNet };
+    constexpr const char* kNames[]    = { "DDP", "E1.31", "Art-Net" };
+
+    // lwIP has room for 8 IGMP groups by default, one of them all-hosts; universes past these need unicast
+    constexpr uint16_t kMaxMulticastUniverses = 7;
+}
+
+LightingServer::LightingServer()
+{
+    _pDatagram = make_unique_psram<uint8_t[]>(kMaxDatagram);
+}
+
+// ITaskService hooks
+//
+// Same task settings as the socket server. select() has a one second timeout so the task sees
+// ShouldShutdown() even when nothing is being sent.
+
+ITaskService::TaskConfig LightingServer::GetTaskConfig() const
+{
+    return TaskConfig {
+        "Lighting Server Loop",
+        SOCKET_STACK_SIZE,
+        SOCKET_PRIORITY,
+        SOCKET_CORE,
+        1500
+    };
+}
+
+void LightingServer::OnBeforeWaitForStop()
+{
+    release();
+}
+
+void LightingServer::release()
+{
+    for (auto& socket_fd : _socket_fds)
+    {
+        int fd = socket_fd.exchange(-1);
+        if (fd >= 0)
+            close(fd);
+    }
+}
+
+bool LightingServer::OpenSocket(size_t iProtocol, int port)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+    {
+        debugE("%s socket error\n", kNames[iProtocol]);
+        return false;
+    }
+
+    int opt = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)))
+    {
+        debugE("setsockopt SO_REUSEADDR failed on %s socket %d: %s (%d)", kNames[iProtocol], fd, strerror(errno), errno);
+        close(fd);
+        return false;
+    }
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0)
+    {
+        debugE("bind failed on %s port %d, socket %d: %s (%d)", kNames[iProtocol], port, fd, strerror(errno), errno);
+        close(fd);
+        return false;
+    }
+
+    _socket_fds[iProtocol].store(fd);
+    debugI("%s server %d listening on port %d", kNames[iProtocol], fd, port);
+    return true;
+}
+
+// JoinUniverses
+//
+// E1.31 multicasts each universe to 239.255.<universe high byte>.<universe low byte>
+
+void LightingServer::JoinUniverses(int fd)
+{
+    const uint16_t first = _pReceiver->FirstUniverse(Protocol::E131, 0);
+    const uint16_t end   = _pReceiver->FirstUniverse(Protocol::E131, g_ptrSystem->GetBufferManagers().size());
+
+    for (uint32_t universe = first; universe < end && universe < first + kMaxMulticastUniverses; universe++)
+    {
+        struct ip_mreq request;
+        memset(&request, 0, sizeof(request));
+        request.imr_multiaddr.s_addr = htonl(0xEFFF0000 | universe);
+        request.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request)) < 0)
+            debugW("Unable to join the multicast group for E1.31 universe %lu: %s (%d)", (unsigned long)universe, strerror(errno), errno);
+    }
+
+    if (end - first > kMaxMulticastUniverses)
+        debugW("E1.31 universes %u and up must be sent unicast", (unsigned)(first + kMaxMulticastUniverses));
+}
+
+bool LightingServer::begin()
+{
+    for (size_t i = 0; i < std::size(kPorts); i++)
+    {
+        if (!OpenSocket(i, kPorts[i]))
+        {
+            release();
+            return false;
+        }
+    }
+
+    JoinUniverses(_socket_fds[static_cast<size_t>(Protocol::E131)].load());
+    return true;
+}
+
+// LightingServer::Run
+//
+// Opens the sockets whenever WiFi is up and feeds every datagram on any of them to the receiver
+
+void LightingServer::Run()
+{
+    if (!_pReceiver)
+    {
+        auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+        _pReceiver = make_unique_internal<LightingReceiver>(bufferManagers.data(), bufferManagers.size(),
+                                                            LIGHTING_START_UNIVERSE, LIGHTING_ARTNET_START_UNIVERSE);
+    }
+
+    while (!ShouldShutdown())
+    {
+        if (!nd_network::IsWiFiConnected())
+        {
+            delay(500);
+            continue;
+        }
+
+        release();
+        if (!begin())
+        {
+            debugE("Failed to start lighting server, retrying in 5 seconds...");
+            delay(5000);
+            continue;
+        }
+
+        while (!ShouldShutdown())
+        {
+            fd_set readable;
+            FD_ZERO(&readable);
+            int maxFd = -1;
+            for (auto& socket_fd : _socket_fds)
+            {
+                const int fd = socket_fd.load();
+                if (fd >= 0)
+                {
+                    FD_SET(fd, &readable);
+                    maxFd = std::max(maxFd, fd);
+                }
+            }
+            if (maxFd < 0)
+                break;
+
+            struct timeval to;
+            to.tv_sec = 1;
+            to.tv_usec = 0;
+            const int ready = select(maxFd + 1, &readable, nullptr, nullptr, &to);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                debugE("Lighting server select failed: %s (%d)", strerror(errno), errno);
+                break;
+            }
+            if (ready == 0)
+            {
+                if (!nd_network::IsWiFiConnected())
+                    break;
+                continue;
+            }
+
+            for (size_t i = 0; i < std::size(kProtocols); i++)
+            {
+                const int fd = _socket_fds[i].load();
+                if (fd < 0 || !FD_ISSET(fd, &readable))
+                    continue;
+
+                const int cbRead = recvfrom(fd, _pDatagram.get(), kMaxDatagram, MSG_DONTWAIT, nullptr, nullptr);
+                if (cbRead < 0)
+                    continue;
+
+                // The receiver holds each channel's reservation between packets, so the lock is taken for
+                // every packet, just as ProcessIncomingData() takes it for every frame
+                std::lock_guard guard(g_buffer_mutex);
+                _pReceiver->Accept(kProtocols[i], _pDatagram.get(), cbRead, LEDBufferManager::ClockMicros());
+            }
+        }
+        delay(500);
+    }
+
+    release();
+}
+
+#endif
@@ -196,9 +196,11 @@
 #include "jsonserializer.h"
 #include "ledbuffer.h"
 #include "ledstripeffect.h"
+#include "lightingserver.h"
 #include "logger.h"
 #include "nd_network.h"
 #include "ntptimeclient.h"
+#include "outputservice.h"
 #include "remotecontrol.h"
 #include "renderservice.h"
 #include "screen.h"
@@ -206,6 +208,7 @@
 #include "soundanalyzer.h"
 #include "systemcontainer.h"
 #include "taskmgr.h"
+#include "udpserver.h"
 #if ENABLE_WEBSERVER
 #include "webserver.h"
 #endif
@@ -248,6 +251,7 @@ void onReceiveESPNOW(const uint8_t *macAddr, const uint8_t *data, int dataLen);
 
 DRAM_ATTR std::unique_ptr<SystemContainer> g_ptrSystem;
 DRAM_ATTR std::mutex g_buffer_mutex;
+DRAM_ATTR std::mutex g_publish_mutex;
 DRAM_ATTR std::recursive_mutex g_render_mutex;
 DRAM_ATTR std::recursive_mutex g_effect_manager_mutex;
 
@@ -513,6 +517,14 @@ void setup()
         g_ptrSystem->SetupSocketServer(NetworkPort::IncomingWiFi, g_ptrSystem->GetDeviceConfig().GetActiveLEDCount());  // $C000 is free RAM on the C64, fwiw!
     #endif
 
+    #if UDP_PIXEL_SERVER_ENABLED
+        g_ptrSystem->SetupUdpServer(NetworkPort::IncomingWiFi);                                                          // Same port number, over UDP
+    #endif
+
+    #if LIGHTING_PROTOCOLS_ENABLED
+        g_ptrSystem->SetupLightingServer();                                                                              // DDP, E1.31 and Art-Net
+    #endif
+
     #if ENABLE_WIFI && ENABLE_WEBSERVER
         g_ptrSystem->SetupWebServer();
 
@@ -706,6 +718,12 @@ void setup()
 
     // Start things that do not depend on the network
 
+    // The output task goes first so the render task's first frame has somewhere to go
+
+    #if USE_STRIP && ASYNC_STRIP_OUTPUT
+        g_ptrSystem->SetupOutputService().Start();
+    #endif
+
     g_ptrSystem->SetupRenderService().Start();
 
     #if USE_SCREEN
@@ -746,6 +764,14 @@ void setup()
         if (g_ptrSystem->HasSocketServer())
             g_ptrSystem->GetSocketServer().Start();
     #endif
+    #if UDP_PIXEL_SERVER_ENABLED
+        if (g_ptrSystem->HasUdpServer())
+            g_ptrSystem->GetUdpServer().Start();
+    #endif
+    #if LIGHTING_PROTOCOLS_ENABLED
+        if (g_ptrSystem->HasLightingServer())
+            g_ptrSystem->GetLightingServer().Start();
+    #endif
     #if ENABLE_WIFI
         g_ptrSystem->SetupDebugConsole().Start();
     #endif
@@ -855,10 +881,7 @@ void loop()
 
             #if INCOMING_WIFI_ENABLED
                 auto& bufferManager = g_ptrSystem->GetBufferManagers()[0];
-                {
-                    std::lock_guard guard(g_buffer_mutex);
-                    strOutput += str_sprintf("Buffer: %zu/%zu, ", (size_t)bufferManager.Depth(), (size_t)bufferManager.BufferCount());
-                }
+                strOutput += str_sprintf("Buffer: %zu/%zu, ", (size_t)bufferManager.Depth(), (size_t)bufferManager.BufferCount());
             #endif
 
             const auto& taskManager = g_ptrSystem->GetTaskManager();
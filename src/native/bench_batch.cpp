@@ -0,0 +1,377 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_batch.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite batch: checks WIFI_COMMAND_PIXELBATCH64 decoding,
+//    with tables that share, skip and overrun pixels, channels the device
+//    doesn't have and a Reconfigure() mid-receive. Then a receiver thread
+//    queues batches against a render thread taking due frames the way
+//    WiFiDraw() does; every pass must find the same frame on every
+//    channel, and the same is counted for frames queued one channel at a
+//    time. Finally it times publishing a frame to every channel, batched
+//    against one commit per channel, and compares their bytes on the wire.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "pixelbatch.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    constexpr size_t   kStressChannels = 4;
+    constexpr uint32_t kStressLeds     = 64;
+    constexpr uint32_t kStressFrames   = 50000;
+    constexpr uint64_t kFarFuture      = 3600ULL * MICROS_PER_SECOND;   // Every queued frame is due by then
+    constexpr size_t   kTimedChannels  = 8;
+
+    struct PublishResult
+    {
+        const char* name;
+        FrameStats  publish;
+        size_t      wireBytes;
+        size_t      responses;
+    };
+
+    constexpr const char* kSuite = "batch";
+
+    std::vector<LEDBufferManager> MakeManagers(const std::vector<uint32_t>& leds, uint32_t cSlots)
+    {
+        std::vector<LEDBufferManager> managers;
+        managers.reserve(leds.size());
+        for (auto count : leds)
+            managers.emplace_back(cSlots, std::make_shared<WS281xGFX>(count, 1));
+        return managers;
+    }
+
+    // Every pixel carries its frame and channel, so a pass that mixes frames shows up
+
+    CRGB PixelFor(uint32_t id, size_t channel, uint32_t i)
+    {
+        return CRGB(static_cast<uint8_t>(id), static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(channel * 64 + i));
+    }
+
+    // The frame id every pixel of a buffer agrees on, or -1
+
+    int64_t FrameId(const LEDBuffer& buffer, size_t channel, uint32_t leds)
+    {
+        const uint32_t id = buffer.Pixels()[0].r | buffer.Pixels()[0].g << 8;
+        for (uint32_t i = 0; i < leds; i++)
+            if (buffer.Pixels()[i] != PixelFor(id, channel, i))
+                return -1;
+        return id;
+    }
+
+    struct Entry
+    {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    std::vector<uint8_t> MakeTable(const std::vector<Entry>& entries)
+    {
+        std::vector<uint8_t> table(PixelBatch::TableSize(entries.size()));
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            memcpy(&table[i * PixelBatch::kEntrySize],     &entries[i].offset, sizeof(uint32_t));
+            memcpy(&table[i * PixelBatch::kEntrySize + 4], &entries[i].count,  sizeof(uint32_t));
+        }
+        return table;
+    }
+
+    int CheckTables()
+    {
+        int failures = 0;
+        size_t packetSize = 0;
+        bool inOrder = false;
+
+        failures += Check(kSuite, !PixelBatch::CheckedPacketSize(0, 10, packetSize), "batch with no entries accepted");
+        failures += Check(kSuite, !PixelBatch::CheckedPacketSize(PixelBatch::kMaxEntries + 1, 10, packetSize), "batch with too many entries accepted");
+        failures += Check(kSuite, PixelBatch::CheckedPacketSize(3, 10, packetSize) && packetSize == 24 + 3 * 8 + 10 * 3, "batch packet size");
+        failures += Check(kSuite, !PixelBatch::CheckedPacketSize(16, UINT32_MAX, packetSize) || packetSize > UINT32_MAX, "batch packet size wrapped");
+
+        auto table = MakeTable({ { 0, 10 }, { 0, 0 }, { 12, 5 }, { 17, 3 } });
+        failures += Check(kSuite, PixelBatch::CheckTable(table.data(), 4, 20, inOrder) && inOrder, "in-order table with a gap rejected or out of order");
+        failures += Check(kSuite, !PixelBatch::CheckTable(table.data(), 4, 19, inOrder), "entry past the pixels accepted");
+
+        table = MakeTable({ { 5, 5 }, { 0, 5 } });
+        failures += Check(kSuite, PixelBatch::CheckTable(table.data(), 2, 10, inOrder) && !inOrder, "backwards table taken as in order");
+
+        table = MakeTable({ { 0, 6 }, { 4, 6 } });
+        failures += Check(kSuite, PixelBatch::CheckTable(table.data(), 2, 10, inOrder) && !inOrder, "overlapping table taken as in order");
+
+        table = MakeTable({ { UINT32_MAX, 2 } });
+        failures += Check(kSuite, !PixelBatch::CheckTable(table.data(), 1, 10, inOrder), "entry wrapping past the end accepted");
+        return failures;
+    }
+
+    // Decodes batches into three channels, as ProcessIncomingData() does with one already in memory
+
+    int CheckDecode()
+    {
+        int failures = 0;
+        auto managers = MakeManagers({ 40, 25, 60 }, 4);
+
+        std::vector<CRGB> pixels(100);
+        for (size_t i = 0; i < pixels.size(); i++)
+            pixels[i] = CRGB(i, 255 - i, i * 3);
+
+        // Channel 1 shares channel 0's pixels, channel 2 is left alone, and channel 3 doesn't exist
+        auto table = MakeTable({ { 10, 40 }, { 10, 20 }, { 0, 0 }, { 50, 50 } });
+        bool inOrder = false;
+        failures += Check(kSuite, PixelBatch::CheckTable(table.data(), 4, pixels.size(), inOrder), "decode table rejected");
+
+        {
+            std::lock_guard guard(g_buffer_mutex);
+            PixelBatch batch(managers.data(), managers.size(), BufferReservation::Socket);
+            failures += Check(kSuite, batch.Reserve(table.data(), 4), "decode batch not reserved");
+            failures += Check(kSuite, batch.Target(0) && batch.Target(1) && !batch.Target(2) && !batch.Target(3), "wrong channels reserved");
+            batch.Fill(table.data(), reinterpret_cast<const uint8_t *>(pixels.data()));
+            failures += Check(kSuite, batch.Commit(7, 500, LEDBufferManager::ClockMicros()) == 0, "batch not queued from channel 0");
+        }
+
+        auto p0 = managers[0].GetOldestBuffer();
+        auto p1 = managers[1].GetOldestBuffer();
+        failures += Check(kSuite, p0 && p0->Length() == 40 && p0->Seconds() == 7 && p0->MicroSeconds() == 500 &&
+                          memcmp(p0->Pixels(), &pixels[10], 40 * sizeof(CRGB)) == 0, "channel 0 frame wrong");
+        failures += Check(kSuite, p1 && p1->Length() == 20 && p1->Seconds() == 7 &&
+                          memcmp(p1->Pixels(), &pixels[10], 20 * sizeof(CRGB)) == 0, "channel 1 frame wrong");
+        failures += Check(kSuite, managers[2].IsEmpty(), "channel 2 queued a frame it wasn't sent");
+
+        uint64_t due0 = 0, due1 = 0;
+        {
+            std::lock_guard guard(g_buffer_mutex);
+            PixelBatch batch(managers.data(), managers.size(), BufferReservation::Socket);
+            batch.Reserve(table.data(), 2);
+            batch.Fill(table.data(), reinterpret_cast<const uint8_t *>(pixels.data()));
+            batch.Commit(8, 0, LEDBufferManager::ClockMicros());
+        }
+        failures += Check(kSuite, managers[0].PeekOldestDue(due0) && managers[1].PeekOldestDue(due1) && due0 == due1, "batched frames due at different times");
+        managers[0].GetOldestBuffer();
+        managers[1].GetOldestBuffer();
+
+        // One channel too short for its entry rejects the whole batch before anything is reserved
+        table = MakeTable({ { 0, 40 }, { 0, 26 } });
+        {
+            std::lock_guard guard(g_buffer_mutex);
+            PixelBatch batch(managers.data(), managers.size(), BufferReservation::Socket);
+            failures += Check(kSuite, !batch.Reserve(table.data(), 2), "entry longer than its channel accepted");
+            failures += Check(kSuite, !batch.Target(0) && batch.Commit(9, 0, LEDBufferManager::ClockMicros()) < 0, "rejected batch queued");
+        }
+        failures += Check(kSuite, managers[0].IsEmpty() && managers[1].IsEmpty(), "rejected batch left frames behind");
+
+        // A channel reconfigured mid-receive is dropped, and the rest still go
+        table = MakeTable({ { 0, 40 }, { 0, 25 }, { 0, 60 } });
+        {
+            PixelBatch batch(managers.data(), managers.size(), BufferReservation::Socket);
+            {
+                std::lock_guard guard(g_buffer_mutex);
+                batch.Reserve(table.data(), 3);
+            }
+            batch.Fill(table.data(), reinterpret_cast<const uint8_t *>(pixels.data()));
+            managers[1].Reconfigure(std::make_shared<WS281xGFX>(25, 1));
+
+            std::lock_guard guard(g_buffer_mutex);
+            failures += Check(kSuite, batch.Commit(10, 0, LEDBufferManager::ClockMicros()) == 0, "batch lost with one channel reconfigured");
+        }
+        failures += Check(kSuite, managers[0].Depth() == 1 && managers[1].IsEmpty() && managers[2].Depth() == 1, "reconfigured channel queued a stale frame");
+        return failures;
+    }
+
+    // A receiver thread queueing frames on every channel against a render thread taking the due ones
+    // under g_publish_mutex. Returns how many passes found different frames on different channels.
+
+    uint32_t CountTornPasses(bool batched, uint32_t frames, int& failures)
+    {
+        std::vector<uint32_t> leds(kStressChannels, kStressLeds);
+        auto managers = MakeManagers(leds, 3);
+        std::atomic<bool> done { false };
+
+        std::thread receiver([&]()
+        {
+            std::array<std::shared_ptr<LEDBuffer>, kStressChannels> buffers;
+            for (uint32_t id = 1; id <= frames; id++)
+            {
+                const uint64_t now = LEDBufferManager::ClockMicros();
+                std::lock_guard guard(g_buffer_mutex);
+                for (size_t c = 0; c < kStressChannels; c++)
+                {
+                    buffers[c] = managers[c].ReserveBuffer(BufferReservation::Incoming);
+                    for (uint32_t i = 0; i < kStressLeds; i++)
+                        buffers[c]->Pixels()[i] = PixelFor(id, c, i);
+                    buffers[c]->SetFrame(now / MICROS_PER_SECOND, now % MICROS_PER_SECOND + 1, kStressLeds);
+                    if (!batched)
+                        managers[c].CommitBuffer(buffers[c], now);
+                }
+                if (batched)
+                    LEDBufferManager::CommitBuffers(managers.data(), managers.size(), buffers.data(), now);
+            }
+            done = true;
+        });
+
+        uint32_t torn = 0, passes = 0;
+        std::array<std::shared_ptr<LEDBuffer>, kStressChannels> due;
+        for (bool finished = false; !finished; )
+        {
+            finished = done;
+            {
+                std::lock_guard guard(g_publish_mutex);
+                const uint64_t now = LEDBufferManager::ClockMicros() + kFarFuture;
+                for (size_t c = 0; c < kStressChannels; c++)
+                    due[c] = managers[c].GetDueBuffer(now);
+            }
+
+            int64_t first = -2;
+            bool tornPass = false;
+            for (size_t c = 0; c < kStressChannels; c++)
+            {
+                const int64_t id = due[c] ? FrameId(*due[c], c, kStressLeds) : 0;
+                if (id < 0)
+                    failures += Check(kSuite, false, "torn frame taken");
+                if (first == -2)
+                    first = id;
+                else if (id != first)
+                    tornPass = true;
+            }
+            torn += tornPass;
+            passes += first > 0;
+        }
+        receiver.join();
+
+        failures += Check(kSuite, passes > 0, "render thread never took a frame");
+        return torn;
+    }
+
+    // Publishes one frame to every channel and takes them back off, batched or one commit per channel
+
+    PublishResult RunPublish(const BenchOptions& options, const char* name, bool batched)
+    {
+        const uint32_t leds = MATRIX_WIDTH * MATRIX_HEIGHT;
+        std::vector<uint32_t> channelLeds(kTimedChannels, leds);
+        auto managers = MakeManagers(channelLeds, 4);
+        std::vector<CRGB> packet(leds, CRGB(1, 2, 3));
+        std::array<std::shared_ptr<LEDBuffer>, kTimedChannels> buffers;
+
+        PublishResult result { name };
+        result.publish = TimeFrames(options, [&]()
+        {
+            const uint64_t now = LEDBufferManager::ClockMicros();
+            std::lock_guard guard(g_buffer_mutex);
+            for (size_t c = 0; c < kTimedChannels; c++)
+            {
+                buffers[c] = managers[c].ReserveBuffer(BufferReservation::Incoming);
+                memcpy(buffers[c]->Pixels(), packet.data(), leds * sizeof(CRGB));
+                buffers[c]->SetFrame(now / MICROS_PER_SECOND, now % MICROS_PER_SECOND + 1, leds);
+                if (!batched)
+                    managers[c].CommitBuffer(buffers[c], now);
+            }
+            if (batched)
+                LEDBufferManager::CommitBuffers(managers.data(), managers.size(), buffers.data(), now);
+
+            std::lock_guard publish(g_publish_mutex);
+            for (auto& manager : managers)
+                KeepAlive(manager.GetDueBuffer(now + kFarFuture).get());
+        });
+
+        const size_t pixelBytes = kTimedChannels * leds * sizeof(CRGB);
+        result.wireBytes = batched ? PixelBatch::kHeaderSize + PixelBatch::TableSize(kTimedChannels) + pixelBytes
+                                   : kTimedChannels * LEDBuffer::kWireHeaderSize + pixelBytes;
+        result.responses = batched ? 1 : kTimedChannels;
+        return result;
+    }
+}
+
+int RunBatchSuite(const BenchOptions& options)
+{
+    int failures = CheckTables() + CheckDecode();
+
+    const uint32_t tornBatched  = CountTornPasses(true,  kStressFrames, failures);
+    const uint32_t tornSeparate = CountTornPasses(false, kStressFrames, failures);
+    failures += Check(kSuite, tornBatched == 0, str_sprintf("%u render passes found batched channels on different frames", tornBatched));
+
+    if (failures)
+    {
+        fprintf(stderr, "batch: not timing batches that don't hold up\n");
+        return failures;
+    }
+
+    const PublishResult results[] =
+    {
+        RunPublish(options, "channel", false),
+        RunPublish(options, "batch",   true),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]        = "batch";
+        doc["frames"]       = options.frames;
+        doc["failures"]     = failures;
+        doc["channels"]     = kTimedChannels;
+        doc["leds"]         = MATRIX_WIDTH * MATRIX_HEIGHT;
+        doc["tornBatched"]  = tornBatched;
+        doc["tornSeparate"] = tornSeparate;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["commit"]          = result.name;
+            entry["publishMeanUs"]   = result.publish.mean;
+            entry["publishMedianUs"] = result.publish.median;
+            entry["publishP99Us"]    = result.publish.p99;
+            entry["wireBytes"]       = result.wireBytes;
+            entry["responses"]       = result.responses;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        printf("render passes with channels on different frames, of %u frames on %zu channels: %u batched, %u one commit per channel\n\n",
+               kStressFrames, kStressChannels, tornBatched, tornSeparate);
+        printf("publishing a frame of %d LEDs to each of %zu channels\n\n", MATRIX_WIDTH * MATRIX_HEIGHT, kTimedChannels);
+        printf("%-8s %10s %10s %10s %12s %10s\n", "commit", "mean us", "median us", "p99 us", "wire bytes", "responses");
+        for (const auto& result : results)
+            printf("%-8s %10.2f %10u %10u %12zu %10zu\n", result.name, result.publish.mean, result.publish.median, result.publish.p99,
+                   result.wireBytes, result.responses);
+    }
+
+    return failures;
+}
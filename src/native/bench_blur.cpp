@@ -0,0 +1,254 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_blur.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite blur: checks that GFXBase::blur2d and every lane pack
+//    in blurkernels.h produce exactly the output of the original per-pixel
+//    CRGB kernel (kept here as the reference) over random frames, blur
+//    amounts, start offsets, odd sizes and both wirings. It then times a
+//    full-frame blur2d with the reference, the 32-bit SWAR pack and the
+//    native pack at 32x16, 64x32, 128x64 and 256x128.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "blurkernels.h"
+#include "gfxbase.h"
+#include "nd_bench.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    struct BlurResult
+    {
+        uint16_t   width;
+        uint16_t   height;
+        FrameStats reference;
+        FrameStats swar;
+        FrameStats native;
+    };
+
+    // The blurRows/blurColumns bodies as they were before the packed kernels, reaching xy() through
+    // an opaque device pointer the way the global XY() does
+
+    void ReferenceBlur2d(const GFXBase* device, CRGB* leds, uint16_t width, uint16_t firstColumn, uint16_t height, uint16_t firstRow, fract8 blur_amount)
+    {
+        uint8_t keep = 255 - blur_amount;
+        uint8_t seep = blur_amount >> 1;
+        for (uint16_t row = 0; row < height; row++)
+        {
+            CRGB carryover = CRGB::Black;
+            for (uint16_t i = firstColumn; i < width; i++)
+            {
+                CRGB cur = leds[device->xy(i, row)];
+                CRGB part = cur;
+                part.nscale8(seep);
+                cur.nscale8(keep);
+                cur += carryover;
+                if (i)
+                    leds[device->xy(i - 1, row)] += part;
+                leds[device->xy(i, row)] = cur;
+                carryover = part;
+            }
+        }
+        for (uint16_t col = 0; col < width; ++col)
+        {
+            CRGB carryover = CRGB::Black;
+            for (uint16_t i = firstRow; i < height; ++i)
+            {
+                CRGB cur = leds[device->xy(col, i)];
+                CRGB part = cur;
+                part.nscale8(seep);
+                cur.nscale8(keep);
+                cur += carryover;
+                if (i)
+                    leds[device->xy(col, i - 1)] += part;
+                leds[device->xy(col, i)] = cur;
+                carryover = part;
+            }
+        }
+    }
+
+    template <typename Lanes>
+    void LanesBlur2d(const GFXBase* device, CRGB* leds, uint16_t width, uint16_t firstColumn, uint16_t height, uint16_t firstRow, fract8 blur_amount)
+    {
+        device->WithXY([&](auto mapXY)
+        {
+            BlurLines<Lanes>(leds, height, width, firstColumn, blur_amount, [mapXY](uint16_t row, uint16_t i) { return mapXY(i, row); });
+            BlurLines<Lanes>(leds, width, height, firstRow, blur_amount, [mapXY](uint16_t col, uint16_t i) { return mapXY(col, i); });
+        });
+    }
+
+    void RandomFrame(CRGB* leds, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            leds[i] = CRGB(random8(), random8(), random8());
+
+        // Mostly-saturated frames exercise the qadd8 clamp, which random noise rarely reaches
+        if (random8() < 64)
+            for (size_t i = 0; i < count; i += 2)
+                leds[i] = CRGB::White;
+    }
+
+    int CheckSize(uint16_t width, uint16_t height, bool serpentine)
+    {
+        auto device = std::make_shared<WS281xGFX>(width, height);
+        device->ConfigureTopology(width, height, serpentine);
+        const size_t count = width * height;
+
+        std::vector<CRGB> source(count), expected(count), actual(count);
+        int failures = 0;
+
+        for (uint8_t amount : { 0, 1, 10, 27, 80, 128, 200, 254, 255 })
+        {
+            for (uint16_t first : { 0, 1, 3 })
+            {
+                RandomFrame(source.data(), count);
+                expected = source;
+                ReferenceBlur2d(device.get(), expected.data(), width, first, height, first, amount);
+
+                auto compare = [&](const char* kernel)
+                {
+                    if (actual == expected)
+                        return;
+                    fprintf(stderr, "blur: %s differs from the reference at %ux%u %s, amount %u, first column/row %u\n",
+                            kernel, width, height, serpentine ? "serpentine" : "linear", amount, first);
+                    failures++;
+                };
+
+                actual = source;
+                device->blur2d(actual.data(), width, first, height, first, amount);
+                compare("GFXBase::blur2d");
+
+                actual = source;
+                LanesBlur2d<BlurLanesScalar>(device.get(), actual.data(), width, first, height, first, amount);
+                compare("BlurLanesScalar");
+
+                actual = source;
+                LanesBlur2d<BlurLanesSWAR>(device.get(), actual.data(), width, first, height, first, amount);
+                compare("BlurLanesSWAR");
+
+                actual = source;
+                LanesBlur2d<BlurLanesNative>(device.get(), actual.data(), width, first, height, first, amount);
+                compare("BlurLanesNative");
+            }
+        }
+        return failures;
+    }
+
+    BlurResult RunSize(const BenchOptions& options, uint16_t width, uint16_t height)
+    {
+        auto device = std::make_shared<WS281xGFX>(width, height);
+        device->ConfigureTopology(width, height, true);
+        const GFXBase* volatile opaqueDevice = device.get();
+        RandomFrame(device->leds, width * height);
+
+        // Blurring the same buffer over and over decays it toward black, so every sample starts from
+        // a fresh copy of the same frame
+        std::vector<CRGB> source(device->leds, device->leds + width * height);
+        auto timeKernel = [&](auto kernel)
+        {
+            return TimeFrames(options, [&]()
+            {
+                std::copy(source.begin(), source.end(), device->leds);
+                kernel();
+                KeepAlive(device->leds[0]);
+            });
+        };
+
+        BlurResult result { width, height };
+        result.reference = timeKernel([&]() { ReferenceBlur2d(opaqueDevice, device->leds, width, 0, height, 1, 80); });
+        result.swar      = timeKernel([&]() { LanesBlur2d<BlurLanesSWAR>(opaqueDevice, device->leds, width, 0, height, 1, 80); });
+        result.native    = timeKernel([&]() { device->blur2d(device->leds, width, 0, height, 1, 80); });
+        return result;
+    }
+
+    double MegapixelsPerSecond(const BlurResult& result, const FrameStats& stats)
+    {
+        return stats.median ? static_cast<double>(result.width) * result.height / stats.median : 0.0;
+    }
+}
+
+int RunBlurSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    for (bool serpentine : { true, false })
+    {
+        failures += CheckSize(64, 32, serpentine);
+        failures += CheckSize(17, 9, serpentine);
+        failures += CheckSize(1, 5, serpentine);
+        failures += CheckSize(128, 64, serpentine);
+    }
+
+    const BlurResult results[] =
+    {
+        RunSize(options, 32, 16),
+        RunSize(options, 64, 32),
+        RunSize(options, 128, 64),
+        RunSize(options, 256, 128),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "blur";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["width"]             = result.width;
+            entry["height"]            = result.height;
+            entry["referenceMedianUs"] = result.reference.median;
+            entry["swarMedianUs"]      = result.swar.median;
+            entry["nativeMedianUs"]    = result.native.median;
+            entry["nativeMpixPerSec"]  = MegapixelsPerSecond(result, result.native);
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("equivalence: %s\n\n", failures ? "FAILED" : "bit-identical");
+        printf("%-9s %14s %14s %14s %12s\n", "matrix", "reference us", "swar us", "native us", "native Mpx/s");
+        for (const auto& result : results)
+        {
+            printf("%4ux%-4u %14u %14u %14u %12.1f\n",
+                   result.width, result.height,
+                   result.reference.median, result.swar.median, result.native.median,
+                   MegapixelsPerSecond(result, result.native));
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,673 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_delta.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite delta: round-trips WIFI_COMMAND_PIXELDELTA64 frames
+//    through PixelDelta and DeltaSequence the way the socket server
+//    receives them, fed in random slices into LEDBufferManager's reserved
+//    spare, and checks every queued frame is the one encoded. It checks a
+//    lost frame, a full frame queued in between and Reconfigure() each
+//    make deltas wait for the next keyframe, that a delta still applies to
+//    the frame sent once its buffer has been drawn and written over by
+//    another receiver, and that runs past the end of the frame are
+//    refused. It then reports bytes per frame and receive time for full
+//    and delta frames of mostly static, twinkling and scrolling content.
+//
+//    --capture FILE replays a stream written by
+//    "tools/pixeldelta.py --write-stream", in which each delta packet is
+//    followed by the same frame as a full WIFI_COMMAND_PIXELDATA64 packet,
+//    and checks the two agree.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <ArduinoJson.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "byte_utils.h"
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "pixeldelta.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    constexpr uint32_t kRingSize         = 8;
+    constexpr uint32_t kKeyframeInterval = 30;
+    constexpr uint32_t kMaxRun           = 0xFFFF;
+    constexpr size_t   kCycleFrames      = 90;      // Frames timed in a loop; a multiple of the keyframe interval
+    constexpr size_t   kWholePacket      = SIZE_MAX;
+
+    enum class Received { Applied, Refused, Malformed };
+
+    struct ContentResult
+    {
+        const char* name;
+        double      fullBytes;
+        double      deltaBytes;
+        FrameStats  full;
+        FrameStats  delta;
+    };
+
+    constexpr const char* kSuite = "delta";
+
+    void WriteHeader(std::vector<uint8_t>& packet, uint16_t command, uint16_t channel, uint32_t leds, uint64_t seconds, uint64_t micros)
+    {
+        packet.resize(LEDBuffer::kWireHeaderSize);
+        memcpy(&packet[0],  &command, sizeof(command));
+        memcpy(&packet[2],  &channel, sizeof(channel));
+        memcpy(&packet[4],  &leds,    sizeof(leds));
+        memcpy(&packet[8],  &seconds, sizeof(seconds));
+        memcpy(&packet[16], &micros,  sizeof(micros));
+    }
+
+    template <typename T>
+    void Append(std::vector<uint8_t>& packet, T value)
+    {
+        const auto* p = reinterpret_cast<const uint8_t*>(&value);
+        packet.insert(packet.end(), p, p + sizeof(value));
+    }
+
+    // DeltaEncoder
+    //
+    // tools/pixeldelta.py's encoder: runs of changed pixels with one-pixel gaps folded in, and a keyframe
+    // to start with, every kKeyframeInterval frames, and whenever it's no bigger than the delta
+
+    class DeltaEncoder
+    {
+      public:
+
+        DeltaEncoder(uint32_t leds, uint16_t channel = 1) : _leds(leds), _channel(channel), _black(leds, CRGB::Black) {}
+
+        void Resync() { _previous.clear(); }
+
+        std::vector<uint8_t> Encode(const std::vector<CRGB>& frame, uint64_t seconds, uint64_t micros)
+        {
+            std::vector<uint8_t> runs, pixels;
+            EncodeRuns(_black, frame, runs, pixels);
+            uint16_t flags = PixelDelta::kKeyframe;
+
+            if (!_previous.empty() && _sinceKeyframe + 1 < kKeyframeInterval)
+            {
+                std::vector<uint8_t> deltaRuns, deltaPixels;
+                EncodeRuns(_previous, frame, deltaRuns, deltaPixels);
+                if (deltaRuns.size() + deltaPixels.size() < runs.size() + pixels.size())
+                {
+                    flags = 0;
+                    runs.swap(deltaRuns);
+                    pixels.swap(deltaPixels);
+                }
+            }
+
+            _sinceKeyframe = (flags & PixelDelta::kKeyframe) ? 0 : _sinceKeyframe + 1;
+            _previous = frame;
+            _sequence++;
+
+            std::vector<uint8_t> packet;
+            WriteHeader(packet, WIFI_COMMAND_PIXELDELTA64, _channel, _leds, seconds, micros);
+            Append<uint32_t>(packet, _sequence);
+            Append<uint16_t>(packet, flags);
+            Append<uint16_t>(packet, runs.size() / PixelDelta::kRunSize);
+            packet.insert(packet.end(), runs.begin(), runs.end());
+            packet.insert(packet.end(), pixels.begin(), pixels.end());
+            return packet;
+        }
+
+      private:
+
+        void EncodeRuns(const std::vector<CRGB>& base, const std::vector<CRGB>& frame, std::vector<uint8_t>& runs, std::vector<uint8_t>& pixels) const
+        {
+            auto addRun = [&](uint32_t skip, uint32_t start, uint32_t count)
+            {
+                Append<uint16_t>(runs, skip);
+                Append<uint16_t>(runs, count);
+                const auto* p = reinterpret_cast<const uint8_t*>(&frame[start]);
+                pixels.insert(pixels.end(), p, p + count * sizeof(CRGB));
+            };
+
+            uint32_t position = 0;
+            for (uint32_t i = 0; i < _leds; )
+            {
+                if (frame[i] == base[i])
+                {
+                    i++;
+                    continue;
+                }
+
+                uint32_t end = i + 1;
+                while (end < _leds && (frame[end] != base[end] || (end + 1 < _leds && frame[end + 1] != base[end + 1])))
+                    end++;
+
+                uint32_t skip = i - position;
+                for (; skip > kMaxRun; skip -= kMaxRun)
+                    addRun(kMaxRun, i, 0);
+                for (uint32_t start = i; start < end; skip = 0)
+                {
+                    const uint32_t count = std::min(end - start, kMaxRun);
+                    addRun(skip, start, count);
+                    start += count;
+                }
+                position = i = end;
+            }
+        }
+
+        uint32_t          _leds;
+        uint16_t          _channel;
+        std::vector<CRGB> _black;
+        std::vector<CRGB> _previous;
+        uint32_t          _sinceKeyframe = 0;
+        uint32_t          _sequence = 0;
+    };
+
+    // ReceiveDelta
+    //
+    // SocketServer::ReceivePixelDelta() for one channel, with the packet's changed pixels fed in random
+    // slices of at most maxSlice bytes as the socket would hand them over, or all at once for kWholePacket
+
+    Received ReceiveDelta(LEDBufferManager& manager, DeltaSequence& sequence, const uint8_t* pPacket, size_t maxSlice, std::minstd_rand& rng)
+    {
+        const uint16_t channel16 = WORDFromMemory(pPacket + 2);
+        const uint32_t length32  = DWORDFromMemory(pPacket + 4);
+        const uint64_t seconds   = ULONGFromMemory(pPacket + 8);
+        const uint64_t micros    = ULONGFromMemory(pPacket + 16);
+        const uint32_t frame     = DWORDFromMemory(pPacket + 24);
+        const uint16_t flags     = WORDFromMemory(pPacket + 28);
+        const uint16_t runCount  = WORDFromMemory(pPacket + 30);
+        const uint8_t* pRuns     = pPacket + PixelDelta::kHeaderSize;
+
+        size_t changedPixels = 0;
+        if (length32 > manager.LEDCount() || !PixelDelta::CheckRuns(pRuns, runCount, length32, changedPixels))
+            return Received::Malformed;
+
+        auto pTarget = manager.ReserveBuffer(BufferReservation::Socket);
+        if (!sequence.PrepareBase(manager, channel16, frame, flags, length32, *pTarget))
+            return Received::Refused;
+
+        PixelDelta delta(pRuns, runCount, pTarget->Pixels());
+        const uint8_t* pPixels = pRuns + runCount * PixelDelta::kRunSize;
+        std::uniform_int_distribution<size_t> slice(1, maxSlice);
+        for (size_t cbLeft = changedPixels * sizeof(CRGB); cbLeft > 0; )
+        {
+            const size_t cb = maxSlice == kWholePacket ? cbLeft : std::min(cbLeft, slice(rng));
+            delta.Feed(pPixels, cb);
+            pPixels += cb;
+            cbLeft  -= cb;
+        }
+
+        pTarget->SetFrame(seconds, micros, length32);
+        if (!manager.CommitBuffer(pTarget))
+        {
+            sequence.Reset();
+            return Received::Refused;
+        }
+        sequence.Committed(manager, channel16, frame, *pTarget);
+        return Received::Applied;
+    }
+
+    // SocketServer::ReceivePixelData() for one channel
+
+    bool ReceiveFull(LEDBufferManager& manager, const CRGB* pPixels, uint32_t leds, uint64_t seconds, uint64_t micros)
+    {
+        auto pTarget = manager.ReserveBuffer(BufferReservation::Socket);
+        memcpy(pTarget->Pixels(), pPixels, leds * sizeof(CRGB));
+        pTarget->SetFrame(seconds, micros, leds);
+        return manager.CommitBuffer(pTarget);
+    }
+
+    bool SameFrame(const std::shared_ptr<LEDBuffer>& pBuffer, const CRGB* pPixels, uint32_t leds)
+    {
+        return pBuffer && pBuffer->Length() == leds && memcmp(pBuffer->Pixels(), pPixels, leds * sizeof(CRGB)) == 0;
+    }
+
+    // The content deltas are sent for, and some they aren't much use for
+
+    enum class Content { Static, Twinkle, Scroll, Mixed };
+
+    void NextFrame(std::vector<CRGB>& frame, Content content, size_t n, std::minstd_rand& rng)
+    {
+        const uint32_t leds = frame.size();
+        std::uniform_int_distribution<uint32_t> pixel(0, leds - 1), byte(0, 255);
+        auto randomColor = [&]() { return CRGB(byte(rng), byte(rng), byte(rng)); };
+
+        if (content == Content::Mixed)
+            content = static_cast<Content>(n / 20 % 3);
+
+        switch (content)
+        {
+            case Content::Static:       // A clock or status display: a few dots move on a fixed background
+                for (uint32_t dot = 0; dot < 4; dot++)
+                {
+                    frame[(n * (dot + 1) * 7) % leds]       = CHSV(dot * 64, 255, 255);
+                    frame[((n + 1) * (dot + 1) * 7) % leds] = CRGB(10, 10, 10);
+                }
+                break;
+
+            case Content::Twinkle:      // About one pixel in fifty lights or fades each frame
+                for (uint32_t i = 0; i < leds / 50; i++)
+                    frame[pixel(rng)] = (i & 1) ? CRGB::Black : randomColor();
+                break;
+
+            case Content::Scroll:       // Everything moves along one pixel
+                std::rotate(frame.begin(), frame.begin() + 1, frame.end());
+                frame[leds - 1] = randomColor();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    int CheckRoundTrip(uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        DeltaSequence sequence;
+        DeltaEncoder encoder(leds);
+        std::minstd_rand rng(leds);
+        std::vector<CRGB> frame(leds, CRGB::Black);
+        int failures = 0;
+        uint32_t deltas = 0;
+
+        for (size_t n = 0; n < 400 && failures < 10; n++)
+        {
+            NextFrame(frame, Content::Mixed, n, rng);
+            const auto packet = encoder.Encode(frame, 100 + n / 30, 1 + n % 30 * 33333);
+            deltas += (WORDFromMemory(&packet[28]) & PixelDelta::kKeyframe) == 0;
+
+            if (ReceiveDelta(manager, sequence, packet.data(), 1 + n % 700, rng) != Received::Applied)
+                failures += Check(kSuite, false, str_sprintf("frame %zu of %u LEDs refused", n, leds).c_str());
+            else if (!SameFrame(manager.PeekNewestBuffer(), frame.data(), leds))
+                failures += Check(kSuite, false, str_sprintf("frame %zu of %u LEDs queued wrong", n, leds).c_str());
+
+            // The drawing side taking frames doesn't disturb what the next delta applies to
+            for (int draws = rng() % 3; draws > 0 && !manager.IsEmpty(); draws--)
+                manager.GetOldestBuffer()->DrawBuffer();
+        }
+
+        failures += Check(kSuite, deltas > 200, "the encoder hardly sent any deltas");
+        return failures;
+    }
+
+    int CheckResync(uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        DeltaSequence sequence;
+        DeltaEncoder encoder(leds);
+        std::minstd_rand rng(7);
+        std::vector<CRGB> frame(leds, CRGB::Black);
+        size_t n = 0;
+        int failures = 0;
+
+        // Encodes and receives frames until the next keyframe, which is received as well; returns how
+        // many of the deltas before it were applied
+        auto untilKeyframe = [&]()
+        {
+            int applied = 0;
+            for (uint32_t i = 0; i < kKeyframeInterval; i++)
+            {
+                NextFrame(frame, Content::Static, n++, rng);
+                const auto packet = encoder.Encode(frame, 0, n);
+                const auto received = ReceiveDelta(manager, sequence, packet.data(), 64, rng);
+                if (WORDFromMemory(&packet[28]) & PixelDelta::kKeyframe)
+                {
+                    failures += Check(kSuite, received == Received::Applied && SameFrame(manager.PeekNewestBuffer(), frame.data(), leds),
+                                      "keyframe after a break not applied");
+                    return applied;
+                }
+                applied += received == Received::Applied;
+            }
+            failures += Check(kSuite, false, "no keyframe within the keyframe interval");
+            return applied;
+        };
+        auto nextDelta = [&]()
+        {
+            NextFrame(frame, Content::Static, n++, rng);
+            return encoder.Encode(frame, 0, n);
+        };
+
+        untilKeyframe();
+
+        // A lost frame: nothing more applies until the keyframe, and deltas apply again after it
+        nextDelta();
+        failures += Check(kSuite, untilKeyframe() == 0, "a delta after a lost frame was applied");
+        auto packet = nextDelta();
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Applied, "delta after a keyframe refused");
+
+        // A full frame queued on the channel in between
+        const std::vector<CRGB> other(leds, CRGB::Red);
+        failures += Check(kSuite, ReceiveFull(manager, other.data(), leds, 0, 999999), "full frame refused");
+        packet = nextDelta();
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Refused, "delta applied over another frame");
+        failures += Check(kSuite, SameFrame(manager.PeekNewestBuffer(), other.data(), leds), "refused delta disturbed the queue");
+        untilKeyframe();
+
+        // The same sequence number twice, as a resent frame would be
+        packet = nextDelta();
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Applied, "delta refused");
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Refused, "delta applied twice");
+        untilKeyframe();
+
+        // A different channel mask
+        packet = nextDelta();
+        packet[2] = 2;
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Refused, "delta for another channel applied");
+        untilKeyframe();
+
+        // Reconfigure() empties the ring under the stream
+        manager.Reconfigure(device);
+        packet = nextDelta();
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Refused, "delta applied after Reconfigure()");
+        failures += Check(kSuite, manager.IsEmpty(), "refused delta queued a frame");
+        untilKeyframe();
+
+        // A sender that reconnects starts with a keyframe, which applies whatever came before
+        sequence.Reset();
+        encoder.Resync();
+        packet = nextDelta();
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, packet.data(), 64, rng) == Received::Applied, "keyframe after a reset refused");
+        failures += Check(kSuite, SameFrame(manager.PeekNewestBuffer(), frame.data(), leds), "keyframe after a reset queued wrong");
+
+        return failures;
+    }
+
+    // Once a frame is drawn its buffer goes back to the pool, and whichever receiver is handed it next
+    // writes over it without anything being queued; the next delta still applies to the frame as sent
+
+    int CheckBaseReuse(uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        DeltaSequence sequence;
+        DeltaEncoder encoder(leds);
+        std::minstd_rand rng(11);
+        std::vector<CRGB> frame(leds, CRGB::Black);
+        const std::vector<CRGB> scribble(leds, CRGB(0xDE, 0xAD, 0x42));
+        int failures = 0;
+
+        for (size_t n = 0; n < 100 && failures < 10; n++)
+        {
+            NextFrame(frame, Content::Twinkle, n, rng);
+            const auto packet = encoder.Encode(frame, 0, 1 + n);
+            if (ReceiveDelta(manager, sequence, packet.data(), kWholePacket, rng) != Received::Applied)
+            {
+                failures += Check(kSuite, false, str_sprintf("frame %zu refused after its base was reused", n).c_str());
+                continue;
+            }
+            if (!SameFrame(manager.PeekNewestBuffer(), frame.data(), leds))
+            {
+                failures += Check(kSuite, false, str_sprintf("frame %zu queued on a reused base", n).c_str());
+                continue;
+            }
+
+            auto pDrawn = manager.GetOldestBuffer();
+            pDrawn->DrawBuffer();
+
+            // The UDP server gets a buffer and fills it, but hasn't committed it yet; then the drawn buffer
+            // is handed out as well, as it would be once the render task moves on from it
+            auto pIncoming = manager.ReserveBuffer(BufferReservation::Incoming);
+            memcpy(pIncoming->Pixels(), scribble.data(), leds * sizeof(CRGB));
+            memcpy(pDrawn->Pixels(), scribble.data(), leds * sizeof(CRGB));
+        }
+        return failures;
+    }
+
+    int CheckMalformed(uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        DeltaSequence sequence;
+        std::minstd_rand rng(3);
+        int failures = 0;
+
+        auto keyframe = [&](std::initializer_list<std::pair<uint16_t, uint16_t>> runs)
+        {
+            std::vector<uint8_t> packet;
+            WriteHeader(packet, WIFI_COMMAND_PIXELDELTA64, 1, leds, 0, 1);
+            Append<uint32_t>(packet, 1);
+            Append<uint16_t>(packet, PixelDelta::kKeyframe);
+            Append<uint16_t>(packet, runs.size());
+            size_t changed = 0;
+            for (const auto& [skip, count] : runs)
+            {
+                Append<uint16_t>(packet, skip);
+                Append<uint16_t>(packet, count);
+                changed += count;
+            }
+            packet.resize(packet.size() + changed * sizeof(CRGB), 0x5A);
+            return packet;
+        };
+
+        const uint16_t last = leds - 1;
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, keyframe({ { last, 1 } }).data(), 64, rng) == Received::Applied,
+                          "run ending on the last pixel refused");
+        failures += Check(kSuite, manager.PeekNewestBuffer()->Pixels()[last] == CRGB(0x5A, 0x5A, 0x5A) && manager.PeekNewestBuffer()->Pixels()[0] == CRGB::Black,
+                          "keyframe didn't start from black");
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, keyframe({ { last, 2 } }).data(), 64, rng) == Received::Malformed,
+                          "run past the last pixel accepted");
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, keyframe({ { 0, 1 }, { last, 1 } }).data(), 64, rng) == Received::Malformed,
+                          "runs adding up past the last pixel accepted");
+        failures += Check(kSuite, ReceiveDelta(manager, sequence, keyframe({ { 0, 0 }, { 0, 0 } }).data(), 64, rng) == Received::Applied,
+                          "empty runs refused");
+        return failures;
+    }
+
+    // Replays tools/pixeldelta.py --write-stream output: each delta packet is followed by its full frame
+
+    int CheckCapture(const std::string& path, size_t& frames)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            fprintf(stderr, "delta: can't open capture %s\n", path.c_str());
+            return 1;
+        }
+
+        std::vector<uint8_t> bytes;
+        uint8_t chunk[4096];
+        for (size_t cb; (cb = fread(chunk, 1, sizeof(chunk), file)) > 0; )
+            bytes.insert(bytes.end(), chunk, chunk + cb);
+        fclose(file);
+
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        DeltaSequence sequence;
+        std::minstd_rand rng(1);
+        bool applied = false;
+        int failures = 0;
+        frames = 0;
+
+        for (size_t offset = 0; offset + PixelDelta::kHeaderSize <= bytes.size() && failures < 10; )
+        {
+            const uint8_t* pPacket = &bytes[offset];
+            const uint16_t command = WORDFromMemory(pPacket);
+            const uint32_t leds    = DWORDFromMemory(pPacket + 4);
+            size_t packetSize;
+
+            if (command == WIFI_COMMAND_PIXELDELTA64)
+            {
+                const uint16_t runCount = WORDFromMemory(pPacket + 30);
+                size_t changedPixels = 0;
+                packetSize = PixelDelta::kHeaderSize + runCount * PixelDelta::kRunSize;
+                if (offset + packetSize > bytes.size() ||
+                    !PixelDelta::CheckRuns(pPacket + PixelDelta::kHeaderSize, runCount, leds, changedPixels))
+                {
+                    return failures + Check(kSuite, false, "capture ends in a broken delta packet");
+                }
+                packetSize += changedPixels * sizeof(CRGB);
+                if (offset + packetSize > bytes.size())
+                    break;
+
+                const auto received = ReceiveDelta(manager, sequence, pPacket, 1460, rng);
+                if (received == Received::Malformed)
+                    return failures + Check(kSuite, false, str_sprintf("capture frame of %u LEDs doesn't fit the %dx%d matrix", leds, MATRIX_WIDTH, MATRIX_HEIGHT).c_str());
+                failures += Check(kSuite, received == Received::Applied, str_sprintf("capture delta %zu refused", frames).c_str());
+                applied = received == Received::Applied;
+                frames++;
+            }
+            else if (command == WIFI_COMMAND_PIXELDATA64)
+            {
+                packetSize = LEDBuffer::kWireHeaderSize + leds * sizeof(CRGB);
+                if (offset + packetSize > bytes.size())
+                    break;
+                if (applied && !SameFrame(manager.PeekNewestBuffer(), reinterpret_cast<const CRGB*>(pPacket + LEDBuffer::kWireHeaderSize), leds))
+                    failures += Check(kSuite, false, str_sprintf("capture delta %zu decoded differently from its full frame", frames - 1).c_str());
+                applied = false;
+            }
+            else
+                return failures + Check(kSuite, false, str_sprintf("capture has command %u at offset %zu", command, offset).c_str());
+
+            offset += packetSize;
+        }
+
+        return failures + Check(kSuite, frames > 0, "capture has no delta frames");
+    }
+
+    ContentResult RunContent(const BenchOptions& options, const char* name, Content content, uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager fullManager(kRingSize, device);
+        LEDBufferManager deltaManager(kRingSize, device);
+        DeltaSequence sequence;
+        DeltaEncoder encoder(leds);
+        std::minstd_rand rng(options.seed);
+
+        // One cycle of frames over a full picture to loop over, starting with a keyframe so the wrap back to
+        // it is seamless
+        std::vector<CRGB> frame(leds);
+        for (auto& pixel : frame)
+            pixel = CRGB(rng(), rng(), rng());
+
+        std::vector<std::vector<CRGB>> frames;
+        std::vector<std::vector<uint8_t>> packets;
+        for (size_t n = 0; n < kCycleFrames; n++)
+        {
+            NextFrame(frame, content, n, rng);
+            frames.push_back(frame);
+            packets.push_back(encoder.Encode(frame, 0, 0));
+        }
+
+        ContentResult result { name, double(LEDBuffer::kWireHeaderSize + leds * sizeof(CRGB)), 0, {}, {} };
+        for (const auto& packet : packets)
+            result.deltaBytes += packet.size();
+        result.deltaBytes /= packets.size();
+
+        size_t n = 0;
+        uint64_t micros = 0;
+        result.full = TimeFrames(options, [&]()
+        {
+            micros += 16667;
+            ReceiveFull(fullManager, frames[n++ % kCycleFrames].data(), leds, 0, micros);
+            KeepAlive(fullManager.PeekNewestBuffer()->Pixels()[0]);
+        });
+
+        // Renumber the cycle's packets as they go round, as the encoder would have
+        n = 0;
+        result.delta = TimeFrames(options, [&]()
+        {
+            auto& packet = packets[n % kCycleFrames];
+            const uint32_t frameNumber = n + 1;
+            micros += 16667;
+            memcpy(&packet[16], &micros, sizeof(micros));
+            memcpy(&packet[24], &frameNumber, sizeof(frameNumber));
+            ReceiveDelta(deltaManager, sequence, packet.data(), kWholePacket, rng);
+            KeepAlive(deltaManager.PeekNewestBuffer()->Pixels()[0]);
+            n++;
+        });
+
+        return result;
+    }
+}
+
+int RunDeltaSuite(const BenchOptions& options)
+{
+    const uint32_t leds = MATRIX_WIDTH * MATRIX_HEIGHT;
+
+    int failures = CheckRoundTrip(leds);
+    failures += CheckRoundTrip(leds / 3);
+    failures += CheckResync(leds);
+    failures += CheckBaseReuse(leds);
+    failures += CheckMalformed(leds);
+
+    size_t captureFrames = 0;
+    if (!options.capture.empty())
+        failures += CheckCapture(options.capture, captureFrames);
+
+    const ContentResult results[] =
+    {
+        RunContent(options, "static",  Content::Static,  leds),
+        RunContent(options, "twinkle", Content::Twinkle, leds),
+        RunContent(options, "scroll",  Content::Scroll,  leds),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "delta";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+        doc["leds"]     = leds;
+        if (!options.capture.empty())
+        {
+            doc["capture"]       = options.capture.c_str();
+            doc["captureFrames"] = captureFrames;
+        }
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["content"]       = result.name;
+            entry["fullBytes"]     = result.fullBytes;
+            entry["deltaBytes"]    = result.deltaBytes;
+            entry["fullMedianUs"]  = result.full.median;
+            entry["fullMeanUs"]    = result.full.mean;
+            entry["deltaMedianUs"] = result.delta.median;
+            entry["deltaMeanUs"]   = result.delta.mean;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        if (!options.capture.empty())
+            printf("capture: %zu delta frames from %s\n", captureFrames, options.capture.c_str());
+        printf("frames of %u LEDs, a keyframe every %u\n\n", leds, kKeyframeInterval);
+        printf("%-8s %11s %12s %8s %13s %14s\n", "content", "full bytes", "delta bytes", "ratio", "full mean us", "delta mean us");
+        for (const auto& result : results)
+            printf("%-8s %11.0f %12.0f %7.1f%% %13.2f %14.2f\n", result.name, result.fullBytes, result.deltaBytes,
+                   100.0 * result.deltaBytes / result.fullBytes, result.full.mean, result.delta.mean);
+    }
+
+    return failures;
+}
@@ -0,0 +1,683 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_inflate.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite inflate: feeds a stream of compressed ("DAVE")
+//    packets to the socket server's receive paths over a loopback socket,
+//    with a sender thread writing each packet a Wi-Fi segment at a time.
+//    The packets are received three ways: read and thrown away (the cost
+//    of the transfer alone), read whole and then expanded with
+//    Inflater::DecompressBuffer() and copied into an LEDBuffer (as the
+//    socket server used to), and inflated while they arrive straight into
+//    the LEDBuffer with Inflater's streaming calls. It reports how long
+//    each takes from asking for a packet to having the frame, and how
+//    many compressed bytes each holds at once.
+//
+//    --capture FILE replays a recorded socket stream; the sender-to-device
+//    payload of a port 49152 TCP session saved raw (Wireshark's "Follow
+//    TCP Stream", or tcpflow) is exactly that. Uncompressed packets in it
+//    are skipped. Without a capture the suite compresses its own stream of
+//    mostly dark, scrolling and twinkling frames. Either way it checks
+//    every packet comes back exactly, whichever way the stream is sliced,
+//    and that damaged packets are refused.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "byte_utils.h"
+#include "inflater.h"
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "socketserver.h"
+#include "ws281xgfx.h"
+
+extern "C"
+{
+    #include "uzlib/src/uzlib.h"
+}
+
+namespace
+{
+    struct Packet
+    {
+        std::vector<uint8_t> compressed;     // The zlib stream after the 16-byte header
+        std::vector<uint8_t> expanded;       // What it should inflate to; empty for captured packets
+        uint32_t             expandedSize;
+    };
+
+    constexpr size_t   kSegmentSize  = 1460;                    // One TCP segment over Wi-Fi
+    constexpr uint32_t kSegmentGapUs = 250;                     // Between segments; about 6 MB/s
+
+    // What the socket server's 24-byte header read takes of a compressed packet: its 16-byte header
+    // and the start of the zlib stream
+    constexpr size_t   kStreamPrefix = STANDARD_DATA_HEADER_SIZE - COMPRESSED_HEADER_SIZE;
+
+    struct InflateResult
+    {
+        FrameStats raw;                     // Asking for a packet to having read all of it
+        FrameStats staged;                  // ... to having the frame, read whole and then expanded
+        FrameStats streamed;                // ... to having the frame, expanded as it arrived
+        size_t     stagedBytes;             // Compressed bytes held at once
+        size_t     streamedBytes;
+    };
+
+    constexpr const char* kSuite = "inflate";
+
+    // zlib framing around uzlib's static-Huffman deflate, which is all DecompressBuffer needs to see
+
+    std::vector<uint8_t> Compress(const std::vector<uint8_t>& data)
+    {
+        std::vector<uzlib_hash_entry_t> hashTable(1 << 12);
+        uzlib_comp comp = {};
+        comp.dict_size  = 32768;
+        comp.hash_bits  = 12;
+        comp.hash_table = hashTable.data();
+
+        zlib_start_block(&comp.out);
+        uzlib_compress(&comp, data.data(), data.size());
+        zlib_finish_block(&comp.out);
+
+        std::vector<uint8_t> stream;
+        stream.reserve(comp.out.outlen + 6);
+        stream.push_back(0x78);                         // 32K window, no preset dictionary
+        stream.push_back(0x01);
+        stream.insert(stream.end(), comp.out.outbuf, comp.out.outbuf + comp.out.outlen);
+        free(comp.out.outbuf);
+
+        const uint32_t adler = uzlib_adler32(data.data(), data.size(), 1);
+        for (int shift = 24; shift >= 0; shift -= 8)
+            stream.push_back(static_cast<uint8_t>(adler >> shift));
+        return stream;
+    }
+
+    // A WIFI_COMMAND_PIXELDATA64 packet of a whole frame, as the sender compresses it
+
+    std::vector<uint8_t> MakeFrame(int kind, uint32_t frame)
+    {
+        const uint16_t command = WIFI_COMMAND_PIXELDATA64;
+        const uint16_t channel = 1;
+        const uint32_t leds = NUM_LEDS;
+        const uint64_t seconds = frame / 30, micros = frame % 30 * 33333;
+
+        std::vector<uint8_t> packet(STANDARD_DATA_HEADER_SIZE + leds * sizeof(CRGB));
+        memcpy(&packet[0],  &command, sizeof(command));
+        memcpy(&packet[2],  &channel, sizeof(channel));
+        memcpy(&packet[4],  &leds,    sizeof(leds));
+        memcpy(&packet[8],  &seconds, sizeof(seconds));
+        memcpy(&packet[16], &micros,  sizeof(micros));
+
+        auto pixels = reinterpret_cast<CRGB*>(&packet[STANDARD_DATA_HEADER_SIZE]);
+        for (uint32_t i = 0; i < leds; i++)
+        {
+            switch (kind)
+            {
+                case 0:  pixels[i] = (i % 97 == frame % 97) ? CRGB::White : CRGB::Black;                  break;     // Mostly dark
+                case 1:  pixels[i] = CRGB(CHSV(i + frame * 3, 255, 255));                                   break;     // Scrolling rainbow
+                default: pixels[i] = random8() < 40 ? CRGB(random8(), random8(), random8()) : CRGB::Black; break;     // Twinkles
+            }
+        }
+        return packet;
+    }
+
+    std::vector<Packet> SynthesizeStream(size_t frames)
+    {
+        std::vector<Packet> stream;
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            Packet packet;
+            packet.expanded = MakeFrame(frame % 3, frame);
+            packet.expandedSize = packet.expanded.size();
+            packet.compressed = Compress(packet.expanded);
+
+            // The sender falls back to an uncompressed packet when deflate doesn't pay, and the socket
+            // server refuses compressed ones that don't fit its buffer
+            if (COMPRESSED_HEADER_SIZE + packet.compressed.size() <= MAXIMUM_PACKET_SIZE)
+                stream.push_back(std::move(packet));
+        }
+        return stream;
+    }
+
+    // Walks a raw socket stream packet by packet, keeping the compressed ones
+
+    bool LoadCapture(const std::string& path, std::vector<Packet>& stream)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            fprintf(stderr, "inflate: can't open capture %s\n", path.c_str());
+            return false;
+        }
+
+        std::vector<uint8_t> bytes;
+        uint8_t chunk[4096];
+        for (size_t cb; (cb = fread(chunk, 1, sizeof(chunk), file)) > 0; )
+            bytes.insert(bytes.end(), chunk, chunk + cb);
+        fclose(file);
+
+        size_t offset = 0;
+        while (offset + COMPRESSED_HEADER_SIZE <= bytes.size())
+        {
+            const uint8_t* header = &bytes[offset];
+            size_t packetSize = 0;
+
+            if (DWORDFromMemory(header) == COMPRESSED_HEADER)
+            {
+                const uint32_t compressedSize = DWORDFromMemory(header + 4);
+                packetSize = COMPRESSED_HEADER_SIZE + compressedSize;
+                if (offset + packetSize > bytes.size())
+                    break;
+
+                Packet packet;
+                packet.compressed.assign(header + COMPRESSED_HEADER_SIZE, header + packetSize);
+                packet.expandedSize = DWORDFromMemory(header + 8);
+                stream.push_back(std::move(packet));
+            }
+            else if (offset + STANDARD_DATA_HEADER_SIZE <= bytes.size())
+            {
+                const uint16_t command = WORDFromMemory(header);
+                const uint32_t length = DWORDFromMemory(header + 4);
+                if (command == WIFI_COMMAND_PIXELDATA64)
+                    packetSize = STANDARD_DATA_HEADER_SIZE + static_cast<size_t>(length) * sizeof(CRGB);
+                else if (command == WIFI_COMMAND_PEAKDATA)
+                    packetSize = STANDARD_DATA_HEADER_SIZE + length;
+                else
+                {
+                    fprintf(stderr, "inflate: unknown packet at offset %zu of %s\n", offset, path.c_str());
+                    return false;
+                }
+            }
+            else
+                break;
+
+            offset += packetSize;
+        }
+
+        if (offset != bytes.size())
+            fprintf(stderr, "inflate: ignoring %zu bytes of partial packet at the end of %s\n", bytes.size() - offset, path.c_str());
+        if (stream.empty())
+        {
+            fprintf(stderr, "inflate: no compressed packets in %s\n", path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    int CheckStream(const std::vector<Packet>& stream)
+    {
+        int failures = 0;
+        std::vector<uint8_t> output(MAXIMUM_PACKET_SIZE + 1);
+
+        for (size_t i = 0; i < stream.size() && failures < 10; i++)
+        {
+            const auto& packet = stream[i];
+            if (packet.expandedSize > MAXIMUM_PACKET_SIZE || COMPRESSED_HEADER_SIZE + packet.compressed.size() > MAXIMUM_PACKET_SIZE)
+            {
+                failures += Check(kSuite, false, str_sprintf("packet %zu is bigger than the socket server accepts for this matrix", i).c_str());
+                continue;
+            }
+
+            if (!Inflater::DecompressBuffer(packet.compressed.data(), packet.compressed.size(), output.data(), packet.expandedSize))
+                failures += Check(kSuite, false, str_sprintf("packet %zu didn't decompress", i).c_str());
+            else if (!packet.expanded.empty() && memcmp(output.data(), packet.expanded.data(), packet.expandedSize) != 0)
+                failures += Check(kSuite, false, str_sprintf("packet %zu decompressed to different pixels", i).c_str());
+        }
+        return failures;
+    }
+
+    int CheckDamage(const Packet& packet)
+    {
+        int failures = 0;
+        std::vector<uint8_t> output(MAXIMUM_PACKET_SIZE + 1);
+
+        auto corrupt = packet.compressed;
+        corrupt.back() ^= 0x01;
+        failures += Check(kSuite, !Inflater::DecompressBuffer(corrupt.data(), corrupt.size(), output.data(), packet.expandedSize),
+                          "packet with a bad checksum accepted");
+
+        failures += Check(kSuite, !Inflater::DecompressBuffer(packet.compressed.data(), packet.compressed.size() / 2, output.data(), packet.expandedSize),
+                          "truncated packet accepted");
+
+        failures += Check(kSuite, !Inflater::DecompressBuffer(packet.compressed.data(), packet.compressed.size(), output.data(), packet.expandedSize - 3),
+                          "packet accepted at the wrong expanded size");
+
+        return failures;
+    }
+
+    // The wire form of a packet: the 16-byte compressed header, then the zlib stream
+
+    std::vector<uint8_t> MakeWire(const Packet& packet, uint32_t expandedSize, size_t padding = 0)
+    {
+        const uint32_t magic = COMPRESSED_HEADER;
+        const uint32_t compressedSize = packet.compressed.size() + padding;
+        const uint32_t reserved = 0;
+
+        std::vector<uint8_t> wire(COMPRESSED_HEADER_SIZE);
+        memcpy(&wire[0],  &magic,          sizeof(magic));
+        memcpy(&wire[4],  &compressedSize, sizeof(compressedSize));
+        memcpy(&wire[8],  &expandedSize,   sizeof(expandedSize));
+        memcpy(&wire[12], &reserved,       sizeof(reserved));
+        wire.insert(wire.end(), packet.compressed.begin(), packet.compressed.end());
+        wire.insert(wire.end(), padding, 0xA5);
+        return wire;
+    }
+
+    bool ReadAll(int socket, uint8_t* pDest, size_t cb)
+    {
+        while (cb > 0)
+        {
+            const ssize_t cbRead = read(socket, pDest, cb);
+            if (cbRead <= 0)
+                return false;
+            pDest += cbRead;
+            cb -= cbRead;
+        }
+        return true;
+    }
+
+    bool WriteAll(int socket, const uint8_t* pSource, size_t cb)
+    {
+        while (cb > 0)
+        {
+            const ssize_t cbWritten = write(socket, pSource, cb);
+            if (cbWritten <= 0)
+                return false;
+            pSource += cbWritten;
+            cb -= cbWritten;
+        }
+        return true;
+    }
+
+    // LoopbackSender
+    //
+    // The far end of a socket pair, writing packets from its own thread. Paced, it waits for the receiver
+    // to ask for each packet and trickles it out a segment at a time, the way frames arrive over Wi-Fi;
+    // otherwise it writes them all back to back in random slices, to land chunk boundaries anywhere.
+    // When it runs out of packets it closes its end, so a receiver waiting on a cut-off packet sees EOF.
+
+    class LoopbackSender
+    {
+      public:
+
+        LoopbackSender(const std::vector<std::vector<uint8_t>>& wire, size_t count, bool paced)
+            : _wire(wire), _count(count), _paced(paced)
+        {
+            int sockets[2] = { -1, -1 };
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+                return;
+            _receiver = sockets[0];
+            _sender = sockets[1];
+            _thread = std::thread([this]() { Run(); });
+        }
+
+        ~LoopbackSender()
+        {
+            // Closing our end first breaks a sender blocked on a full socket out of its write
+            if (_receiver >= 0)
+                close(_receiver);
+            if (_thread.joinable())
+                _thread.join();
+        }
+
+        int Socket() const
+        {
+            return _receiver;
+        }
+
+        void Request() const
+        {
+            const uint8_t go = 1;
+            WriteAll(_receiver, &go, sizeof(go));
+        }
+
+      private:
+
+        void Run()
+        {
+            for (size_t i = 0; i < _count; i++)
+            {
+                uint8_t go = 0;
+                if (_paced && !ReadAll(_sender, &go, sizeof(go)))
+                    break;
+
+                const auto& packet = _wire[i % _wire.size()];
+                for (size_t offset = 0; offset < packet.size(); )
+                {
+                    const size_t slice = std::min<size_t>(packet.size() - offset, _paced ? kSegmentSize : _slices(_random));
+                    if (!WriteAll(_sender, &packet[offset], slice))
+                        break;
+                    offset += slice;
+                    if (_paced && offset < packet.size())
+                        delayMicroseconds(kSegmentGapUs);
+                }
+            }
+            close(_sender);
+        }
+
+        const std::vector<std::vector<uint8_t>>& _wire;
+        size_t      _count;
+        bool        _paced;
+        std::minstd_rand _random;
+        std::uniform_int_distribution<size_t> _slices { 1, kSegmentSize };
+        int         _receiver = -1;
+        int         _sender = -1;
+        std::thread _thread;
+    };
+
+    // As the socket server did before streaming: the whole packet read, expanded, then copied into the ring
+
+    bool ReceiveStaged(int socket, std::vector<uint8_t>& staging, std::vector<uint8_t>& output, LEDBuffer& target)
+    {
+        uint8_t prefix[STANDARD_DATA_HEADER_SIZE];
+        if (!ReadAll(socket, prefix, sizeof(prefix)))
+            return false;
+
+        const uint32_t compressedSize = DWORDFromMemory(&prefix[4]);
+        const uint32_t expandedSize   = DWORDFromMemory(&prefix[8]);
+        if (compressedSize < kStreamPrefix || expandedSize > MAXIMUM_PACKET_SIZE)
+            return false;
+
+        staging.resize(compressedSize);
+        memcpy(staging.data(), &prefix[COMPRESSED_HEADER_SIZE], kStreamPrefix);
+        if (!ReadAll(socket, &staging[kStreamPrefix], compressedSize - kStreamPrefix))
+            return false;
+
+        return Inflater::DecompressBuffer(staging.data(), compressedSize, output.data(), expandedSize)
+            && target.UpdateFromWire(output.data(), expandedSize);
+    }
+
+    // SocketServer::ReceiveCompressedData() for a pixel packet: the same 24-byte header read, which takes
+    // the start of the zlib stream with it, handed to the same Inflater::BeginPacket(), then the header
+    // expanded on its own and the whole packet in place in the LEDBuffer
+
+    bool ReceiveStreamed(int socket, Inflater& inflater, LEDBuffer& target)
+    {
+        uint8_t prefix[STANDARD_DATA_HEADER_SIZE];
+        if (!ReadAll(socket, prefix, sizeof(prefix)))
+            return false;
+
+        const uint32_t expandedSize = DWORDFromMemory(&prefix[8]);
+        if (expandedSize < STANDARD_DATA_HEADER_SIZE || expandedSize > MAXIMUM_PACKET_SIZE)
+            return false;
+
+        if (!inflater.BeginPacket(socket, prefix, sizeof(prefix)))
+            return false;
+
+        uint8_t header[STANDARD_DATA_HEADER_SIZE];
+        if (!inflater.Inflate(header, header, sizeof(header)))
+            return false;
+
+        uint8_t* pPacket = target.WirePacket();
+        memcpy(pPacket, header, sizeof(header));
+        if (!inflater.Inflate(pPacket, pPacket + sizeof(header), expandedSize - sizeof(header)) || !inflater.Finish())
+            return false;
+
+        target.SetFrame(ULONGFromMemory(&header[8]), ULONGFromMemory(&header[16]), DWORDFromMemory(&header[4]));
+        return true;
+    }
+
+    // Pixel packets the socket server would expand into an LEDBuffer, with what they expand to filled in
+
+    std::vector<Packet> PixelPackets(const std::vector<Packet>& stream)
+    {
+        std::vector<Packet> pixels;
+        std::vector<uint8_t> output(MAXIMUM_PACKET_SIZE + 1);
+
+        for (const auto& packet : stream)
+        {
+            if (!Inflater::DecompressBuffer(packet.compressed.data(), packet.compressed.size(), output.data(), packet.expandedSize))
+                continue;
+
+            size_t pixelPacketSize = 0;
+            if (WORDFromMemory(&output[0]) != WIFI_COMMAND_PIXELDATA64 ||
+                !CheckedStandardPacketSize(DWORDFromMemory(&output[4]), sizeof(CRGB), pixelPacketSize) ||
+                pixelPacketSize != packet.expandedSize)
+            {
+                continue;
+            }
+
+            Packet pixel = packet;
+            pixel.expanded.assign(output.begin(), output.begin() + packet.expandedSize);
+            pixels.push_back(std::move(pixel));
+        }
+        return pixels;
+    }
+
+    bool SameFrame(const LEDBuffer& buffer, const Packet& packet)
+    {
+        const uint8_t* expanded = packet.expanded.data();
+        return buffer.Length() == DWORDFromMemory(&expanded[4])
+            && buffer.Seconds() == ULONGFromMemory(&expanded[8])
+            && buffer.MicroSeconds() == ULONGFromMemory(&expanded[16])
+            && memcmp(buffer.Pixels(), &expanded[STANDARD_DATA_HEADER_SIZE], packet.expandedSize - STANDARD_DATA_HEADER_SIZE) == 0;
+    }
+
+    int CheckLoopback(const std::vector<Packet>& pixels)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBuffer target(device);
+        auto inflater = std::make_unique<Inflater>();
+        int failures = 0;
+
+        // Every packet back to back, every third one padded past its checksum, which the receiver must
+        // skip to stay in step with the stream
+        std::vector<std::vector<uint8_t>> wire;
+        for (size_t i = 0; i < pixels.size(); i++)
+            wire.push_back(MakeWire(pixels[i], pixels[i].expandedSize, i % 3 == 2 ? Inflater::kChunkSize + 5 : 0));
+        {
+            LoopbackSender sender(wire, wire.size(), false);
+            for (size_t i = 0; i < pixels.size() && failures < 10; i++)
+            {
+                if (!ReceiveStreamed(sender.Socket(), *inflater, target))
+                    return failures + Check(kSuite, false, str_sprintf("packet %zu didn't inflate off the socket", i).c_str());
+                failures += Check(kSuite, SameFrame(target, pixels[i]), str_sprintf("packet %zu inflated off the socket to a different frame", i).c_str());
+            }
+        }
+
+        // Damaged packets are refused rather than queued, and a good one still goes through after them.
+        // They're cut down to half a frame, so one claiming to expand further still fits the buffer.
+        Packet packet;
+        const auto& whole = pixels[1 % pixels.size()];
+        const uint32_t halfLeds = DWORDFromMemory(&whole.expanded[4]) / 2;
+        packet.expanded.assign(whole.expanded.begin(), whole.expanded.begin() + STANDARD_DATA_HEADER_SIZE + halfLeds * sizeof(CRGB));
+        memcpy(&packet.expanded[4], &halfLeds, sizeof(halfLeds));
+        packet.expandedSize = packet.expanded.size();
+        packet.compressed = Compress(packet.expanded);
+
+        auto receives = [&](std::vector<uint8_t> damaged)
+        {
+            const std::vector<std::vector<uint8_t>> single { damaged };
+            LoopbackSender sender(single, 1, false);
+            return ReceiveStreamed(sender.Socket(), *inflater, target);
+        };
+
+        auto corrupt = MakeWire(packet, packet.expandedSize);
+        corrupt.back() ^= 0x01;
+        failures += Check(kSuite, !receives(corrupt), "packet with a bad checksum inflated off the socket");
+
+        auto truncated = MakeWire(packet, packet.expandedSize);
+        truncated.resize(COMPRESSED_HEADER_SIZE + packet.compressed.size() / 2);
+        failures += Check(kSuite, !receives(truncated), "packet cut off mid-stream inflated off the socket");
+
+        failures += Check(kSuite, !receives(MakeWire(packet, packet.expandedSize - 3)), "packet inflated off the socket short of its expanded size");
+        failures += Check(kSuite, !receives(MakeWire(packet, packet.expandedSize + 3)), "packet inflated off the socket past its expanded size");
+
+        failures += Check(kSuite, receives(MakeWire(packet, packet.expandedSize)) && SameFrame(target, packet), "good packet refused after damaged ones");
+        return failures;
+    }
+
+    InflateResult RunLoopback(const BenchOptions& options, const std::vector<Packet>& pixels)
+    {
+        InflateResult result {};
+        const size_t packets = options.warmup + options.frames;
+
+        std::vector<std::vector<uint8_t>> wire;
+        for (const auto& packet : pixels)
+        {
+            wire.push_back(MakeWire(packet, packet.expandedSize));
+            result.stagedBytes = std::max(result.stagedBytes, packet.compressed.size());
+        }
+        result.streamedBytes = Inflater::kChunkSize;
+
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBuffer target(device);
+        std::vector<uint8_t> staging, output(MAXIMUM_PACKET_SIZE + 1);
+
+        // The transfer alone, for the others to be measured against
+        {
+            LoopbackSender sender(wire, packets, true);
+            result.raw = TimeFrames(options, [&]()
+            {
+                sender.Request();
+                uint8_t prefix[STANDARD_DATA_HEADER_SIZE];
+                ReadAll(sender.Socket(), prefix, sizeof(prefix));
+                staging.resize(DWORDFromMemory(&prefix[4]) - kStreamPrefix);
+                ReadAll(sender.Socket(), staging.data(), staging.size());
+                KeepAlive(staging[0]);
+            });
+        }
+
+        {
+            LoopbackSender sender(wire, packets, true);
+            result.staged = TimeFrames(options, [&]()
+            {
+                sender.Request();
+                ReceiveStaged(sender.Socket(), staging, output, target);
+                KeepAlive(target.Pixels()[0]);
+            });
+        }
+
+        {
+            auto inflater = std::make_unique<Inflater>();
+            LoopbackSender sender(wire, packets, true);
+            result.streamed = TimeFrames(options, [&]()
+            {
+                sender.Request();
+                ReceiveStreamed(sender.Socket(), *inflater, target);
+                KeepAlive(target.Pixels()[0]);
+            });
+        }
+
+        return result;
+    }
+}
+
+int RunInflateSuite(const BenchOptions& options)
+{
+    uzlib_init();
+
+    // A receiver that gives up closes its end of the loopback socket under the sender
+    signal(SIGPIPE, SIG_IGN);
+
+    std::vector<Packet> stream;
+    int failures = 0;
+
+    if (options.capture.empty())
+    {
+        stream = SynthesizeStream(90);
+        failures += CheckDamage(stream[1]);
+    }
+    else if (!LoadCapture(options.capture, stream))
+        return 1;
+
+    failures += CheckStream(stream);
+    if (failures)
+    {
+        fprintf(stderr, "inflate: not timing a stream that doesn't decompress\n");
+        return failures;
+    }
+
+    const auto pixels = PixelPackets(stream);
+    if (pixels.empty())
+    {
+        fprintf(stderr, "inflate: no compressed pixel packets to receive\n");
+        return 1;
+    }
+
+    failures += CheckLoopback(pixels);
+    if (failures)
+    {
+        fprintf(stderr, "inflate: not timing a stream that doesn't inflate off the socket\n");
+        return failures;
+    }
+
+    const auto result = RunLoopback(options, pixels);
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]        = "inflate";
+        doc["frames"]       = options.frames;
+        doc["failures"]     = failures;
+        doc["capture"]      = options.capture.empty() ? "synthesized" : options.capture.c_str();
+        doc["packets"]      = stream.size();
+        doc["pixelPackets"] = pixels.size();
+        doc["segmentBytes"] = kSegmentSize;
+        doc["segmentGapUs"] = kSegmentGapUs;
+
+        auto raw = doc["raw"].to<JsonObject>();
+        raw["medianUs"]         = result.raw.median;
+        raw["p99Us"]            = result.raw.p99;
+
+        auto staged = doc["staged"].to<JsonObject>();
+        staged["medianUs"]      = result.staged.median;
+        staged["p99Us"]         = result.staged.p99;
+        staged["bufferedBytes"] = result.stagedBytes;
+
+        auto streamed = doc["streamed"].to<JsonObject>();
+        streamed["medianUs"]      = result.streamed.median;
+        streamed["p99Us"]         = result.streamed.p99;
+        streamed["bufferedBytes"] = result.streamedBytes;
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        auto afterTransfer = [&](const FrameStats& stats) { return static_cast<int>(stats.median) - static_cast<int>(result.raw.median); };
+
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        printf("stream: %zu compressed packets, %zu of them pixels (%s)\n", stream.size(), pixels.size(),
+               options.capture.empty() ? "synthesized" : options.capture.c_str());
+        printf("sent %zu bytes at a time, %u us apart\n\n", kSegmentSize, kSegmentGapUs);
+        printf("%-9s %10s %10s %16s %15s\n", "receive", "median us", "p99 us", "after transfer", "buffered bytes");
+        printf("%-9s %10u %10u %16s %15zu\n", "raw", result.raw.median, result.raw.p99, "-", result.stagedBytes);
+        printf("%-9s %10u %10u %16d %15zu\n", "staged", result.staged.median, result.staged.p99, afterTransfer(result.staged), result.stagedBytes);
+        printf("%-9s %10u %10u %16d %15zu\n", "streamed", result.streamed.median, result.streamed.p99, afterTransfer(result.streamed), result.streamedBytes);
+    }
+
+    return failures;
+}
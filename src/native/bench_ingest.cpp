@@ -0,0 +1,296 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_ingest.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite ingest: checks that receiving a frame straight into
+//    LEDBufferManager's reserved spare and committing it queues exactly
+//    what staging the packet and parsing it with UpdateFromWire() does,
+//    across frames that repeat timestamps, overrun the ring and are drawn
+//    in between, and that a reservation straddling Reconfigure() is
+//    turned away. It then times both paths per frame, with a memcpy
+//    standing in for the socket read, at a quarter, half and all of the
+//    matrix.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    constexpr size_t kHeaderSize = 24;
+    constexpr uint32_t kRingSize = 8;
+
+    struct IngestResult
+    {
+        uint32_t   leds;
+        FrameStats staged;
+        FrameStats direct;
+    };
+
+    constexpr const char* kSuite = "ingest";
+
+    // A WIFI_COMMAND_PIXELDATA64 packet as the socket server reads it into its buffer
+
+    void WritePacket(std::vector<uint8_t>& packet, uint32_t leds, uint64_t seconds, uint64_t micros, uint8_t seed)
+    {
+        const uint16_t command = WIFI_COMMAND_PIXELDATA64;
+        const uint16_t channel = 1;
+
+        packet.resize(kHeaderSize + leds * sizeof(CRGB));
+        memcpy(&packet[0],  &command, sizeof(command));
+        memcpy(&packet[2],  &channel, sizeof(channel));
+        memcpy(&packet[4],  &leds,    sizeof(leds));
+        memcpy(&packet[8],  &seconds, sizeof(seconds));
+        memcpy(&packet[16], &micros,  sizeof(micros));
+        for (size_t i = kHeaderSize; i < packet.size(); i++)
+            packet[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+
+    // ProcessIncomingData's handling of one channel: the packet, already read into a buffer, parsed into the reservation
+
+    void StagedReceive(LEDBufferManager& manager, const std::vector<uint8_t>& packet)
+    {
+        auto pBuffer = manager.ReserveBuffer(BufferReservation::Incoming);
+        pBuffer->UpdateFromWire(packet.data(), packet.size());
+        manager.CommitBuffer(pBuffer);
+    }
+
+    bool DirectReceive(LEDBufferManager& manager, const std::vector<uint8_t>& packet, uint32_t leds, uint64_t seconds, uint64_t micros)
+    {
+        auto pBuffer = manager.ReserveBuffer(BufferReservation::Socket);
+        memcpy(pBuffer->Pixels(), &packet[kHeaderSize], leds * sizeof(CRGB));
+        pBuffer->SetFrame(seconds, micros, leds);
+        return manager.CommitBuffer(pBuffer);
+    }
+
+    bool SameQueue(const LEDBufferManager& staged, const LEDBufferManager& direct)
+    {
+        if (staged.Depth() != direct.Depth())
+            return false;
+
+        for (size_t i = 0; i < staged.Depth(); i++)
+        {
+            auto a = staged[i], b = direct[i];
+            if (a->Seconds() != b->Seconds() || a->MicroSeconds() != b->MicroSeconds() || a->Length() != b->Length())
+                return false;
+            if (memcmp(a->Pixels(), b->Pixels(), a->Length() * sizeof(CRGB)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    int CheckQueue(uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager staged(kRingSize, device);
+        LEDBufferManager direct(kRingSize, device);
+        std::vector<uint8_t> packet;
+
+        int failures = 0;
+        uint64_t seconds = 100, micros = 1;
+        for (int frame = 0; frame < 500 && failures < 10; frame++)
+        {
+            // Mostly new frames, some repeats of the last timestamp, some with no micros at all
+            const uint8_t roll = random8();
+            if (roll < 160)
+                micros += 1 + random16(40000);
+            else if (roll < 190)
+                micros = 0;
+            if (micros >= 1000000)
+            {
+                seconds++;
+                micros -= 1000000;
+            }
+
+            WritePacket(packet, leds - random8(4), seconds, micros, random8());
+            const uint32_t frameLeds = (packet.size() - kHeaderSize) / sizeof(CRGB);
+            StagedReceive(staged, packet);
+            failures += Check(kSuite, DirectReceive(direct, packet, frameLeds, seconds, micros), "commit of a fresh reservation refused");
+
+            // Let the drawing side catch up now and then, sometimes all the way
+            if (random8() < 64)
+            {
+                for (int draws = random8(kRingSize); draws > 0 && !staged.IsEmpty(); draws--)
+                {
+                    staged.GetOldestBuffer();
+                    direct.GetOldestBuffer();
+                }
+            }
+
+            if (!SameQueue(staged, direct))
+                failures += Check(kSuite, false, str_sprintf("queue differs from the staged path after frame %d", frame).c_str());
+        }
+        return failures;
+    }
+
+    int CheckReconfigure()
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        int failures = 0;
+
+        auto pStale = manager.ReserveBuffer(BufferReservation::Socket);
+        manager.Reconfigure(device);
+        pStale->SetFrame(1, 1, 0);
+        failures += Check(kSuite, !manager.CommitBuffer(pStale), "reservation from before Reconfigure() was queued");
+        failures += Check(kSuite, manager.IsEmpty(), "refused commit left a frame queued");
+        failures += Check(kSuite, manager.ReserveBuffer(BufferReservation::Socket) != pStale, "Reconfigure() kept the old spare");
+
+        // The committed spare is in the ring now, so the next reservation is a different buffer
+        auto pFirst = manager.ReserveBuffer(BufferReservation::Socket);
+        pFirst->SetFrame(1, 2, 0);
+        failures += Check(kSuite, manager.CommitBuffer(pFirst), "commit after Reconfigure() refused");
+        failures += Check(kSuite, manager.ReserveBuffer(BufferReservation::Socket) != pFirst && manager.PeekNewestBuffer() == pFirst, "committed buffer still the spare");
+        failures += Check(kSuite, !manager.CommitBuffer(pFirst), "the same buffer was committed twice");
+
+        return failures;
+    }
+
+    // The socket server fills its reservation without g_buffer_mutex while ProcessIncomingData() reserves
+    // and commits around it, so none of the frames the other path queues, or takes back off a full queue,
+    // may be that buffer
+
+    int CheckReservations(uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kRingSize, device);
+        std::vector<uint8_t> packet;
+        int failures = 0;
+
+        auto pSocket = manager.ReserveBuffer(BufferReservation::Socket);
+        std::fill_n(pSocket->Pixels(), leds, CRGB(1, 2, 3));
+        failures += Check(kSuite, manager.ReserveBuffer(BufferReservation::Lighting) != pSocket, "two receivers share a reservation");
+
+        uint64_t micros = 1;
+        for (uint32_t frame = 0; frame < kRingSize * 3; frame++)
+        {
+            WritePacket(packet, leds, 100, micros, frame);
+            StagedReceive(manager, packet);
+            if (frame % 4 == 0)
+                manager.GetOldestBuffer();
+            else if (frame % 4 != 1)
+                micros += 1000;             // Every fourth frame repeats the last one's timestamp and replaces it
+        }
+
+        bool untouched = manager.ReserveBuffer(BufferReservation::Socket) == pSocket;
+        for (size_t i = 0; i < manager.Depth(); i++)
+            untouched = untouched && manager[i] != pSocket;
+        for (uint32_t i = 0; i < leds; i++)
+            untouched = untouched && pSocket->Pixels()[i] == CRGB(1, 2, 3);
+        failures += Check(kSuite, untouched, "another receiver's commits touched the socket reservation");
+
+        pSocket->SetFrame(100, micros + 1000, leds);
+        failures += Check(kSuite, manager.CommitBuffer(pSocket) && manager.PeekNewestBuffer() == pSocket, "socket reservation refused after the other receiver's commits");
+        return failures;
+    }
+
+    IngestResult RunSize(const BenchOptions& options, uint32_t leds)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager staged(kRingSize, device);
+        LEDBufferManager direct(kRingSize, device);
+        std::vector<uint8_t> wire, readBuffer;
+        WritePacket(wire, leds, 0, 0, 1);
+        readBuffer.resize(wire.size());
+
+        IngestResult result { leds };
+        uint64_t micros = 0;
+
+        // The socket fills the read buffer, then the frame is copied into the ring
+        result.staged = TimeFrames(options, [&]()
+        {
+            micros += 16667;
+            memcpy(readBuffer.data(), wire.data(), wire.size());
+            memcpy(&readBuffer[16], &micros, sizeof(micros));
+            StagedReceive(staged, readBuffer);
+            KeepAlive(staged.PeekNewestBuffer()->Pixels()[0]);
+        });
+
+        // The socket fills the reserved buffer, which is swapped into the ring
+        result.direct = TimeFrames(options, [&]()
+        {
+            micros += 16667;
+            DirectReceive(direct, wire, leds, 0, micros);
+            KeepAlive(direct.PeekNewestBuffer()->Pixels()[0]);
+        });
+
+        return result;
+    }
+}
+
+int RunIngestSuite(const BenchOptions& options)
+{
+    const uint32_t leds = MATRIX_WIDTH * MATRIX_HEIGHT;
+
+    int failures = CheckQueue(leds);
+    failures += CheckQueue(leds / 3);
+    failures += CheckReconfigure();
+    failures += CheckReservations(leds);
+
+    const IngestResult results[] =
+    {
+        RunSize(options, leds / 4),
+        RunSize(options, leds / 2),
+        RunSize(options, leds),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "ingest";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["leds"]           = result.leds;
+            entry["stagedMedianUs"] = result.staged.median;
+            entry["directMedianUs"] = result.direct.median;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%-8s %12s %12s\n", "leds", "staged us", "direct us");
+        for (const auto& result : results)
+            printf("%-8u %12u %12u\n", result.leds, result.staged.median, result.direct.median);
+    }
+
+    return failures;
+}
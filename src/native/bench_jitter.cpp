@@ -0,0 +1,315 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_jitter.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite jitter: simulates a sender streaming timestamped
+//    frames at 30fps over a network with random delay, to a receiver whose
+//    clock runs fast or slow against the sender's, and plays them out of an
+//    LEDBufferManager on simulated time with a 1ms render tick. Each run is
+//    played twice: by due time, as WiFiDraw does now, and by raw timestamp,
+//    as it did before the PlayoutScheduler (or, with the clocks apart,
+//    oldest frame first).
+//
+//    Judder is how far each gap between frames shown differs from the
+//    sender's frame interval; a late frame arrived after it should have
+//    been shown, and a dropped one was never shown at all.
+//
+//    A fixed set of scenarios is checked first: a clean network, heavy
+//    jitter, drift either way, unsynchronized clocks and a clock step.
+//    Then the network given by --jitter, --drift and --lead is run for
+//    --frames frames and reported.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    constexpr uint32_t kSlots         = 64;                         // Queue depth of a modest PSRAM board
+    constexpr int64_t  kInterval      = MICROS_PER_SECOND / 30;
+    constexpr int64_t  kTick          = 1000;                       // Render loop's minimum sleep
+    constexpr int64_t  kBaseLatency   = 5000;                       // Network delay before any jitter
+    constexpr int64_t  kSenderEpoch   = 1780000000LL * MICROS_PER_SECOND;
+    constexpr int64_t  kUnsyncedEpoch = 10LL * MICROS_PER_SECOND;   // A receiver clock NTP hasn't set
+
+    enum class Policy { Stamp, Playout };
+
+    struct Network
+    {
+        const char* name;
+        size_t  frames;
+        double  jitterMs;                       // Mean of the random delay on top of kBaseLatency
+        double  driftPpm;                       // How fast the receiver's clock runs against the sender's
+        double  leadMs;                         // How far ahead of sending the sender stamps each frame
+        bool    synced     = true;              // Receiver clock on the sender's time
+        size_t  stepFrame  = 0;                 // Receiver clock steps by stepMicros from this frame on
+        int64_t stepMicros = 0;
+    };
+
+    struct JitterResult
+    {
+        const char* policy;
+        size_t      shown = 0;
+        size_t      late = 0;
+        size_t      dropped = 0;
+        uint32_t    schedulerDropped = 0;
+        FrameStats  judder;                     // |gap between frames shown - frame interval|, us
+        double      latencyMs = 0;              // Mean time from sending to showing
+        int32_t     playoutDelay = 0;
+        int32_t     jitter = 0;
+        int32_t     driftPPM = 0;
+        bool        trusted = false;
+    };
+
+    constexpr const char* kSuite = "jitter";
+
+    // Arrival times in true time, delivered in order as TCP would: a frame held up holds up
+    // every frame behind it
+
+    std::vector<int64_t> ArrivalTimes(const Network& network, unsigned long seed)
+    {
+        std::mt19937 rng(seed);
+        std::exponential_distribution<double> delay(network.jitterMs > 0 ? 1.0 / (network.jitterMs * 1000) : 1.0);
+
+        std::vector<int64_t> arrivals(network.frames);
+        int64_t previous = 0;
+        for (size_t i = 0; i < network.frames; i++)
+        {
+            const double extra = network.jitterMs > 0 ? std::min(delay(rng), network.jitterMs * 8000) : 0;
+            previous = arrivals[i] = std::max(previous, static_cast<int64_t>(i * kInterval + kBaseLatency + llround(extra)));
+        }
+        return arrivals;
+    }
+
+    JitterResult Simulate(const Network& network, Policy policy, unsigned long seed)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(kSlots, device);
+
+        const auto arrivals = ArrivalTimes(network, seed);
+        const int64_t lead = llround(network.leadMs * 1000);
+
+        // The receiver's clock at true time t; the sender's is true time from kSenderEpoch
+        auto receiverClock = [&](int64_t t, bool stepped)
+        {
+            return (network.synced ? kSenderEpoch : kUnsyncedEpoch) + t + llround(t * network.driftPpm * 1e-6) + (stepped ? network.stepMicros : 0);
+        };
+
+        JitterResult result;
+        result.policy = policy == Policy::Playout ? "playout" : "stamp";
+
+        std::vector<uint32_t> judder;
+        size_t next = 0;
+        int64_t lastShown = -1;
+        double latency = 0;
+
+        for (int64_t t = 0; t < arrivals.back() + 2 * MICROS_PER_SECOND; t += kTick)
+        {
+            // The socket task: queue every frame that has arrived
+
+            for (; next < network.frames && arrivals[next] <= t; next++)
+            {
+                const int64_t stamp = kSenderEpoch + next * kInterval + lead;
+                const int64_t arrival = receiverClock(arrivals[next], network.stepFrame && next >= network.stepFrame);
+                if (network.synced && arrival > stamp)
+                    result.late++;
+
+                auto pBuffer = manager.ReserveBuffer(BufferReservation::Socket);
+                pBuffer->Pixels()[0] = CRGB(next & 0xFF, (next >> 8) & 0xFF, (next >> 16) & 0xFF);
+                pBuffer->SetFrame(stamp / MICROS_PER_SECOND, stamp % MICROS_PER_SECOND, 1);
+                manager.CommitBuffer(pBuffer, arrival);
+            }
+
+            // The render task: WiFiDraw now, or as it was
+
+            const uint64_t now = receiverClock(t, network.stepFrame && next > network.stepFrame);
+            std::shared_ptr<LEDBuffer> pBuffer;
+            if (policy == Policy::Playout)
+                pBuffer = manager.GetDueBuffer(now);
+            else if (!network.synced)
+                pBuffer = manager.GetOldestBuffer();
+            else
+            {
+                uint64_t seconds, micros;
+                while (manager.PeekOldestTime(seconds, micros) && seconds * MICROS_PER_SECOND + micros < now)
+                    pBuffer = manager.GetOldestBuffer();
+            }
+
+            if (!pBuffer)
+                continue;
+
+            const CRGB pixel = pBuffer->Pixels()[0];
+            const size_t frame = pixel.r | pixel.g << 8 | pixel.b << 16;
+
+            result.shown++;
+            latency += t - static_cast<int64_t>(frame) * kInterval;
+            if (lastShown >= 0)
+                judder.push_back(static_cast<uint32_t>(std::abs(t - lastShown - kInterval)));
+            lastShown = t;
+        }
+
+        const auto& scheduler = manager.Scheduler();
+        if (policy == Policy::Playout)
+            result.late = scheduler.LateFrames();
+
+        result.dropped          = network.frames - result.shown;
+        result.schedulerDropped = scheduler.DroppedFrames();
+        result.judder           = FrameStats::From(std::move(judder));
+        result.latencyMs        = result.shown ? latency / result.shown / 1000 : 0;
+        result.playoutDelay     = scheduler.PlayoutDelay();
+        result.jitter           = scheduler.Jitter();
+        result.driftPPM         = scheduler.ClockDriftPPM();
+        result.trusted          = scheduler.IsSenderClockTrusted();
+        return result;
+    }
+
+    // CheckNetworks
+    //
+    // The playout scheduler against the old policy on networks with known answers
+
+    int CheckNetworks(const BenchOptions& options)
+    {
+        int failures = 0;
+
+        auto run = [&](const Network& network)
+        {
+            auto stamp   = Simulate(network, Policy::Stamp, options.seed);
+            auto playout = Simulate(network, Policy::Playout, options.seed);
+            failures += Check(kSuite, playout.schedulerDropped == playout.dropped,
+                              str_sprintf("%s: scheduler counted %u dropped, %zu were never shown", network.name, playout.schedulerDropped, playout.dropped));
+            return std::make_pair(stamp, playout);
+        };
+
+        // Frames stamped well ahead over a clean network are shown exactly on their stamps, as before
+        {
+            const Network network { "clean", 900, 0, 0, 100 };
+            auto [stamp, playout] = run(network);
+            failures += Check(kSuite, playout.shown == network.frames && playout.late == 0, "clean: frames dropped or late");
+            failures += Check(kSuite, playout.judder.max <= kTick, str_sprintf("clean: judder of %u us", playout.judder.max));
+            failures += Check(kSuite, std::abs(playout.latencyMs - stamp.latencyMs) < 1, "clean: not shown on the sender's stamps");
+        }
+
+        // Frames stamped as they're sent all arrive late; the playout delay absorbs the jitter
+        for (bool synced : { true, false })
+        {
+            Network network { synced ? "jitter" : "unsynced", 1800, 15, 0, 0 };
+            network.synced = synced;
+            auto [stamp, playout] = run(network);
+            failures += Check(kSuite, playout.trusted == synced, str_sprintf("%s: sender clock %s", network.name, synced ? "distrusted" : "trusted"));
+            failures += Check(kSuite, playout.dropped <= network.frames / 100, str_sprintf("%s: %zu frames dropped", network.name, playout.dropped));
+            failures += Check(kSuite, playout.late <= network.frames / 20, str_sprintf("%s: %zu frames late", network.name, playout.late));
+            failures += Check(kSuite, playout.judder.p99 * 2 < stamp.judder.p99,
+                              str_sprintf("%s: judder p99 %u us against %u us by stamp", network.name, playout.judder.p99, stamp.judder.p99));
+        }
+
+        // Drift either way is measured, and tracked without frames bunching up
+        for (double drift : { 300.0, -300.0 })
+        {
+            const Network network { drift > 0 ? "drift+" : "drift-", 3600, 5, drift, 0 };
+            auto [stamp, playout] = run(network);
+            failures += Check(kSuite, std::abs(playout.driftPPM - drift) <= 60, str_sprintf("%s: drift measured as %d ppm", network.name, playout.driftPPM));
+            failures += Check(kSuite, playout.dropped <= network.frames / 100, str_sprintf("%s: %zu frames dropped", network.name, playout.dropped));
+            failures += Check(kSuite, playout.judder.p99 * 2 < stamp.judder.p99,
+                              str_sprintf("%s: judder p99 %u us against %u us by stamp", network.name, playout.judder.p99, stamp.judder.p99));
+        }
+
+        // The local clock jumping forward makes every frame late until the estimate catches up
+        {
+            const Network network { "step", 1800, 5, 0, 0, true, 600, 5 * MICROS_PER_SECOND };
+            auto [stamp, playout] = run(network);
+            failures += Check(kSuite, playout.dropped <= network.frames / 100, str_sprintf("step: %zu frames dropped", playout.dropped));
+            failures += Check(kSuite, playout.late <= network.frames / 10, str_sprintf("step: %zu frames late", playout.late));
+        }
+
+        return failures;
+    }
+}
+
+int RunJitterSuite(const BenchOptions& options)
+{
+    const int failures = CheckNetworks(options);
+
+    const Network network { "custom", options.frames, options.jitterMs, options.driftPpm, options.leadMs };
+    const JitterResult results[] =
+    {
+        Simulate(network, Policy::Stamp, options.seed),
+        Simulate(network, Policy::Playout, options.seed),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "jitter";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+        doc["jitterMs"] = options.jitterMs;
+        doc["driftPpm"] = options.driftPpm;
+        doc["leadMs"]   = options.leadMs;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["policy"]         = result.policy;
+            entry["shown"]          = result.shown;
+            entry["late"]           = result.late;
+            entry["dropped"]        = result.dropped;
+            entry["judderMedianUs"] = result.judder.median;
+            entry["judderP99Us"]    = result.judder.p99;
+            entry["judderMaxUs"]    = result.judder.max;
+            entry["latencyMs"]      = result.latencyMs;
+            entry["playoutDelayUs"] = result.playoutDelay;
+            entry["jitterUs"]       = result.jitter;
+            entry["driftPpm"]       = result.driftPPM;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        printf("%zu frames at 30fps, %.1fms mean jitter, %+.0fppm drift, stamped %.1fms ahead\n\n",
+               options.frames, options.jitterMs, options.driftPpm, options.leadMs);
+        printf("%-8s %7s %7s %7s %11s %11s %11s %11s\n", "policy", "shown", "late", "dropped", "judder p50", "judder p99", "latency ms", "drift ppm");
+        for (const auto& result : results)
+            printf("%-8s %7zu %7zu %7zu %11u %11u %11.1f %11d\n", result.policy, result.shown, result.late, result.dropped,
+                   result.judder.median, result.judder.p99, result.latencyMs, result.driftPPM);
+        printf("\nplayout delay %d us over the fastest transit, jitter %d us\n", results[1].playoutDelay, results[1].jitter);
+    }
+
+    return failures;
+}
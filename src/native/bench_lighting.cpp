@@ -0,0 +1,782 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_lighting.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite lighting: replays packet captures of DDP, E1.31 and
+//    Art-Net through a LightingReceiver into three channels' LEDBufferManagers
+//    of 300, 170 and 512 LEDs, taking every frame off the queues as the
+//    render task would.
+//
+//    The suite records its own shows first, as a controller like xLights
+//    sends them, into libpcap captures, and replays them: pushed DDP, DDP
+//    covering one channel, E1.31 and Art-Net with and without sync packets
+//    and with their universes shuffled, a lost universe, stale packets and
+//    truncated ones. Every channel must get every frame with the pixels it
+//    was sent, or the last frame's where a universe was lost (a channel
+//    that lost its only universe misses that frame), and frames
+//    that were synced or pushed must carry the same timestamp on every
+//    channel.
+//
+//    --capture FILE replays a capture of a real show instead, recorded with
+//    something like
+//
+//      tcpdump -i eth0 -w show.pcap udp port 4048 or udp port 5568 or udp port 6454
+//
+//    and reports the frames each channel got and the time each packet took.
+//    Captures must be libpcap, not pcapng (editcap -F pcap converts them),
+//    with IPv4 datagrams that weren't fragmented.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <ArduinoJson.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "byte_utils.h"
+#include "ledbuffer.h"
+#include "lightingreceiver.h"
+#include "nd_bench.h"
+#include "nd_network.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    using Protocol = LightingReceiver::Protocol;
+
+    constexpr uint32_t kRingSize            = 8;
+    constexpr size_t   kChannelLeds[]       = { 300, 170, 512 };
+    constexpr size_t   kChannels            = std::size(kChannelLeds);
+    constexpr uint16_t kE131StartUniverse   = 1;
+    constexpr uint16_t kArtNetStartUniverse = 0;
+    constexpr uint16_t kSyncAddress         = 7999;
+    constexpr size_t   kDDPChunk            = 1440;                         // Bytes of pixels per DDP packet, as xLights sends
+    constexpr size_t   kUniverseBytes       = LightingReceiver::kPixelsPerUniverse * 3;
+    constexpr size_t   kScenarioFrames      = 120;
+    constexpr uint64_t kEpoch               = 1780000000ULL * MICROS_PER_SECOND;
+    constexpr uint64_t kInterval            = MICROS_PER_SECOND / 40;
+
+    // One datagram of a capture
+
+    struct Datagram
+    {
+        uint64_t             micros = 0;
+        uint16_t             port   = 0;
+        uint32_t             destination = 0;
+        std::vector<uint8_t> payload;
+    };
+
+    struct Show
+    {
+        const char* name;
+        Protocol    protocol;
+        bool        sync       = false;         // E1.31 sync packets or ArtSync after each frame
+        bool        shuffle    = false;         // Each frame's universes sent in a random order
+        bool        partial    = false;         // DDP covering only channel 1's pixels
+        size_t      loseEvery  = 0;             // Every Nth frame loses one universe
+        size_t      staleEvery = 0;             // Every Nth frame is followed by a packet from the one before
+        bool        junk       = false;         // Truncated packets of each protocol among the rest
+    };
+
+    struct Frame
+    {
+        uint64_t          stamp = 0;
+        std::vector<CRGB> pixels;
+    };
+
+    struct ReplayResult
+    {
+        size_t             packets = 0;
+        std::vector<Frame> frames[kChannels];
+        uint32_t           presented     = 0;
+        uint32_t           syncs         = 0;
+        uint32_t           outOfSequence = 0;
+        uint32_t           malformed     = 0;
+        FrameStats         accept;                  // Microseconds per packet, queueing any frames it completes
+    };
+
+    constexpr const char* kSuite = "lighting";
+
+    CRGB PatternPixel(size_t frame, size_t channel, size_t i)
+    {
+        return CRGB(static_cast<uint8_t>(frame * 3 + i), static_cast<uint8_t>(channel * 50 + i * 5), static_cast<uint8_t>(frame ^ i));
+    }
+
+    void PutBE(std::vector<uint8_t>& out, uint32_t value, int bytes)
+    {
+        for (int i = bytes - 1; i >= 0; i--)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    void PutLE(std::vector<uint8_t>& out, uint32_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    // Packets as a controller sends them
+
+    std::vector<uint8_t> DDPPacket(uint32_t offset, const uint8_t* pData, size_t cbData, bool push)
+    {
+        std::vector<uint8_t> packet;
+        packet.push_back(0x40 | (push ? 0x01 : 0));
+        packet.push_back(0);                                        // Sequence unused
+        packet.push_back(0x0B);                                     // RGB, 8 bits per channel
+        packet.push_back(1);                                        // Default output device
+        PutBE(packet, offset, 4);
+        PutBE(packet, cbData, 2);
+        packet.insert(packet.end(), pData, pData + cbData);
+        return packet;
+    }
+
+    void E131Root(std::vector<uint8_t>& packet, uint32_t vector, size_t cbPacket)
+    {
+        static const uint8_t cid[16] = { 0x4e, 0x44, 0x53, 0x54, 0x52, 0x49, 0x50, 0x00, 1, 2, 3, 4, 5, 6, 7, 8 };
+        PutBE(packet, 0x0010, 2);
+        PutBE(packet, 0x0000, 2);
+        for (char c : { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', '\0', '\0', '\0' })
+            packet.push_back(c);
+        PutBE(packet, 0x7000 | (cbPacket - 16), 2);
+        PutBE(packet, vector, 4);
+        packet.insert(packet.end(), cid, cid + sizeof(cid));
+    }
+
+    std::vector<uint8_t> E131Data(uint16_t universe, uint8_t sequence, uint16_t syncAddress, const uint8_t* pData, size_t cbData)
+    {
+        const size_t cbPacket = 126 + cbData;
+        std::vector<uint8_t> packet;
+        E131Root(packet, 0x00000004, cbPacket);
+
+        PutBE(packet, 0x7000 | (cbPacket - 38), 2);
+        PutBE(packet, 0x00000002, 4);
+        char source[64] = "nd_bench";
+        packet.insert(packet.end(), source, source + sizeof(source));
+        packet.push_back(100);                                      // Priority
+        PutBE(packet, syncAddress, 2);
+        packet.push_back(sequence);
+        packet.push_back(0);                                        // Options
+        PutBE(packet, universe, 2);
+
+        PutBE(packet, 0x7000 | (cbPacket - 115), 2);
+        packet.push_back(0x02);
+        packet.push_back(0xA1);
+        PutBE(packet, 0, 2);
+        PutBE(packet, 1, 2);
+        PutBE(packet, cbData + 1, 2);
+        packet.push_back(0);                                        // DMX start code
+        packet.insert(packet.end(), pData, pData + cbData);
+        return packet;
+    }
+
+    std::vector<uint8_t> E131Sync(uint8_t sequence, uint16_t syncAddress)
+    {
+        std::vector<uint8_t> packet;
+        E131Root(packet, 0x00000008, 49);
+        PutBE(packet, 0x7000 | (49 - 38), 2);
+        PutBE(packet, 0x00000001, 4);
+        packet.push_back(sequence);
+        PutBE(packet, syncAddress, 2);
+        PutBE(packet, 0, 2);
+        return packet;
+    }
+
+    void ArtNetHeader(std::vector<uint8_t>& packet, uint16_t opcode)
+    {
+        for (char c : { 'A', 'r', 't', '-', 'N', 'e', 't', '\0' })
+            packet.push_back(c);
+        PutLE(packet, opcode, 2);
+        PutBE(packet, 14, 2);
+    }
+
+    std::vector<uint8_t> ArtDmx(uint16_t universe, uint8_t sequence, const uint8_t* pData, size_t cbData)
+    {
+        std::vector<uint8_t> packet;
+        ArtNetHeader(packet, 0x5000);
+        packet.push_back(sequence);
+        packet.push_back(0);                                        // Physical
+        packet.push_back(universe & 0xFF);
+        packet.push_back((universe >> 8) & 0x7F);
+        const size_t cbEven = cbData + (cbData & 1);
+        PutBE(packet, cbEven, 2);
+        packet.insert(packet.end(), pData, pData + cbData);
+        packet.resize(packet.size() + cbEven - cbData);
+        return packet;
+    }
+
+    std::vector<uint8_t> ArtSync()
+    {
+        std::vector<uint8_t> packet;
+        ArtNetHeader(packet, 0x5200);
+        PutBE(packet, 0, 2);
+        return packet;
+    }
+
+    Protocol ProtocolForPort(uint16_t port)
+    {
+        return port == NetworkPort::DDP ? Protocol::DDP : port == NetworkPort::E131 ? Protocol::E131 : Protocol::ArtNet;
+    }
+
+    bool IsLightingPort(uint16_t port)
+    {
+        return port == NetworkPort::DDP || port == NetworkPort::E131 || port == NetworkPort::ArtNet;
+    }
+
+    // libpcap captures: a 24-byte file header, then each packet behind a 16-byte record header
+
+    constexpr uint32_t kPcapMagicMicros = 0xA1B2C3D4;
+    constexpr uint32_t kPcapMagicNanos  = 0xA1B23C4D;
+    constexpr uint32_t kLinkNull        = 0;
+    constexpr uint32_t kLinkEthernet    = 1;
+    constexpr uint32_t kLinkRaw         = 101;
+    constexpr uint32_t kLinkLinuxSLL    = 113;
+    constexpr uint32_t kLinkLinuxSLL2   = 276;
+
+    // WriteCapture
+    //
+    // Each datagram as an Ethernet frame from a controller at 192.168.1.10
+
+    std::vector<uint8_t> WriteCapture(const std::vector<Datagram>& datagrams)
+    {
+        std::vector<uint8_t> file;
+        PutLE(file, kPcapMagicMicros, 4);
+        PutLE(file, 2, 2);
+        PutLE(file, 4, 2);
+        PutLE(file, 0, 4);
+        PutLE(file, 0, 4);
+        PutLE(file, 65535, 4);
+        PutLE(file, kLinkEthernet, 4);
+
+        for (const auto& datagram : datagrams)
+        {
+            std::vector<uint8_t> frame;
+            const bool multicast = (datagram.destination >> 28) == 0xE;
+            if (multicast)
+                frame.insert(frame.end(), { 0x01, 0x00, 0x5E, uint8_t((datagram.destination >> 16) & 0x7F),
+                                            uint8_t(datagram.destination >> 8), uint8_t(datagram.destination) });
+            else
+                frame.insert(frame.end(), { 0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01 });
+            frame.insert(frame.end(), { 0x02, 0x00, 0x00, 0x00, 0x00, 0x10 });
+            PutBE(frame, 0x0800, 2);
+
+            const size_t cbUdp = 8 + datagram.payload.size();
+            const size_t ip = frame.size();
+            frame.insert(frame.end(), { 0x45, 0x00 });
+            PutBE(frame, 20 + cbUdp, 2);
+            PutBE(frame, 0, 2);                                     // Identification
+            PutBE(frame, 0x4000, 2);                                // Don't fragment
+            frame.insert(frame.end(), { 64, 17 });                  // TTL, UDP
+            PutBE(frame, 0, 2);                                     // Checksum, filled in below
+            PutBE(frame, 0xC0A8010A, 4);
+            PutBE(frame, datagram.destination, 4);
+
+            uint32_t sum = 0;
+            for (size_t i = ip; i < ip + 20; i += 2)
+                sum += frame[i] << 8 | frame[i + 1];
+            sum = (sum & 0xFFFF) + (sum >> 16);
+            sum = ~((sum & 0xFFFF) + (sum >> 16)) & 0xFFFF;
+            frame[ip + 10] = sum >> 8;
+            frame[ip + 11] = sum & 0xFF;
+
+            PutBE(frame, datagram.port, 2);                         // Controllers commonly send from the same port
+            PutBE(frame, datagram.port, 2);
+            PutBE(frame, cbUdp, 2);
+            PutBE(frame, 0, 2);                                     // No UDP checksum
+            frame.insert(frame.end(), datagram.payload.begin(), datagram.payload.end());
+
+            PutLE(file, datagram.micros / MICROS_PER_SECOND, 4);
+            PutLE(file, datagram.micros % MICROS_PER_SECOND, 4);
+            PutLE(file, frame.size(), 4);
+            PutLE(file, frame.size(), 4);
+            file.insert(file.end(), frame.begin(), frame.end());
+        }
+        return file;
+    }
+
+    // ReadCapture
+    //
+    // The DDP, E1.31 and Art-Net datagrams in a libpcap capture, by destination port. Anything else,
+    // and IPv4 fragments, are skipped.
+
+    bool ReadCapture(const std::vector<uint8_t>& file, std::vector<Datagram>& datagrams)
+    {
+        if (file.size() < 24)
+            return false;
+
+        uint32_t magic = DWORDFromMemory(&file[0]);
+        const bool swapped = magic == ByteswapU32(kPcapMagicMicros) || magic == ByteswapU32(kPcapMagicNanos);
+        auto read32 = [&](size_t offset) { const uint32_t value = DWORDFromMemory(&file[offset]); return swapped ? ByteswapU32(value) : value; };
+
+        magic = read32(0);
+        if (magic != kPcapMagicMicros && magic != kPcapMagicNanos)
+        {
+            fprintf(stderr, "lighting: not a libpcap capture (pcapng can be converted with editcap -F pcap)\n");
+            return false;
+        }
+        const bool nanos = magic == kPcapMagicNanos;
+        const uint32_t link = read32(20) & 0x0FFFFFFF;
+
+        for (size_t offset = 24; offset + 16 <= file.size(); )
+        {
+            const uint64_t seconds  = read32(offset);
+            const uint64_t fraction = read32(offset + 4);
+            const size_t   cbFrame  = read32(offset + 8);
+            const size_t   start    = offset + 16;
+            offset = start + cbFrame;
+            if (offset > file.size())
+                break;
+
+            const uint8_t* p = &file[start];
+            size_t cb = cbFrame;
+
+            // Down to the IP header
+            size_t ip = 0;
+            uint16_t etherType = 0x0800;
+            switch (link)
+            {
+                case kLinkNull:      ip = 4;  etherType = cb >= 4 && (p[0] == 2 || p[3] == 2) ? 0x0800 : 0; break;
+                case kLinkRaw:       ip = 0;  break;
+                case kLinkLinuxSLL:  ip = 16; etherType = cb >= 16 ? WORDFromMemoryBE(&p[14]) : 0; break;
+                case kLinkLinuxSLL2: ip = 20; etherType = cb >= 20 ? WORDFromMemoryBE(&p[0]) : 0; break;
+                case kLinkEthernet:
+                    ip = 14;
+                    etherType = cb >= 14 ? WORDFromMemoryBE(&p[12]) : 0;
+                    while ((etherType == 0x8100 || etherType == 0x88A8) && cb >= ip + 4)
+                    {
+                        etherType = WORDFromMemoryBE(&p[ip + 2]);
+                        ip += 4;
+                    }
+                    break;
+                default:
+                    fprintf(stderr, "lighting: capture link type %u isn't supported\n", (unsigned)link);
+                    return false;
+            }
+
+            if (etherType != 0x0800 || cb < ip + 20 || (p[ip] >> 4) != 4 || p[ip + 9] != 17)
+                continue;
+            const size_t cbIpHeader = (p[ip] & 0x0F) * 4;
+            const uint16_t fragment = WORDFromMemoryBE(&p[ip + 6]);
+            if ((fragment & 0x3FFF) != 0)
+                continue;
+
+            cb = std::min<size_t>(cb, ip + WORDFromMemoryBE(&p[ip + 2]));
+            const size_t udp = ip + cbIpHeader;
+            if (cb < udp + 8)
+                continue;
+            const uint16_t port = WORDFromMemoryBE(&p[udp + 2]);
+            if (!IsLightingPort(port))
+                continue;
+
+            Datagram datagram;
+            datagram.micros      = seconds * MICROS_PER_SECOND + (nanos ? fraction / 1000 : fraction);
+            datagram.port        = port;
+            datagram.destination = DWORDFromMemoryBE(&p[ip + 16]);
+            datagram.payload.assign(p + udp + 8, p + std::min<size_t>(cb, udp + WORDFromMemoryBE(&p[udp + 4])));
+            datagrams.push_back(std::move(datagram));
+        }
+        return true;
+    }
+
+    // Record
+    //
+    // The datagrams a controller sends for a show of the given number of frames
+
+    std::vector<Datagram> Record(const Show& show, size_t frames, unsigned long seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<Datagram> datagrams;
+        uint64_t now = kEpoch;
+
+        auto send = [&](uint16_t port, uint32_t destination, std::vector<uint8_t> payload)
+        {
+            Datagram datagram;
+            datagram.micros      = now;
+            datagram.port        = port;
+            datagram.destination = destination;
+            datagram.payload     = std::move(payload);
+            datagrams.push_back(std::move(datagram));
+            now += 20;
+        };
+
+        constexpr uint32_t kDevice = 0xC0A80132;                    // 192.168.1.50
+
+        uint8_t sequence = 0;
+        std::vector<std::vector<uint8_t>> lastFrame;                // Universe packets of the frame before
+
+        // Art-Net data doesn't say it's synced, so the receiver only knows to wait once it has seen an
+        // ArtSync; controllers send them all along, so there's one before the first frame
+        if (show.sync && show.protocol == Protocol::ArtNet)
+            send(NetworkPort::ArtNet, kDevice, ArtSync());
+
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            now = kEpoch + frame * kInterval;
+            sequence++;
+            if (show.protocol == Protocol::ArtNet && sequence == 0)
+                sequence = 1;
+
+            std::vector<uint8_t> channelBytes[kChannels];
+            for (size_t c = 0; c < kChannels; c++)
+                for (size_t i = 0; i < kChannelLeds[c]; i++)
+                {
+                    const CRGB pixel = PatternPixel(frame, c, i);
+                    channelBytes[c].insert(channelBytes[c].end(), { pixel.r, pixel.g, pixel.b });
+                }
+
+            if (show.protocol == Protocol::DDP)
+            {
+                std::vector<uint8_t> span;
+                size_t first = 0;
+                for (size_t c = 0; c < kChannels; c++)
+                {
+                    if (show.partial && c < 1)
+                        first += channelBytes[c].size();
+                    if (!show.partial || c == 1)
+                        span.insert(span.end(), channelBytes[c].begin(), channelBytes[c].end());
+                }
+                for (size_t offset = 0; offset < span.size(); offset += kDDPChunk)
+                {
+                    const size_t cb = std::min(kDDPChunk, span.size() - offset);
+                    send(NetworkPort::DDP, kDevice, DDPPacket(first + offset, &span[offset], cb, offset + cb == span.size()));
+                }
+            }
+            else
+            {
+                // Each universe as its own packet, in channel order unless shuffled
+                struct Universe { uint16_t number; size_t channel; size_t index; };
+                std::vector<Universe> universes;
+                uint16_t number = show.protocol == Protocol::E131 ? kE131StartUniverse : kArtNetStartUniverse;
+                for (size_t c = 0; c < kChannels; c++)
+                    for (size_t u = 0; u < LightingReceiver::UniverseCount(kChannelLeds[c]); u++)
+                        universes.push_back({ number++, c, u });
+                if (show.shuffle)
+                    std::shuffle(universes.begin(), universes.end(), rng);
+
+                const bool losing = show.loseEvery && frame % show.loseEvery == show.loseEvery - 1 && frame + 1 < frames;
+                const size_t lost = frame % universes.size();
+
+                std::vector<std::vector<uint8_t>> packets;
+                for (size_t i = 0; i < universes.size(); i++)
+                {
+                    const auto& universe = universes[i];
+                    const auto& bytes = channelBytes[universe.channel];
+                    const size_t offset = universe.index * kUniverseBytes;
+                    const size_t cb = std::min(kUniverseBytes, bytes.size() - offset);
+
+                    auto packet = show.protocol == Protocol::E131
+                        ? E131Data(universe.number, sequence, show.sync ? kSyncAddress : 0, &bytes[offset], cb)
+                        : ArtDmx(universe.number, sequence, &bytes[offset], cb);
+                    packets.push_back(packet);
+
+                    if (losing && i == lost)
+                        continue;
+
+                    const uint32_t destination = show.protocol == Protocol::E131 ? 0xEFFF0000 | universe.number : kDevice;
+                    send(show.protocol == Protocol::E131 ? NetworkPort::E131 : NetworkPort::ArtNet, destination, std::move(packet));
+                }
+
+                if (show.sync)
+                {
+                    if (show.protocol == Protocol::E131)
+                        send(NetworkPort::E131, 0xEFFF0000 | kSyncAddress, E131Sync(sequence, kSyncAddress));
+                    else
+                        send(NetworkPort::ArtNet, kDevice, ArtSync());
+                }
+
+                if (show.staleEvery && frame % show.staleEvery == 0 && !lastFrame.empty())
+                    send(show.protocol == Protocol::E131 ? NetworkPort::E131 : NetworkPort::ArtNet, kDevice, lastFrame.front());
+
+                lastFrame = std::move(packets);
+            }
+
+            if (show.junk && frame % 10 == 5)
+            {
+                send(NetworkPort::DDP, kDevice, { 0x41, 0, 1, 1, 0, 0 });
+                auto e131 = E131Data(kE131StartUniverse, sequence, 0, channelBytes[0].data(), 30);
+                e131.resize(100);
+                send(NetworkPort::E131, kDevice, std::move(e131));
+                auto artnet = ArtDmx(kArtNetStartUniverse, sequence, channelBytes[0].data(), 30);
+                artnet.resize(15);
+                send(NetworkPort::ArtNet, kDevice, std::move(artnet));
+            }
+        }
+        return datagrams;
+    }
+
+    // Replay
+    //
+    // Feeds a capture through a receiver, taking each frame off the queues as soon as it's queued
+
+    ReplayResult Replay(const std::vector<Datagram>& datagrams, bool keepPixels)
+    {
+        std::vector<LEDBufferManager> managers;
+        managers.reserve(kChannels);
+        for (auto leds : kChannelLeds)
+            managers.emplace_back(kRingSize, std::make_shared<WS281xGFX>(leds, 1));
+
+        LightingReceiver receiver(managers.data(), managers.size(), kE131StartUniverse, kArtNetStartUniverse);
+
+        ReplayResult result;
+        std::vector<uint32_t> samples;
+        samples.reserve(datagrams.size());
+
+        for (const auto& datagram : datagrams)
+        {
+            const unsigned long start = micros();
+            receiver.Accept(ProtocolForPort(datagram.port), datagram.payload.data(), datagram.payload.size(), datagram.micros);
+            samples.push_back(micros() - start);
+            result.packets++;
+
+            for (size_t c = 0; c < kChannels; c++)
+            {
+                while (auto pBuffer = managers[c].GetOldestBuffer())
+                {
+                    Frame frame;
+                    frame.stamp = pBuffer->Seconds() * MICROS_PER_SECOND + pBuffer->MicroSeconds();
+                    if (keepPixels)
+                        frame.pixels.assign(pBuffer->Pixels(), pBuffer->Pixels() + pBuffer->Length());
+                    result.frames[c].push_back(std::move(frame));
+                }
+            }
+        }
+
+        result.presented     = receiver.FramesPresented();
+        result.syncs         = receiver.SyncPackets();
+        result.outOfSequence = receiver.OutOfSequence();
+        result.malformed     = receiver.MalformedPackets();
+        result.accept        = FrameStats::From(std::move(samples));
+        return result;
+    }
+
+    // CheckShow
+    //
+    // Records a show, replays it through a capture file's bytes, and checks every frame each channel got
+
+    int CheckShow(const Show& show, unsigned long seed, ReplayResult& result)
+    {
+        std::vector<Datagram> captured;
+        const auto recorded = Record(show, kScenarioFrames, seed);
+        if (!ReadCapture(WriteCapture(recorded), captured))
+            return Check(kSuite, false, str_sprintf("%s: capture didn't read back", show.name));
+
+        int failures = 0;
+        failures += Check(kSuite, captured.size() == recorded.size(), str_sprintf("%s: %zu of %zu datagrams read back", show.name, captured.size(), recorded.size()));
+
+        result = Replay(captured, true);
+
+        size_t universesBefore[kChannels] = {};
+        size_t totalUniverses = 0;
+        for (size_t c = 0; c < kChannels; c++)
+        {
+            universesBefore[c] = totalUniverses;
+            totalUniverses += LightingReceiver::UniverseCount(kChannelLeds[c]);
+        }
+
+        // The frames each channel should get, in order. A channel whose every universe a frame lost
+        // never hears of that frame.
+        auto lostUniverse = [&](size_t f) -> size_t
+        {
+            const bool losing = show.loseEvery && f % show.loseEvery == show.loseEvery - 1 && f + 1 < kScenarioFrames;
+            return losing && !show.shuffle ? f % totalUniverses : SIZE_MAX;
+        };
+
+        std::vector<size_t> sent[kChannels];
+        for (size_t c = 0; c < kChannels; c++)
+        {
+            if (show.partial && c != 1)
+                continue;
+            for (size_t f = 0; f < kScenarioFrames; f++)
+                if (LightingReceiver::UniverseCount(kChannelLeds[c]) > 1 || lostUniverse(f) != universesBefore[c])
+                    sent[c].push_back(f);
+        }
+
+        for (size_t c = 0; c < kChannels; c++)
+        {
+            const auto& frames = result.frames[c];
+            if (show.partial && c != 1)
+            {
+                failures += Check(kSuite, frames.empty(), str_sprintf("%s: channel %zu got %zu frames it wasn't sent", show.name, c, frames.size()));
+                continue;
+            }
+
+            failures += Check(kSuite, frames.size() == sent[c].size(), str_sprintf("%s: channel %zu got %zu of %zu frames", show.name, c, frames.size(), sent[c].size()));
+
+            size_t corrupt = 0;
+            for (size_t k = 0; k < frames.size() && k < sent[c].size(); k++)
+            {
+                // The universe a frame lost keeps the frame before's pixels
+                const size_t f = sent[c][k];
+                for (size_t i = 0; i < frames[k].pixels.size(); i++)
+                {
+                    const bool lost = universesBefore[c] + i / LightingReceiver::kPixelsPerUniverse == lostUniverse(f);
+                    if (frames[k].pixels[i] != PatternPixel(lost ? f - 1 : f, c, i))
+                    {
+                        corrupt++;
+                        break;
+                    }
+                }
+            }
+            failures += Check(kSuite, corrupt == 0, str_sprintf("%s: channel %zu has %zu frames with the wrong pixels", show.name, c, corrupt));
+        }
+
+        // Pushed and synced frames go out on every channel with the same stamp
+        if ((show.protocol == Protocol::DDP && !show.partial) || show.sync)
+        {
+            std::vector<uint64_t> stamps(kScenarioFrames, 0);
+            for (size_t k = 0; k < result.frames[0].size() && k < sent[0].size(); k++)
+                stamps[sent[0][k]] = result.frames[0][k].stamp;
+
+            size_t split = 0;
+            for (size_t c = 1; c < kChannels; c++)
+                for (size_t k = 0; k < result.frames[c].size() && k < sent[c].size(); k++)
+                    if (result.frames[c][k].stamp != stamps[sent[c][k]])
+                        split++;
+            failures += Check(kSuite, split == 0, str_sprintf("%s: %zu frames stamped differently across channels", show.name, split));
+        }
+
+        if (show.staleEvery)
+        {
+            const uint32_t stale = (kScenarioFrames - 1) / show.staleEvery;
+            failures += Check(kSuite, result.outOfSequence == stale, str_sprintf("%s: %u packets out of sequence, %u sent", show.name, result.outOfSequence, stale));
+        }
+        if (show.junk)
+            failures += Check(kSuite, result.malformed == kScenarioFrames / 10 * 3, str_sprintf("%s: %u packets malformed", show.name, result.malformed));
+        else
+            failures += Check(kSuite, result.malformed == 0, str_sprintf("%s: %u packets malformed", show.name, result.malformed));
+
+        return failures;
+    }
+
+    const Show kShows[] =
+    {
+        { "ddp",            Protocol::DDP,    false, false, false, 0,  0, true  },
+        { "ddp-partial",    Protocol::DDP,    false, false, true                },
+        { "e131",           Protocol::E131,   false, false, false, 0,  5        },
+        { "e131-sync",      Protocol::E131,   true,  true                       },
+        { "e131-lost",      Protocol::E131,   false, false, false, 10           },
+        { "e131-sync-lost", Protocol::E131,   true,  false, false, 10           },
+        { "artnet",         Protocol::ArtNet, false, false, false, 0,  5        },
+        { "artnet-sync",    Protocol::ArtNet, true,  true                       },
+    };
+
+    bool LoadFile(const std::string& path, std::vector<uint8_t>& bytes)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            fprintf(stderr, "lighting: can't open capture %s\n", path.c_str());
+            return false;
+        }
+
+        uint8_t chunk[4096];
+        for (size_t cb; (cb = fread(chunk, 1, sizeof(chunk), file)) > 0; )
+            bytes.insert(bytes.end(), chunk, chunk + cb);
+        fclose(file);
+        return true;
+    }
+
+    void PrintLayout()
+    {
+        size_t offset = 0;
+        uint16_t e131 = kE131StartUniverse, artnet = kArtNetStartUniverse;
+        for (size_t c = 0; c < kChannels; c++)
+        {
+            const uint16_t universes = LightingReceiver::UniverseCount(kChannelLeds[c]);
+            printf("channel %zu: %4zu LEDs, DDP bytes %zu-%zu, E1.31 universes %u-%u, Art-Net %u-%u\n", c, kChannelLeds[c],
+                   offset, offset + kChannelLeds[c] * 3 - 1, e131, e131 + universes - 1, artnet, artnet + universes - 1);
+            offset += kChannelLeds[c] * 3;
+            e131   += universes;
+            artnet += universes;
+        }
+    }
+}
+
+int RunLightingSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    std::vector<std::pair<const char*, ReplayResult>> results;
+
+    if (options.capture.empty())
+    {
+        for (const auto& show : kShows)
+        {
+            ReplayResult result;
+            failures += CheckShow(show, options.seed, result);
+            results.emplace_back(show.name, std::move(result));
+        }
+    }
+    else
+    {
+        std::vector<uint8_t> file;
+        std::vector<Datagram> captured;
+        if (!LoadFile(options.capture, file) || !ReadCapture(file, captured))
+            return 1;
+        failures += Check(kSuite, !captured.empty(), "capture has no DDP, E1.31 or Art-Net datagrams");
+        results.emplace_back(options.capture.c_str(), Replay(captured, false));
+    }
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "lighting";
+        doc["capture"]  = options.capture.empty() ? "synthesized" : options.capture.c_str();
+        doc["failures"] = failures;
+        for (const auto& [name, result] : results)
+        {
+            auto entry = doc["shows"].add<JsonObject>();
+            entry["name"]          = name;
+            entry["packets"]       = result.packets;
+            for (size_t c = 0; c < kChannels; c++)
+                entry["frames"].add(result.frames[c].size());
+            entry["syncs"]         = result.syncs;
+            entry["outOfSequence"] = result.outOfSequence;
+            entry["malformed"]     = result.malformed;
+            entry["acceptMedianUs"] = result.accept.median;
+            entry["acceptP99Us"]    = result.accept.p99;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        PrintLayout();
+        printf("\n%-16s %8s %20s %6s %6s %9s %11s %11s\n", "show", "packets", "frames per channel", "syncs", "stale", "malformed", "accept p50", "accept p99");
+        for (const auto& [name, result] : results)
+        {
+            const String frames = str_sprintf("%zu/%zu/%zu", result.frames[0].size(), result.frames[1].size(), result.frames[2].size());
+            printf("%-16s %8zu %20s %6u %6u %9u %11u %11u\n", name, result.packets, frames.c_str(), result.syncs,
+                   result.outOfSequence, result.malformed, result.accept.median, result.accept.p99);
+        }
+    }
+
+    return failures;
+}
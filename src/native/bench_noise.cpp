@@ -0,0 +1,269 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_noise.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite noise: checks that NoiseField reproduces FastLED's
+//    inoise16() sample for sample, then that FillGetNoise() leaves the
+//    noise pool exactly as the original one-inoise16-per-cell loop (kept
+//    here as the reference) does over a run of frames that drift, scroll
+//    by whole samples, stand still, rescale and change size. It then times
+//    both on three motions: drifting in x, y and z like MRI, scrolling by
+//    whole samples, and standing still like Smoke, at half and full matrix
+//    size. The noise effects themselves are timed with
+//    "nd_bench --effect @noise".
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <string>
+
+#include "gfxbase.h"
+#include "nd_bench.h"
+#include "noisefield.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    enum class Motion { Drift, Scroll, Still };
+
+    const char* MotionName(Motion motion)
+    {
+        return motion == Motion::Drift ? "drift" : motion == Motion::Scroll ? "scroll" : "still";
+    }
+
+    struct NoiseResult
+    {
+        uint16_t   width;
+        uint16_t   height;
+        Motion     motion;
+        FrameStats reference;
+        FrameStats field;
+    };
+
+    // FillGetNoiseImpl as it was before NoiseField: one inoise16 call per cell
+
+    void ReferenceFill(Noise& noise, size_t width, size_t height)
+    {
+        for (uint32_t i = 0; i < width; i++)
+        {
+            int32_t ioffset = noise.noise_scale_x * (int32_t)(i - (width / 2));
+
+            for (uint32_t j = 0; j < height; j++)
+            {
+                int32_t joffset = noise.noise_scale_y * (int32_t)(j - (height / 2));
+                uint8_t data    = inoise16(noise.noise_x + ioffset, noise.noise_y + joffset, noise.noise_z) >> 8;
+                uint8_t olddata = noise.noise[i][j];
+                uint8_t newdata = scale8(olddata, noise.noisesmoothing) + scale8(data, 256 - noise.noisesmoothing);
+
+                noise.noise[i][j] = newdata;
+            }
+        }
+    }
+
+    void Advance(Noise& noise, Motion motion)
+    {
+        switch (motion)
+        {
+            case Motion::Drift:
+                noise.noise_x += 388;
+                noise.noise_y -= 612;
+                noise.noise_z += 240;
+                break;
+            case Motion::Scroll:
+                noise.noise_x += noise.noise_scale_x;
+                break;
+            case Motion::Still:
+                break;
+        }
+    }
+
+    int CheckSamples()
+    {
+        auto check = [](uint32_t x, uint32_t y, uint32_t z)
+        {
+            const uint16_t expected = inoise16(x, y, z);
+            const uint16_t actual = NoiseField::Sample(x, y, z);
+            if (actual == expected)
+                return 0;
+            fprintf(stderr, "noise: Sample(0x%08x, 0x%08x, 0x%08x) gave %u, inoise16 %u\n", x, y, z, actual, expected);
+            return 1;
+        };
+
+        int failures = 0;
+
+        // Fractions at and either side of the ease curve's midpoint and the cell edges
+        constexpr uint16_t kFractions[] = { 0x0000, 0x0001, 0x7FFF, 0x8000, 0x8001, 0xFFFE, 0xFFFF };
+        for (uint32_t cell : { 0u, 1u, 0x7Fu, 0xFFu })
+            for (uint16_t fx : kFractions)
+                for (uint16_t fy : kFractions)
+                    for (uint16_t fz : kFractions)
+                        failures += check((cell << 16) | fx, ((cell ^ 0x5A) << 16) | fy, ((cell + 3) << 16) | fz);
+
+        auto random32 = []() { return static_cast<uint32_t>(random16()) << 16 | random16(); };
+        for (int i = 0; i < 100000 && failures < 10; i++)
+            failures += check(random32(), random32(), random32());
+
+        return failures;
+    }
+
+    // Runs the device and a copy of its noise state through the same frames, changing the
+    // parameters each frame the way one of the effects might
+
+    int CheckFill(uint16_t width, uint16_t height)
+    {
+        auto device = std::make_shared<WS281xGFX>(width, height);
+        Noise& noise = device->GetNoise();
+        auto reference = std::make_unique<Noise>(noise);
+
+        int failures = 0;
+        for (int frame = 0; frame < 400 && failures < 10; frame++)
+        {
+            auto change = [&](uint32_t Noise::*member, uint32_t value)
+            {
+                noise.*member = value;
+                (*reference).*member = value;
+            };
+            const int32_t steps = static_cast<int32_t>(random8(9)) - 4;
+
+            switch (frame % 8)
+            {
+                case 0:  change(&Noise::noise_x, noise.noise_x + noise.noise_scale_x * steps); break;
+                case 1:  change(&Noise::noise_y, noise.noise_y + noise.noise_scale_y * steps); break;
+                case 2:  change(&Noise::noise_x, noise.noise_x + noise.noise_scale_x * random16(3 * width));
+                         change(&Noise::noise_y, noise.noise_y - noise.noise_scale_y * steps); break;
+                case 3:  change(&Noise::noise_z, noise.noise_z + random16(2000)); break;
+                case 4:  change(&Noise::noise_x, noise.noise_x + random16(2000)); break;
+                case 5:  break;
+                case 6:  if (random8() < 32)
+                             change(&Noise::noise_scale_y, random16(10000) + 2000);
+                         break;
+                default: change(&Noise::noise_x, noise.noise_x + 1000);
+                         change(&Noise::noise_y, noise.noise_y + 1000); break;
+            }
+
+            // Halfway through, shrink the topology so the saved field no longer lines up
+            const uint16_t w = frame < 200 ? width : width / 2;
+            const uint16_t h = frame < 200 ? height : height / 2;
+            if (frame == 200)
+                device->ConfigureTopology(w, h, true);
+
+            device->FillGetNoise();
+            ReferenceFill(*reference, w, h);
+
+            auto mismatch = [&]()
+            {
+                for (uint16_t i = 0; i < w; i++)
+                {
+                    for (uint16_t j = 0; j < h; j++)
+                    {
+                        if (noise.noise[i][j] != reference->noise[i][j])
+                        {
+                            fprintf(stderr, "noise: frame %d cell (%u, %u) of %ux%u is %u, reference %u\n",
+                                    frame, i, j, w, h, noise.noise[i][j], reference->noise[i][j]);
+                            return 1;
+                        }
+                    }
+                }
+                return 0;
+            };
+            failures += mismatch();
+        }
+        return failures;
+    }
+
+    NoiseResult RunSize(const BenchOptions& options, uint16_t width, uint16_t height, Motion motion)
+    {
+        auto device = std::make_shared<WS281xGFX>(width, height);
+        const GFXBase* volatile opaqueDevice = device.get();
+        Noise& noise = device->GetNoise();
+        auto reference = std::make_unique<Noise>(noise);
+
+        NoiseResult result { width, height, motion };
+        result.reference = TimeFrames(options, [&]()
+        {
+            Advance(*reference, motion);
+            ReferenceFill(*reference, width, height);
+            KeepAlive(reference->noise[0][0]);
+        });
+        result.field = TimeFrames(options, [&]()
+        {
+            Advance(noise, motion);
+            opaqueDevice->FillGetNoise();
+            KeepAlive(noise.noise[0][0]);
+        });
+        return result;
+    }
+}
+
+int RunNoiseSuite(const BenchOptions& options)
+{
+    int failures = CheckSamples();
+    failures += CheckFill(MATRIX_WIDTH, MATRIX_HEIGHT);
+    failures += CheckFill(MATRIX_WIDTH - 3, MATRIX_HEIGHT - 5);
+
+    const NoiseResult results[] =
+    {
+        RunSize(options, MATRIX_WIDTH / 2, MATRIX_HEIGHT / 2, Motion::Drift),
+        RunSize(options, MATRIX_WIDTH,     MATRIX_HEIGHT,     Motion::Drift),
+        RunSize(options, MATRIX_WIDTH,     MATRIX_HEIGHT,     Motion::Scroll),
+        RunSize(options, MATRIX_WIDTH,     MATRIX_HEIGHT,     Motion::Still),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "noise";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["width"]             = result.width;
+            entry["height"]            = result.height;
+            entry["motion"]            = MotionName(result.motion);
+            entry["referenceMedianUs"] = result.reference.median;
+            entry["fieldMedianUs"]     = result.field.median;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "bit-identical");
+        printf("%-9s %-7s %14s %14s\n", "matrix", "motion", "reference us", "field us");
+        for (const auto& result : results)
+        {
+            printf("%4ux%-4u %-7s %14u %14u\n", result.width, result.height, MotionName(result.motion),
+                   result.reference.median, result.field.median);
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,292 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_pack.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite pack: checks that the kernel each PixelFormat hands
+//    out for every color order writes the same bytes as its Pack(), with
+//    and without a whites plane, across brightness and fader settings,
+//    white policies, and strips drawn short of, up to and past their
+//    length, and that the sums each kernel returns for the power limiter
+//    are what it packed. It then times Pack() against the kernel for RGB, RGBW and
+//    RGBCCW on a 2048 LED channel and reports pixels per second.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <ArduinoJson.h>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "nd_bench.h"
+#include "pixelformat.h"
+
+namespace
+{
+    using Order = DeviceConfig::WS281xColorOrder;
+
+    constexpr Order kOrders[] = { Order::RGB, Order::RBG, Order::GRB, Order::GBR, Order::BRG, Order::BGR };
+    constexpr size_t kTimedLeds = 2048;
+
+    struct WhitePolicy
+    {
+        uint16_t cctKelvin;
+        uint8_t  ambientCw;
+        uint8_t  ambientWw;
+        uint8_t  extractRatio;
+    };
+
+    struct PackResult
+    {
+        const char* name;
+        FrameStats  reference;
+        FrameStats  kernel;
+    };
+
+    // Output storage with the 4-byte alignment the channel buffers have on the device
+    struct AlignedBytes
+    {
+        std::vector<uint32_t> words;
+
+        explicit AlignedBytes(size_t byteCount) : words((byteCount + 3) / 4 + 1) {}
+        uint8_t* data() { return reinterpret_cast<uint8_t*>(words.data()); }
+    };
+
+    void Randomize(std::vector<CRGB>& leds, std::vector<CRGBW>& whites)
+    {
+        for (auto& pixel : leds)
+            pixel = CRGB(random8(), random8(), random8());
+
+        // Mostly unset, as effects leave them, so both sides of the pull branch get taken
+        for (auto& white : whites)
+            white = random8() < 192 ? CRGBW::Black() : CRGBW{ random8(), static_cast<uint8_t>(random8() & 1 ? random8() : 0) };
+
+        // Greys and saturated primaries, where the shared white is all or nothing
+        for (size_t i = 0; i < leds.size(); i += 5)
+        {
+            const uint8_t v = random8();
+            leds[i] = (i / 5) & 1 ? CRGB(v, v, v) : CRGB(v, 0, 255 - v);
+        }
+    }
+
+    // At full brightness and fader Pack() writes the very values a kernel sums, so
+    // summing its bytes by where the color order puts them gives the expected sums
+    PackSums SumPacked(const uint8_t* bytes, size_t ledCount, size_t bytesPerPixel, Order order)
+    {
+        const auto indices = PixelFormatHelpers::IndicesFor(order);
+        PackSums sums;
+        for (size_t i = 0; i < ledCount; ++i, bytes += bytesPerPixel)
+        {
+            sums.red   += bytes[indices.rIdx];
+            sums.green += bytes[indices.gIdx];
+            sums.blue  += bytes[indices.bIdx];
+            for (size_t white = 3; white < bytesPerPixel; ++white)
+                sums.white += bytes[white];
+        }
+        sums.pixels = ledCount;
+        return sums;
+    }
+
+    bool SameSums(const PackSums& a, const PackSums& b)
+    {
+        return a.red == b.red && a.green == b.green && a.blue == b.blue && a.white == b.white && a.pixels == b.pixels;
+    }
+
+    int CheckFormat(const char* name, const PixelFormat& format)
+    {
+        const WhitePolicy policies[] = { { 4000, 0, 0, 128 }, { 2700, 10, 3, 255 }, { 6500, 0, 40, 0 }, { 5100, 200, 100, 77 } };
+        const uint8_t levels[][2] = { { 255, 255 }, { 128, 255 }, { 37, 200 }, { 255, 1 }, { 0, 255 } };
+
+        // { active, shown }: empty, one pixel, less than a group, groups plus a remainder, drawn short, drawn past the end
+        const size_t sizes[][2] = { { 0, 0 }, { 1, 1 }, { 3, 3 }, { 67, 67 }, { 67, 30 }, { 64, 0 }, { 40, 90 } };
+
+        const size_t bytesPerPixel = format.BytesPerPixel();
+        std::vector<CRGB> leds(128);
+        std::vector<CRGBW> whites(leds.size());
+        AlignedBytes expected(leds.size() * bytesPerPixel), actual(leds.size() * bytesPerPixel), full(leds.size() * bytesPerPixel);
+
+        PackParams params;
+        int failures = 0;
+        for (const auto& policy : policies)
+        {
+            params.SetWhitePolicy(policy.cctKelvin, policy.ambientCw, policy.ambientWw, policy.extractRatio);
+            for (const auto& level : levels)
+            {
+                params.SetScale(level[0], level[1]);
+                for (auto order : kOrders)
+                {
+                    const PackKernel kernel = format.SelectKernel(order);
+                    for (const auto& size : sizes)
+                    {
+                        for (bool withWhites : { false, true })
+                        {
+                            Randomize(leds, whites);
+                            const CRGBW* plane = withWhites ? whites.data() : nullptr;
+                            const size_t byteCount = size[0] * bytesPerPixel;
+
+                            std::fill_n(expected.data(), byteCount, 0xA5);
+                            std::fill_n(actual.data(), byteCount + 4, 0x5A);
+                            format.Pack(expected.data(), leds.data(), plane, size[0], size[1], level[0], level[1], order,
+                                        policy.cctKelvin, policy.ambientCw, policy.ambientWw, policy.extractRatio);
+                            const PackSums sums = kernel(actual.data(), leds.data(), plane, size[0], size[1], params);
+                            format.Pack(full.data(), leds.data(), plane, size[0], size[1], 255, 255, order,
+                                        policy.cctKelvin, policy.ambientCw, policy.ambientWw, policy.extractRatio);
+
+                            const bool overran = std::any_of(actual.data() + byteCount, actual.data() + byteCount + 4,
+                                                             [](uint8_t b) { return b != 0x5A; });
+                            const bool differs = !std::equal(expected.data(), expected.data() + byteCount, actual.data());
+                            const bool wrongSums = !SameSums(sums, SumPacked(full.data(), size[0], bytesPerPixel, order));
+                            if (overran || differs || wrongSums)
+                            {
+                                fprintf(stderr, "pack: %s %s %zu/%zu LEDs%s, brightness %u fader %u, %uK ambient %u/%u ratio %u: %s\n",
+                                        name, DeviceConfig::GetColorOrderName(order).c_str(), size[1], size[0],
+                                        withWhites ? " with whites" : "", level[0], level[1], policy.cctKelvin,
+                                        policy.ambientCw, policy.ambientWw, policy.extractRatio,
+                                        overran ? "wrote past the channel" : differs ? "differs from Pack()" : "sums aren't what it packed");
+                                failures++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return failures;
+    }
+
+    // Gamma is folded into the scale table, so RGB output should be Pack() of the gamma-mapped colors
+    int CheckGamma()
+    {
+        std::array<uint8_t, 256> gamma;
+        for (size_t i = 0; i < gamma.size(); ++i)
+            gamma[i] = static_cast<uint8_t>(i * i / 255);
+
+        const Ws2812Format format;
+        std::vector<CRGB> leds(50), mapped(leds.size());
+        std::vector<CRGBW> whites(leds.size());
+        Randomize(leds, whites);
+        for (size_t i = 0; i < leds.size(); ++i)
+            mapped[i] = CRGB(gamma[leds[i].r], gamma[leds[i].g], gamma[leds[i].b]);
+
+        PackParams params;
+        params.SetScale(200, 180, gamma.data());
+        AlignedBytes expected(leds.size() * 3), actual(leds.size() * 3);
+        format.Pack(expected.data(), mapped.data(), nullptr, leds.size(), leds.size(), 200, 180, Order::GRB, 0, 0, 0, 0);
+        format.SelectKernel(Order::GRB)(actual.data(), leds.data(), nullptr, leds.size(), leds.size(), params);
+
+        if (std::equal(expected.data(), expected.data() + leds.size() * 3, actual.data()))
+            return 0;
+
+        fprintf(stderr, "pack: gamma scale table differs from Pack() of gamma-mapped colors\n");
+        return 1;
+    }
+
+    PackResult RunFormat(const BenchOptions& options, const char* name, const PixelFormat& format)
+    {
+        std::vector<CRGB> leds(kTimedLeds);
+        std::vector<CRGBW> whites(leds.size());
+        Randomize(leds, whites);
+        AlignedBytes output(leds.size() * format.BytesPerPixel());
+
+        // The white plane is only there on white-capable builds
+        const CRGBW* plane = format.BytesPerPixel() > 3 ? whites.data() : nullptr;
+        const PixelFormat* volatile opaqueFormat = &format;
+        const PackKernel kernel = format.SelectKernel(Order::GRB);
+        PackParams params;
+        params.SetWhitePolicy(4000, 0, 0, 128);
+        uint8_t brightness = 0;
+
+        PackResult result { name };
+        result.reference = TimeFrames(options, [&]()
+        {
+            opaqueFormat->Pack(output.data(), leds.data(), plane, leds.size(), leds.size(), brightness++, 255,
+                               Order::GRB, 4000, 0, 0, 128);
+            KeepAlive(output.words[0]);
+        });
+        result.kernel = TimeFrames(options, [&]()
+        {
+            params.SetScale(brightness++, 255);
+            kernel(output.data(), leds.data(), plane, leds.size(), leds.size(), params);
+            KeepAlive(output.words[0]);
+        });
+        return result;
+    }
+
+    double PixelsPerSecond(const FrameStats& stats)
+    {
+        return stats.median ? kTimedLeds * 1e6 / stats.median : 0;
+    }
+}
+
+int RunPackSuite(const BenchOptions& options)
+{
+    const Ws2812Format rgb;
+    const Sk6812Format rgbw;
+    const Ws2805Format rgbccw;
+
+    int failures = CheckFormat("RGB", rgb) + CheckFormat("RGBW", rgbw) + CheckFormat("RGBCCW", rgbccw) + CheckGamma();
+
+    const PackResult results[] =
+    {
+        RunFormat(options, "RGB",    rgb),
+        RunFormat(options, "RGBW",   rgbw),
+        RunFormat(options, "RGBCCW", rgbccw),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "pack";
+        doc["frames"]   = options.frames;
+        doc["leds"]     = kTimedLeds;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["format"]             = result.name;
+            entry["referenceMedianUs"]  = result.reference.median;
+            entry["kernelMedianUs"]     = result.kernel.median;
+            entry["referencePxPerSec"]  = PixelsPerSecond(result.reference);
+            entry["kernelPxPerSec"]     = PixelsPerSecond(result.kernel);
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%-8s %12s %12s %14s %14s\n", "format", "Pack() us", "kernel us", "Pack() Mpx/s", "kernel Mpx/s");
+        for (const auto& result : results)
+        {
+            printf("%-8s %12u %12u %14.1f %14.1f\n", result.name, result.reference.median, result.kernel.median,
+                   PixelsPerSecond(result.reference) / 1e6, PixelsPerSecond(result.kernel) / 1e6);
+        }
+    }
+
+    return failures;
+}
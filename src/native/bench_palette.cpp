@@ -0,0 +1,151 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_palette.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite palette: checks that ColorFromCurrentPalette, now
+//    served from the expanded palette cache, matches FastLED's
+//    ColorFromPalette on the current palette for every index and a spread
+//    of brightnesses: after loadPalette, setPalette, CyclePalette and each
+//    step of an UpdatePaletteCycle cross-fade. It then times a frame's worth
+//    of lookups both ways. The palette-heavy effects themselves are timed
+//    with "nd_bench --effect @palette".
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <string>
+
+#include "gfxbase.h"
+#include "nd_bench.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    constexpr uint8_t kBrightnesses[] = { 0, 1, 2, 31, 64, 127, 128, 200, 253, 254, 255 };
+
+    int CheckPalette(const GFXBase& device, const char* when)
+    {
+        for (uint8_t brightness : kBrightnesses)
+        {
+            for (int index = 0; index < 256; index++)
+            {
+                const CRGB expected = ColorFromPalette(device.GetCurrentPalette(), index, brightness, LINEARBLEND);
+                const CRGB actual = device.ColorFromCurrentPalette(index, brightness);
+                if (actual != expected)
+                {
+                    fprintf(stderr, "palette: %s: index %d brightness %u gave %02x%02x%02x, expected %02x%02x%02x\n",
+                            when, index, brightness, actual.r, actual.g, actual.b, expected.r, expected.g, expected.b);
+                    return 1;
+                }
+            }
+        }
+        return 0;
+    }
+
+    int CheckCache()
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        device->PausePalette(true);             // Keep ChangePalettePeriodically from moving the target
+        int failures = 0;
+
+        for (int index = 0; index < 9; index++)
+        {
+            device->loadPalette(index);
+            failures += CheckPalette(*device, str_sprintf("loadPalette(%d)", index).c_str());
+        }
+
+        device->CyclePalette();
+        failures += CheckPalette(*device, "CyclePalette");
+
+        device->setPalette(CRGBPalette16(CRGB::Red, CRGB::Black, CRGB::Green, CRGB::White));
+        failures += CheckPalette(*device, "setPalette");
+
+        // Rainbow fading toward Ice; the cache has to follow every step of the blend
+        device->loadPalette(0);
+        device->ColorFromCurrentPalette();
+        device->setupIcePalette();
+        for (int step = 0; step < 48; step++)
+        {
+            device->UpdatePaletteCycle();
+            failures += CheckPalette(*device, str_sprintf("UpdatePaletteCycle step %d", step).c_str());
+        }
+
+        return failures;
+    }
+}
+
+int RunPaletteSuite(const BenchOptions& options)
+{
+    const int failures = CheckCache();
+
+    auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+    device->loadPalette(0);
+    const GFXBase* volatile opaqueDevice = device.get();
+    const CRGBPalette16 palette = device->GetCurrentPalette();
+    const size_t lookups = MATRIX_WIDTH * MATRIX_HEIGHT;
+    uint8_t t = 0;
+
+    // One lookup per pixel with a varying index and brightness, like a noise effect's inner loop
+    const FrameStats direct = TimeFrames(options, [&]()
+    {
+        CRGB sum;
+        for (size_t i = 0; i < lookups; i++)
+            sum += ColorFromPalette(palette, i * 7 + t, 128 + (i & 0x7F), LINEARBLEND);
+        KeepAlive(sum);
+        t++;
+    });
+    const FrameStats cached = TimeFrames(options, [&]()
+    {
+        CRGB sum;
+        for (size_t i = 0; i < lookups; i++)
+            sum += opaqueDevice->ColorFromCurrentPalette(i * 7 + t, 128 + (i & 0x7F));
+        KeepAlive(sum);
+        t++;
+    });
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]          = "palette";
+        doc["frames"]         = options.frames;
+        doc["failures"]       = failures;
+        doc["lookups"]        = lookups;
+        doc["directMedianUs"] = direct.median;
+        doc["cachedMedianUs"] = cached.median;
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "bit-identical");
+        printf("%zu lookups per frame: ColorFromPalette %u us, ColorFromCurrentPalette %u us\n",
+               lookups, direct.median, cached.median);
+    }
+
+    return failures;
+}
@@ -0,0 +1,286 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_pixelmap.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite pixelmap: checks that PixelMap builds the tables the
+//    layout format promises (plain matrices, rotated and chained tiles,
+//    gaps), that the binary format round-trips and rejects bad input, and
+//    that ConfigureTopology picks a map up from SPIFFS. It then times a
+//    full-frame write through the lookup table against the plain
+//    serpentine xy() at 64x32 and 128x64.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <SPIFFS.h>
+#include <string>
+#include <vector>
+
+#include "gfxbase.h"
+#include "nd_bench.h"
+#include "pixelmap.h"
+#include "ws281xgfx.h"
+#include "xymapping.h"
+
+namespace
+{
+    struct PixelMapResult
+    {
+        uint16_t   width;
+        uint16_t   height;
+        FrameStats plainXY;
+        FrameStats tableXY;
+    };
+
+    constexpr const char* kSuite = "pixelmap";
+
+    // Same shape as the xy suite's frame so the two sets of numbers can be compared
+
+    template <typename MapXY>
+    __attribute__((noinline)) void RenderFrame(CRGB* leds, uint16_t width, uint16_t height, MapXY mapXY, uint8_t t)
+    {
+        for (uint16_t x = 0; x < width; x++)
+            for (uint16_t y = 0; y < height; y++)
+                leds[mapXY(x, y)] = CRGB(x + t, y - t, x ^ y);
+    }
+
+    struct VirtualXY
+    {
+        const GFXBase* device;
+
+        uint16_t operator()(uint16_t x, uint16_t y) const noexcept
+        {
+            return device->xy(x, y);
+        }
+    };
+
+    // A single full-size tile has to reproduce the built-in column wiring exactly
+
+    int CheckPlainMatrix(uint16_t width, uint16_t height, bool serpentine)
+    {
+        PixelMap::Table table;
+        auto [ok, reason] = PixelMap::FromTiles({ { 0, 0, width, height, 0, serpentine } }, width, height, table);
+        if (!ok)
+            return Check(kSuite, false, reason.c_str());
+
+        for (uint16_t x = 0; x < width; x++)
+        {
+            for (uint16_t y = 0; y < height; y++)
+            {
+                const uint16_t expected = x * height + ((serpentine && (x & 0x01)) ? height - 1 - y : y);
+                if (table[y * width + x] != expected)
+                    return Check(kSuite, false, "single tile doesn't match the built-in column wiring");
+            }
+        }
+        return 0;
+    }
+
+    // Small layouts worked out by hand, written as the row-major grid tools/pixelmap.py --print shows
+
+    int CheckHandLayouts()
+    {
+        int failures = 0;
+        PixelMap::Table table;
+
+        // Two 2x2 serpentine panels side by side, the second mounted upside down
+        PixelMap::FromTiles({ { 0, 0, 2, 2, 0 }, { 2, 0, 2, 2, 180 } }, 4, 2, table);
+        failures += Check(kSuite, table == PixelMap::Table { 0, 3, 6, 5,
+                                                     1, 2, 7, 4 }, "chained 0/180 degree panels");
+
+        // A 3x2 linear panel turned 90 degrees clockwise
+        PixelMap::FromTiles({ { 0, 0, 3, 2, 90, false } }, 3, 2, table);
+        failures += Check(kSuite, table == PixelMap::Table { 2, 1, 0,
+                                                     5, 4, 3 }, "90 degree panel");
+
+        // A 2x2 panel whose chain starts one LED in, with the left column of the grid unwired; the
+        // gap cells park on the skipped LED first, then past the end of the chain
+        PixelMap::FromTiles({ { 1, 0, 2, 2, 270, true, 1 } }, 3, 2, table);
+        failures += Check(kSuite, table == PixelMap::Table { 0, 4, 3,
+                                                     5, 1, 2 }, "skipped LEDs and gap cells");
+
+        return failures;
+    }
+
+    int CheckErrors()
+    {
+        int failures = 0;
+        PixelMap::Table table;
+
+        failures += Check(kSuite, !PixelMap::FromTiles({ { 0, 0, 2, 2 }, { 1, 0, 2, 2 } }, 4, 2, table).first, "overlapping tiles accepted");
+        failures += Check(kSuite, table.empty(), "failed build left a table behind");
+        failures += Check(kSuite, !PixelMap::FromTiles({ { 3, 0, 2, 2 } }, 4, 2, table).first, "out-of-bounds tile accepted");
+        failures += Check(kSuite, !PixelMap::FromTiles({ { 0, 0, 2, 2, 45 } }, 4, 2, table).first, "45 degree rotation accepted");
+        failures += Check(kSuite, !PixelMap::FromTiles({ { 0, 0, 4, 2, 0, true, 1 } }, 4, 2, table).first, "chain longer than the matrix accepted");
+
+        JsonDocument layout;
+        layout["width"] = 8;
+        layout["height"] = 2;
+        layout["tiles"].add<JsonObject>();
+        failures += Check(kSuite, !PixelMap::FromLayout(layout.as<JsonObjectConst>(), 4, 2, table).first, "layout for another size accepted");
+
+        return failures;
+    }
+
+    int CheckBinary()
+    {
+        int failures = 0;
+        PixelMap::Table table, loaded;
+        PixelMap::FromTiles({ { 0, 0, 2, 2, 0 }, { 2, 0, 2, 2, 180 } }, 4, 2, table);
+
+        auto data = PixelMap::ToBinary(table, 4, 2);
+        failures += Check(kSuite, PixelMap::FromBinary(data.data(), data.size(), 4, 2, loaded).first && loaded == table, "binary round trip");
+        failures += Check(kSuite, !PixelMap::FromBinary(data.data(), data.size(), 2, 4, loaded).first, "binary map for another size accepted");
+        failures += Check(kSuite, !PixelMap::FromBinary(data.data(), data.size() - 1, 4, 2, loaded).first, "truncated binary map accepted");
+
+        auto repeated = data;
+        repeated[PixelMap::kHeaderSize] = repeated[PixelMap::kHeaderSize + 2];
+        failures += Check(kSuite, !PixelMap::FromBinary(repeated.data(), repeated.size(), 4, 2, loaded).first, "binary map with a repeated LED accepted");
+
+        auto corrupt = data;
+        corrupt[0] = 'X';
+        failures += Check(kSuite, !PixelMap::FromBinary(corrupt.data(), corrupt.size(), 4, 2, loaded).first, "binary map with a bad magic accepted");
+
+        return failures;
+    }
+
+    // ConfigureTopology should pick up either file from SPIFFS, and drop back to the built-in
+    // wiring when the map is for a different size
+
+    int CheckLoad()
+    {
+        int failures = 0;
+        auto device = std::make_shared<WS281xGFX>(4, 2);
+
+        PixelMap::Table table;
+        PixelMap::FromTiles({ { 0, 0, 2, 2, 0 }, { 2, 0, 2, 2, 180 } }, 4, 2, table);
+        const auto data = PixelMap::ToBinary(table, 4, 2);
+
+        SPIFFS.open(PIXEL_MAP_FILE, FILE_WRITE).write(data.data(), data.size());
+        device->ConfigureTopology(4, 2, true);
+        failures += Check(kSuite, device->GetXYLayout() == XYLayout::Table && device->xy(3, 1) == 4, "binary map not applied by ConfigureTopology");
+
+        device->ConfigureTopology(2, 4, true);
+        failures += Check(kSuite, device->GetXYLayout() == XYLayout::ColumnSerpentine, "map for another size applied");
+        SPIFFS.remove(PIXEL_MAP_FILE);
+
+        SPIFFS.open(PIXEL_LAYOUT_FILE, FILE_WRITE).print(
+            R"({ "width": 3, "height": 2, "tiles": [ { "width": 3, "height": 2, "rotation": 90, "serpentine": false } ] })");
+        device->ConfigureTopology(3, 2, true);
+        failures += Check(kSuite, device->GetXYLayout() == XYLayout::Table && device->xy(0, 0) == 2, "layout not applied by ConfigureTopology");
+        SPIFFS.remove(PIXEL_LAYOUT_FILE);
+
+        device->ConfigureTopology(3, 2, true);
+        failures += Check(kSuite, device->GetXYLayout() == XYLayout::ColumnSerpentine, "map still applied after its file was removed");
+
+        return failures;
+    }
+
+    PixelMapResult RunSize(const BenchOptions& options, uint16_t width, uint16_t height)
+    {
+        auto plain = std::make_shared<WS281xGFX>(width, height);
+        plain->ConfigureTopology(width, height, true);
+
+        // Same wiring as the plain device, but reached through the table
+        auto mapped = std::make_shared<WS281xGFX>(width, height);
+        PixelMap::Table table;
+        PixelMap::FromTiles({ { 0, 0, width, height } }, width, height, table);
+        const auto data = PixelMap::ToBinary(table, width, height);
+        SPIFFS.open(PIXEL_MAP_FILE, FILE_WRITE).write(data.data(), data.size());
+        mapped->ConfigureTopology(width, height, true);
+        SPIFFS.remove(PIXEL_MAP_FILE);
+
+        const GFXBase* volatile opaquePlain = plain.get();
+        const GFXBase* volatile opaqueMapped = mapped.get();
+
+        PixelMapResult result { width, height };
+        uint8_t t = 0;
+
+        result.plainXY = TimeFrames(options, [&]()
+        {
+            RenderFrame(plain->leds, width, height, VirtualXY { opaquePlain }, t++);
+            KeepAlive(plain->leds[0]);
+        });
+        result.tableXY = TimeFrames(options, [&]()
+        {
+            opaqueMapped->WithXY([&](auto mapXY)
+            {
+                RenderFrame(mapped->leds, width, height, mapXY, t++);
+            });
+            KeepAlive(mapped->leds[0]);
+        });
+        return result;
+    }
+}
+
+int RunPixelMapSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    failures += CheckPlainMatrix(64, 32, true);
+    failures += CheckPlainMatrix(64, 32, false);
+    failures += CheckHandLayouts();
+    failures += CheckErrors();
+    failures += CheckBinary();
+    failures += CheckLoad();
+
+    const PixelMapResult results[] =
+    {
+        RunSize(options, 64, 32),
+        RunSize(options, 128, 64),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "pixelmap";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["width"]         = result.width;
+            entry["height"]        = result.height;
+            entry["plainMedianUs"] = result.plainXY.median;
+            entry["plainP99Us"]    = result.plainXY.p99;
+            entry["tableMedianUs"] = result.tableXY.median;
+            entry["tableP99Us"]    = result.tableXY.p99;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%-9s %14s %14s\n", "matrix", "xy() us", "table us");
+        for (const auto& result : results)
+            printf("%4ux%-4u %14u %14u\n", result.width, result.height, result.plainXY.median, result.tableXY.median);
+    }
+
+    return failures;
+}
@@ -0,0 +1,242 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_polar.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite polar: checks that PolarLUT's centered map holds what
+//    the old GFXBase::getPolarMap() table did, that its squared_radius
+//    gives Crystallize the same distance term ZVcalcDist() computed, and
+//    that the cache shares maps, drops them when the size changes and
+//    counts its bytes. It then times a RadialWave-style frame with atan2f
+//    and hypotf per pixel against the same frame read from the map, and
+//    the one-off cost of building a map, at 64x32, 128x64 and 256x128.
+//    The radial effects themselves are timed with
+//    "nd_bench --effect @polar".
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "nd_bench.h"
+#include "polarlut.h"
+
+namespace
+{
+    struct PolarResult
+    {
+        uint16_t   width;
+        uint16_t   height;
+        FrameStats computed;
+        FrameStats lookup;
+        uint32_t   buildUs;
+    };
+
+    constexpr const char* kSuite = "polar";
+
+    // The body of getPolarMap(), for one pixel of a width x height matrix
+
+    PolarLUT::Entry ReferenceEntry(uint16_t width, uint16_t height, uint16_t column, uint16_t row)
+    {
+        const int16_t C_X = width / 2;
+        const int16_t C_Y = height / 2;
+        const float mapp = 255.0f / width;
+        const int16_t x = column - C_X;
+        const int16_t y = row - C_Y;
+
+        float angle_rad = atan2f(static_cast<float>(y), static_cast<float>(x));
+        float radius_float = hypotf(static_cast<float>(x), static_cast<float>(y));
+
+        PolarLUT::Entry entry {};
+        entry.angle = static_cast<int>(128.0f * (angle_rad / (float)M_PI));
+        entry.scaled_radius = radius_float * mapp;
+        entry.unscaled_radius = radius_float;
+        return entry;
+    }
+
+    // PatternSM2DDPR::ZVcalcDist() as it was, centered on the middle of the matrix
+
+    int16_t ReferenceCrystallizeDist(uint16_t width, uint16_t height, uint8_t x, uint8_t y)
+    {
+        const float center_x = width * .5;
+        const float center_y = height * .5;
+        int16_t a = (center_y - y - .5);
+        int16_t b = (center_x - x - .5);
+        a *= a;
+        b *= b;
+        return sin8(a + b);
+    }
+
+    int CheckMaps(uint16_t width, uint16_t height)
+    {
+        const auto centered = PolarLUT::Get(PolarLUT::Params::Centered(width, height));
+        const auto geometric = PolarLUT::Get(PolarLUT::Params::Geometric(width, height));
+
+        for (uint16_t x = 0; x < width; x++)
+        {
+            for (uint16_t y = 0; y < height; y++)
+            {
+                const auto expected = ReferenceEntry(width, height, x, y);
+                const auto& actual = centered->at(x, y);
+                if (actual.angle != expected.angle || actual.scaled_radius != expected.scaled_radius || actual.unscaled_radius != expected.unscaled_radius)
+                    return Check(kSuite, false, str_sprintf("%ux%u centered map differs from getPolarMap() at (%u, %u)", width, height, x, y).c_str());
+
+                if (sin8(geometric->at(x, y).squared_radius) != ReferenceCrystallizeDist(width, height, x, y))
+                    return Check(kSuite, false, str_sprintf("%ux%u squared_radius differs from ZVcalcDist() at (%u, %u)", width, height, x, y).c_str());
+
+                if (&(*centered)[x][y] != &actual)
+                    return Check(kSuite, false, "map[x][y] and at(x, y) disagree");
+            }
+        }
+        return 0;
+    }
+
+    int CheckCache()
+    {
+        int failures = 0;
+
+        const auto first = PolarLUT::Get(PolarLUT::Params::Centered(40, 20));
+        failures += Check(kSuite, PolarLUT::Get(PolarLUT::Params::Centered(40, 20)) == first, "same params built a second map");
+        failures += Check(kSuite, PolarLUT::BytesInUse() == 40 * 20 * sizeof(PolarLUT::Entry), "cache holds maps for other sizes");
+
+        const auto other = PolarLUT::Get(PolarLUT::Params::Geometric(40, 20));
+        failures += Check(kSuite, other != first, "different centers shared a map");
+        failures += Check(kSuite, PolarLUT::BytesInUse() == 2 * 40 * 20 * sizeof(PolarLUT::Entry), "second center not counted");
+
+        // A new topology drops both, but the map still held here stays valid
+        const auto resized = PolarLUT::Get(PolarLUT::Params::Centered(24, 12));
+        failures += Check(kSuite, PolarLUT::BytesInUse() == 24 * 12 * sizeof(PolarLUT::Entry), "maps for the old size kept after a resize");
+        failures += Check(kSuite, first->width() == 40 && first->at(39, 19).unscaled_radius == ReferenceEntry(40, 20, 39, 19).unscaled_radius,
+                          "held map changed after it left the cache");
+        failures += Check(kSuite, PolarLUT::Get(PolarLUT::Params::Centered(40, 20)) != first, "dropped map came back from the cache");
+
+        return failures;
+    }
+
+    PolarResult RunSize(const BenchOptions& options, uint16_t width, uint16_t height)
+    {
+        std::vector<CRGB> frame(width * height);
+        PolarResult result { width, height };
+        uint32_t t = 0;
+
+        // RadialWave's Draw(), with the polar terms worked out per pixel as the effects used to
+        result.computed = TimeFrames(options, [&]()
+        {
+            t++;
+            const int16_t cx = width / 2, cy = height / 2;
+            const float mapp = 255.0f / width;
+            for (uint16_t x = 0; x < width; x++)
+            {
+                for (uint16_t y = 0; y < height; y++)
+                {
+                    const float fx = x - cx, fy = y - cy;
+                    const uint8_t angle = static_cast<int>(128.0f * (atan2f(fy, fx) / (float)M_PI));
+                    const uint8_t radius = hypotf(fx, fy) * mapp;
+                    frame[x * height + y] = CHSV(t + radius, 255, sin8(t * 4 + sin8(t * 4 - radius) + angle * 3));
+                }
+            }
+            KeepAlive(frame[0]);
+        });
+
+        result.lookup = TimeFrames(options, [&]()
+        {
+            t++;
+            const auto polar = PolarLUT::Get(PolarLUT::Params::Centered(width, height));
+            const auto& rMap = *polar;
+            for (uint16_t x = 0; x < width; x++)
+            {
+                for (uint16_t y = 0; y < height; y++)
+                {
+                    const uint8_t angle = rMap[x][y].angle;
+                    const uint8_t radius = rMap[x][y].scaled_radius;
+                    frame[x * height + y] = CHSV(t + radius, 255, sin8(t * 4 + sin8(t * 4 - radius) + angle * 3));
+                }
+            }
+            KeepAlive(frame[0]);
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        const PolarLUT built(PolarLUT::Params::Centered(width, height));
+        KeepAlive(built.at(0, 0).angle);
+        result.buildUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
+}
+
+int RunPolarSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    failures += CheckMaps(MATRIX_WIDTH, MATRIX_HEIGHT);
+    failures += CheckMaps(17, 11);
+    failures += CheckMaps(16, 16);
+    failures += CheckCache();
+
+    const PolarResult results[] =
+    {
+        RunSize(options, 64,  32),
+        RunSize(options, 128, 64),
+        RunSize(options, 256, 128),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "polar";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["width"]            = result.width;
+            entry["height"]           = result.height;
+            entry["computedMedianUs"] = result.computed.median;
+            entry["lookupMedianUs"]   = result.lookup.median;
+            entry["buildUs"]          = result.buildUs;
+            entry["mapBytes"]         = result.width * result.height * sizeof(PolarLUT::Entry);
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%-9s %14s %14s %10s %10s\n", "matrix", "atan2/hypot us", "lookup us", "build us", "map bytes");
+        for (const auto& result : results)
+        {
+            printf("%4ux%-4u %14u %14u %10u %10zu\n", result.width, result.height,
+                   result.computed.median, result.lookup.median, result.buildUs,
+                   result.width * result.height * sizeof(PolarLUT::Entry));
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,411 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_queue.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite queue: checks LEDBufferManager's lock-free frame
+//    queue. On one thread it runs random commits, takes and Reconfigure()
+//    calls against a plain deque that drops the oldest frame when full and
+//    replaces the newest when a frame repeats its timestamp, comparing the
+//    queue after every step. Then a socket thread and a render thread hammer
+//    it at once: every frame the render thread takes must be whole, in
+//    order, and left alone while it holds it, and the last frame sent must
+//    arrive. Finally it times the render thread's take while the socket
+//    thread queues full frames flat out, with the old g_buffer_mutex
+//    locking (the copy into the buffer made under the lock, as
+//    ProcessIncomingData did) against none.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    constexpr uint32_t kStressLeds = 256;       // Enough pixels that a torn frame shows, few enough to go fast
+    constexpr uint32_t kDrawMicros = 500;       // How long the timed render thread holds each frame
+
+    struct QueueResult
+    {
+        const char* name;
+        FrameStats  take;
+        double      queuedPerSecond;
+    };
+
+    constexpr const char* kSuite = "queue";
+
+    // Frames are identified by their timestamp, in seconds, and a version for resends of the same
+    // timestamp; every pixel carries both so a frame mixed from two shows up
+
+    CRGB PixelFor(uint32_t id, uint8_t version, uint32_t i)
+    {
+        return CRGB(static_cast<uint8_t>(id), static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(version * 31 + i));
+    }
+
+    void FillFrame(LEDBuffer& buffer, uint32_t id, uint8_t version, uint32_t leds)
+    {
+        for (uint32_t i = 0; i < leds; i++)
+            buffer.Pixels()[i] = PixelFor(id, version, i);
+        buffer.SetFrame(id, 1, leds);
+    }
+
+    // The frame's version if every pixel agrees with its id, else -1
+
+    int FrameVersion(const LEDBuffer& buffer, uint32_t id, uint32_t leds)
+    {
+        const uint8_t version = static_cast<uint8_t>((buffer.Pixels()[0].b) / 31);
+        for (uint32_t i = 0; i < leds; i++)
+            if (buffer.Pixels()[i] != PixelFor(id, version, i))
+                return -1;
+        return version;
+    }
+
+    // The queue as it's meant to behave
+
+    struct ModelFrame
+    {
+        uint64_t seconds;
+        uint64_t micros;
+        uint8_t  tag;
+    };
+
+    bool SameAsModel(const LEDBufferManager& manager, const std::deque<ModelFrame>& model)
+    {
+        if (manager.Depth() != model.size())
+            return false;
+
+        for (size_t i = 0; i < model.size(); i++)
+        {
+            auto pBuffer = manager[i];
+            if (!pBuffer || pBuffer->Seconds() != model[i].seconds || pBuffer->MicroSeconds() != model[i].micros || pBuffer->Pixels()[0].r != model[i].tag)
+                return false;
+        }
+
+        uint64_t seconds = 0, micros = 0;
+        if (model.empty())
+            return !manager.PeekOldestTime(seconds, micros) && !manager.PeekNewestTime(seconds, micros);
+
+        return manager.PeekOldestTime(seconds, micros) && seconds == model.front().seconds && micros == model.front().micros
+            && manager.PeekNewestTime(seconds, micros) && seconds == model.back().seconds && micros == model.back().micros;
+    }
+
+    int CheckModel(uint32_t cSlots)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(cSlots, device);
+        std::deque<ModelFrame> model;
+        std::minstd_rand rng(cSlots);
+        std::shared_ptr<LEDBuffer> pDrawing;
+        uint8_t drawingTag = 0, tag = 0;
+        uint64_t seconds = 100, micros = 1;
+        uint32_t overwritten = 0;
+        int failures = 0;
+
+        for (int step = 0; step < 5000 && failures < 10; step++)
+        {
+            const uint32_t roll = rng() % 100;
+            if (roll < 60)
+            {
+                // Mostly new timestamps, some repeats of the last one, some with no micros at all
+                const uint32_t kind = rng() % 8;
+                if (kind < 5)
+                    micros = 1 + micros % 999999;
+                else if (kind == 5)
+                    micros = 0;
+                seconds += kind < 5;
+
+                auto pBuffer = manager.ReserveBuffer(BufferReservation::Socket);
+                failures += Check(kSuite, pBuffer != pDrawing, "reservation is the buffer being drawn");
+                pBuffer->Pixels()[0] = CRGB(++tag, 0, 0);
+                pBuffer->SetFrame(seconds, micros, 1);
+                failures += Check(kSuite, manager.CommitBuffer(pBuffer), "commit refused");
+
+                const ModelFrame frame { seconds, micros, tag };
+                if (!model.empty() && micros != 0 && model.back().seconds == seconds && model.back().micros == micros)
+                    model.back() = frame;
+                else
+                {
+                    if (model.size() == cSlots)
+                    {
+                        model.pop_front();
+                        overwritten++;
+                    }
+                    model.push_back(frame);
+                }
+            }
+            else if (roll < 98)
+            {
+                // The frame handed out last must have been left alone until now
+                if (pDrawing)
+                    failures += Check(kSuite, pDrawing->Pixels()[0].r == drawingTag, "buffer being drawn was overwritten");
+
+                pDrawing = manager.GetOldestBuffer();
+                if (model.empty())
+                    failures += Check(kSuite, !pDrawing, "frame taken from an empty queue");
+                else
+                {
+                    failures += Check(kSuite, pDrawing && pDrawing->Seconds() == model.front().seconds && pDrawing->Pixels()[0].r == model.front().tag,
+                                      "took the wrong frame");
+                    drawingTag = model.front().tag;
+                    model.pop_front();
+                }
+            }
+            else
+            {
+                manager.Reconfigure(device);
+                model.clear();
+                pDrawing.reset();
+            }
+
+            if (!SameAsModel(manager, model))
+                failures += Check(kSuite, false, str_sprintf("queue of %u differs from the model after step %d", cSlots, step).c_str());
+        }
+
+        failures += Check(kSuite, manager.Scheduler().OverwrittenFrames() == overwritten, "frames pushed out of a full queue miscounted");
+        return failures;
+    }
+
+    // A socket thread queueing frames, some sent twice with the same timestamp, against a render
+    // thread taking them as fast as it can
+
+    int CheckThreads(uint32_t cSlots, uint32_t frames)
+    {
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(cSlots, device);
+        std::atomic<bool> done { false };
+        uint8_t lastVersion = 0;
+
+        std::thread socket([&]()
+        {
+            std::minstd_rand rng(frames);
+            for (uint32_t id = 1; id <= frames; id++)
+            {
+                const uint8_t versions = rng() % 8 == 0 ? 2 + rng() % 3 : 1;
+                for (uint8_t version = 0; version < versions; version++)
+                {
+                    auto pBuffer = manager.ReserveBuffer(BufferReservation::Socket);
+                    FillFrame(*pBuffer, id, version, kStressLeds);
+                    manager.CommitBuffer(pBuffer);
+                }
+                lastVersion = versions - 1;
+                if (rng() % 64 == 0)
+                    std::this_thread::yield();
+            }
+            done = true;
+        });
+
+        int failures = 0;
+        uint32_t lastId = 0, taken = 0;     // taken varies how long each frame is held
+        int lastSeen = -1;
+        for (bool finished = false; !finished && failures < 10; )
+        {
+            finished = done;
+
+            uint64_t seconds, micros;
+            if (manager.PeekOldestTime(seconds, micros))
+                failures += Check(kSuite, seconds >= 1 && seconds <= frames && micros == 1, "peeked a timestamp that was never queued");
+            failures += Check(kSuite, manager.Depth() <= cSlots, "queue deeper than its slots");
+
+            auto pBuffer = manager.GetOldestBuffer();
+            if (!pBuffer)
+            {
+                if (finished)
+                    break;
+                continue;
+            }
+
+            // Whole, in order, and still whole after holding it a while as a draw would
+            const uint32_t id = pBuffer->Seconds();
+            const int version = FrameVersion(*pBuffer, id, kStressLeds);
+            if (version < 0 || id < lastId || (id == lastId && version <= lastSeen))
+            {
+                failures += Check(kSuite, false, str_sprintf("frame %u version %d taken after frame %u version %d, or torn", id, version, lastId, lastSeen).c_str());
+                continue;
+            }
+            for (volatile int spin = taken % 4 * 200; spin > 0; spin--)
+                ;
+            failures += Check(kSuite, FrameVersion(*pBuffer, id, kStressLeds) == version, "buffer being drawn was overwritten");
+
+            lastId = id;
+            lastSeen = version;
+            taken++;
+            finished = false;
+        }
+        socket.join();
+
+        failures += Check(kSuite, lastId == frames && lastSeen == lastVersion, str_sprintf("last frame taken was %u version %d", lastId, lastSeen).c_str());
+        return failures;
+    }
+
+    // Times the render thread's take while a socket thread queues full frames as fast as it can
+
+    QueueResult RunContention(const BenchOptions& options, const char* name, bool locked)
+    {
+        const uint32_t leds = MATRIX_WIDTH * MATRIX_HEIGHT;
+        auto device = std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+        LEDBufferManager manager(8, device);
+        std::vector<CRGB> packet(leds, CRGB(1, 2, 3));
+        std::atomic<bool> stop { false };
+        std::atomic<uint32_t> queued { 0 };
+
+        std::thread socket([&]()
+        {
+            for (uint64_t micros = 1; !stop; micros++)
+            {
+                if (locked)
+                {
+                    // The old path: parse the staged packet into the ring with the lock held
+                    std::lock_guard guard(g_buffer_mutex);
+                    auto pBuffer = manager.ReserveBuffer(BufferReservation::Socket);
+                    memcpy(pBuffer->Pixels(), packet.data(), leds * sizeof(CRGB));
+                    pBuffer->SetFrame(0, micros, leds);
+                    manager.CommitBuffer(pBuffer);
+                }
+                else
+                {
+                    // The lock-free path: the lock, which the render thread never takes, only around reserve and commit
+                    std::shared_ptr<LEDBuffer> pBuffer;
+                    {
+                        std::lock_guard guard(g_buffer_mutex);
+                        pBuffer = manager.ReserveBuffer(BufferReservation::Socket);
+                    }
+                    memcpy(pBuffer->Pixels(), packet.data(), leds * sizeof(CRGB));
+                    pBuffer->SetFrame(0, micros, leds);
+
+                    std::lock_guard guard(g_buffer_mutex);
+                    manager.CommitBuffer(pBuffer);
+                }
+                queued++;
+            }
+        });
+
+        while (queued == 0)
+            std::this_thread::yield();
+
+        const unsigned long start = micros();
+        const uint32_t queuedBefore = queued;
+
+        // Take a frame, then leave the queue alone for a while as drawing it would
+        auto take = [&]()
+        {
+            std::shared_ptr<LEDBuffer> pBuffer;
+            if (locked)
+            {
+                std::lock_guard guard(g_buffer_mutex);
+                pBuffer = manager.GetOldestBuffer();
+            }
+            else
+                pBuffer = manager.GetOldestBuffer();
+
+            if (pBuffer)
+                KeepAlive(pBuffer->Pixels()[0]);
+        };
+
+        std::vector<uint32_t> samples;
+        for (size_t i = 0; i < options.warmup + options.frames; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(kDrawMicros));
+
+            const unsigned long before = micros();
+            take();
+            if (i >= options.warmup)
+                samples.push_back(micros() - before);
+        }
+
+        QueueResult result { name, FrameStats::From(std::move(samples)) };
+        result.queuedPerSecond = (queued - queuedBefore) * 1e6 / std::max<unsigned long>(1, micros() - start);
+        stop = true;
+        socket.join();
+        return result;
+    }
+}
+
+int RunQueueSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    for (uint32_t cSlots : { 1u, 2u, 3u, 8u })
+        failures += CheckModel(cSlots);
+    for (uint32_t cSlots : { 1u, 3u, 8u })
+        failures += CheckThreads(cSlots, 100000);
+
+    if (failures)
+    {
+        fprintf(stderr, "queue: not timing a queue that doesn't hold up\n");
+        return failures;
+    }
+
+    const QueueResult results[] =
+    {
+        RunContention(options, "mutex",     true),
+        RunContention(options, "lockfree",  false),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "queue";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+        doc["leds"]     = MATRIX_WIDTH * MATRIX_HEIGHT;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["locking"]         = result.name;
+            entry["takeMeanUs"]      = result.take.mean;
+            entry["takeMedianUs"]    = result.take.median;
+            entry["takeP99Us"]       = result.take.p99;
+            entry["takeMaxUs"]       = result.take.max;
+            entry["queuedPerSecond"] = result.queuedPerSecond;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        printf("render thread taking frames of %d LEDs while a socket thread queues them flat out\n\n", MATRIX_WIDTH * MATRIX_HEIGHT);
+        printf("%-9s %10s %10s %10s %14s\n", "locking", "mean us", "p99 us", "max us", "queued/s");
+        for (const auto& result : results)
+            printf("%-9s %10.2f %10u %10u %14.0f\n", result.name, result.take.mean, result.take.p99, result.take.max, result.queuedPerSecond);
+    }
+
+    return failures;
+}
@@ -0,0 +1,236 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_show.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite show: renders frames through WS281xOutputManager
+//    with the host transport holding each one on a simulated wire for as
+//    long as a real strip takes to clock it out, once with the synchronous
+//    Show(), once pipelined, and once posted to an OutputService that
+//    shows it from its own task. A stand-in Draw() spins for none, half
+//    and one and a half of the wire time. It checks that no frame was
+//    packed over while still on the wire, that the synchronous Show()
+//    really waits for the wire, that pipelining and the output task both
+//    shorten the frame when Draw() and the wire can overlap, and that the
+//    output task shows every frame posted without ever holding more than
+//    its pool; then reports the time the render task spent in Show() or
+//    Post() and the whole frame for each.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <string>
+#include <vector>
+
+#include "deviceconfig.h"
+#include "nd_bench.h"
+#include "outputservice.h"
+#include "systemcontainer.h"
+#include "ws281xoutputmanager.h"
+
+namespace
+{
+    constexpr size_t kMaxFrames = 20;                       // Each frame is tens of ms of simulated wire
+    constexpr size_t kMaxWarmup = 3;
+    constexpr double kWireMicrosPerByte = 8 * 1.25;         // 800 kHz
+
+    enum class ShowMode
+    {
+        Synchronous,
+        Pipelined,
+        Async,                                              // Pipelined, shown from an OutputService
+    };
+
+    const char* ModeName(ShowMode mode)
+    {
+        switch (mode)
+        {
+            case ShowMode::Synchronous: return "synchronous";
+            case ShowMode::Pipelined:   return "pipelined";
+            case ShowMode::Async:       return "async";
+        }
+        return "unknown";
+    }
+
+    struct ShowResult
+    {
+        ShowMode   mode;
+        uint32_t   drawMicros;
+        FrameStats show;                                    // Show(), or Post() for the output task
+        FrameStats frame;                                   // Draw() + Show(), the render task's frame period
+        size_t     overwritten;
+        size_t     posted;                                  // Frames handed to the output task...
+        size_t     shown;                                   // ...and how many of them it showed
+        size_t     maxDepth;                                // Most frames it ever held at once
+    };
+
+    ShowResult RunMode(const BenchOptions& options, ShowMode mode, uint32_t drawMicros)
+    {
+        auto& devices = g_ptrSystem->GetDevices();
+        WS281xOutputManager manager(mode != ShowMode::Synchronous);
+        manager.SimulateWireTime(true);
+        auto [applied, error] = manager.ApplyConfig(g_ptrSystem->GetDeviceConfig(), devices);
+        if (!applied)
+            fprintf(stderr, "show: ApplyConfig failed: %s\n", error.c_str());
+
+        OutputService service(manager);
+        if (mode == ShowMode::Async && !service.Start())
+            fprintf(stderr, "show: OutputService failed to start\n");
+
+        const size_t ledCount = manager.GetActiveLEDCount();
+        const size_t warmup = std::min(options.warmup, kMaxWarmup);
+        const size_t frames = std::min(options.frames, kMaxFrames);
+        std::vector<uint32_t> showSamples, frameSamples;
+        size_t posted = 0, maxDepth = 0;
+        uint8_t hue = 0;
+
+        for (size_t i = 0; i < warmup + frames; i++)
+        {
+            const unsigned long start = micros();
+
+            // A Draw() that changes every pixel and takes drawMicros
+            for (auto& device : devices)
+                fill_rainbow(device->leds, ledCount, hue++);
+            while (micros() - start < drawMicros)
+                ;
+
+            const unsigned long showStart = micros();
+            if (mode == ShowMode::Async && service.Post(devices, ledCount, 255, 255))
+                posted++;
+            else
+                manager.Show(devices, ledCount, 255, 255);
+            const unsigned long end = micros();
+            maxDepth = std::max(maxDepth, service.Depth());
+
+            if (i >= warmup)
+            {
+                showSamples.push_back(end - showStart);
+                frameSamples.push_back(end - start);
+            }
+        }
+
+        // Let the last frame off the wire before counting
+        service.Flush();
+        const size_t shown = service.FramesShown();
+        service.Stop();
+        manager.Reset();
+        return { mode, drawMicros, FrameStats::From(std::move(showSamples)), FrameStats::From(std::move(frameSamples)),
+                 manager.GetFramesOverwrittenOnWire(), posted, shown, maxDepth };
+    }
+}
+
+int RunShowSuite(const BenchOptions& options)
+{
+    const size_t ledCount = g_ptrSystem->GetDeviceConfig().GetActiveLEDCount();
+    const auto wireMicros = static_cast<uint32_t>(ledCount * sizeof(CRGB) * kWireMicrosPerByte);
+
+    std::vector<ShowResult> results;
+    for (uint32_t drawMicros : { 0u, wireMicros / 2, wireMicros * 3 / 2 })
+        for (ShowMode mode : { ShowMode::Synchronous, ShowMode::Pipelined, ShowMode::Async })
+            results.push_back(RunMode(options, mode, drawMicros));
+
+    int failures = 0;
+    for (const auto& result : results)
+    {
+        if (result.overwritten)
+        {
+            fprintf(stderr, "show: %zu %s frames were packed over while on the wire\n",
+                    result.overwritten, ModeName(result.mode));
+            failures++;
+        }
+        if (result.mode == ShowMode::Synchronous && result.show.median < wireMicros * 0.95)
+        {
+            fprintf(stderr, "show: synchronous Show() took %u us, less than the %u us wire time\n", result.show.median, wireMicros);
+            failures++;
+        }
+
+        if (result.mode == ShowMode::Async && result.shown != result.posted)
+        {
+            fprintf(stderr, "show: output task showed %zu of %zu frames posted\n", result.shown, result.posted);
+            failures++;
+        }
+        if (result.maxDepth > OutputService::kPoolSize)
+        {
+            fprintf(stderr, "show: output task held %zu frames with a pool of %zu\n", result.maxDepth, OutputService::kPoolSize);
+            failures++;
+        }
+    }
+
+    // With Draw() at half the wire time the overlapped frames are the wire time, the synchronous one half as long again
+    const auto& overlapSync = results[3];
+    for (const ShowResult* overlapped : { &results[4], &results[5] })
+    {
+        if (overlapped->frame.median > overlapSync.frame.median * 0.85)
+        {
+            fprintf(stderr, "show: %s frame took %u us against %u us synchronous\n",
+                    ModeName(overlapped->mode), overlapped->frame.median, overlapSync.frame.median);
+            failures++;
+        }
+    }
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]      = "show";
+        doc["frames"]     = std::min(options.frames, kMaxFrames);
+        doc["leds"]       = ledCount;
+        doc["wireMicros"] = wireMicros;
+        doc["failures"]   = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["mode"]          = ModeName(result.mode);
+            entry["drawMicros"]    = result.drawMicros;
+            entry["showMedianUs"]  = result.show.median;
+            entry["frameMedianUs"] = result.frame.median;
+            entry["overwritten"]   = result.overwritten;
+            if (result.mode == ShowMode::Async)
+            {
+                entry["posted"]   = result.posted;
+                entry["shown"]    = result.shown;
+                entry["maxDepth"] = result.maxDepth;
+            }
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%zu LEDs, %u us on the wire\n\n", ledCount, wireMicros);
+        printf("%-12s %10s %10s %10s %8s\n", "show", "draw us", "Show() us", "frame us", "fps");
+        for (const auto& result : results)
+        {
+            printf("%-12s %10u %10u %10u %8.1f\n", ModeName(result.mode),
+                   result.drawMicros, result.show.median, result.frame.median,
+                   result.frame.median ? 1e6 / result.frame.median : 0.0);
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,244 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_span.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite span: checks every GFXBase span primitive against
+//    the same operation done pixel by pixel through xy(), for rows and
+//    columns that start off-matrix, run past the edge or miss it entirely,
+//    on serpentine, linear and pixel-mapped wiring. It then times filling
+//    every column and every row with setPixel() against fillSpan() at
+//    64x32 and 128x64.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <SPIFFS.h>
+#include <string>
+#include <vector>
+
+#include "gfxbase.h"
+#include "nd_bench.h"
+#include "pixelmap.h"
+#include "ws281xgfx.h"
+
+namespace
+{
+    struct SpanResult
+    {
+        uint16_t   width;
+        uint16_t   height;
+        SpanAxis   axis;
+        FrameStats setPixel;
+        FrameStats fillSpan;
+    };
+
+    enum class Wiring { Serpentine, Linear, Mapped };
+
+    const char* WiringName(Wiring wiring)
+    {
+        return wiring == Wiring::Serpentine ? "serpentine" : wiring == Wiring::Linear ? "linear" : "mapped";
+    }
+
+    std::shared_ptr<WS281xGFX> MakeDevice(uint16_t width, uint16_t height, Wiring wiring)
+    {
+        auto device = std::make_shared<WS281xGFX>(width, height);
+
+        // Two half-width panels, the second upside down, so no span has a fixed stride
+        if (wiring == Wiring::Mapped)
+        {
+            PixelMap::Table table;
+            const uint16_t half = width / 2;
+            PixelMap::FromTiles({ { 0, 0, half, height, 0 }, { half, 0, static_cast<uint16_t>(width - half), height, 180 } }, width, height, table);
+            const auto data = PixelMap::ToBinary(table, width, height);
+            SPIFFS.open(PIXEL_MAP_FILE, FILE_WRITE).write(data.data(), data.size());
+        }
+        device->ConfigureTopology(width, height, wiring != Wiring::Linear);
+        SPIFFS.remove(PIXEL_MAP_FILE);
+        return device;
+    }
+
+    // The per-pixel version of a span operation: op(pixel, i) for every in-bounds pixel of the run
+
+    template <typename Op>
+    void ReferenceSpan(GFXBase& device, SpanAxis axis, int x, int y, int count, Op op)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            const int px = axis == SpanAxis::Row ? x + i : x;
+            const int py = axis == SpanAxis::Row ? y : y + i;
+            if (px >= 0 && py >= 0 && device.isValidPixel(px, py))
+                op(device.leds[device.xy(px, py)], i);
+        }
+    }
+
+    int CheckWiring(uint16_t width, uint16_t height, Wiring wiring)
+    {
+        auto device = MakeDevice(width, height, wiring);
+        const size_t ledCount = width * height;
+        std::vector<CRGB> source(ledCount), expected;
+        std::vector<CRGB> colors(width + height + 8);
+        for (auto& color : colors)
+            color = CRGB(random8(), random8(), random8());
+
+        int failures = 0;
+        for (auto axis : { SpanAxis::Row, SpanAxis::Column })
+        {
+            const int length  = axis == SpanAxis::Row ? width : height;
+            const int breadth = axis == SpanAxis::Row ? height : width;
+
+            // { along, across, count }: a whole line, clipped on either end, hanging off both ends,
+            // beside the matrix, past its end, before its start, and empty
+            const int runs[][3] =
+            {
+                { 0, 0, length }, { 3, 2, 5 }, { -4, 1, 9 }, { length - 3, 3, 8 }, { -2, 0, length + 4 },
+                { 1, -1, 4 }, { 1, breadth, 4 }, { length, 0, 3 }, { -5, 0, 3 }, { 2, 1, 0 },
+            };
+
+            for (const auto& run : runs)
+            {
+                const int x = axis == SpanAxis::Row ? run[0] : run[1];
+                const int y = axis == SpanAxis::Row ? run[1] : run[0];
+                const int count = run[2];
+
+                auto check = [&](const char* primitive, auto&& spanCall, auto&& op)
+                {
+                    for (auto& pixel : source)
+                        pixel = CRGB(random8(), random8(), random8());
+
+                    std::copy(source.begin(), source.end(), device->leds);
+                    ReferenceSpan(*device, axis, x, y, count, op);
+                    expected.assign(device->leds, device->leds + ledCount);
+
+                    std::copy(source.begin(), source.end(), device->leds);
+                    spanCall();
+                    if (!std::equal(expected.begin(), expected.end(), device->leds))
+                    {
+                        fprintf(stderr, "span: %s %s (%d, %d) x %d differs from per-pixel on %ux%u %s\n",
+                                primitive, axis == SpanAxis::Row ? "row" : "column", x, y, count, width, height, WiringName(wiring));
+                        failures++;
+                    }
+                };
+
+                const CRGB color = colors[0];
+                check("fillSpan", [&]() { device->fillSpan(axis, x, y, count, color); },
+                                  [&](CRGB& pixel, int) { pixel = color; });
+                check("fadeSpanToBlackBy", [&]() { device->fadeSpanToBlackBy(axis, x, y, count, 100); },
+                                           [&](CRGB& pixel, int) { pixel.fadeToBlackBy(100); });
+                check("addSpan", [&]() { device->addSpan(axis, x, y, count, color); },
+                                 [&](CRGB& pixel, int) { pixel += color; });
+                check("blendSpan", [&]() { device->blendSpan(axis, x, y, count, color, 90); },
+                                   [&](CRGB& pixel, int) { nblend(pixel, color, 90); });
+                check("copySpan", [&]() { device->copySpan(axis, x, y, count, colors.data()); },
+                                  [&](CRGB& pixel, int i) { pixel = colors[i]; });
+                check("paletteSpan", [&]() { device->paletteSpan(axis, x, y, count, RainbowColors_p, 10, 7); },
+                                     [&](CRGB& pixel, int i) { pixel = ColorFromPalette(RainbowColors_p, static_cast<uint8_t>(10 + i * 7)); });
+            }
+        }
+        return failures;
+    }
+
+    SpanResult RunSize(const BenchOptions& options, uint16_t width, uint16_t height, SpanAxis axis)
+    {
+        auto device = MakeDevice(width, height, Wiring::Serpentine);
+        GFXBase* volatile opaqueDevice = device.get();
+        const bool isRow = axis == SpanAxis::Row;
+        const int lines = isRow ? height : width;
+        const int length = isRow ? width : height;
+        uint8_t hue = 0;
+
+        SpanResult result { width, height, axis };
+        result.setPixel = TimeFrames(options, [&]()
+        {
+            const CRGB color = CHSV(hue++, 255, 255);
+            for (int line = 0; line < lines; line++)
+                for (int i = 0; i < length; i++)
+                    opaqueDevice->setPixel(isRow ? i : line, isRow ? line : i, color);
+            KeepAlive(device->leds[0]);
+        });
+        result.fillSpan = TimeFrames(options, [&]()
+        {
+            const CRGB color = CHSV(hue++, 255, 255);
+            for (int line = 0; line < lines; line++)
+                opaqueDevice->fillSpan(axis, isRow ? 0 : line, isRow ? line : 0, length, color);
+            KeepAlive(device->leds[0]);
+        });
+        return result;
+    }
+}
+
+int RunSpanSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    for (auto wiring : { Wiring::Serpentine, Wiring::Linear, Wiring::Mapped })
+    {
+        failures += CheckWiring(16, 8, wiring);
+        failures += CheckWiring(17, 11, wiring);
+    }
+
+    const SpanResult results[] =
+    {
+        RunSize(options, 64,  32, SpanAxis::Column),
+        RunSize(options, 64,  32, SpanAxis::Row),
+        RunSize(options, 128, 64, SpanAxis::Column),
+        RunSize(options, 128, 64, SpanAxis::Row),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]    = "span";
+        doc["frames"]   = options.frames;
+        doc["failures"] = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["width"]            = result.width;
+            entry["height"]           = result.height;
+            entry["axis"]             = result.axis == SpanAxis::Row ? "row" : "column";
+            entry["setPixelMedianUs"] = result.setPixel.median;
+            entry["fillSpanMedianUs"] = result.fillSpan.median;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%-9s %-7s %14s %14s\n", "matrix", "axis", "setPixel us", "fillSpan us");
+        for (const auto& result : results)
+        {
+            printf("%4ux%-4u %-7s %14u %14u\n", result.width, result.height,
+                   result.axis == SpanAxis::Row ? "row" : "column",
+                   result.setPixel.median, result.fillSpan.median);
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,631 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_udp.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite udp: sends pixel frames, every other one compressed,
+//    fragmented over a loopback UDP socket the way tools/udpsender.py does,
+//    and receives them the way the UDP server does: each datagram into
+//    UdpFrameAssembler, each whole frame expanded if need be and queued on
+//    an LEDBufferManager. Every frame taken off the queue is checked
+//    against the pattern it was sent with.
+//
+//    The datagrams go through a simulated link first. A clean link and one
+//    that reorders fragments between neighbouring frames and duplicates
+//    some must deliver every frame; one that shuffles datagrams further
+//    and one that loses them must deliver only whole frames, in order,
+//    with every frame the sender numbered accounted for as queued or
+//    dropped. A sender that restarts its sequence and datagrams that
+//    aren't fragments are checked too. Then the link given by --loss and
+//    --reorder is run for --frames frames and reported.
+//
+//    --listen PORT instead receives from tools/udpsender.py on that port
+//    until --frames frames have come in or it stops sending, and checks
+//    them against its pattern.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <ArduinoJson.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <netinet/in.h>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "byte_utils.h"
+#include "inflater.h"
+#include "ledbuffer.h"
+#include "nd_bench.h"
+#include "socketserver.h"
+#include "udpassembler.h"
+#include "ws281xgfx.h"
+
+extern "C"
+{
+    #include "uzlib/src/uzlib.h"
+}
+
+namespace
+{
+    constexpr uint32_t kRingSize       = 8;
+    constexpr size_t   kFragmentSize   = 1400;                  // Packet bytes per datagram, as udpsender.py sends
+    constexpr size_t   kScenarioFrames = 240;
+    constexpr size_t   kScenarioBytes  = 512;                   // Smaller fragments for the checks, so frames have more
+
+    struct Link
+    {
+        const char* name;
+        size_t      fragment   = kScenarioBytes;
+        uint32_t    first      = 1;             // Sequence number of the first frame
+        bool        compress   = true;          // Every other frame sent compressed
+        double      loss       = 0;             // Fraction of datagrams lost
+        double      duplicate  = 0;             // Fraction sent twice
+        size_t      reorder    = 0;             // How many places a datagram can move, at most
+        bool        interleave = false;         // Each frame's second half sent amid the next one's first
+        bool        restart    = false;         // The sender starts numbering over from 1 halfway through
+        size_t      garbage    = 0;             // Datagrams that aren't fragments, sent among the rest
+    };
+
+    struct LinkResult
+    {
+        String     name;
+        size_t     sent       = 0;              // Frames sent
+        size_t     whole      = 0;              // ... with none of their datagrams lost
+        size_t     datagrams  = 0;
+        size_t     queued     = 0;              // Frames that came off the LEDBufferManager
+        size_t     corrupt    = 0;              // ... not matching what was sent
+        size_t     outOfOrder = 0;              // ... older than one queued before them
+        uint32_t   dropped    = 0;
+        uint32_t   late       = 0;
+        uint32_t   duplicates = 0;
+        uint32_t   malformed  = 0;
+        FrameStats receive;                     // Microseconds of reassembly and queueing per frame
+    };
+
+    constexpr const char* kSuite = "udp";
+
+    // The pattern tools/udpsender.py sends
+
+    CRGB PatternPixel(uint32_t frame, uint32_t i)
+    {
+        return CRGB(static_cast<uint8_t>((i + frame) * 7), static_cast<uint8_t>(i * 3 + frame), static_cast<uint8_t>(frame * 5));
+    }
+
+    void Put(std::vector<uint8_t>& out, uint64_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    // zlib framing around uzlib's static-Huffman deflate, as in the inflate suite
+
+    std::vector<uint8_t> Compress(const std::vector<uint8_t>& data)
+    {
+        std::vector<uzlib_hash_entry_t> hashTable(1 << 12);
+        uzlib_comp comp = {};
+        comp.dict_size  = 32768;
+        comp.hash_bits  = 12;
+        comp.hash_table = hashTable.data();
+
+        zlib_start_block(&comp.out);
+        uzlib_compress(&comp, data.data(), data.size());
+        zlib_finish_block(&comp.out);
+
+        std::vector<uint8_t> stream;
+        stream.reserve(comp.out.outlen + 6);
+        stream.push_back(0x78);
+        stream.push_back(0x01);
+        stream.insert(stream.end(), comp.out.outbuf, comp.out.outbuf + comp.out.outlen);
+        free(comp.out.outbuf);
+
+        const uint32_t adler = uzlib_adler32(data.data(), data.size(), 1);
+        for (int shift = 24; shift >= 0; shift -= 8)
+            stream.push_back(static_cast<uint8_t>(adler >> shift));
+        return stream;
+    }
+
+    std::vector<uint8_t> MakePacket(uint32_t frame, uint32_t leds, bool compressed)
+    {
+        std::vector<uint8_t> packet;
+        Put(packet, WIFI_COMMAND_PIXELDATA64, 2);
+        Put(packet, 1, 2);
+        Put(packet, leds, 4);
+        Put(packet, 100 + frame / 30, 8);
+        Put(packet, 1 + frame % 30 * 33333, 8);
+        for (uint32_t i = 0; i < leds; i++)
+        {
+            const CRGB pixel = PatternPixel(frame, i);
+            packet.insert(packet.end(), { pixel.r, pixel.g, pixel.b });
+        }
+
+        if (!compressed)
+            return packet;
+
+        const auto stream = Compress(packet);
+        std::vector<uint8_t> wire;
+        Put(wire, COMPRESSED_HEADER, 4);
+        Put(wire, stream.size(), 4);
+        Put(wire, packet.size(), 4);
+        Put(wire, 0, 4);
+        wire.insert(wire.end(), stream.begin(), stream.end());
+        return wire;
+    }
+
+    std::vector<std::vector<uint8_t>> Fragment(const std::vector<uint8_t>& packet, uint32_t sequence, size_t fragmentSize)
+    {
+        const size_t count = (packet.size() + fragmentSize - 1) / fragmentSize;
+        std::vector<std::vector<uint8_t>> datagrams;
+        for (size_t index = 0; index < count; index++)
+        {
+            const size_t offset = index * fragmentSize;
+            const size_t cb = std::min(fragmentSize, packet.size() - offset);
+
+            std::vector<uint8_t> datagram(UDP_FRAGMENT_HEADER_SIZE + cb);
+            UdpFrameAssembler::WriteHeader(datagram.data(), sequence, index, count, offset, packet.size());
+            memcpy(&datagram[UDP_FRAGMENT_HEADER_SIZE], &packet[offset], cb);
+            datagrams.push_back(std::move(datagram));
+        }
+        return datagrams;
+    }
+
+    // The receiving end: a UDP socket and what the UDP server does with each datagram
+
+    class Receiver
+    {
+      public:
+
+        Receiver(uint16_t port, bool loopbackOnly) :
+            _device(std::make_shared<WS281xGFX>(MATRIX_WIDTH, MATRIX_HEIGHT)),
+            _manager(kRingSize, _device),
+            _datagram(UDP_FRAGMENT_HEADER_SIZE + MAXIMUM_PACKET_SIZE),
+            _output(MAXIMUM_PACKET_SIZE + 1)
+        {
+            _socket = socket(AF_INET, SOCK_DGRAM, 0);
+
+            // Room for a burst of frames in case the sender gets ahead
+            int size = 4 << 20;
+            setsockopt(_socket, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+            address.sin_port = htons(port);
+            if (bind(_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+            {
+                fprintf(stderr, "udp: bind to port %u failed: %s\n", port, strerror(errno));
+                close(_socket);
+                _socket = -1;
+                return;
+            }
+
+            socklen_t length = sizeof(_address);
+            getsockname(_socket, reinterpret_cast<sockaddr *>(&_address), &length);
+            _address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        }
+
+        ~Receiver()
+        {
+            if (_socket >= 0)
+                close(_socket);
+        }
+
+        bool IsOpen() const { return _socket >= 0; }
+        const sockaddr_in& Address() const { return _address; }
+        const UdpFrameAssembler& Assembler() const { return _assembler; }
+
+        // Drain
+        //
+        // Receives until nothing has arrived for timeoutMs, or frames have been queued. Loopback
+        // datagrams are there as soon as sendto() returns, so a timeout of 0 only takes what's been sent.
+
+        void Drain(LinkResult& result, int timeoutMs, size_t frames = SIZE_MAX)
+        {
+            if (timeoutMs > 0)
+            {
+                timeval to = { timeoutMs / 1000, (timeoutMs % 1000) * 1000 };
+                setsockopt(_socket, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+            }
+
+            while (result.queued < frames)
+            {
+                const ssize_t cb = recv(_socket, _datagram.data(), _datagram.size(), timeoutMs > 0 ? 0 : MSG_DONTWAIT);
+                if (cb < 0)
+                    break;
+
+                const unsigned long start = micros();
+                if (_assembler.Accept(_datagram.data(), cb) == UdpFrameAssembler::Result::Complete)
+                {
+                    const bool queued = Queue();
+                    _elapsed += micros() - start;
+                    _samples.push_back(_elapsed);
+                    _elapsed = 0;
+                    if (queued)
+                        Take(result);
+                }
+                else
+                {
+                    _elapsed += micros() - start;
+                }
+            }
+        }
+
+        void Finish(LinkResult& result)
+        {
+            result.dropped    = _assembler.FramesDropped();
+            result.late       = _assembler.LateFragments();
+            result.duplicates = _assembler.DuplicateFragments();
+            result.malformed  = _assembler.MalformedDatagrams();
+            result.receive    = FrameStats::From(std::move(_samples));
+        }
+
+      private:
+
+        // UdpServer::ProcessPacket and ProcessIncomingData's handling of one channel
+
+        bool Queue()
+        {
+            const uint8_t * pPacket = _assembler.Packet().get();
+            size_t cbPacket = _assembler.PacketSize();
+
+            if (cbPacket >= COMPRESSED_HEADER_SIZE && DWORDFromMemory(pPacket) == COMPRESSED_HEADER)
+            {
+                const uint32_t compressedSize = DWORDFromMemory(&pPacket[4]);
+                const uint32_t expandedSize   = DWORDFromMemory(&pPacket[8]);
+                if (compressedSize != cbPacket - COMPRESSED_HEADER_SIZE || expandedSize > MAXIMUM_PACKET_SIZE ||
+                    !Inflater::DecompressBuffer(&pPacket[COMPRESSED_HEADER_SIZE], compressedSize, _output.data(), expandedSize))
+                {
+                    return false;
+                }
+                pPacket  = _output.data();
+                cbPacket = expandedSize;
+            }
+
+            if (!LEDBuffer::ValidateWirePayload(pPacket, cbPacket, _manager.LEDCount()))
+                return false;
+
+            auto pBuffer = _manager.ReserveBuffer(BufferReservation::Incoming);
+            if (!pBuffer->UpdateFromWire(pPacket, cbPacket))
+                return false;
+            _sequences.push_back(_assembler.PacketSequence());
+            return _manager.CommitBuffer(pBuffer);
+        }
+
+        // What the render task would draw, checked against the pattern for its sequence
+
+        void Take(LinkResult& result)
+        {
+            while (auto pBuffer = _manager.GetOldestBuffer())
+            {
+                const uint32_t sequence = _sequences.front();
+                _sequences.erase(_sequences.begin());
+
+                result.queued++;
+                if (_hasLast && static_cast<int32_t>(sequence - _last) <= 0 && !_restarting)
+                    result.outOfOrder++;
+                _restarting = false;
+                _hasLast = true;
+                _last = sequence;
+
+                for (size_t i = 0; i < pBuffer->Length(); i++)
+                {
+                    if (pBuffer->Pixels()[i] != PatternPixel(sequence, i))
+                    {
+                        result.corrupt++;
+                        break;
+                    }
+                }
+            }
+        }
+
+      public:
+
+        // The sender is about to start numbering over, so the next frame may be older than the last
+        void ExpectRestart() { _restarting = true; }
+
+      private:
+
+        int                         _socket = -1;
+        sockaddr_in                 _address = {};
+        std::shared_ptr<WS281xGFX>  _device;
+        LEDBufferManager            _manager;
+        UdpFrameAssembler           _assembler { MAXIMUM_PACKET_SIZE };
+        std::vector<uint8_t>        _datagram;
+        std::vector<uint8_t>        _output;
+        std::vector<uint32_t>       _sequences;             // Of the frames queued, oldest first
+        std::vector<uint32_t>       _samples;
+        unsigned long               _elapsed    = 0;
+        bool                        _hasLast    = false;
+        bool                        _restarting = false;
+        uint32_t                    _last       = 0;
+    };
+
+    // RunLink
+    //
+    // Sends frames through the link and receives them as it goes, so the socket buffer never fills
+
+    LinkResult RunLink(const Link& link, size_t frames, unsigned long seed)
+    {
+        LinkResult result;
+        result.name = link.name;
+
+        Receiver receiver(0, true);
+        if (!receiver.IsOpen())
+            return result;
+
+        const int sender = socket(AF_INET, SOCK_DGRAM, 0);
+        const sockaddr_in address = receiver.Address();
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> chance(0, 1);
+
+        const uint32_t leds = std::min<uint32_t>(NUM_LEDS, 1024);
+        uint32_t sequence = link.first;
+
+        // Datagrams wait here with the position each is due to go out at. Nothing added later is due
+        // before the current position, so everything due before it can be sent.
+        std::vector<std::pair<double, std::vector<uint8_t>>> pending;
+        double position = 0;
+
+        auto send = [&](double upTo)
+        {
+            std::stable_sort(pending.begin(), pending.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            while (!pending.empty() && pending.front().first < upTo)
+            {
+                const auto& datagram = pending.front().second;
+                sendto(sender, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+                result.datagrams++;
+                pending.erase(pending.begin());
+                receiver.Drain(result, 0);
+            }
+        };
+
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            if (link.restart && frame == frames / 2)
+            {
+                send(position);
+                receiver.ExpectRestart();
+                sequence = 1;
+            }
+
+            auto datagrams = Fragment(MakePacket(sequence, leds, link.compress && frame % 2 == 1), sequence, link.fragment);
+            sequence++;
+            result.sent++;
+
+            bool whole = true;
+            const size_t half = datagrams.size() / 2;
+            for (size_t i = 0; i < datagrams.size(); i++)
+            {
+                // Interleaved, the second half of one frame goes out between the first fragments of the
+                // next, so two frames are always in progress
+                double due = position++;
+                if (link.interleave && i >= half)
+                    due += datagrams.size() - half + 0.5;
+                if (link.reorder)
+                    due += chance(rng) * link.reorder;
+
+                if (chance(rng) < link.loss)
+                {
+                    whole = false;
+                    continue;
+                }
+                if (chance(rng) < link.duplicate)
+                    pending.emplace_back(due + 1.5, datagrams[i]);
+                pending.emplace_back(due, std::move(datagrams[i]));
+            }
+            result.whole += whole;
+
+            for (size_t i = 0; i < link.garbage && frame % 10 == 5; i++)
+            {
+                std::vector<uint8_t> junk(1 + rng() % 64);
+                for (auto& byte : junk)
+                    byte = rng();
+                if (i % 2)
+                {
+                    // Looks like a fragment, but claims bytes past the end of its packet
+                    junk.resize(UDP_FRAGMENT_HEADER_SIZE + 8);
+                    UdpFrameAssembler::WriteHeader(junk.data(), sequence, 0, 1, 100, 50);
+                }
+                pending.emplace_back(position - 0.5, std::move(junk));
+            }
+
+            send(position);
+        }
+        send(INFINITY);
+        receiver.Drain(result, 50);
+        receiver.Finish(result);
+        close(sender);
+        return result;
+    }
+
+    // CheckAccounting
+    //
+    // Every frame sent is either queued or counted as dropped, except any at the very end that were
+    // never finished; nothing queued is damaged or older than what went before it
+
+    int CheckAccounting(const LinkResult& result)
+    {
+        int failures = 0;
+        failures += Check(kSuite, result.corrupt == 0, str_sprintf("%s: %zu frames queued with the wrong pixels", result.name.c_str(), result.corrupt));
+        failures += Check(kSuite, result.outOfOrder == 0, str_sprintf("%s: %zu frames queued after a newer one", result.name.c_str(), result.outOfOrder));
+        failures += Check(kSuite, result.queued + result.dropped <= result.sent && result.queued + result.dropped + 2 >= result.sent,
+                          str_sprintf("%s: %zu frames sent, %zu queued and %u dropped", result.name.c_str(), result.sent, result.queued, result.dropped));
+        return failures;
+    }
+
+    // CheckLinks
+    //
+    // The fixed scenarios, on fragments small enough that every frame is split several ways
+
+    int CheckLinks(unsigned long seed)
+    {
+        int failures = 0;
+
+        {
+            // Starts close enough to the top that the sequence wraps
+            Link link { "clean" };
+            link.first = 0xFFFFFF80u;
+            const auto result = RunLink(link, kScenarioFrames, seed);
+            failures += CheckAccounting(result);
+            failures += Check(kSuite, result.queued == result.sent, str_sprintf("clean: %zu of %zu frames queued", result.queued, result.sent));
+            failures += Check(kSuite, result.late + result.duplicates + result.malformed == 0, "clean: fragments late, duplicated or malformed");
+        }
+
+        {
+            Link link { "interleaved" };
+            link.compress   = false;
+            link.interleave = true;
+            link.duplicate  = 0.1;
+            const auto result = RunLink(link, kScenarioFrames, seed);
+            failures += CheckAccounting(result);
+            failures += Check(kSuite, result.queued == result.sent, str_sprintf("interleaved: %zu of %zu frames queued", result.queued, result.sent));
+            failures += Check(kSuite, result.duplicates > 0, "interleaved: no duplicate fragments counted");
+        }
+
+        {
+            Link link { "reordered" };
+            link.reorder = 8;
+            const auto result = RunLink(link, kScenarioFrames, seed);
+            failures += CheckAccounting(result);
+            failures += Check(kSuite, result.queued * 3 >= result.sent * 2, str_sprintf("reordered: only %zu of %zu frames queued", result.queued, result.sent));
+        }
+
+        {
+            Link link { "lossy" };
+            link.loss    = 0.02;
+            link.reorder = 2;
+            const auto result = RunLink(link, kScenarioFrames, seed);
+            failures += CheckAccounting(result);
+            failures += Check(kSuite, result.whole < result.sent, "lossy: no frame lost a datagram");
+            failures += Check(kSuite, result.queued * 10 >= result.whole * 8, str_sprintf("lossy: %zu frames queued of %zu that lost nothing", result.queued, result.whole));
+        }
+
+        {
+            Link link { "restart" };
+            link.first   = 1000;
+            link.restart = true;
+            const auto result = RunLink(link, kScenarioFrames, seed);
+            failures += CheckAccounting(result);
+            failures += Check(kSuite, result.queued == result.sent, str_sprintf("restart: %zu of %zu frames queued", result.queued, result.sent));
+        }
+
+        {
+            Link link { "garbage" };
+            link.garbage = 4;
+            const auto result = RunLink(link, kScenarioFrames, seed);
+            failures += CheckAccounting(result);
+            failures += Check(kSuite, result.queued == result.sent, str_sprintf("garbage: %zu of %zu frames queued", result.queued, result.sent));
+            failures += Check(kSuite, result.malformed == kScenarioFrames / 10 * link.garbage, str_sprintf("garbage: %u datagrams malformed", result.malformed));
+        }
+
+        return failures;
+    }
+
+    // Listen
+    //
+    // Takes frames from tools/udpsender.py for as long as it keeps sending
+
+    int Listen(const BenchOptions& options)
+    {
+        Receiver receiver(options.listenPort, false);
+        if (!receiver.IsOpen())
+            return 1;
+
+        fprintf(stderr, "udp: listening on port %d for %zu frames\n", options.listenPort, options.frames);
+
+        LinkResult result;
+        result.name = "listen";
+        receiver.Drain(result, 5000, options.frames);
+        receiver.Finish(result);
+
+        int failures = 0;
+        failures += Check(kSuite, result.queued > 0, "listen: no frames received");
+        failures += Check(kSuite, result.corrupt == 0, str_sprintf("listen: %zu frames don't match the pattern", result.corrupt));
+        failures += Check(kSuite, result.outOfOrder == 0, str_sprintf("listen: %zu frames queued after a newer one", result.outOfOrder));
+
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        printf("%zu frames queued, %u dropped; %u fragments late, %u duplicate, %u malformed\n",
+               result.queued, result.dropped, result.late, result.duplicates, result.malformed);
+        printf("receive us/frame: median %u, p99 %u\n", result.receive.median, result.receive.p99);
+        return failures;
+    }
+}
+
+int RunUdpSuite(const BenchOptions& options)
+{
+    uzlib_init();
+
+    if (options.listenPort)
+        return Listen(options);
+
+    const int failures = CheckLinks(options.seed);
+
+    Link link { "custom" };
+    link.fragment = kFragmentSize;
+    link.loss     = options.lossPct / 100;
+    link.reorder  = options.reorder;
+    const auto result = RunLink(link, options.frames, options.seed);
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]         = "udp";
+        doc["frames"]        = options.frames;
+        doc["failures"]      = failures;
+        doc["lossPct"]       = options.lossPct;
+        doc["reorder"]       = options.reorder;
+        doc["fragmentBytes"] = kFragmentSize;
+        doc["datagrams"]     = result.datagrams;
+        doc["whole"]         = result.whole;
+        doc["queued"]        = result.queued;
+        doc["dropped"]       = result.dropped;
+        doc["late"]          = result.late;
+        doc["corrupt"]       = result.corrupt;
+        doc["receiveMedianUs"] = result.receive.median;
+        doc["receiveP99Us"]    = result.receive.p99;
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n", failures ? "FAILED" : "passed");
+        printf("%zu frames in %zu-byte fragments, every other one compressed, %.1f%% of datagrams lost, reordered by up to %zu\n\n",
+               options.frames, kFragmentSize, options.lossPct, options.reorder);
+        printf("%9s %7s %7s %7s %7s %7s %12s %12s\n", "datagrams", "whole", "queued", "dropped", "late", "corrupt", "receive p50", "receive p99");
+        printf("%9zu %7zu %7zu %7u %7u %7zu %12u %12u\n", result.datagrams, result.whole, result.queued, result.dropped, result.late,
+               result.corrupt, result.receive.median, result.receive.p99);
+    }
+
+    return failures + CheckAccounting(result);
+}
@@ -0,0 +1,406 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_wire.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite wire: captures the bytes the host transport would
+//    have clocked out of each WS281x channel and checks them. Fixed
+//    patterns go through Show() at a spread of brightness, fader and
+//    pixels-drawn settings, and every byte on the wire has to be the
+//    color order and video scaling of the pixel it came from, with black
+//    past the pixels drawn. Then bright frames go through the real
+//    PostProcessFrame(), and the power of what reached the wire has to
+//    stay inside the configured limit; the sums the pack kernels hand the
+//    limiter have to add up to the bytes that were sent. Every Show() has
+//    to put exactly one frame on each active channel, and the channels
+//    have to start within one frame's wire time of each other.
+//
+//    Nothing captured depends on the host's clock, so the capture is the
+//    same from run to run. --save FILE writes it out as text, one hex line
+//    per 16 pixels with repeats collapsed, for diffing between builds;
+//    --capture FILE compares this run against one saved earlier and fails
+//    on every frame that differs.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "deviceconfig.h"
+#include "nd_bench.h"
+#include "pixelformat.h"
+#include "systemcontainer.h"
+#include "values.h"
+#include "ws281xgfx.h"
+#include "ws281xoutputmanager.h"
+
+namespace
+{
+    using WireFrame = WS281xOutputManager::WireFrame;
+
+    constexpr size_t kMaxCapturedFrames = 256;
+    constexpr size_t kPixelsPerLine     = 16;
+
+    constexpr uint32_t kPowerRedMw   = 16 * 5;          // The FastLED model ws281xgfx.cpp limits by
+    constexpr uint32_t kPowerGreenMw = 11 * 5;
+    constexpr uint32_t kPowerBlueMw  = 15 * 5;
+
+    struct Level
+    {
+        uint8_t brightness;
+        uint8_t fader;
+        size_t  drawnPercent;
+    };
+
+    struct Shown
+    {
+        std::string             name;
+        std::vector<WireFrame>  frames;                 // One per active channel
+        double                  watts = 0;              // Worked out from the bytes on the wire
+        uint64_t                skewNanos = 0;          // Latest channel start less the earliest
+    };
+
+    // A Draw() that depends only on the frame number, so captures match from run to run
+    void DrawPattern(size_t frame)
+    {
+        for (auto& device : g_ptrSystem->GetDevices())
+        {
+            for (size_t i = 0; i < device->GetLEDCount(); ++i)
+                device->leds[i] = CRGB(static_cast<uint8_t>(i * 7 + frame * 13), static_cast<uint8_t>((i * 3) ^ frame), static_cast<uint8_t>(255 - i - frame));
+        }
+    }
+
+    constexpr const char* kSuite = "wire";
+
+    double WireWatts(const std::vector<WireFrame>& frames, PixelFormatHelpers::ColorOrderIndices indices)
+    {
+        uint64_t red = 0, green = 0, blue = 0;
+        for (const auto& frame : frames)
+        {
+            for (size_t i = 0; i + 2 < frame.bytes.size(); i += 3)
+            {
+                red   += frame.bytes[i + indices.rIdx];
+                green += frame.bytes[i + indices.gIdx];
+                blue  += frame.bytes[i + indices.bIdx];
+            }
+        }
+        return ((red * kPowerRedMw >> 8) + (green * kPowerGreenMw >> 8) + (blue * kPowerBlueMw >> 8)) / 1000.0;
+    }
+
+    // Every active channel sent one frame, all with the same sequence and within a frame's wire time of each other
+    int CheckFrames(Shown& shown, size_t channelCount, size_t byteCount, PixelFormatHelpers::ColorOrderIndices indices)
+    {
+        int failures = Check(kSuite, shown.frames.size() == channelCount, shown.name + ": expected one frame per active channel");
+        if (shown.frames.empty())
+            return failures + 1;
+
+        uint64_t earliest = UINT64_MAX, latest = 0;
+        for (size_t c = 0; c < shown.frames.size(); ++c)
+        {
+            const auto& frame = shown.frames[c];
+            failures += Check(kSuite, frame.channel == c && frame.sequence == shown.frames[0].sequence, shown.name + ": channels out of step");
+            failures += Check(kSuite, frame.bytes.size() == byteCount, shown.name + ": frame is not the active strip's length");
+            failures += Check(kSuite, frame.wireNanos >= byteCount * 8 * 1200, shown.name + ": frame left the wire faster than 800 kHz");
+            earliest = std::min(earliest, frame.startNanos);
+            latest   = std::max(latest, frame.startNanos);
+        }
+        shown.skewNanos = latest - earliest;
+        shown.watts = WireWatts(shown.frames, indices);
+        failures += Check(kSuite, shown.skewNanos < shown.frames[0].wireNanos, shown.name + ": channels started more than a frame apart");
+        return failures;
+    }
+
+    // Show() at each level: every byte is its pixel's color, in wire order, video-scaled
+    int CheckLevels(std::vector<Shown>& results, PixelFormatHelpers::ColorOrderIndices indices)
+    {
+        const Level levels[] = { { 255, 255, 100 }, { 128, 255, 100 }, { 200, 100, 50 }, { 17, 255, 1 }, { 255, 0, 100 }, { 0, 255, 100 } };
+
+        auto& devices = g_ptrSystem->GetDevices();
+        WS281xOutputManager manager;
+        manager.ApplyConfig(g_ptrSystem->GetDeviceConfig(), devices);
+        manager.CaptureFrames(kMaxCapturedFrames);
+
+        const size_t ledCount = manager.GetActiveLEDCount();
+        const size_t channelCount = manager.GetActiveChannelCount();
+
+        int failures = 0;
+        for (size_t i = 0; i < std::size(levels); ++i)
+        {
+            const auto& level = levels[i];
+            const size_t drawn = std::max<size_t>(1, ledCount * level.drawnPercent / 100);
+            DrawPattern(i);
+            manager.Show(devices, drawn, level.brightness, level.fader);
+
+            Shown shown { "brightness " + std::to_string(level.brightness) + " fader " + std::to_string(level.fader) +
+                          " drawn " + std::to_string(drawn), manager.TakeCapturedFrames() };
+            failures += CheckFrames(shown, channelCount, ledCount * 3, indices);
+
+            for (const auto& frame : shown.frames)
+            {
+                if (frame.bytes.size() != ledCount * 3)
+                    continue;
+
+                const CRGB* leds = devices[frame.channel]->leds;
+                size_t wrong = 0;
+                for (size_t p = 0; p < ledCount; ++p)
+                {
+                    const CRGB color = p < drawn ? leds[p] : CRGB::Black;
+                    const uint8_t* out = frame.bytes.data() + p * 3;
+                    wrong += out[indices.rIdx] != PixelFormatHelpers::Scale(color.r, level.brightness, level.fader)
+                          || out[indices.gIdx] != PixelFormatHelpers::Scale(color.g, level.brightness, level.fader)
+                          || out[indices.bIdx] != PixelFormatHelpers::Scale(color.b, level.brightness, level.fader);
+                }
+                failures += Check(kSuite, wrong == 0, shown.name + ": wire bytes aren't the scaled pixels in color order");
+            }
+
+            // At full brightness and fader the wire bytes are the values themselves, so the sums
+            // the power limiter gets for the frame have to add up to them
+            if (level.brightness == 255 && level.fader == 255)
+            {
+                PackSums sums, wire;
+                for (const auto& frame : shown.frames)
+                {
+                    for (size_t i = 0; i + 2 < frame.bytes.size(); i += 3)
+                    {
+                        wire.red   += frame.bytes[i + indices.rIdx];
+                        wire.green += frame.bytes[i + indices.gIdx];
+                        wire.blue  += frame.bytes[i + indices.bIdx];
+                    }
+                    wire.pixels += frame.bytes.size() / 3;
+                }
+                const bool sumsMatch = manager.GetLastFrameSums(sums) && sums.red == wire.red && sums.green == wire.green
+                                    && sums.blue == wire.blue && sums.pixels == wire.pixels;
+                failures += Check(kSuite, sumsMatch, shown.name + ": last frame's power sums aren't what went on the wire");
+            }
+            results.push_back(std::move(shown));
+        }
+        return failures;
+    }
+
+    // Bright frames through PostProcessFrame(), as the render task sends them: the power
+    // limiter has to hold what reaches the wire to the configured limit, including the
+    // white frame straight after a dark one, when the last frame's sums are low. The output
+    // scale rounds up by a step of brightness and fader, which the limiter doesn't
+    // model, so that much over is allowed.
+    int CheckPowerLimit(std::vector<Shown>& results, PixelFormatHelpers::ColorOrderIndices indices)
+    {
+        auto& devices = g_ptrSystem->GetDevices();
+        auto& manager = static_cast<WS281xOutputManager&>(g_ptrSystem->GetStripOutputManager());
+        const double limitWatts = g_ptrSystem->GetDeviceConfig().GetPowerLimit() / 1000.0;
+        const size_t ledCount = manager.GetActiveLEDCount();
+        const uint8_t fader = g_Values.Fader;
+
+        manager.CaptureFrames(kMaxCapturedFrames);
+        int failures = 0;
+        for (const char* pattern : { "sparse", "white", "pattern" })
+        {
+            const std::string name = std::string("power ") + pattern;
+            for (auto& device : devices)
+            {
+                if (name == "power white")
+                    fill_solid(device->leds, device->GetLEDCount(), CRGB::White);
+                else if (name == "power pattern")
+                    DrawPattern(100);
+                else
+                {
+                    fill_solid(device->leds, device->GetLEDCount(), CRGB::Black);
+                    for (size_t i = 0; i < device->GetLEDCount(); i += 64)
+                        device->leds[i] = CRGB::Red;
+                }
+            }
+            devices[0]->PostProcessFrame(ledCount, 0);
+
+            Shown shown { name, manager.TakeCapturedFrames() };
+            failures += CheckFrames(shown, manager.GetActiveChannelCount(), ledCount * 3, indices);
+
+            const double brightness = std::max(1.0, std::round(g_Values.Brite * 255.0 / 100));
+            const double allowance = (brightness + 1) / brightness * (fader + 1.0) / std::max<uint8_t>(1, fader);
+            if (shown.watts > limitWatts * allowance * 1.01)
+            {
+                fprintf(stderr, "wire: %s: %.2f W on the wire against a %.2f W limit\n", name.c_str(), shown.watts, limitWatts);
+                failures++;
+            }
+            results.push_back(std::move(shown));
+        }
+        manager.CaptureFrames(0);
+        return failures;
+    }
+
+    // The capture as text: a header line per frame and its bytes in hex, kPixelsPerLine pixels
+    // a line, with runs of identical lines after the first collapsed to "* count"
+    std::string FormatCapture(const std::vector<Shown>& results)
+    {
+        std::string text = "nd_bench wire capture 1\n";
+        char line[128];
+        for (const auto& shown : results)
+        {
+            for (const auto& frame : shown.frames)
+            {
+                snprintf(line, sizeof(line), "frame %s channel %zu pin %d bytes %zu wire_ns %" PRIu64 "\n",
+                         shown.name.c_str(), frame.channel, frame.pin, frame.bytes.size(), frame.wireNanos);
+                text += line;
+
+                const size_t lineBytes = kPixelsPerLine * 3;
+                std::string previous;
+                size_t repeats = 0;
+                for (size_t offset = 0; offset < frame.bytes.size(); offset += lineBytes)
+                {
+                    std::string hex;
+                    for (size_t i = offset; i < std::min(offset + lineBytes, frame.bytes.size()); ++i)
+                    {
+                        snprintf(line, sizeof(line), "%02x", frame.bytes[i]);
+                        hex += line;
+                    }
+                    if (hex == previous)
+                    {
+                        repeats++;
+                        continue;
+                    }
+                    if (repeats)
+                        text += "* " + std::to_string(repeats) + "\n";
+                    snprintf(line, sizeof(line), "%zu ", offset / 3);
+                    text += line + hex + "\n";
+                    previous = std::move(hex);
+                    repeats = 0;
+                }
+                if (repeats)
+                    text += "* " + std::to_string(repeats) + "\n";
+            }
+        }
+        return text;
+    }
+
+    bool LoadText(const std::string& path, std::string& text)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+
+        char chunk[4096];
+        for (size_t cb; (cb = fread(chunk, 1, sizeof(chunk), file)) > 0; )
+            text.append(chunk, cb);
+        fclose(file);
+        return true;
+    }
+
+    // Splits a capture into its frames, header line first, so they can be compared one at a time
+    std::vector<std::string> SplitFrames(const std::string& text)
+    {
+        std::vector<std::string> frames;
+        for (size_t start = text.find("frame "); start != std::string::npos; )
+        {
+            const size_t next = text.find("\nframe ", start);
+            frames.push_back(text.substr(start, next == std::string::npos ? std::string::npos : next + 1 - start));
+            start = next == std::string::npos ? next : next + 1;
+        }
+        return frames;
+    }
+
+    int CompareCapture(const std::string& path, const std::string& current)
+    {
+        std::string saved;
+        if (!LoadText(path, saved))
+        {
+            fprintf(stderr, "wire: can't open capture %s\n", path.c_str());
+            return 1;
+        }
+
+        const auto before = SplitFrames(saved);
+        const auto after = SplitFrames(current);
+        int failures = 0;
+        for (size_t i = 0; i < std::max(before.size(), after.size()); ++i)
+        {
+            if (i < before.size() && i < after.size() && before[i] == after[i])
+                continue;
+
+            const std::string& frame = i < after.size() ? after[i] : before[i];
+            fprintf(stderr, "wire: differs from %s: %s", path.c_str(), frame.substr(0, frame.find('\n') + 1).c_str());
+            failures++;
+        }
+        return failures;
+    }
+}
+
+int RunWireSuite(const BenchOptions& options)
+{
+    const auto indices = PixelFormatHelpers::IndicesFor(g_ptrSystem->GetDeviceConfig().GetWS281xColorOrder());
+
+    std::vector<Shown> results;
+    int failures = CheckLevels(results, indices) + CheckPowerLimit(results, indices);
+
+    const std::string capture = FormatCapture(results);
+    if (!options.save.empty())
+    {
+        FILE* file = fopen(options.save.c_str(), "wb");
+        if (!file || fwrite(capture.data(), 1, capture.size(), file) != capture.size())
+        {
+            fprintf(stderr, "wire: can't write %s\n", options.save.c_str());
+            failures++;
+        }
+        if (file)
+            fclose(file);
+    }
+    if (!options.capture.empty())
+        failures += CompareCapture(options.capture, capture);
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]        = "wire";
+        doc["captureBytes"] = capture.size();
+        doc["failures"]     = failures;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& shown : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["name"]      = shown.name;
+            entry["channels"]  = shown.frames.size();
+            entry["wireUs"]    = shown.frames.empty() ? 0 : shown.frames[0].wireNanos / 1000;
+            entry["skewUs"]    = shown.skewNanos / 1000;
+            entry["watts"]     = shown.watts;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("checks: %s\n\n", failures ? "FAILED" : "passed");
+        printf("%-36s %8s %10s %8s %8s\n", "frame", "channels", "wire us", "skew us", "watts");
+        for (const auto& shown : results)
+        {
+            printf("%-36s %8zu %10" PRIu64 " %8" PRIu64 " %8.2f\n", shown.name.c_str(), shown.frames.size(),
+                   shown.frames.empty() ? 0 : shown.frames[0].wireNanos / 1000, shown.skewNanos / 1000, shown.watts);
+        }
+        printf("\ncapture: %zu bytes%s%s\n", capture.size(), options.save.empty() ? "" : ", saved to ", options.save.c_str());
+    }
+
+    return failures;
+}
@@ -0,0 +1,181 @@
+//+--------------------------------------------------------------------------
+//
+// File:        bench_xy.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    nd_bench --suite xy: compares a full-frame per-pixel write through the
+//    virtual GFXBase::xy() with the same loop through StaticXY, at 64x32
+//    and 128x64 regardless of the size nd_bench was built for. Before
+//    timing anything it checks that every StaticXY index matches xy() for
+//    both serpentine and linear wiring.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <string>
+
+#include "gfxbase.h"
+#include "nd_bench.h"
+#include "ws281xgfx.h"
+#include "xymapping.h"
+
+namespace
+{
+    struct XYResult
+    {
+        uint16_t   width;
+        uint16_t   height;
+        bool       serpentine;
+        FrameStats virtualXY;
+        FrameStats staticXY;
+    };
+
+    // The frame body both paths share: roughly what a plasma-style effect does per pixel, so the
+    // mapping cost is measured against real work rather than an empty loop.
+
+    template <uint16_t Width, uint16_t Height, typename MapXY>
+    __attribute__((noinline)) void RenderFrame(CRGB* leds, MapXY mapXY, uint8_t t)
+    {
+        for (uint16_t x = 0; x < Width; x++)
+            for (uint16_t y = 0; y < Height; y++)
+                leds[mapXY(x, y)] = CRGB(x + t, y - t, x ^ y);
+    }
+
+    // Calls through a GFXBase& that the compiler can't see the origin of, the way effects reach
+    // g().xy() in firmware, so the virtual call isn't devirtualized away.
+
+    struct VirtualXY
+    {
+        const GFXBase* device;
+
+        uint16_t operator()(uint16_t x, uint16_t y) const noexcept
+        {
+            return device->xy(x, y);
+        }
+    };
+
+    template <uint16_t Width, uint16_t Height, XYLayout Layout>
+    int CheckMapping(const GFXBase& device)
+    {
+        constexpr StaticXY<Width, Height, Layout> mapXY;
+        int mismatches = 0;
+        for (uint16_t x = 0; x < Width; x++)
+        {
+            for (uint16_t y = 0; y < Height; y++)
+            {
+                if (mapXY(x, y) != device.xy(x, y) && mismatches++ == 0)
+                    fprintf(stderr, "StaticXY<%u, %u> disagrees with xy() at (%u, %u): %u != %u\n",
+                            Width, Height, x, y, mapXY(x, y), device.xy(x, y));
+            }
+        }
+        return mismatches ? 1 : 0;
+    }
+
+    template <uint16_t Width, uint16_t Height, XYLayout Layout>
+    XYResult RunSize(const BenchOptions& options, int& failures)
+    {
+        constexpr bool serpentine = Layout == XYLayout::ColumnSerpentine;
+
+        auto device = std::make_shared<WS281xGFX>(Width, Height);
+        device->ConfigureTopology(Width, Height, serpentine);
+        const GFXBase* volatile opaqueDevice = device.get();
+
+        failures += CheckMapping<Width, Height, Layout>(*device);
+
+        XYResult result { Width, Height, serpentine };
+        uint8_t t = 0;
+
+        result.virtualXY = TimeFrames(options, [&]()
+        {
+            RenderFrame<Width, Height>(device->leds, VirtualXY { opaqueDevice }, t++);
+            KeepAlive(device->leds[0]);
+        });
+        result.staticXY = TimeFrames(options, [&]()
+        {
+            RenderFrame<Width, Height>(device->leds, StaticXY<Width, Height, Layout>(), t++);
+            KeepAlive(device->leds[0]);
+        });
+        return result;
+    }
+
+    double Savings(const XYResult& result)
+    {
+        return result.virtualXY.median
+            ? 100.0 * (1.0 - static_cast<double>(result.staticXY.median) / result.virtualXY.median)
+            : 0.0;
+    }
+}
+
+int RunXYSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    const XYResult results[] =
+    {
+        RunSize<64,  32, XYLayout::ColumnSerpentine>(options, failures),
+        RunSize<64,  32, XYLayout::ColumnLinear>(options, failures),
+        RunSize<128, 64, XYLayout::ColumnSerpentine>(options, failures),
+        RunSize<128, 64, XYLayout::ColumnLinear>(options, failures),
+    };
+
+    if (options.json)
+    {
+        JsonDocument doc;
+        doc["suite"]  = "xy";
+        doc["frames"] = options.frames;
+
+        auto entries = doc["results"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = entries.add<JsonObject>();
+            entry["width"]           = result.width;
+            entry["height"]          = result.height;
+            entry["serpentine"]      = result.serpentine;
+            entry["virtualMedianUs"] = result.virtualXY.median;
+            entry["virtualP99Us"]    = result.virtualXY.p99;
+            entry["staticMedianUs"]  = result.staticXY.median;
+            entry["staticP99Us"]     = result.staticXY.p99;
+            entry["savingsPercent"]  = Savings(result);
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+    else
+    {
+        printf("%-9s %-11s %14s %14s %9s\n", "matrix", "layout", "virtual us", "static us", "savings");
+        for (const auto& result : results)
+        {
+            printf("%4ux%-4u %-11s %14u %14u %8.1f%%\n",
+                   result.width, result.height,
+                   result.serpentine ? "serpentine" : "linear",
+                   result.virtualXY.median,
+                   result.staticXY.median,
+                   Savings(result));
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,549 @@
+//+--------------------------------------------------------------------------
+//
+// File:        host_runtime.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Out-of-line half of the include/native shims for the [env:native]
+//    host build: Arduino timing/random, Serial, ESP, the counting heap,
+//    FreeRTOS tasks on std::thread, the Logger back end and the few
+//    nd_network queries effects make. Only compiled into nd_bench.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <esp_heap_caps.h>
+#include <freertos/task.h>
+#include <FS.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <SD.h>
+#include <SPI.h>
+#include <SPIFFS.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Wire.h>
+
+#include "nd_network.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+fs::SPIFFSFS SPIFFS;
+fs::SDFS SD;
+SPIClass SPI;
+TwoWire Wire;
+
+// Timing
+
+namespace
+{
+    const auto g_hostEpoch = std::chrono::steady_clock::now();
+}
+
+unsigned long millis()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - g_hostEpoch).count();
+}
+
+unsigned long micros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_hostEpoch).count();
+}
+
+void delay(uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+// Random
+
+long random(long howbig)
+{
+    return howbig <= 0 ? 0 : rand() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+    return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    srand(static_cast<unsigned int>(seed));
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    if (in_max == in_min)
+        return out_min;
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// HardwareSerial
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush()
+{
+    fflush(stdout);
+}
+
+// Counting heap
+//
+// Every block carries a small header recording its size so frees can be
+// attributed. The counters back ESP.getFreeHeap() and nd_bench's per-frame
+// allocation figures. The "total" is a nominal 8MB so free-memory math in
+// SystemContainer behaves like a PSRAM board.
+
+namespace
+{
+    constexpr size_t kHostHeapSize = 8 * 1024 * 1024;
+
+    struct alignas(std::max_align_t) BlockHeader
+    {
+        size_t size;
+    };
+
+    std::atomic<uint64_t> g_allocations{0};
+    std::atomic<uint64_t> g_frees{0};
+    std::atomic<uint64_t> g_bytesAllocated{0};
+    std::atomic<uint64_t> g_bytesInUse{0};
+    std::atomic<uint64_t> g_peakBytesInUse{0};
+
+    void* CountedAlloc(size_t size)
+    {
+        auto* header = static_cast<BlockHeader*>(malloc(sizeof(BlockHeader) + size));
+        if (!header)
+            return nullptr;
+        header->size = size;
+
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+        const uint64_t inUse = g_bytesInUse.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peak = g_peakBytesInUse.load(std::memory_order_relaxed);
+        while (inUse > peak && !g_peakBytesInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+            ;
+        return header + 1;
+    }
+
+    void CountedFree(void* ptr)
+    {
+        if (!ptr)
+            return;
+        auto* header = static_cast<BlockHeader*>(ptr) - 1;
+        g_frees.fetch_add(1, std::memory_order_relaxed);
+        g_bytesInUse.fetch_sub(header->size, std::memory_order_relaxed);
+        free(header);
+    }
+
+    size_t FreeBytes()
+    {
+        const uint64_t inUse = g_bytesInUse.load(std::memory_order_relaxed);
+        return inUse >= kHostHeapSize ? 0 : kHostHeapSize - inUse;
+    }
+}
+
+void* heap_caps_malloc(size_t size, uint32_t)
+{
+    return CountedAlloc(size);
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+    void* ptr = heap_caps_malloc(n * size, caps);
+    if (ptr)
+        memset(ptr, 0, n * size);
+    return ptr;
+}
+
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps)
+{
+    if (!ptr)
+        return heap_caps_malloc(size, caps);
+
+    void* resized = heap_caps_malloc(size, caps);
+    if (resized)
+    {
+        memcpy(resized, ptr, std::min(size, (static_cast<BlockHeader*>(ptr) - 1)->size));
+        heap_caps_free(ptr);
+    }
+    return resized;
+}
+
+void heap_caps_free(void* ptr)
+{
+    CountedFree(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t)          { return FreeBytes(); }
+size_t heap_caps_get_total_size(uint32_t)         { return kHostHeapSize; }
+size_t heap_caps_get_largest_free_block(uint32_t) { return FreeBytes(); }
+size_t heap_caps_get_minimum_free_size(uint32_t)  { return kHostHeapSize - g_peakBytesInUse.load(std::memory_order_relaxed); }
+
+HostHeapStats HostGetHeapStats()
+{
+    return {
+        g_allocations.load(std::memory_order_relaxed),
+        g_frees.load(std::memory_order_relaxed),
+        g_bytesAllocated.load(std::memory_order_relaxed),
+        g_bytesInUse.load(std::memory_order_relaxed),
+        g_peakBytesInUse.load(std::memory_order_relaxed)
+    };
+}
+
+void* operator new(size_t size)
+{
+    if (void* ptr = CountedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept                { CountedFree(ptr); }
+void operator delete[](void* ptr) noexcept              { CountedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept        { CountedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept      { CountedFree(ptr); }
+
+uint32_t EspClass::getHeapSize()      { return kHostHeapSize; }
+uint32_t EspClass::getFreeHeap()      { return FreeBytes(); }
+uint32_t EspClass::getMinFreeHeap()   { return heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT); }
+uint32_t EspClass::getMaxAllocHeap()  { return FreeBytes(); }
+uint32_t EspClass::getPsramSize()     { return kHostHeapSize; }
+uint32_t EspClass::getFreePsram()     { return FreeBytes(); }
+uint32_t EspClass::getMinFreePsram()  { return getMinFreeHeap(); }
+uint32_t EspClass::getMaxAllocPsram() { return FreeBytes(); }
+
+void EspClass::restart()
+{
+    fflush(stdout);
+    std::exit(EXIT_FAILURE);
+}
+
+// FreeRTOS tasks
+//
+// Each task is a detached std::thread. FreeRTOS lets one task delete another,
+// which std::thread can't do, so deletion is cooperative: vTaskDelete marks
+// the target and the target unwinds at its next vTaskDelay or notify wait.
+// That matches ITaskService, whose tasks park in vTaskDelay until Stop()
+// reaps them.
+
+struct HostTask
+{
+    std::string name;
+    UBaseType_t priority = 0;
+    BaseType_t core = tskNO_AFFINITY;
+    std::mutex mutex;
+    std::condition_variable wake;
+    uint32_t notifications = 0;
+    bool deleted = false;
+};
+
+namespace
+{
+    struct HostTaskExit {};
+
+    thread_local std::shared_ptr<HostTask> t_currentTask;
+
+    // Tasks that finish are unlinked from this list; it only exists so
+    // handles stay valid for as long as anyone could still use them.
+    std::mutex g_tasksMutex;
+    std::vector<std::shared_ptr<HostTask>> g_tasks;
+
+    void ForgetTask(HostTask* task)
+    {
+        std::lock_guard guard(g_tasksMutex);
+        std::erase_if(g_tasks, [task](const auto& entry) { return entry.get() == task; });
+    }
+
+    // WaitOnTask
+    //
+    // Blocks the calling task until the predicate holds or the timeout passes,
+    // unwinding the thread if the task is deleted in the meantime.
+
+    template <typename Predicate>
+    bool WaitOnTask(HostTask& task, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate predicate)
+    {
+        auto ready = [&]() { return task.deleted || predicate(); };
+        if (ticks == portMAX_DELAY)
+            task.wake.wait(lock, ready);
+        else
+            task.wake.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready);
+
+        if (task.deleted)
+            throw HostTaskExit();
+        return predicate();
+    }
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t entry,
+                                   const char* name,
+                                   uint32_t,
+                                   void* parameter,
+                                   UBaseType_t priority,
+                                   TaskHandle_t* createdTask,
+                                   BaseType_t coreId)
+{
+    auto task = std::make_shared<HostTask>();
+    task->name = name ? name : "";
+    task->priority = priority;
+    task->core = coreId;
+
+    {
+        std::lock_guard guard(g_tasksMutex);
+        g_tasks.push_back(task);
+    }
+
+    if (createdTask)
+        *createdTask = task.get();
+
+    std::thread([task, entry, parameter]()
+    {
+        t_currentTask = task;
+        try
+        {
+            entry(parameter);
+        }
+        catch (const HostTaskExit&)
+        {
+        }
+        ForgetTask(task.get());
+    }).detach();
+
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t entry,
+                       const char* name,
+                       uint32_t stackDepth,
+                       void* parameter,
+                       UBaseType_t priority,
+                       TaskHandle_t* createdTask)
+{
+    return xTaskCreatePinnedToCore(entry, name, stackDepth, parameter, priority, createdTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (!task || task == t_currentTask.get())
+        throw HostTaskExit();
+
+    std::lock_guard lock(task->mutex);
+    task->deleted = true;
+    task->wake.notify_all();
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    // The main thread (nd_bench itself) isn't a task and can't be deleted
+    if (!t_currentTask)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+        return;
+    }
+
+    std::unique_lock lock(t_currentTask->mutex);
+    WaitOnTask(*t_currentTask, lock, ticks, []() { return false; });
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return static_cast<TickType_t>(millis() / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return t_currentTask.get();
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t)
+{
+    return nullptr;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t)
+{
+    return nullptr;
+}
+
+BaseType_t xPortGetCoreID()
+{
+    return t_currentTask && t_currentTask->core != tskNO_AFFINITY ? t_currentTask->core : 0;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t)
+{
+    return 0;
+}
+
+const char* pcTaskGetName(TaskHandle_t task)
+{
+    if (!task)
+        task = t_currentTask.get();
+    return task ? task->name.c_str() : "main";
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    if (!t_currentTask)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ticksToWait == portMAX_DELAY ? 1 : ticksToWait * portTICK_PERIOD_MS));
+        return 0;
+    }
+
+    auto& task = *t_currentTask;
+    std::unique_lock lock(task.mutex);
+    if (!WaitOnTask(task, lock, ticksToWait, [&task]() { return task.notifications > 0; }))
+        return 0;
+
+    const uint32_t count = task.notifications;
+    task.notifications = clearCountOnExit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    if (!task)
+        return pdFAIL;
+
+    std::lock_guard lock(task->mutex);
+    task->notifications++;
+    task->wake.notify_all();
+    return pdPASS;
+}
+
+// Logger
+//
+// The firmware's logger.cpp fans out through ConsoleManager to serial and
+// telnet sinks; on the host everything goes straight to stderr so it never
+// mixes with nd_bench's machine-readable stdout.
+
+LogLevel Logger::_level = LogLevel::Warn;
+
+void Logger::SetLevel(LogLevel level)
+{
+    _level = level;
+}
+
+LogLevel Logger::GetLevel()
+{
+    return _level;
+}
+
+bool Logger::IsEnabled(LogLevel level)
+{
+    return static_cast<int>(level) <= static_cast<int>(_level);
+}
+
+void Logger::Logf(LogLevel level, const char* tag, const char* fmt, ...)
+{
+    if (!IsEnabled(level))
+        return;
+
+    va_list args;
+    va_start(args, fmt);
+    Logv(level, tag, fmt, args);
+    va_end(args);
+}
+
+void Logger::Logv(LogLevel level, const char* tag, const char* fmt, va_list args)
+{
+    if (!IsEnabled(level))
+        return;
+
+    fprintf(stderr, "[%s] ", tag);
+    vfprintf(stderr, fmt, args);
+}
+
+void Logger::InstallLogHook()
+{
+}
+
+// nd_network
+//
+// Effects only ask whether there is a network and what the address is; the
+// host never has one.
+
+namespace nd_network
+{
+    bool IsWiFiConnected()
+    {
+        return false;
+    }
+
+    String GetWiFiLocalIP()
+    {
+        return "0.0.0.0";
+    }
+
+    String GetMacAddress(const char* separator)
+    {
+        String mac;
+        for (int i = 0; i < 6; i++)
+        {
+            if (i && separator)
+                mac += separator;
+            mac += "00";
+        }
+        return mac;
+    }
+}
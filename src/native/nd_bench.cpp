@@ -0,0 +1,481 @@
+//+--------------------------------------------------------------------------
+//
+// File:        nd_bench.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Entry point for the headless [env:native] build. Brings up the same
+//    SystemContainer pieces main.cpp does for a WS281x matrix (config,
+//    devices, output manager, effect factories, EffectManager) with no
+//    hardware attached, then renders effects on the host so their cost can
+//    be measured without flashing a board.
+//
+//    Build and run:
+//
+//      pio run -e native
+//      .pio/build/native/nd_bench --list
+//      .pio/build/native/nd_bench --effect Hypnosis --frames 1000
+//
+//    Each effect is freshly constructed, Init()ed and Start()ed, then timed
+//    for N frames of Draw() + PostProcessFrame(). nd_bench reports min,
+//    median, p99 and max microseconds per frame and the heap allocated per
+//    frame; --json emits the same data in a stable form that can be saved
+//    and diffed between releases.
+//
+//    Other suites (--suite NAME) benchmark individual kernels against their
+//    reference implementations; they live in src/native/bench_*.cpp.
+//
+//    The matrix size is fixed at compile time; set ND_MATRIX_WIDTH and
+//    ND_MATRIX_HEIGHT in the environment before building to change it.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <ArduinoJson.h>
+#include <cstdio>
+#include <cstdlib>
+#include <esp_heap_caps.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "effectfactories.h"
+#include "effectmanager.h"
+#include "gfxbase.h"
+#include "ledstripeffect.h"
+#include "nd_bench.h"
+#include "systemcontainer.h"
+#include "values.h"
+#include "ws281xgfx.h"
+
+DRAM_ATTR std::unique_ptr<SystemContainer> g_ptrSystem;
+DRAM_ATTR std::mutex g_buffer_mutex;
+DRAM_ATTR std::mutex g_publish_mutex;
+DRAM_ATTR std::recursive_mutex g_render_mutex;
+DRAM_ATTR std::recursive_mutex g_effect_manager_mutex;
+
+// Defined in effects.cpp
+
+extern allocated_unique_ptr<EffectFactories> g_ptrEffectFactories;
+void LoadEffectFactories();
+
+namespace
+{
+    // Named groups for --effect @NAME. "palette" is the effects that draw mostly through
+    // ColorFromCurrentPalette, for measuring the palette cache.
+
+    const std::map<std::string, std::vector<std::string>> kEffectGroups =
+    {
+        { "palette", { "Wave", "Swirl", "Pulse", "Smoke", "Cubes", "Spiro", "Spin", "Star Deep", "Fireplace", "RadialFire", "Radar" } },
+        { "noise",   { "MRI", "Smoke", "RainbowFlag" } },
+        { "polar",   { "RadialFire", "RadialWave", "Colorspin", "Hypnosis", "Crystallize" } },
+    };
+
+    void PrintUsage(const char* program)
+    {
+        fprintf(stderr,
+                "Usage: %s [--suite NAME] [--list] [--json] [--effect NAME]... [--frames N] [--warmup N] [--seed N]\n"
+                "          [--capture FILE] [--save FILE] [--jitter MS] [--drift PPM] [--lead MS] [--loss PCT] [--reorder N] [--listen PORT]\n"
+                "\n"
+                "  --suite NAME    Benchmark to run (default effects):\n"
+                "                    effects  Draw() + PostProcessFrame() of each registered effect\n"
+                "                    xy       Virtual xy() against the compile-time StaticXY mappers\n"
+                "                    pixelmap PixelMap layout/binary checks and lookup-table xy() cost\n"
+                "                    blur     Packed blur2d kernels against the per-pixel reference\n"
+                "                    span     GFXBase span primitives against per-pixel setPixel()\n"
+                "                    palette  Palette cache against FastLED's ColorFromPalette\n"
+                "                    noise    NoiseField FillGetNoise() against per-cell inoise16()\n"
+                "                    polar    Shared polar map against per-pixel atan2f/hypotf\n"
+                "                    ingest   Zero-copy LEDBuffer receive against staged UpdateFromWire()\n"
+                "                    inflate  Compressed packets inflated off a loopback socket against read-then-inflate\n"
+                "                    delta    Delta-frame packets round-tripped, and their size and cost against full frames\n"
+                "                    queue    Frame queue hammered by a socket and a render thread, and take latency against a mutex\n"
+                "                    jitter   Playout of timestamped frames over a simulated jittery network with clock drift\n"
+                "                    udp      Fragmented frames reassembled off a loopback UDP socket through loss and reordering\n"
+                "                    lighting DDP, E1.31 and Art-Net captures replayed into the channels' frame queues\n"
+                "                    batch    Multi-channel batch packets decoded, queued as one, and their cost against per-channel frames\n"
+                "                    pack     PixelFormat pack kernels against Pack() for every format and color order\n"
+                "                    show     Synchronous, pipelined and output-task WS281x Show() over a simulated wire\n"
+                "                    wire     Captured WS281x wire bytes checked for order, scaling, power limit and channel alignment\n"
+                "  --list          List the registered effects and exit\n"
+                "  --json          Write results as JSON instead of a table\n"
+                "  --effect NAME   Only run effects whose name contains NAME (repeatable);\n"
+                "                  @palette selects the palette-heavy effects,\n"
+                "                  @noise the ones built on the noise pool,\n"
+                "                  @polar the radial ones\n"
+                "  --frames N      Frames to time per effect (default 300)\n"
+                "  --warmup N      Untimed frames to render first (default 10)\n"
+                "  --seed N        Seed for random() and FastLED's random8/16 (default 1)\n"
+                "  --capture FILE  Socket stream (port 49152 payload) for the inflate or delta suite to replay,\n"
+                "                  a libpcap capture for the lighting suite, or a wire capture to compare against\n"
+                "  --save FILE     Write the wire suite's capture to FILE\n"
+                "  --jitter MS     Mean random network delay for the jitter suite (default 10)\n"
+                "  --drift PPM     Receiver clock drift against the sender for the jitter suite (default 50)\n"
+                "  --lead MS       How far ahead the jitter suite's sender stamps its frames (default 0)\n"
+                "  --loss PCT      Datagrams the udp suite's link loses (default 2)\n"
+                "  --reorder N     Places the udp suite's link can move a datagram (default 4)\n"
+                "  --listen PORT   Have the udp suite receive from tools/udpsender.py on PORT instead\n"
+                "\n"
+                "Matrix: %dx%d, %d channel(s)\n",
+                program, MATRIX_WIDTH, MATRIX_HEIGHT, NUM_CHANNELS);
+    }
+
+    bool ParseOptions(int argc, char** argv, BenchOptions& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--suite" && hasValue)
+                options.suite = argv[++i];
+            else if (arg == "--list")
+                options.list = true;
+            else if (arg == "--json")
+                options.json = true;
+            else if (arg == "--effect" && hasValue)
+            {
+                const std::string name = argv[++i];
+                if (name[0] != '@')
+                    options.effects.push_back(name);
+                else if (auto group = kEffectGroups.find(name.substr(1)); group != kEffectGroups.end())
+                    options.effects.insert(options.effects.end(), group->second.begin(), group->second.end());
+                else
+                    return false;
+            }
+            else if (arg == "--frames" && hasValue)
+                options.frames = std::max(1L, strtol(argv[++i], nullptr, 10));
+            else if (arg == "--warmup" && hasValue)
+                options.warmup = std::max(0L, strtol(argv[++i], nullptr, 10));
+            else if (arg == "--seed" && hasValue)
+                options.seed = strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--capture" && hasValue)
+                options.capture = argv[++i];
+            else if (arg == "--save" && hasValue)
+                options.save = argv[++i];
+            else if (arg == "--jitter" && hasValue)
+                options.jitterMs = std::max(0.0, strtod(argv[++i], nullptr));
+            else if (arg == "--drift" && hasValue)
+                options.driftPpm = strtod(argv[++i], nullptr);
+            else if (arg == "--lead" && hasValue)
+                options.leadMs = std::max(0.0, strtod(argv[++i], nullptr));
+            else if (arg == "--loss" && hasValue)
+                options.lossPct = std::clamp(strtod(argv[++i], nullptr), 0.0, 100.0);
+            else if (arg == "--reorder" && hasValue)
+                options.reorder = std::max(0L, strtol(argv[++i], nullptr, 10));
+            else if (arg == "--listen" && hasValue)
+                options.listenPort = std::clamp(strtol(argv[++i], nullptr, 10), 0L, 65535L);
+            else
+                return false;
+        }
+        return true;
+    }
+
+    bool MatchesFilter(const String& name, const BenchOptions& options)
+    {
+        if (options.effects.empty())
+            return true;
+
+        String lowerName = name;
+        lowerName.toLowerCase();
+        for (const auto& filter : options.effects)
+        {
+            String lowerFilter = filter.c_str();
+            lowerFilter.toLowerCase();
+            if (lowerName.indexOf(lowerFilter) >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    // StartHost
+    //
+    // The subset of setup() in main.cpp that the render path depends on. Network, web, audio input,
+    // screens and the render task itself are left out; nd_bench drives frames from this thread.
+
+    void StartHost()
+    {
+        g_ptrSystem = std::make_unique<SystemContainer>();
+        g_ptrSystem->SetupTaskManager();
+        g_ptrSystem->SetupConfig();
+
+        auto& devices = g_ptrSystem->SetupDevices();
+        WS281xGFX::InitializeHardware(devices);
+
+        LoadEffectFactories();
+
+        // EffectManager owns its own effect instances; the ones nd_bench measures are built separately
+        // from the same factories so each run starts from a freshly constructed effect.
+        g_ptrSystem->SetupEffectManager(devices);
+        if (!g_ptrSystem->GetEffectManager().Init())
+            throw std::runtime_error("Could not initialize effect manager");
+    }
+
+    struct EffectResult
+    {
+        String     name;
+        EffectId   effectId = 0;
+        size_t     frames = 0;
+        FrameStats micros;                      // Draw() + PostProcessFrame() time per frame
+        FrameStats heapBytes;                   // Bytes allocated during each frame (not net of frees)
+        double     allocationsPerFrame = 0;
+        uint64_t   initBytes = 0;               // Bytes allocated by construction, Init() and Start()
+    };
+
+    // RunEffect
+    //
+    // Constructs, initializes and starts one effect, then renders frames the way RenderService does:
+    // new frame time, Draw(), then PostProcessFrame() into the output manager. Only the timed frames
+    // after the warmup contribute to the results.
+
+    std::optional<EffectResult> RunEffect(const EffectFactories::NumberedFactory& factory, const BenchOptions& options)
+    {
+        auto& devices = g_ptrSystem->GetDevices();
+        auto& graphics = *devices[0];
+
+        randomSeed(options.seed);
+        random16_set_seed(static_cast<uint16_t>(options.seed));
+        graphics.Clear();
+
+        const auto heapBeforeInit = HostGetHeapStats();
+
+        auto effect = factory.CreateEffect();
+        if (!effect || !effect->Init(devices))
+        {
+            fprintf(stderr, "Effect %s failed to initialize\n", effect ? effect->FriendlyName().c_str() : "(null)");
+            return std::nullopt;
+        }
+        effect->Start();
+
+        EffectResult result;
+        result.name      = effect->FriendlyName();
+        result.effectId  = factory.EffectID();
+        result.frames    = options.frames;
+        result.initBytes = HostGetHeapStats().bytesAllocated - heapBeforeInit.bytesAllocated;
+
+        auto renderFrame = [&]()
+        {
+            g_Values.AppTime.NewFrame();
+            graphics.PrepareFrame();
+            effect->Draw();
+            graphics.PostProcessFrame(graphics.GetLEDCount(), 0);
+        };
+
+        for (size_t frame = 0; frame < options.warmup; frame++)
+            renderFrame();
+
+        std::vector<uint32_t> frameMicros, frameBytes;
+        frameMicros.reserve(options.frames);
+        frameBytes.reserve(options.frames);
+        uint64_t allocations = 0;
+
+        for (size_t frame = 0; frame < options.frames; frame++)
+        {
+            const auto heapBefore = HostGetHeapStats();
+            const unsigned long start = micros();
+
+            renderFrame();
+
+            const unsigned long elapsed = micros() - start;
+            const auto heapAfter = HostGetHeapStats();
+
+            frameMicros.push_back(elapsed);
+            frameBytes.push_back(heapAfter.bytesAllocated - heapBefore.bytesAllocated);
+            allocations += heapAfter.allocations - heapBefore.allocations;
+        }
+
+        result.micros = FrameStats::From(std::move(frameMicros));
+        result.heapBytes = FrameStats::From(std::move(frameBytes));
+        result.allocationsPerFrame = static_cast<double>(allocations) / options.frames;
+        return result;
+    }
+
+    void PrintTable(const std::vector<EffectResult>& results)
+    {
+        printf("%-32s %9s %9s %9s %9s %12s %10s\n", "effect", "min us", "median us", "p99 us", "max us", "heap B/frm", "allocs/frm");
+        for (const auto& result : results)
+        {
+            printf("%-32s %9u %9u %9u %9u %12.1f %10.2f\n",
+                   result.name.c_str(),
+                   result.micros.min,
+                   result.micros.median,
+                   result.micros.p99,
+                   result.micros.max,
+                   result.heapBytes.mean,
+                   result.allocationsPerFrame);
+        }
+    }
+
+    // PrintJSON
+    //
+    // Keys are stable and effects come out in factory order, so two runs can be compared with a plain
+    // text diff or loaded side by side by a script.
+
+    void PrintJSON(const std::vector<EffectResult>& results, const BenchOptions& options)
+    {
+        JsonDocument doc;
+
+        doc["version"]  = FLASH_VERSION_NAME;
+        doc["width"]    = MATRIX_WIDTH;
+        doc["height"]   = MATRIX_HEIGHT;
+        doc["frames"]   = options.frames;
+        doc["warmup"]   = options.warmup;
+        doc["seed"]     = options.seed;
+
+        auto effects = doc["effects"].to<JsonArray>();
+        for (const auto& result : results)
+        {
+            auto entry = effects.add<JsonObject>();
+            entry["name"]     = result.name;
+            entry["effectId"] = result.effectId;
+
+            auto frameMicros = entry["us"].to<JsonObject>();
+            frameMicros["min"]    = result.micros.min;
+            frameMicros["median"] = result.micros.median;
+            frameMicros["p99"]    = result.micros.p99;
+            frameMicros["max"]    = result.micros.max;
+            frameMicros["mean"]   = result.micros.mean;
+
+            auto heap = entry["heap"].to<JsonObject>();
+            heap["bytesPerFrame"]       = result.heapBytes.mean;
+            heap["maxBytesPerFrame"]    = result.heapBytes.max;
+            heap["allocationsPerFrame"] = result.allocationsPerFrame;
+            heap["initBytes"]           = result.initBytes;
+        }
+
+        std::string output;
+        serializeJsonPretty(doc, output);
+        puts(output.c_str());
+    }
+}
+
+// RunEffectsSuite
+//
+// The default suite: every registered effect, in factory order.
+
+int RunEffectsSuite(const BenchOptions& options)
+{
+    int failures = 0;
+    std::vector<EffectResult> results;
+    for (const auto& factory : g_ptrEffectFactories->GetDefaultFactories())
+    {
+        auto probe = factory.CreateEffect();
+        if (!probe || !MatchesFilter(probe->FriendlyName(), options))
+            continue;
+
+        if (options.list)
+        {
+            printf("%s\n", probe->FriendlyName().c_str());
+            continue;
+        }
+
+        probe.reset();
+        if (auto result = RunEffect(factory, options))
+            results.push_back(std::move(*result));
+        else
+            failures++;
+    }
+
+    if (!options.list)
+    {
+        if (options.json)
+            PrintJSON(results, options);
+        else
+            PrintTable(results);
+    }
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        StartHost();
+    }
+    catch (const std::exception& ex)
+    {
+        fprintf(stderr, "Host startup failed: %s\n", ex.what());
+        return EXIT_FAILURE;
+    }
+
+    int failures = 0;
+    if (options.suite == "effects")
+        failures = RunEffectsSuite(options);
+    else if (options.suite == "xy")
+        failures = RunXYSuite(options);
+    else if (options.suite == "pixelmap")
+        failures = RunPixelMapSuite(options);
+    else if (options.suite == "blur")
+        failures = RunBlurSuite(options);
+    else if (options.suite == "span")
+        failures = RunSpanSuite(options);
+    else if (options.suite == "palette")
+        failures = RunPaletteSuite(options);
+    else if (options.suite == "noise")
+        failures = RunNoiseSuite(options);
+    else if (options.suite == "polar")
+        failures = RunPolarSuite(options);
+    else if (options.suite == "ingest")
+        failures = RunIngestSuite(options);
+    else if (options.suite == "inflate")
+        failures = RunInflateSuite(options);
+    else if (options.suite == "delta")
+        failures = RunDeltaSuite(options);
+    else if (options.suite == "queue")
+        failures = RunQueueSuite(options);
+    else if (options.suite == "jitter")
+        failures = RunJitterSuite(options);
+    else if (options.suite == "udp")
+        failures = RunUdpSuite(options);
+    else if (options.suite == "lighting")
+        failures = RunLightingSuite(options);
+    else if (options.suite == "batch")
+        failures = RunBatchSuite(options);
+    else if (options.suite == "pack")
+        failures = RunPackSuite(options);
+    else if (options.suite == "show")
+        failures = RunShowSuite(options);
+    else if (options.suite == "wire")
+        failures = RunWireSuite(options);
+    else
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    fflush(stdout);
+
+    // Skip static destructors: service tasks are still parked on their own threads
+    std::_Exit(failures ? EXIT_FAILURE : EXIT_SUCCESS);
+}
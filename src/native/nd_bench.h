@@ -0,0 +1,162 @@
+#pragma once
+
+//+--------------------------------------------------------------------------
+//
+// File:        nd_bench.h
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Shared pieces of the nd_bench host benchmark: command line options,
+//    per-frame statistics and the entry points of the individual suites.
+//    Each suite lives in its own src/native/bench_*.cpp and returns the
+//    number of failures (checks that didn't hold) it found.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct BenchOptions
+{
+    std::string suite = "effects";
+    bool list = false;
+    bool json = false;
+    size_t frames = 300;
+    size_t warmup = 10;
+    unsigned long seed = 1;
+    std::vector<std::string> effects;       // Case-insensitive substrings; empty means "all"
+    std::string capture;                    // Socket stream (inflate and delta suites) or pcap (lighting) to replay; empty means synthesize one
+    std::string save;                       // Where the wire suite writes its capture; empty means don't
+    double jitterMs = 10;                   // Simulated network for the jitter suite: mean extra delay,
+    double driftPpm = 50;                   //   receiver clock drift against the sender's,
+    double leadMs = 0;                      //   and how far ahead of sending frames are stamped
+    double lossPct = 2;                     // Simulated link for the udp suite: datagrams lost,
+    size_t reorder = 4;                     //   and how far they can be reordered
+    int listenPort = 0;                     // Receive from tools/udpsender.py on this port instead; 0 means don't
+};
+
+// FrameStats
+//
+// Order statistics over one run's per-frame samples. Percentiles use the nearest-rank method
+// so every reported value is a frame that actually happened.
+
+struct FrameStats
+{
+    uint32_t min = 0;
+    uint32_t median = 0;
+    uint32_t p99 = 0;
+    uint32_t max = 0;
+    double   mean = 0;
+
+    static FrameStats From(std::vector<uint32_t> samples)
+    {
+        FrameStats stats;
+        if (samples.empty())
+            return stats;
+
+        std::sort(samples.begin(), samples.end());
+        auto rank = [&](double p) { return samples[std::max<size_t>(1, static_cast<size_t>(std::ceil(p * samples.size()))) - 1]; };
+
+        stats.min    = samples.front();
+        stats.median = rank(0.50);
+        stats.p99    = rank(0.99);
+        stats.max    = samples.back();
+        for (auto sample : samples)
+            stats.mean += sample;
+        stats.mean /= samples.size();
+        return stats;
+    }
+};
+
+// TimeFrames
+//
+// Runs frame() warmup + frames times and returns the statistics of the timed calls.
+
+template <typename Frame>
+FrameStats TimeFrames(const BenchOptions& options, Frame&& frame)
+{
+    for (size_t i = 0; i < options.warmup; i++)
+        frame();
+
+    std::vector<uint32_t> samples;
+    samples.reserve(options.frames);
+    for (size_t i = 0; i < options.frames; i++)
+    {
+        const unsigned long start = micros();
+        frame();
+        samples.push_back(micros() - start);
+    }
+    return FrameStats::From(std::move(samples));
+}
+
+// Keeps the optimizer from discarding a result that is only computed to be timed
+
+template <typename T>
+inline void KeepAlive(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Counts a check that didn't hold: says what on stderr, after the suite's name, and
+// returns 1 so suites can add the results up into their failure count
+
+inline int Check(const char* suite, bool condition, const char* what)
+{
+    if (condition)
+        return 0;
+    fprintf(stderr, "%s: %s\n", suite, what);
+    return 1;
+}
+
+inline int Check(const char* suite, bool condition, const std::string& what)
+{
+    return Check(suite, condition, what.c_str());
+}
+
+inline int Check(const char* suite, bool condition, const String& what)
+{
+    return Check(suite, condition, what.c_str());
+}
+
+int RunEffectsSuite(const BenchOptions& options);
+int RunXYSuite(const BenchOptions& options);
+int RunPixelMapSuite(const BenchOptions& options);
+int RunBlurSuite(const BenchOptions& options);
+int RunSpanSuite(const BenchOptions& options);
+int RunPaletteSuite(const BenchOptions& options);
+int RunNoiseSuite(const BenchOptions& options);
+int RunPolarSuite(const BenchOptions& options);
+int RunIngestSuite(const BenchOptions& options);
+int RunInflateSuite(const BenchOptions& options);
+int RunDeltaSuite(const BenchOptions& options);
+int RunQueueSuite(const BenchOptions& options);
+int RunJitterSuite(const BenchOptions& options);
+int RunUdpSuite(const BenchOptions& options);
+int RunLightingSuite(const BenchOptions& options);
+int RunBatchSuite(const BenchOptions& options);
+int RunPackSuite(const BenchOptions& options);
+int RunShowSuite(const BenchOptions& options);
+int RunWireSuite(const BenchOptions& options);
@@ -51,7 +51,9 @@
 #include "deviceconfig.h"
 #include "effectmanager.h"
 #include "ledbuffer.h"
+#include "lightingserver.h"
 #include "nd_network.h"
+#include "pixelbatch.h"
 
 #if ENABLE_REMOTE
     #include "remotecontrol.h"
@@ -60,6 +62,7 @@
 #include "socketserver.h"
 #include "systemcontainer.h"
 #include "taskmgr.h"
+#include "udpserver.h"
 #include "values.h"
 #include "webserver.h"
 #include "websocketserver.h"
@@ -658,16 +661,18 @@ namespace nd_network
             IsWiFiConnected() ? WiFi.localIP().toString().c_str() : "None");
         if (g_ptrSystem->HasBufferManagers())
         {
+            // Depth and ages are safe to read from any task
             auto &bufferManager = g_ptrSystem->GetBufferManagers()[0];
-            // Buffer indices are mutated by the socket task and consumed by
-            // the render task; status reads need the same mutex or they can
-            // sample a half-updated ring state on the other core.
-            std::lock_guard guard(g_buffer_mutex);
             DebugCLI::cli_printf("BUFR:%02zu/%02zu [%lufps]",
                 (size_t)bufferManager.Depth(), (size_t)bufferManager.BufferCount(),
                 (unsigned long)g_Values.FPS);
             DebugCLI::cli_printf("DATA:%+04.2f-%+04.2f",
                 (float)bufferManager.AgeOfOldestBuffer(), (float)bufferManager.AgeOfNewestBuffer());
+            const auto& scheduler = bufferManager.Scheduler();
+            DebugCLI::cli_printf("PLAY:%ldus +/-%ldus %+ldppm late:%lu drop:%lu full:%lu",
+                (long)scheduler.PlayoutDelay(), (long)scheduler.Jitter(), (long)scheduler.ClockDriftPPM(),
+                (unsigned long)scheduler.LateFrames(), (unsigned long)scheduler.DroppedFrames(),
+                (unsigned long)scheduler.OverwrittenFrames());
         }
 
         #if ENABLE_AUDIO
@@ -678,6 +683,28 @@ namespace nd_network
         #if INCOMING_WIFI_ENABLED
         DebugCLI::cli_printf("Socket Buffer _cbReceived: %zu", g_ptrSystem->GetSocketServer()._cbReceived);
         #endif
+
+        #if UDP_PIXEL_SERVER_ENABLED
+        if (g_ptrSystem->HasUdpServer())
+        {
+            const auto& assembler = g_ptrSystem->GetUdpServer().Assembler();
+            DebugCLI::cli_printf("UDP: Frames: %lu, Dropped: %lu, Late: %lu, Duplicate: %lu, Malformed: %lu",
+                (unsigned long)assembler.FramesCompleted(), (unsigned long)assembler.FramesDropped(),
+                (unsigned long)assembler.LateFragments(), (unsigned long)assembler.DuplicateFragments(),
+                (unsigned long)assembler.MalformedDatagrams());
+        }
+        #endif
+
+        #if LIGHTING_PROTOCOLS_ENABLED
+        if (g_ptrSystem->HasLightingServer() && g_ptrSystem->GetLightingServer().Receiver())
+        {
+            const auto& receiver = *g_ptrSystem->GetLightingServer().Receiver();
+            DebugCLI::cli_printf("DDP/E1.31/Art-Net: Packets: %lu, Frames: %lu, Syncs: %lu, Out of sequence: %lu, Malformed: %lu",
+                (unsigned long)receiver.Packets(), (unsigned long)receiver.FramesPresented(),
+                (unsigned long)receiver.SyncPackets(), (unsigned long)receiver.OutOfSequence(),
+                (unsigned long)receiver.MalformedPackets());
+        }
+        #endif
     }
 
     void InitNetworkCLI()
@@ -921,6 +948,9 @@ bool ProcessIncomingData(allocated_unique_ptr<uint8_t[]> &payloadData, size_t pa
 
                 // Go through the channel mask to see which bits are set in the channel16 specifier, and send the data to each and every
                 // channel that matches the mask.  So if the send channel 7, that means the lowest 3 channels will be set.
+                // Each copy goes into the channel's reserved buffer and is committed, which replaces the newest frame if
+                // the timestamps match. The lock is held from reserve to commit, as the UDP server and the socket
+                // server's compressed path both come through here; the render task never waits on it.
                 std::lock_guard guard(g_buffer_mutex);
 
                 for (int iChannel = 0, channelMask = 1; iChannel < g_ptrSystem->GetBufferManagers().size(); iChannel++, channelMask <<= 1)
@@ -929,13 +959,11 @@ bool ProcessIncomingData(allocated_unique_ptr<uint8_t[]> &payloadData, size_t pa
                     {
                         debugV("Processing for Channel %d", iChannel);
 
-                        bool bDone = false;
                         auto &bufferManager = g_ptrSystem->GetBufferManagers()[iChannel];
                         const size_t channelLedCount = bufferManager.LEDCount();
 
-                        // Validate against the active channel before reserving a
-                        // circular-buffer slot. Reserving first meant a rejected
-                        // packet could leave an old frame queued in the new slot.
+                        // Validate against the active channel before touching its reserved buffer, so a rejected
+                        // packet can't leave a half-written frame behind
                         if (!LEDBuffer::ValidateWirePayload(payloadData.get(), payloadLength, channelLedCount))
                         {
                             debugW("Pixel packet rejected for channel %d: %lu LEDs, channel has %zu",
@@ -943,29 +971,46 @@ bool ProcessIncomingData(allocated_unique_ptr<uint8_t[]> &payloadData, size_t pa
                             return false;
                         }
 
-                        if (!bufferManager.IsEmpty())
-                        {
-                            auto pNewestBuffer = bufferManager.PeekNewestBuffer();
-                            if (micros != 0 && pNewestBuffer->MicroSeconds() == micros && pNewestBuffer->Seconds() == seconds)
-                            {
-                                debugV("Updating existing buffer");
-                                if (!pNewestBuffer->UpdateFromWire(payloadData.get(), payloadLength))
-                                    return false;
-                                bDone = true;
-                            }
-                        }
-                        if (!bDone)
-                        {
-                            debugV("No match so adding new buffer");
-                            auto pNewBuffer = bufferManager.GetNewBuffer();
-                            if (!pNewBuffer || !pNewBuffer->UpdateFromWire(payloadData.get(), payloadLength))
-                                return false;
-                        }
+                        auto pBuffer = bufferManager.ReserveBuffer(BufferReservation::Incoming);
+                        if (!pBuffer || !pBuffer->UpdateFromWire(payloadData.get(), payloadLength))
+                            return false;
+                        bufferManager.CommitBuffer(pBuffer);
                     }
                 }
                 return true;
             }
 
+            // WIFI_COMMAND_PIXELBATCH64 has a header, a table of entries and the pixels they share
+            case WIFI_COMMAND_PIXELBATCH64:
+            {
+                uint16_t entryCount = WORDFromMemory(&payloadData[2]);
+                uint32_t length32   = DWORDFromMemory(&payloadData[4]);
+                uint64_t seconds    = ULONGFromMemory(&payloadData[8]);
+                uint64_t micros     = ULONGFromMemory(&payloadData[16]);
+
+                size_t expectedLength = 0;
+                bool inOrder = false;
+                const uint8_t * pTable = payloadData.get() + PixelBatch::kHeaderSize;
+                if (!PixelBatch::CheckedPacketSize(entryCount, length32, expectedLength) ||
+                    payloadLength < expectedLength ||
+                    !PixelBatch::CheckTable(pTable, entryCount, length32, inOrder))
+                {
+                    debugW("Malformed pixel batch: entries=%u length=%lu payload=%zu",
+                           (unsigned int)entryCount, (unsigned long)length32, payloadLength);
+                    return false;
+                }
+
+                auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+                PixelBatch batch(bufferManagers.data(), bufferManagers.size(), BufferReservation::Incoming);
+
+                std::lock_guard guard(g_buffer_mutex);
+                if (!batch.Reserve(pTable, entryCount))
+                    return false;
+                batch.Fill(pTable, pTable + PixelBatch::TableSize(entryCount));
+                batch.Commit(seconds, micros, LEDBufferManager::ClockMicros());
+                return true;
+            }
+
             default:
             {
                 debugV("ProcessIncomingData -- Unknown command: 0x%x", command16);
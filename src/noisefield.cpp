@@ -0,0 +1,170 @@
+//+--------------------------------------------------------------------------
+//
+// File:        noisefield.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    The inoise16() arithmetic behind noisefield.h, split so the lattice
+//    work can be hoisted out of the per-sample loop.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include "noisefield.h"
+
+namespace
+{
+    // Ken Perlin's permutation, with the first entry repeated so corner + 1 never needs a wrap.
+    // FastLED's noise.cpp uses the same table.
+
+    const uint8_t kPermutation[257] =
+    {
+        151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
+        140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
+        247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
+         57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
+         74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
+         60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
+         65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
+        200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
+         52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
+        207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
+        119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
+        129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
+        218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
+         81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
+        184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
+        222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180,
+        151
+    };
+
+    inline uint8_t P(int index)
+    {
+        return kPermutation[index];
+    }
+
+    inline uint16_t Scale16(uint16_t value, uint16_t scale)
+    {
+        return (static_cast<uint32_t>(value) * (1 + static_cast<uint32_t>(scale))) >> 16;
+    }
+
+    // FastLED's ease16InOutQuad
+    inline uint16_t Ease(uint16_t i)
+    {
+        uint16_t j = (i & 0x8000) ? 65535 - i : i;
+        uint16_t eased = Scale16(j, j) << 1;
+        return (i & 0x8000) ? 65535 - eased : eased;
+    }
+
+    // FastLED's lerp15by16
+    inline int16_t Lerp(int16_t a, int16_t b, uint16_t fraction)
+    {
+        if (b > a)
+            return a + Scale16(static_cast<uint16_t>(b - a), fraction);
+        return a - Scale16(static_cast<uint16_t>(a - b), fraction);
+    }
+
+    // FastLED's grad16, averaged with avg15 (rounds up when the first term is odd)
+    inline int16_t Grad(uint8_t hash, int16_t x, int16_t y, int16_t z)
+    {
+        hash &= 15;
+        int16_t u = hash < 8 ? x : y;
+        int16_t v = hash < 4 ? y : (hash == 12 || hash == 14) ? x : z;
+        if (hash & 1)
+            u = -u;
+        if (hash & 2)
+            v = -v;
+        return (u >> 1) + (v >> 1) + (u & 0x1);
+    }
+
+    // The permutation entries of the eight corners of one lattice cube, in the order inoise16's
+    // lerps visit them
+
+    struct Corners
+    {
+        uint8_t hash[8];
+
+        Corners(uint8_t X, uint8_t Y, uint8_t Z)
+        {
+            const uint8_t A  = P(X) + Y;
+            const uint8_t AA = P(A) + Z;
+            const uint8_t AB = P(A + 1) + Z;
+            const uint8_t B  = P(X + 1) + Y;
+            const uint8_t BA = P(B) + Z;
+            const uint8_t BB = P(B + 1) + Z;
+
+            hash[0] = P(AA);     hash[1] = P(BA);     hash[2] = P(AB);     hash[3] = P(BB);
+            hash[4] = P(AA + 1); hash[5] = P(BA + 1); hash[6] = P(AB + 1); hash[7] = P(BB + 1);
+        }
+    };
+
+    inline uint16_t Blend(const Corners& corners, const NoiseField::Axis& x, const NoiseField::Axis& y, const NoiseField::Axis& z)
+    {
+        const uint8_t* h = corners.hash;
+        const int16_t xx = x.offset, yy = y.offset, zz = z.offset;
+        const int16_t xn = xx - 0x8000, yn = yy - 0x8000, zn = zz - 0x8000;
+
+        const int16_t x1 = Lerp(Grad(h[0], xx, yy, zz), Grad(h[1], xn, yy, zz), x.ease);
+        const int16_t x2 = Lerp(Grad(h[2], xx, yn, zz), Grad(h[3], xn, yn, zz), x.ease);
+        const int16_t x3 = Lerp(Grad(h[4], xx, yy, zn), Grad(h[5], xn, yy, zn), x.ease);
+        const int16_t x4 = Lerp(Grad(h[6], xx, yn, zn), Grad(h[7], xn, yn, zn), x.ease);
+
+        const int16_t y1 = Lerp(x1, x2, y.ease);
+        const int16_t y2 = Lerp(x3, x4, y.ease);
+        const int32_t raw = Lerp(y1, y2, z.ease);
+
+        // Stretch the raw -19052..19052-ish range over 0..65535, as inoise16 does
+        uint32_t stretched = raw + 19052L;
+        stretched *= 440L;
+        return stretched >> 8;
+    }
+}
+
+NoiseField::Axis NoiseField::Axis::From(uint32_t coordinate)
+{
+    const uint16_t fraction = coordinate & 0xFFFF;
+    return { static_cast<uint8_t>(coordinate >> 16), Ease(fraction), static_cast<int16_t>(fraction >> 1) };
+}
+
+uint16_t NoiseField::Sample(const Axis& x, const Axis& y, const Axis& z)
+{
+    return Blend(Corners(x.cell, y.cell, z.cell), x, y, z);
+}
+
+void NoiseField::SampleLine(uint8_t* out, const Axis& x, const Axis* ys, size_t count, const Axis& z)
+{
+    if (count == 0)
+        return;
+
+    Corners corners(x.cell, ys[0].cell, z.cell);
+    uint8_t cell = ys[0].cell;
+
+    for (size_t j = 0; j < count; j++)
+    {
+        if (ys[j].cell != cell)
+        {
+            cell = ys[j].cell;
+            corners = Corners(x.cell, cell, z.cell);
+        }
+        out[j] = Blend(corners, x, ys[j], z) >> 8;
+    }
+}
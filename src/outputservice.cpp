@@ -0,0 +1,189 @@
+//+--------------------------------------------------------------------------
+//
+// File:        outputservice.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    OutputService: the frame pool the render task posts into and the
+//    task that shows what's posted.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#if USE_STRIP && ASYNC_STRIP_OUTPUT
+
+#include <cstring>
+
+#include "frametiming.h"
+#include "gfxbase.h"
+#include "outputservice.h"
+#include "taskmgr.h"
+
+ITaskService::TaskConfig OutputService::GetTaskConfig() const
+{
+    return TaskConfig {
+        "Output Loop",
+        OUTPUT_STACK_SIZE,
+        OUTPUT_PRIORITY,
+        OUTPUT_CORE
+    };
+}
+
+// OutputService::WaitForShown
+//
+// Blocks the calling task until `target` frames have been shown. The output task notifies
+// whoever is in _waiter after each frame; the short timeout only bounds how long a stop
+// request can go unnoticed, and keeps a caller that isn't a task (nd_bench's main thread)
+// polling. Returns false if the service stopped first.
+
+bool OutputService::WaitForShown(uint32_t target)
+{
+    _waiter.store(xTaskGetCurrentTaskHandle());
+
+    bool shown = true;
+    while (static_cast<int32_t>(_shown.load() - target) < 0)
+    {
+        if (!IsRunning() || ShouldShutdown())
+        {
+            shown = false;
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1));
+    }
+
+    _waiter.store(nullptr);
+    return shown;
+}
+
+// OutputService::Snapshot
+//
+// Copies each device's leds, and whites where it has them, into one frame. The frame's
+// buffers only reallocate when the topology grows, so a steady frame is just the copies.
+
+void OutputService::Snapshot(Frame& frame, const std::vector<std::shared_ptr<GFXBase>>& devices)
+{
+    const size_t channelCount = std::min<size_t>(devices.size(), NUM_CHANNELS);
+
+    size_t ledTotal = 0, whiteTotal = 0;
+    for (size_t i = 0; i < channelCount; ++i)
+    {
+        ledTotal += devices[i]->GetLEDCount();
+        if (devices[i]->whites)
+            whiteTotal += devices[i]->GetLEDCount();
+    }
+    frame.leds.resize(ledTotal);
+    frame.whites.resize(whiteTotal);
+
+    CRGB*  leds   = frame.leds.data();
+    CRGBW* whites = frame.whites.data();
+    for (size_t i = 0; i < channelCount; ++i)
+    {
+        const auto& device = *devices[i];
+        const size_t ledCount = device.GetLEDCount();
+
+        memcpy(leds, device.leds, ledCount * sizeof(CRGB));
+        frame.planes[i] = { leds, nullptr, ledCount };
+        leds += ledCount;
+
+        if (device.whites)
+        {
+            memcpy(whites, device.whites, ledCount * sizeof(CRGBW));
+            frame.planes[i].whites = whites;
+            whites += ledCount;
+        }
+    }
+    frame.channelCount = channelCount;
+}
+
+bool OutputService::Post(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader)
+{
+    if (!IsRunning() || ShouldShutdown())
+        return false;
+
+    // Back-pressure: with every frame in the pool still waiting to be shown, hold the
+    // render task here until the oldest is out. Only frames that actually waited are
+    // recorded, so the percentiles describe the stalls rather than being all zeroes.
+
+    const uint32_t posted = _posted.load(std::memory_order_relaxed);
+    if (posted - _shown.load() >= kPoolSize)
+    {
+        const uint32_t waitStart = ESP.getCycleCount();
+        const bool freed = WaitForShown(posted - kPoolSize + 1);
+        g_FrameTimings.Record(RenderStage::OutputWait, waitStart, ESP.getCycleCount());
+        if (!freed)
+            return false;
+    }
+
+    Frame& frame = _pool[posted % kPoolSize];
+    {
+        FrameTimings::ScopedStage snapshotStage(g_FrameTimings, RenderStage::Snapshot);
+        Snapshot(frame, devices);
+    }
+    frame.pixelsDrawn  = pixelsDrawn;
+    frame.brightness   = brightness;
+    frame.fader        = fader;
+    frame.postedMicros = micros();
+
+    _posted.store(posted + 1, std::memory_order_release);
+    WakeTask();
+    return true;
+}
+
+void OutputService::Flush()
+{
+    if (IsRunning())
+        WaitForShown(_posted.load());
+}
+
+// OutputService::Run
+//
+// Shows posted frames oldest first, sleeping until the render task posts when there are
+// none. A frame only goes back to the pool once ShowPlanes() has returned; a pipelined
+// WS281x manager has packed it by then and no longer reads the planes.
+
+void OutputService::Run()
+{
+    debugW(">> OutputService::Run\n");
+
+    while (!ShouldShutdown())
+    {
+        const uint32_t shown = _shown.load(std::memory_order_relaxed);
+        if (_posted.load(std::memory_order_acquire) == shown)
+        {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+            continue;
+        }
+
+        const Frame& frame = _pool[shown % kPoolSize];
+        g_FrameTimings.RecordMicros(RenderStage::OutputQueue, micros() - frame.postedMicros);
+        {
+            FrameTimings::ScopedStage showStage(g_FrameTimings, RenderStage::Show);
+            _output.ShowPlanes(frame.planes.data(), frame.channelCount, frame.pixelsDrawn, frame.brightness, frame.fader);
+        }
+
+        _shown.store(shown + 1);
+        if (TaskHandle_t waiter = _waiter.load())
+            xTaskNotifyGive(waiter);
+    }
+}
+
+#endif
@@ -0,0 +1,147 @@
+//+--------------------------------------------------------------------------
+//
+// File:        pixelbatch.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Decoding of WIFI_COMMAND_PIXELBATCH64 packets; see pixelbatch.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "byte_utils.h"
+#include "pixelbatch.h"
+
+bool PixelBatch::CheckedPacketSize(uint16_t entryCount, uint32_t pixelCount, size_t & packetSize)
+{
+    packetSize = 0;
+    if (entryCount == 0 || entryCount > kMaxEntries)
+        return false;
+
+    const size_t cbFixed = kHeaderSize + TableSize(entryCount);
+    if (pixelCount > (std::numeric_limits<size_t>::max() - cbFixed) / sizeof(CRGB))
+        return false;
+
+    packetSize = cbFixed + pixelCount * sizeof(CRGB);
+    return true;
+}
+
+bool PixelBatch::CheckTable(const uint8_t * pTable, uint16_t entryCount, uint32_t pixelCount, bool & inOrder)
+{
+    uint64_t end = 0;
+    inOrder = true;
+
+    for (uint16_t i = 0; i < entryCount; i++)
+    {
+        uint32_t offset, count;
+        Entry(pTable, i, offset, count);
+        if (count == 0)
+            continue;
+
+        if ((uint64_t)offset + count > pixelCount)
+        {
+            debugW("Batch entry %u covers pixels %lu-%llu of %lu", i, (unsigned long)offset,
+                   (unsigned long long)offset + count - 1, (unsigned long)pixelCount);
+            return false;
+        }
+        if (offset < end)
+            inOrder = false;
+        end = (uint64_t)offset + count;
+    }
+    return true;
+}
+
+void PixelBatch::Entry(const uint8_t * pTable, size_t iEntry, uint32_t & offset, uint32_t & count)
+{
+    offset = DWORDFromMemory(pTable + iEntry * kEntrySize);
+    count  = DWORDFromMemory(pTable + iEntry * kEntrySize + 4);
+}
+
+PixelBatch::PixelBatch(LEDBufferManager * pManagers, size_t cManagers, BufferReservation reservation)
+    : _pManagers(pManagers),
+      _cManagers(std::min(cManagers, kMaxEntries)),
+      _reservation(reservation)
+{
+}
+
+bool PixelBatch::Reserve(const uint8_t * pTable, uint16_t entryCount)
+{
+    const size_t cChannels = std::min<size_t>(entryCount, _cManagers);
+
+    // Check every channel before reserving any, so a rejected batch leaves them all alone
+    for (size_t i = 0; i < cChannels; i++)
+    {
+        uint32_t offset;
+        Entry(pTable, i, offset, _counts[i]);
+        if (_counts[i] > _pManagers[i].LEDCount())
+        {
+            debugW("Pixel batch rejected for channel %zu: %lu LEDs, channel has %zu",
+                   i, (unsigned long)_counts[i], _pManagers[i].LEDCount());
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < cChannels; i++)
+        if (_counts[i] > 0)
+            _targets[i] = _pManagers[i].ReserveBuffer(_reservation);
+    return true;
+}
+
+CRGB * PixelBatch::Target(size_t iChannel) const
+{
+    return iChannel < _targets.size() && _targets[iChannel] ? _targets[iChannel]->Pixels() : nullptr;
+}
+
+void PixelBatch::Fill(const uint8_t * pTable, const uint8_t * pPixels)
+{
+    for (size_t i = 0; i < _cManagers; i++)
+    {
+        if (!_targets[i])
+            continue;
+
+        uint32_t offset, count;
+        Entry(pTable, i, offset, count);
+        memcpy(_targets[i]->Pixels(), pPixels + (size_t)offset * sizeof(CRGB), (size_t)count * sizeof(CRGB));
+    }
+}
+
+int PixelBatch::Commit(uint64_t seconds, uint64_t micros, uint64_t arrivalMicros)
+{
+    int firstChannel = -1;
+    for (size_t i = 0; i < _cManagers; i++)
+    {
+        if (!_targets[i])
+            continue;
+
+        _targets[i]->SetFrame(seconds, micros, _counts[i]);
+        if (firstChannel < 0)
+            firstChannel = i;
+    }
+
+    if (firstChannel < 0 || LEDBufferManager::CommitBuffers(_pManagers, _cManagers, _targets.data(), arrivalMicros) == 0)
+        return -1;
+    return firstChannel;
+}
@@ -0,0 +1,138 @@
+//+--------------------------------------------------------------------------
+//
+// File:        pixeldelta.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Decoding of WIFI_COMMAND_PIXELDELTA64 frames; see pixeldelta.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "byte_utils.h"
+#include "pixeldelta.h"
+
+bool PixelDelta::CheckRuns(const uint8_t * pRuns, uint16_t runCount, uint32_t pixelCount, size_t & changedPixels)
+{
+    size_t covered = 0;
+    changedPixels = 0;
+
+    for (uint16_t i = 0; i < runCount; i++, pRuns += kRunSize)
+    {
+        const uint16_t skip  = WORDFromMemory(pRuns);
+        const uint16_t count = WORDFromMemory(pRuns + 2);
+
+        covered += skip + count;
+        if (covered > pixelCount)
+        {
+            debugW("Delta run %u reaches pixel %zu of %lu", i, covered, (unsigned long)pixelCount);
+            return false;
+        }
+        changedPixels += count;
+    }
+    return true;
+}
+
+PixelDelta::PixelDelta(const uint8_t * pRuns, uint16_t runCount, CRGB * pPixels)
+    : _pRuns(pRuns),
+      _runsLeft(runCount),
+      _pDest(reinterpret_cast<uint8_t *>(pPixels))
+{
+    NextRun();
+}
+
+// NextRun
+//
+// Step over runs until one with pixels in it, skipping the unchanged pixels ahead of each
+
+void PixelDelta::NextRun()
+{
+    while (_cbLeftInRun == 0 && _runsLeft > 0)
+    {
+        _pDest       += WORDFromMemory(_pRuns) * sizeof(CRGB);
+        _cbLeftInRun  = WORDFromMemory(_pRuns + 2) * sizeof(CRGB);
+        _pRuns       += kRunSize;
+        _runsLeft--;
+    }
+}
+
+void PixelDelta::Feed(const uint8_t * pData, size_t cb)
+{
+    while (cb > 0 && _cbLeftInRun > 0)
+    {
+        const size_t cbCopy = std::min(cb, _cbLeftInRun);
+        memcpy(_pDest, pData, cbCopy);
+
+        _pDest       += cbCopy;
+        _cbLeftInRun -= cbCopy;
+        pData        += cbCopy;
+        cb           -= cbCopy;
+        NextRun();
+    }
+}
+
+bool DeltaSequence::PrepareBase(const LEDBufferManager & manager, uint16_t channel16, uint32_t sequence, uint16_t flags, uint32_t pixelCount, LEDBuffer & target)
+{
+    if (flags & PixelDelta::kKeyframe)
+    {
+        memset(target.Pixels(), 0, pixelCount * sizeof(CRGB));
+        return true;
+    }
+
+    if (!_valid)
+        return false;
+
+    // Anything queued on the channel since our last frame, a Reconfigure() included, bumps its generation
+    if (channel16 != _channel16 || sequence != _sequence + 1 || manager.Generation() != _generation ||
+        _base.size() != pixelCount)
+    {
+        debugW("Delta frame %lu doesn't follow frame %lu on this channel, waiting for a keyframe",
+               (unsigned long)sequence, (unsigned long)_sequence);
+        _valid = false;
+        return false;
+    }
+
+    std::copy(_base.begin(), _base.end(), target.Pixels());
+    return true;
+}
+
+// Committed
+//
+// The copy is taken while the caller still holds g_buffer_mutex, so frame can't have been handed to
+// another receiver yet, even if the render task has already drawn it
+
+void DeltaSequence::Committed(const LEDBufferManager & manager, uint16_t channel16, uint32_t sequence, const LEDBuffer & frame)
+{
+    _base.assign(frame.Pixels(), frame.Pixels() + frame.Length());
+    _valid      = true;
+    _channel16  = channel16;
+    _sequence   = sequence;
+    _generation = manager.Generation();
+}
+
+void DeltaSequence::Reset()
+{
+    _valid = false;
+}
@@ -0,0 +1,263 @@
+//+--------------------------------------------------------------------------
+//
+// File:        pixelformat.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// Description:
+//
+//   The pack kernels behind PixelFormat::SelectKernel(). Each is a format's
+//   Pack() with the color order made a template parameter, so the swizzle
+//   folds into where each byte lands in the word being built, and with
+//   every multiply and divide replaced by a lookup in PackParams. RGB and
+//   RGBCCW pixels are packed four at a time, 12 and 20 bytes, so every
+//   store is a whole aligned word; an RGBW pixel is a word on its own.
+//   Each also sums the channel values it looks up as it goes, which is
+//   all the power limiter needs of the frame.
+//
+//   Anything changed here has to stay byte-identical with Pack(); run
+//   nd_bench --suite pack.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <cstring>
+
+#include "pixelformat.h"
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Pack kernels build wire bytes in little-endian words");
+static_assert(sizeof(CRGB) == 3, "Pack kernels read CRGB as three packed bytes");
+
+void PackParams::SetScale(uint8_t brightness, uint8_t fader, const uint8_t* gamma)
+{
+    for (size_t value = 0; value < scale.size(); ++value)
+        scale[value] = PixelFormatHelpers::Scale(gamma ? gamma[value] : static_cast<uint8_t>(value), brightness, fader);
+}
+
+void PackParams::SetWhitePolicy(uint16_t cctKelvin, uint8_t cw, uint8_t ww, uint8_t whiteExtractRatio)
+{
+    for (size_t shared = 0; shared < pull.size(); ++shared)
+    {
+        pull[shared]      = static_cast<uint8_t>((shared * whiteExtractRatio + 127) / 255);
+        coolShare[shared] = SplitByCct(cctKelvin, static_cast<uint8_t>(shared)).cw;
+    }
+    ambientWhite = PixelFormatHelpers::SaturatingAdd(cw, ww);
+    ambientCw    = cw;
+    ambientWw    = ww;
+}
+
+namespace
+{
+    // A wire color order as the byte each of R, G and B goes to
+    template <uint8_t R, uint8_t G, uint8_t B>
+    struct Order
+    {
+        static constexpr uint8_t r = R;
+        static constexpr uint8_t g = G;
+        static constexpr uint8_t b = B;
+    };
+
+    constexpr size_t kGroup = 4;            // Pixels per group; 4 x 3 and 4 x 5 bytes are whole words
+
+    inline uint8_t Min3(uint8_t r, uint8_t g, uint8_t b)
+    {
+        return std::min(r, std::min(g, b));
+    }
+
+    // Ws2812Format
+
+    template <typename O>
+    struct RgbKernel
+    {
+        static void Pixel(uint8_t* out, const uint8_t* in, const uint8_t* scale, PackSums& sums)
+        {
+            out[O::r] = scale[in[0]];
+            out[O::g] = scale[in[1]];
+            out[O::b] = scale[in[2]];
+            sums.red   += in[0];
+            sums.green += in[1];
+            sums.blue  += in[2];
+        }
+
+        static PackSums Pack(uint8_t* output, const CRGB* leds, const CRGBW* /*whites*/, size_t activeLedCount, size_t pixelsToShow, const PackParams& params)
+        {
+            PackSums sums;
+            const uint8_t* scale = params.scale.data();
+            const uint8_t* in    = reinterpret_cast<const uint8_t*>(leds);
+            uint8_t* out         = static_cast<uint8_t*>(__builtin_assume_aligned(output, 4));
+            const size_t shown   = std::min(pixelsToShow, activeLedCount);
+
+            size_t i = 0;
+            for (; i + kGroup <= shown; i += kGroup, in += kGroup * 3, out += kGroup * 3)
+            {
+                uint32_t words[3];
+                auto* group = reinterpret_cast<uint8_t*>(words);
+                for (size_t k = 0; k < kGroup; ++k)
+                    Pixel(group + k * 3, in + k * 3, scale, sums);
+                memcpy(out, words, sizeof(words));
+            }
+            for (; i < shown; ++i, in += 3, out += 3)
+                Pixel(out, in, scale, sums);
+
+            // Black past the pixels drawn
+            std::fill(out, out + (activeLedCount - i) * 3, scale[0]);
+
+            sums.pixels = activeLedCount;
+            return sums;
+        }
+    };
+
+    // Sk6812Format
+
+    template <typename O>
+    struct RgbwKernel
+    {
+        static uint32_t Pixel(const uint8_t* in, uint8_t effectWhite, const PackParams& params, PackSums& sums)
+        {
+            uint8_t r = in[0], g = in[1], b = in[2];
+            uint8_t pull = 0;
+            if (effectWhite == 0)
+            {
+                pull = params.pull[Min3(r, g, b)];
+                r -= pull;
+                g -= pull;
+                b -= pull;
+            }
+            const uint8_t w = std::max(PixelFormatHelpers::SaturatingAdd(pull, effectWhite), params.ambientWhite);
+            sums.red   += r;
+            sums.green += g;
+            sums.blue  += b;
+            sums.white += w;
+
+            const uint8_t* scale = params.scale.data();
+            return static_cast<uint32_t>(scale[r]) << (8 * O::r)
+                 | static_cast<uint32_t>(scale[g]) << (8 * O::g)
+                 | static_cast<uint32_t>(scale[b]) << (8 * O::b)
+                 | static_cast<uint32_t>(scale[w]) << 24;
+        }
+
+        template <bool kWhites>
+        static PackSums Run(uint32_t* out, const uint8_t* in, const CRGBW* whites, size_t activeLedCount, size_t shown, const PackParams& params)
+        {
+            static constexpr uint8_t kBlack[3] = { 0, 0, 0 };
+            PackSums sums;
+            for (size_t i = 0; i < activeLedCount; ++i)
+            {
+                const uint8_t effectWhite = kWhites ? PixelFormatHelpers::SaturatingAdd(whites[i].cw, whites[i].ww) : 0;
+                const uint32_t word = Pixel(i < shown ? in + i * 3 : kBlack, effectWhite, params, sums);
+                memcpy(out + i, &word, sizeof(word));
+            }
+            sums.pixels = activeLedCount;
+            return sums;
+        }
+
+        static PackSums Pack(uint8_t* output, const CRGB* leds, const CRGBW* whites, size_t activeLedCount, size_t pixelsToShow, const PackParams& params)
+        {
+            auto* out = static_cast<uint32_t*>(__builtin_assume_aligned(output, 4));
+            const auto* in = reinterpret_cast<const uint8_t*>(leds);
+            if (whites)
+                return Run<true>(out, in, whites, activeLedCount, pixelsToShow, params);
+            return Run<false>(out, in, whites, activeLedCount, pixelsToShow, params);
+        }
+    };
+
+    // Ws2805Format
+
+    template <typename O>
+    struct RgbccwKernel
+    {
+        static void Pixel(uint8_t* out, const uint8_t* in, CRGBW white, const PackParams& params, PackSums& sums)
+        {
+            uint8_t r = in[0], g = in[1], b = in[2];
+            if (white.isZero())
+            {
+                const uint8_t pull = params.pull[Min3(r, g, b)];
+                r -= pull;
+                g -= pull;
+                b -= pull;
+                white.cw = params.coolShare[pull];
+                white.ww = pull - white.cw;
+            }
+
+            const uint8_t cw = std::max(white.cw, params.ambientCw);
+            const uint8_t ww = std::max(white.ww, params.ambientWw);
+            sums.red   += r;
+            sums.green += g;
+            sums.blue  += b;
+            sums.white += cw + ww;
+
+            const uint8_t* scale = params.scale.data();
+            out[O::r] = scale[r];
+            out[O::g] = scale[g];
+            out[O::b] = scale[b];
+            out[3]    = scale[cw];
+            out[4]    = scale[ww];
+        }
+
+        template <bool kWhites>
+        static PackSums Run(uint8_t* out, const uint8_t* in, const CRGBW* whites, size_t activeLedCount, size_t shown, const PackParams& params)
+        {
+            static constexpr uint8_t kBlack[3] = { 0, 0, 0 };
+            auto whiteAt = [whites](size_t i) { return kWhites ? whites[i] : CRGBW::Black(); };
+            PackSums sums;
+
+            size_t i = 0;
+            for (; i + kGroup <= shown; i += kGroup, out += kGroup * 5)
+            {
+                uint32_t words[5];
+                auto* group = reinterpret_cast<uint8_t*>(words);
+                for (size_t k = 0; k < kGroup; ++k)
+                    Pixel(group + k * 5, in + (i + k) * 3, whiteAt(i + k), params, sums);
+                memcpy(out, words, sizeof(words));
+            }
+            for (; i < activeLedCount; ++i, out += 5)
+                Pixel(out, i < shown ? in + i * 3 : kBlack, whiteAt(i), params, sums);
+
+            sums.pixels = activeLedCount;
+            return sums;
+        }
+
+        static PackSums Pack(uint8_t* output, const CRGB* leds, const CRGBW* whites, size_t activeLedCount, size_t pixelsToShow, const PackParams& params)
+        {
+            auto* out = static_cast<uint8_t*>(__builtin_assume_aligned(output, 4));
+            const auto* in = reinterpret_cast<const uint8_t*>(leds);
+            const size_t shown = std::min(pixelsToShow, activeLedCount);
+            if (whites)
+                return Run<true>(out, in, whites, activeLedCount, shown, params);
+            return Run<false>(out, in, whites, activeLedCount, shown, params);
+        }
+    };
+
+    // The kernel for a color order, with the same GRB fallback as IndicesFor()
+
+    template <template <typename> class Kernel>
+    PackKernel ForOrder(DeviceConfig::WS281xColorOrder colorOrder)
+    {
+        switch (colorOrder)
+        {
+            case DeviceConfig::WS281xColorOrder::RGB: return Kernel<Order<0, 1, 2>>::Pack;
+            case DeviceConfig::WS281xColorOrder::RBG: return Kernel<Order<0, 2, 1>>::Pack;
+            case DeviceConfig::WS281xColorOrder::GRB: return Kernel<Order<1, 0, 2>>::Pack;
+            case DeviceConfig::WS281xColorOrder::GBR: return Kernel<Order<2, 0, 1>>::Pack;
+            case DeviceConfig::WS281xColorOrder::BRG: return Kernel<Order<1, 2, 0>>::Pack;
+            case DeviceConfig::WS281xColorOrder::BGR: return Kernel<Order<2, 1, 0>>::Pack;
+            default:                                  return Kernel<Order<1, 0, 2>>::Pack;
+        }
+    }
+}
+
+PackKernel Ws2812Format::SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const
+{
+    return ForOrder<RgbKernel>(colorOrder);
+}
+
+PackKernel Sk6812Format::SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const
+{
+    return ForOrder<RgbwKernel>(colorOrder);
+}
+
+PackKernel Ws2805Format::SelectKernel(DeviceConfig::WS281xColorOrder colorOrder) const
+{
+    return ForOrder<RgbccwKernel>(colorOrder);
+}
@@ -0,0 +1,237 @@
+//+--------------------------------------------------------------------------
+//
+// File:        pixelmap.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Builds, validates, serializes and loads the lookup tables described
+//    in pixelmap.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <cstring>
+#include <SPIFFS.h>
+
+#include "jsonserializer.h"
+#include "pixelmap.h"
+
+namespace
+{
+    constexpr uint16_t kUnmapped = 0xFFFF;
+
+    uint16_t ReadU16(const uint8_t* p)
+    {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    void WriteU16(std::vector<uint8_t>& out, uint16_t value)
+    {
+        out.push_back(value & 0xFF);
+        out.push_back(value >> 8);
+    }
+
+    std::pair<bool, String> Fail(PixelMap::Table& table, const String& reason)
+    {
+        table.clear();
+        return { false, reason };
+    }
+}
+
+// FromTiles
+//
+// Walks the chain tile by tile, handing out consecutive LED indices, then parks any grid cells
+// that no tile covered on the LEDs the chain skipped or never reached.
+
+std::pair<bool, String> PixelMap::FromTiles(const std::vector<Tile>& tiles, size_t width, size_t height, Table& table)
+{
+    const size_t ledCount = width * height;
+    if (ledCount == 0 || ledCount > kUnmapped)
+        return Fail(table, str_sprintf("pixel map size %zux%zu is out of range", width, height));
+
+    table.assign(ledCount, kUnmapped);
+    size_t nextLED = 0;
+
+    for (size_t t = 0; t < tiles.size(); t++)
+    {
+        const auto& tile = tiles[t];
+
+        if (tile.rotation % 90 != 0 || tile.rotation >= 360)
+            return Fail(table, str_sprintf("tile %zu: rotation must be 0, 90, 180 or 270", t));
+        if (tile.width == 0 || tile.height == 0 || tile.x + tile.width > width || tile.y + tile.height > height)
+            return Fail(table, str_sprintf("tile %zu does not fit in the %zux%zu matrix", t, width, height));
+
+        nextLED += tile.skip;
+
+        // The wiring runs in columns of the tile's own frame, which is turned on its side for 90/270
+        const bool sideways = tile.rotation == 90 || tile.rotation == 270;
+        const uint16_t columns = sideways ? tile.height : tile.width;
+        const uint16_t rows    = sideways ? tile.width : tile.height;
+
+        for (uint16_t u = 0; u < columns; u++)
+        {
+            for (uint16_t i = 0; i < rows; i++)
+            {
+                const uint16_t v = (tile.serpentine && (u & 0x01)) ? rows - 1 - i : i;
+
+                uint16_t dx, dy;
+                switch (tile.rotation)
+                {
+                    case 90:  dx = rows - 1 - v;    dy = u;                 break;
+                    case 180: dx = columns - 1 - u; dy = rows - 1 - v;      break;
+                    case 270: dx = v;               dy = columns - 1 - u;   break;
+                    default:  dx = u;               dy = v;                 break;
+                }
+
+                auto& entry = table[(tile.y + dy) * width + tile.x + dx];
+                if (entry != kUnmapped)
+                    return Fail(table, str_sprintf("tile %zu overlaps an earlier tile at (%u, %u)", t, tile.x + dx, tile.y + dy));
+                if (nextLED >= ledCount)
+                    return Fail(table, str_sprintf("layout needs more than the %zu LEDs a %zux%zu matrix has", ledCount, width, height));
+
+                entry = nextLED++;
+            }
+        }
+    }
+
+    // Every index the chain didn't hand out (skipped LEDs and the tail) is a spare that a cell
+    // with no LED behind it can be parked on; the counts always match once the chain fits
+    std::vector<bool> used(ledCount, false);
+    for (auto entry : table)
+        if (entry != kUnmapped)
+            used[entry] = true;
+
+    size_t spare = 0;
+    for (auto& entry : table)
+    {
+        if (entry != kUnmapped)
+            continue;
+        while (used[spare])
+            spare++;
+        entry = spare++;
+    }
+
+    return { true, "" };
+}
+
+std::pair<bool, String> PixelMap::FromLayout(JsonObjectConst layout, size_t width, size_t height, Table& table)
+{
+    if (layout["width"].as<size_t>() != width || layout["height"].as<size_t>() != height)
+        return Fail(table, str_sprintf("layout is %zux%zu but the topology is %zux%zu",
+                                       layout["width"].as<size_t>(), layout["height"].as<size_t>(), width, height));
+
+    std::vector<Tile> tiles;
+    for (JsonObjectConst jsonTile : layout["tiles"].as<JsonArrayConst>())
+    {
+        Tile tile;
+        tile.x          = jsonTile["x"]          | tile.x;
+        tile.y          = jsonTile["y"]          | tile.y;
+        tile.width      = jsonTile["width"]      | tile.width;
+        tile.height     = jsonTile["height"]     | tile.height;
+        tile.rotation   = jsonTile["rotation"]   | tile.rotation;
+        tile.serpentine = jsonTile["serpentine"] | tile.serpentine;
+        tile.skip       = jsonTile["skip"]       | tile.skip;
+        tiles.push_back(tile);
+    }
+
+    if (tiles.empty())
+        return Fail(table, "layout has no tiles");
+
+    return FromTiles(tiles, width, height, table);
+}
+
+// FromBinary
+//
+// The file must be exactly one permutation of 0..width*height-1; anything else would leave some
+// LED unreachable and another written twice.
+
+std::pair<bool, String> PixelMap::FromBinary(const uint8_t* data, size_t size, size_t width, size_t height, Table& table)
+{
+    const size_t ledCount = width * height;
+
+    if (size < kHeaderSize || memcmp(data, kMagic, sizeof(kMagic)) != 0 || data[4] != kVersion)
+        return Fail(table, "not a version 1 pixel map");
+    if (ReadU16(data + 6) != width || ReadU16(data + 8) != height)
+        return Fail(table, str_sprintf("map is %ux%u but the topology is %zux%zu", ReadU16(data + 6), ReadU16(data + 8), width, height));
+    if (size != kHeaderSize + ledCount * sizeof(uint16_t))
+        return Fail(table, "pixel map file is truncated or has trailing data");
+
+    std::vector<bool> seen(ledCount, false);
+    table.resize(ledCount);
+    for (size_t i = 0; i < ledCount; i++)
+    {
+        const uint16_t index = ReadU16(data + kHeaderSize + i * sizeof(uint16_t));
+        if (index >= ledCount || seen[index])
+            return Fail(table, str_sprintf("entry %zu (LED %u) is out of range or repeated", i, index));
+        seen[index] = true;
+        table[i] = index;
+    }
+
+    return { true, "" };
+}
+
+std::vector<uint8_t> PixelMap::ToBinary(const Table& table, size_t width, size_t height)
+{
+    std::vector<uint8_t> out(std::begin(kMagic), std::end(kMagic));
+    out.push_back(kVersion);
+    out.push_back(0);
+    WriteU16(out, width);
+    WriteU16(out, height);
+    for (auto index : table)
+        WriteU16(out, index);
+    return out;
+}
+
+PixelMap::Table PixelMap::Load(size_t width, size_t height)
+{
+    Table table;
+
+    if (SPIFFS.exists(PIXEL_MAP_FILE))
+    {
+        File file = SPIFFS.open(PIXEL_MAP_FILE);
+        std::vector<uint8_t> data(file.size());
+        const size_t bytesRead = file.readBytes(data.data(), data.size());
+        file.close();
+
+        auto [loaded, reason] = FromBinary(data.data(), bytesRead, width, height, table);
+        if (loaded)
+            debugI("Loaded pixel map %s for %zux%zu", PIXEL_MAP_FILE, width, height);
+        else
+            debugW("Ignoring %s: %s", PIXEL_MAP_FILE, reason.c_str());
+        return table;
+    }
+
+    if (SPIFFS.exists(PIXEL_LAYOUT_FILE))
+    {
+        auto jsonDoc = CreateJsonDocument();
+        if (!LoadJSONFile(PIXEL_LAYOUT_FILE, jsonDoc))
+            return table;
+
+        auto [built, reason] = FromLayout(jsonDoc.as<JsonObjectConst>(), width, height, table);
+        if (built)
+            debugI("Built pixel map from %s for %zux%zu", PIXEL_LAYOUT_FILE, width, height);
+        else
+            debugW("Ignoring %s: %s", PIXEL_LAYOUT_FILE, reason.c_str());
+    }
+
+    return table;
+}
@@ -0,0 +1,226 @@
+//+--------------------------------------------------------------------------
+//
+// File:        playoutscheduler.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Presentation times for frames that arrive over WiFi; see
+//    playoutscheduler.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "playoutscheduler.h"
+
+// Crystals are good to tens of ppm; a slope steeper than this is noise in the floor samples
+static constexpr double kMaxDrift = 500e-6;
+
+// FloorAt
+//
+// The fastest transit expected for a frame stamped stamp: the last window's floor carried forward by
+// the drift, unless the window in progress has already seen faster
+
+int64_t PlayoutScheduler::FloorAt(int64_t stamp) const
+{
+    if (!_hasFloor)
+        return _windowMin;
+
+    const int64_t extrapolated = _floor + llround(_drift * (stamp - _floorStamp));
+    return std::min(extrapolated, _windowMin);
+}
+
+int64_t PlayoutScheduler::Schedule(int64_t stamp, int64_t arrival)
+{
+    if (stamp == 0)
+        return arrival;
+
+    // How long after its stamp the frame turned up: the clock offset, plus network delay and jitter,
+    // less however far ahead the sender stamped it
+
+    const int64_t transit = arrival - stamp;
+
+    // A sender that restarted or stepped its clock back, or frames suddenly arriving much earlier than
+    // the fastest seen, mean the old estimate no longer applies
+
+    if (_started && (stamp + kResyncStep < _lastStamp || transit + kResyncStep < FloorAt(stamp)))
+    {
+        debugI("Frame timing moved by %lld us, restarting playout estimate", (long long)(transit - _lastTransit));
+        Reset();
+    }
+
+    bool snap = !_started;
+    if (!_started)
+    {
+        _windowStart    = stamp;
+        _windowMin      = transit;
+        _windowMinStamp = stamp;
+    }
+    else
+    {
+        // Interarrival jitter as RFC 3550 keeps it. A repeated stamp is the sender updating a frame
+        // it already sent, not a new one, so its transit says nothing about the network.
+
+        if (stamp != _lastStamp)
+            _jitter += (std::abs(transit - _lastTransit) - _jitter) / 16.0;
+
+        if (stamp - _windowStart >= kFloorWindow)
+        {
+            // The window is over, so its fastest transit is the new floor. The slope from the last
+            // floor gives the drift; a floor far above the last one is the local clock stepping
+            // forward, and the delay jumps to match rather than the frames all arriving late for
+            // as long as slewing would take.
+
+            const int64_t expected = _hasFloor ? _floor + llround(_drift * (_windowMinStamp - _floorStamp)) : _windowMin;
+            if (_hasFloor && _windowMin - expected > kResyncStep)
+            {
+                _drift = 0;
+                snap = true;
+            }
+            else if (_hasFloor && _windowMinStamp - _floorStamp > kFloorWindow / 2)
+            {
+                const double slope = (_windowMin - _floor) / static_cast<double>(_windowMinStamp - _floorStamp);
+                _drift = std::clamp(_drift + (slope - _drift) / 8, -kMaxDrift, kMaxDrift);
+            }
+
+            _hasFloor       = true;
+            _floor          = _windowMin;
+            _floorStamp     = _windowMinStamp;
+            _windowStart    = stamp;
+            _windowMin      = transit;
+            _windowMinStamp = stamp;
+        }
+        else if (transit < _windowMin)
+        {
+            _windowMin      = transit;
+            _windowMinStamp = stamp;
+        }
+    }
+
+    // Enough buffering over the fastest transit to ride out the jitter. When the clocks agree, a
+    // frame is never shown before its stamp.
+
+    const int64_t floor = FloorAt(stamp);
+    const int64_t buffering = std::min<int64_t>(kJitterMultiplier * llround(_jitter) + kMargin, kMaxBuffering);
+    const bool trusted = std::llabs(floor) < kUnsyncedOffset;
+
+    int64_t target = floor + buffering;
+    if (trusted)
+        target = std::max<int64_t>(0, target);
+
+    if (snap)
+    {
+        _delay = target;
+    }
+    else
+    {
+        const int64_t interval = std::max<int64_t>(0, stamp - _lastStamp);
+        _delay += std::clamp(target - _delay, -interval / kShrinkDivisor, interval / kGrowDivisor);
+    }
+
+    _started     = true;
+    _lastStamp   = stamp;
+    _lastTransit = transit;
+
+    int64_t due = stamp + _delay;
+    if (due < arrival)
+    {
+        _lateFrames.fetch_add(1, std::memory_order_relaxed);
+        due = arrival;
+    }
+
+    _trusted.store(trusted, std::memory_order_relaxed);
+    Publish(floor);
+    return due;
+}
+
+void PlayoutScheduler::Publish(int64_t floor)
+{
+    constexpr int64_t kMin = std::numeric_limits<int32_t>::min();
+    constexpr int64_t kMax = std::numeric_limits<int32_t>::max();
+
+    _playoutDelay.store(static_cast<int32_t>(std::clamp(_delay - floor, kMin, kMax)), std::memory_order_relaxed);
+    _jitterMicros.store(static_cast<int32_t>(std::min<int64_t>(llround(_jitter), kMax)), std::memory_order_relaxed);
+    _driftPPM.store(static_cast<int32_t>(lround(_drift * 1e6)), std::memory_order_relaxed);
+}
+
+void PlayoutScheduler::CountDropped(uint32_t frames)
+{
+    _droppedFrames.fetch_add(frames, std::memory_order_relaxed);
+}
+
+void PlayoutScheduler::CountOverwritten()
+{
+    _overwrittenFrames.fetch_add(1, std::memory_order_relaxed);
+    CountDropped();
+}
+
+void PlayoutScheduler::Reset()
+{
+    _started  = false;
+    _hasFloor = false;
+    _delay    = 0;
+    _jitter   = 0;
+    _drift    = 0;
+
+    _trusted.store(false, std::memory_order_relaxed);
+    Publish(0);
+}
+
+uint32_t PlayoutScheduler::LateFrames() const
+{
+    return _lateFrames.load(std::memory_order_relaxed);
+}
+
+uint32_t PlayoutScheduler::DroppedFrames() const
+{
+    return _droppedFrames.load(std::memory_order_relaxed);
+}
+
+uint32_t PlayoutScheduler::OverwrittenFrames() const
+{
+    return _overwrittenFrames.load(std::memory_order_relaxed);
+}
+
+int32_t PlayoutScheduler::PlayoutDelay() const
+{
+    return _playoutDelay.load(std::memory_order_relaxed);
+}
+
+int32_t PlayoutScheduler::Jitter() const
+{
+    return _jitterMicros.load(std::memory_order_relaxed);
+}
+
+int32_t PlayoutScheduler::ClockDriftPPM() const
+{
+    return _driftPPM.load(std::memory_order_relaxed);
+}
+
+bool PlayoutScheduler::IsSenderClockTrusted() const
+{
+    return _trusted.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,105 @@
+//+--------------------------------------------------------------------------
+//
+// File:        polarlut.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Builds and caches the polar maps described in polarlut.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "polarlut.h"
+
+namespace
+{
+    std::mutex g_polarMutex;
+    std::vector<std::shared_ptr<const PolarLUT>> g_polarCache;
+
+    // Caller holds g_polarMutex
+    size_t CachedBytes()
+    {
+        size_t bytes = 0;
+        for (const auto& lut : g_polarCache)
+            bytes += static_cast<size_t>(lut->width()) * lut->height() * sizeof(PolarLUT::Entry);
+        return bytes;
+    }
+}
+
+PolarLUT::PolarLUT(const Params& params)
+    : _params(params)
+{
+    _entries.resize(static_cast<size_t>(params.width) * params.height);
+
+    for (uint16_t x = 0; x < params.width; x++)
+    {
+        const float dx = x - params.centerX;
+        const int   tx = static_cast<int>(dx);
+
+        for (uint16_t y = 0; y < params.height; y++)
+        {
+            const float dy = y - params.centerY;
+            const int   ty = static_cast<int>(dy);
+
+            const float angle_rad = atan2f(dy, dx);
+            const float radius_float = hypotf(dx, dy);
+
+            // Negative angles wrap into 128-255 by way of int, rather than an out-of-range float
+            // to uint8_t conversion
+            Entry& entry = _entries[x * params.height + y];
+            entry.angle           = static_cast<int>(128.0f * (angle_rad / (float)M_PI));
+            entry.scaled_radius   = radius_float * params.radiusScale;
+            entry.unscaled_radius = radius_float;
+            entry.squared_radius  = tx * tx + ty * ty;
+        }
+    }
+}
+
+std::shared_ptr<const PolarLUT> PolarLUT::Get(const Params& params)
+{
+    std::lock_guard<std::mutex> lock(g_polarMutex);
+
+    auto found = std::find_if(g_polarCache.begin(), g_polarCache.end(), [&](const auto& lut) { return lut->GetParams() == params; });
+    if (found != g_polarCache.end())
+        return *found;
+
+    // A new size means the topology changed; maps for the old one won't be asked for again
+    g_polarCache.erase(std::remove_if(g_polarCache.begin(), g_polarCache.end(), [&](const auto& lut)
+    {
+        return lut->width() != params.width || lut->height() != params.height;
+    }), g_polarCache.end());
+
+    auto lut = std::make_shared<const PolarLUT>(params);
+    g_polarCache.push_back(lut);
+    debugV("Built %ux%u polar map, %zu bytes cached", params.width, params.height, CachedBytes());
+    return lut;
+}
+
+size_t PolarLUT::BytesInUse()
+{
+    std::lock_guard<std::mutex> lock(g_polarMutex);
+    return CachedBytes();
+}
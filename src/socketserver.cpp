@@ -30,8 +30,11 @@
 
 #include "globals.h"
 #include "byte_utils.h"
+#include "inflater.h"
 #include "ledbuffer.h"
 #include "nd_network.h"
+#include "pixelbatch.h"
+#include "pixeldelta.h"
 #include "socketserver.h"
 #include "soundanalyzer.h"
 #include "systemcontainer.h"
@@ -46,15 +49,11 @@
 #include <limits>
 #include <mutex>
 #include <netinet/in.h>
+#include <optional>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
 
-extern "C"
-{
-    #include "uzlib/src/uzlib.h"
-}
-
 #if INCOMING_WIFI_ENABLED
 
 namespace
@@ -67,6 +66,65 @@ namespace
         result = left + right;
         return true;
     }
+
+    // Checks a pixel frame against every channel selected in channel16 before any of them queues it, then
+    // reserves the socket server's buffer on the first one to receive into. pTarget is left empty if none of the selected
+    // channels exist here.
+
+    bool ReservePixelTarget(uint16_t channel16, uint32_t length32, int& firstChannel, std::shared_ptr<LEDBuffer>& pTarget)
+    {
+        auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+        std::lock_guard guard(g_buffer_mutex);
+
+        firstChannel = -1;
+        for (int iChannel = 0; iChannel < bufferManagers.size(); iChannel++)
+        {
+            if ((channel16 & (1 << iChannel)) == 0)
+                continue;
+
+            const size_t channelLedCount = bufferManagers[iChannel].LEDCount();
+            if (length32 > channelLedCount)
+            {
+                debugW("Pixel packet rejected for channel %d: %lu LEDs, channel has %zu",
+                       iChannel, (unsigned long)length32, channelLedCount);
+                return false;
+            }
+            if (firstChannel < 0)
+                firstChannel = iChannel;
+        }
+        if (firstChannel >= 0)
+            pTarget = bufferManagers[firstChannel].ReserveBuffer(BufferReservation::Socket);
+        return true;
+    }
+
+    // Copies a received frame to the other selected channels, then queues it on its own. The copies come
+    // first because once it's queued the render task may take it and clear its timestamp as it draws.
+    // Caller holds g_buffer_mutex. Returns false if the frame was dropped.
+
+    bool CommitPixelTarget(uint16_t channel16, int firstChannel, const std::shared_ptr<LEDBuffer>& pTarget)
+    {
+        auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+
+        if (bufferManagers[firstChannel].ReserveBuffer(BufferReservation::Socket) != pTarget)
+        {
+            // The topology changed while the frame was arriving; drop it but keep the connection
+            debugW("Channel %d was reconfigured during receive, dropping frame", firstChannel);
+            return false;
+        }
+
+        for (int iChannel = firstChannel + 1; iChannel < bufferManagers.size(); iChannel++)
+        {
+            if ((channel16 & (1 << iChannel)) == 0)
+                continue;
+
+            auto& bufferManager = bufferManagers[iChannel];
+            auto pCopy = bufferManager.ReserveBuffer(BufferReservation::Socket);
+            if (pCopy->CopyFrameFrom(*pTarget))
+                bufferManager.CommitBuffer(pCopy);
+        }
+
+        return bufferManagers[firstChannel].CommitBuffer(pTarget);
+    }
 }
 
 // SocketResponse
@@ -78,7 +136,8 @@ SocketServer::SocketServer(int port, int numLeds) :
     _numLeds(numLeds),
     _cbReceived(0)
 {
-    _abOutputBuffer = make_unique_psram<uint8_t[]>(MAXIMUM_PACKET_SIZE + 1);                    // +1 for uzlib one byte overreach bug
+    _abOutputBuffer = make_unique_psram<uint8_t[]>(MAXIMUM_PACKET_SIZE);
+    _pInflater = make_unique_internal<Inflater>();                                              // uzlib's state is too big for the task stack
     memset(&_address, 0, sizeof(_address));
 }
 
@@ -263,54 +322,312 @@ bool SocketServer::ReadUntilNBytesReceived(size_t socket, size_t cbNeeded)
     return true;
 }
 
-// DecompressBuffer
+// ReadExactly
+//
+// Read exactly cbNeeded bytes from the socket into pDest, bypassing the read buffer
+
+bool SocketServer::ReadExactly(size_t socket, uint8_t * pDest, size_t cbNeeded)
+{
+    size_t cbDone = 0;
+    while (cbDone < cbNeeded)
+    {
+        int cbRead = 0;
+        do
+        {
+            cbRead = read(socket, pDest + cbDone, cbNeeded - cbDone);
+        } while (cbRead < 0 && errno == EINTR);
+
+        if (cbRead <= 0)
+        {
+            debugE("ERROR: %d bytes read in ReadExactly trying to read %zu\n", cbRead, cbNeeded - cbDone);
+            return false;
+        }
+        cbDone += cbRead;
+    }
+    return true;
+}
+
+// SkipBytes
+//
+// Read and throw away cbSkip bytes from the socket, through _abOutputBuffer
+
+bool SocketServer::SkipBytes(size_t socket, size_t cbSkip)
+{
+    while (cbSkip > 0)
+    {
+        const size_t cbChunk = std::min<size_t>(cbSkip, MAXIMUM_PACKET_SIZE);
+        if (false == ReadExactly(socket, _abOutputBuffer.get(), cbChunk))
+            return false;
+        cbSkip -= cbChunk;
+    }
+    return true;
+}
+
+// ReceivePixelData
+//
+// Reads pixel data straight into a reserved LEDBuffer, fanning it out only to any extra channels
+
+bool SocketServer::ReceivePixelData(size_t socket, uint16_t channel16, uint32_t length32, uint64_t seconds, uint64_t micros)
+{
+    // Channel 0 is the very old single-channel protocol; see ProcessIncomingData
+    if (channel16 == 0)
+        channel16 = 1;
+
+    int firstChannel = -1;
+    std::shared_ptr<LEDBuffer> pTarget;
+    if (!ReservePixelTarget(channel16, length32, firstChannel, pTarget))
+        return false;
+
+    // None of the selected channels exist here, so read the pixels only to keep the stream in sync
+    const size_t payloadBytes = static_cast<size_t>(length32) * sizeof(CRGB);
+    if (!pTarget)
+        return ReadUntilNBytesReceived(socket, STANDARD_DATA_HEADER_SIZE + payloadBytes);
+
+    // The buffer lock isn't held across the read; the socket server's reservation is its own, so the
+    // other receivers reserving and committing meanwhile can't touch it
+    if (false == ReadExactly(socket, reinterpret_cast<uint8_t *>(pTarget->Pixels()), payloadBytes))
+        return false;
+    pTarget->SetFrame(seconds, micros, length32);
+
+    std::lock_guard guard(g_buffer_mutex);
+    CommitPixelTarget(channel16, firstChannel, pTarget);
+    _responseChannel = firstChannel;
+    return true;
+}
+
+// ReceiveCompressedData
 //
-// Use unzlib to decompress a memory buffer
+// Inflates a compressed packet while it's still arriving. Pixel data is expanded straight into the first
+// selected channel's reserved LEDBuffer, header and all, so it's never staged anywhere; anything else is
+// expanded into _abOutputBuffer and handed to ProcessIncomingData as before.
 
-bool SocketServer::DecompressBuffer(const uint8_t * pBuffer, size_t cBuffer, uint8_t * pOutput, size_t expectedOutputSize)
+bool SocketServer::ReceiveCompressedData(size_t socket, uint32_t expandedSize)
 {
-    if (pBuffer == nullptr || pOutput == nullptr || cBuffer < 4)
+    static_assert(Inflater::kHeaderSize == COMPRESSED_HEADER_SIZE, "Inflater must agree on the compressed header");
+
+    if (expandedSize < STANDARD_DATA_HEADER_SIZE)
     {
-        debugE("Compressed packet too short to decompress: %zu bytes", cBuffer);
+        debugE("Compressed packet expands to only %lu bytes", (unsigned long)expandedSize);
         return false;
     }
 
-    debugV("Compressed Data: %02X %02X %02X %02X...", pBuffer[0], pBuffer[1], pBuffer[2], pBuffer[3]);
+    // Reading the header took the first few bytes of the zlib stream along with the compressed header
+    if (!_pInflater->BeginPacket(socket, _pBuffer.get(), _cbReceived))
+        return false;
 
-    struct uzlib_uncomp d = { 0 };
-    uzlib_uncompress_init(&d, nullptr, 0);
+    uint8_t header[STANDARD_DATA_HEADER_SIZE];
+    if (!_pInflater->Inflate(header, header, sizeof(header)))
+        return false;
 
-    d.source         = pBuffer;
-    d.source_limit   = pBuffer + cBuffer;
-    d.source_read_cb = nullptr;
-    d.dest_start     = pOutput;
-    d.dest           = pOutput;
+    uint16_t command16 = WORDFromMemory(&header[0]);
+    uint16_t channel16 = WORDFromMemory(&header[2]);
+    uint32_t length32  = DWORDFromMemory(&header[4]);
+    uint64_t seconds   = ULONGFromMemory(&header[8]);
+    uint64_t micros    = ULONGFromMemory(&header[16]);
 
-    // There's an "off by one" bug/feature in uzlib that reaches one byte past the end.  Took forever
-    // to find it...
+    size_t pixelPacketSize = 0;
+    if (command16 != WIFI_COMMAND_PIXELDATA64 ||
+        !CheckedStandardPacketSize(length32, LED_DATA_SIZE, pixelPacketSize) ||
+        pixelPacketSize != expandedSize)
+    {
+        // ProcessIncomingData can rewrite the newest frame in place, behind the delta stream's back
+        _deltaSequence.Reset();
 
-    d.dest_limit     = pOutput + expectedOutputSize + 1;
+        memcpy(_abOutputBuffer.get(), header, sizeof(header));
+        if (!_pInflater->Inflate(_abOutputBuffer.get(), _abOutputBuffer.get() + sizeof(header), expandedSize - sizeof(header)) ||
+            !_pInflater->Finish())
+        {
+            return false;
+        }
+        return ProcessIncomingData(_abOutputBuffer, expandedSize);
+    }
+
+    debugV("Compressed pixels: channel16=%u, length=%lu, seconds=%llu, micro=%llu", channel16, (unsigned long)length32, seconds, micros);
+
+    if (channel16 == 0)
+        channel16 = 1;
+
+    int firstChannel = -1;
+    std::shared_ptr<LEDBuffer> pTarget;
+    if (!ReservePixelTarget(channel16, length32, firstChannel, pTarget))
+        return false;
+
+    // With nowhere to put the pixels they're still expanded, into _abOutputBuffer, to get through the stream
+    static_assert(LEDBuffer::kWireHeaderSize == STANDARD_DATA_HEADER_SIZE, "LEDBuffer headroom must hold the wire header");
+    uint8_t * pPacket = pTarget ? pTarget->WirePacket() : _abOutputBuffer.get();
+    memcpy(pPacket, header, sizeof(header));
+    if (!_pInflater->Inflate(pPacket, pPacket + sizeof(header), expandedSize - sizeof(header)) || !_pInflater->Finish())
+        return false;
+
+    if (!pTarget)
+        return true;
+
+    pTarget->SetFrame(seconds, micros, length32);
 
-    int res = uzlib_zlib_parse_header(&d);
-    if (res < 0)
+    std::lock_guard guard(g_buffer_mutex);
+    CommitPixelTarget(channel16, firstChannel, pTarget);
+    _responseChannel = firstChannel;
+    return true;
+}
+
+// ReceivePixelDelta
+//
+// Reads a WIFI_COMMAND_PIXELDELTA64 packet, whose standard header has already been read and checked. Its
+// run table is read into _pBuffer after the header, then the changed pixels are read through the rest of
+// _pBuffer and scattered over a copy of the previous frame in the first selected channel's reserved
+// LEDBuffer. A delta that doesn't follow the last frame is read and dropped.
+
+bool SocketServer::ReceivePixelDelta(size_t socket, uint16_t channel16, uint32_t length32, uint64_t seconds, uint64_t micros)
+{
+    if (false == ReadUntilNBytesReceived(socket, PixelDelta::kHeaderSize))
+        return false;
+
+    const uint32_t sequence = DWORDFromMemory(&_pBuffer[24]);
+    const uint16_t flags    = WORDFromMemory(&_pBuffer[28]);
+    const uint16_t runCount = WORDFromMemory(&_pBuffer[30]);
+
+    const size_t tableEnd = PixelDelta::kHeaderSize + runCount * PixelDelta::kRunSize;
+    if (tableEnd >= MAXIMUM_PACKET_SIZE)
     {
-        debugE("ERROR: Cannot parse zlib data header\n");
+        debugE("Delta frame has %u runs, more than fit the read buffer", runCount);
         return false;
     }
 
-    res = uzlib_uncompress_chksum(&d);                                          // Expand the data
+    size_t changedPixels = 0;
+    if (false == ReadUntilNBytesReceived(socket, tableEnd) ||
+        false == PixelDelta::CheckRuns(&_pBuffer[PixelDelta::kHeaderSize], runCount, length32, changedPixels))
+    {
+        return false;
+    }
+
+    debugV("Delta Header: channel16=%u, length=%lu, sequence=%lu, flags=%u, runs=%u, changed=%zu",
+           channel16, (unsigned long)length32, (unsigned long)sequence, flags, runCount, changedPixels);
+
+    if (channel16 == 0)
+        channel16 = 1;
 
-    if (res != TINF_DONE) {
-        debugE("Error during decompression after producing %d bytes: %d\n", d.dest - pOutput, res);
+    int firstChannel = -1;
+    std::shared_ptr<LEDBuffer> pTarget;
+    if (!ReservePixelTarget(channel16, length32, firstChannel, pTarget))
         return false;
+
+    if (pTarget)
+    {
+        std::lock_guard guard(g_buffer_mutex);
+        if (!_deltaSequence.PrepareBase(g_ptrSystem->GetBufferManagers()[firstChannel], channel16, sequence, flags, length32, *pTarget))
+            pTarget.reset();
     }
 
-    if (d.dest - pOutput != expectedOutputSize)
+    // With no frame to apply them to, the pixels are still read to keep the stream in sync
+    std::optional<PixelDelta> delta;
+    if (pTarget)
+        delta.emplace(&_pBuffer[PixelDelta::kHeaderSize], runCount, pTarget->Pixels());
+
+    uint8_t * pChunk = &_pBuffer[tableEnd];
+    for (size_t cbLeft = changedPixels * sizeof(CRGB); cbLeft > 0; )
     {
-        debugE("Expected it to to decompress to %d but got %d instead\n", expectedOutputSize, d.dest - pOutput);
+        int cbRead = 0;
+        do
+        {
+            cbRead = read(socket, pChunk, std::min<size_t>(cbLeft, MAXIMUM_PACKET_SIZE - tableEnd));
+        } while (cbRead < 0 && errno == EINTR);
+
+        if (cbRead <= 0)
+        {
+            debugE("ERROR: %d bytes read in ReceivePixelDelta with %zu to go\n", cbRead, cbLeft);
+            return false;
+        }
+        if (delta)
+            delta->Feed(pChunk, cbRead);
+        cbLeft -= cbRead;
+    }
+
+    if (!pTarget)
+        return true;
+
+    pTarget->SetFrame(seconds, micros, length32);
+
+    std::lock_guard guard(g_buffer_mutex);
+    _responseChannel = firstChannel;
+    if (CommitPixelTarget(channel16, firstChannel, pTarget))
+        _deltaSequence.Committed(g_ptrSystem->GetBufferManagers()[firstChannel], channel16, sequence, *pTarget);
+    else
+        _deltaSequence.Reset();
+    return true;
+}
+
+// ReceivePixelBatch
+//
+// Reads a WIFI_COMMAND_PIXELBATCH64 packet, whose standard header has already been read and size-checked.
+// Its entry table is read into _pBuffer after the header and every channel it feeds gets a buffer reserved.
+// When the entries run in order the pixels are then read straight into those buffers, skipping whatever
+// no channel here wants; otherwise the whole packet is read into _pBuffer and copied out. The frames
+// are queued together, so the render task never draws one channel's without the others'.
+
+bool SocketServer::ReceivePixelBatch(size_t socket, uint16_t entryCount, uint32_t length32, uint64_t seconds, uint64_t micros)
+{
+    const size_t tableEnd = PixelBatch::kHeaderSize + PixelBatch::TableSize(entryCount);
+    if (false == ReadUntilNBytesReceived(socket, tableEnd))
+        return false;
+
+    const uint8_t * pTable = &_pBuffer[PixelBatch::kHeaderSize];
+    bool inOrder = false;
+    if (false == PixelBatch::CheckTable(pTable, entryCount, length32, inOrder))
         return false;
+
+    debugV("Batch Header: entries=%u, length=%lu, seconds=%llu, micro=%llu, inOrder=%d",
+           entryCount, (unsigned long)length32, seconds, micros, inOrder);
+
+    auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+    PixelBatch batch(bufferManagers.data(), bufferManagers.size(), BufferReservation::Socket);
+    {
+        std::lock_guard guard(g_buffer_mutex);
+        if (false == batch.Reserve(pTable, entryCount))
+            return false;
     }
 
+    // The buffer lock isn't held across the reads; as in ReceivePixelData(), the reservations are the
+    // socket server's own
+    if (inOrder)
+    {
+        size_t cursor = 0;
+        for (uint16_t i = 0; i < entryCount; i++)
+        {
+            uint32_t offset, count;
+            PixelBatch::Entry(pTable, i, offset, count);
+            if (count == 0)
+                continue;
+
+            if (false == SkipBytes(socket, (offset - cursor) * sizeof(CRGB)))
+                return false;
+
+            CRGB * pTarget = batch.Target(i);
+            const size_t cbPixels = static_cast<size_t>(count) * sizeof(CRGB);
+            if (false == (pTarget ? ReadExactly(socket, reinterpret_cast<uint8_t *>(pTarget), cbPixels)
+                                  : SkipBytes(socket, cbPixels)))
+                return false;
+            cursor = static_cast<size_t>(offset) + count;
+        }
+        if (false == SkipBytes(socket, (length32 - cursor) * sizeof(CRGB)))
+            return false;
+    }
+    else
+    {
+        size_t packetSize = 0;
+        if (false == PixelBatch::CheckedPacketSize(entryCount, length32, packetSize) || packetSize > MAXIMUM_PACKET_SIZE)
+        {
+            debugE("Batch with overlapping entries is %zu bytes, more than fit the read buffer", packetSize);
+            return false;
+        }
+        if (false == ReadUntilNBytesReceived(socket, packetSize))
+            return false;
+        batch.Fill(pTable, &_pBuffer[tableEnd]);
+    }
+
+    std::lock_guard guard(g_buffer_mutex);
+    const int firstChannel = batch.Commit(seconds, micros, LEDBufferManager::ClockMicros());
+    if (firstChannel >= 0)
+        _responseChannel = firstChannel;
     return true;
 }
 
@@ -393,6 +710,9 @@ bool SocketServer::ProcessIncomingConnectionsLoop()
         return false;
     }
 
+    // A new connection starts a new delta stream, which begins with a keyframe
+    _deltaSequence.Reset();
+
     do
     {
         bool bSendResponsePacket = false;
@@ -425,40 +745,12 @@ bool SocketServer::ProcessIncomingConnectionsLoop()
                 break;
             }
 
-            // Check addition before ReadUntilNBytesReceived; an overflowed
-            // header+payload size can wrap back below MAXIMUM_PACKET_SIZE and
-            // make the socket reader under-read a malformed packet.
-            if (false == ReadUntilNBytesReceived(new_socket, compressedPacketSize))
+            // The payload is inflated as it arrives rather than read in full first
+            if (false == ReceiveCompressedData(new_socket, expandedSize))
             {
-                debugE("Could not read compressed data from stream\n");
+                debugE("Error receiving compressed data\n");
                 break;
             }
-            debugV("Successfully read %zu bytes", compressedPacketSize);
-
-            // If our buffer is in PSRAM it would be expensive to decompress in place, as the SPIRAM doesn't like
-            // non-linear access from what I can tell.  I bet it must send addr+len to request each unique read, so
-            // one big read one time would work best, and we use that to copy it to a regular RAM buffer.
-
-            #if USE_PSRAM
-                auto _abTempBuffer = make_unique_internal<uint8_t[]>(MAXIMUM_PACKET_SIZE + 1);    // Plus one for uzlib buffer overreach bug
-                memcpy(_abTempBuffer.get(), _pBuffer.get(), MAXIMUM_PACKET_SIZE);
-                auto pSourceBuffer = &_abTempBuffer[COMPRESSED_HEADER_SIZE];
-            #else
-                auto pSourceBuffer = &_pBuffer[COMPRESSED_HEADER_SIZE];
-            #endif
-
-            if (!DecompressBuffer(pSourceBuffer, compressedSize, _abOutputBuffer.get(), expandedSize))
-            {
-                debugE("Error decompressing data\n");
-                break;
-            }
-
-            if (false == ProcessIncomingData(_abOutputBuffer, expandedSize))
-            {
-                debugE("Error processing data\n");
-                break;
-
-            }
             ResetReadBuffer();
             bSendResponsePacket = true;
         }
@@ -546,23 +838,66 @@ bool SocketServer::ProcessIncomingConnectionsLoop()
                     break;
                 }
 
+                // Receive the pixels directly into the buffer ring rather than staging them in _pBuffer
+
                 debugV("Expecting %zu total bytes", (size_t)totalExpected);
-                if (false == ReadUntilNBytesReceived(new_socket, totalExpected))
+                if (false == ReceivePixelData(new_socket, channel16, length32, seconds, micros))
                 {
                     debugE("Error in getting pixel data from wifi\n");
                     break;
                 }
 
-                // Add it to the buffer ring
+                // Consume the data by resetting the buffer
+                debugV("Consuming the data as WIFI_COMMAND_PIXELDATA64 by setting _cbReceived to from %zu down 0.", (size_t)_cbReceived);
+                ResetReadBuffer();
+
+                bSendResponsePacket = true;
+            }
+            else if (command16 == WIFI_COMMAND_PIXELDELTA64)
+            {
+                uint16_t channel16 = WORDFromMemory(&_pBuffer.get()[2]);
+                uint32_t length32  = DWORDFromMemory(&_pBuffer.get()[4]);
+                uint64_t seconds   = ULONGFromMemory(&_pBuffer.get()[8]);
+                uint64_t micros    = ULONGFromMemory(&_pBuffer.get()[16]);
+
+                size_t totalExpected = 0;
+                if (!CheckedStandardPacketSize(length32, LED_DATA_SIZE, totalExpected) ||
+                    totalExpected > MAXIMUM_PACKET_SIZE)
+                {
+                    debugE("Delta frame of %lu LEDs is more than we can use at max packet (%lu)\n", (unsigned long)length32, (unsigned long)MAXIMUM_PACKET_SIZE);
+                    break;
+                }
+
+                if (false == ReceivePixelDelta(new_socket, channel16, length32, seconds, micros))
+                {
+                    debugE("Error in getting delta frame from wifi\n");
+                    break;
+                }
+                ResetReadBuffer();
 
-                if (false == ProcessIncomingData(_pBuffer, totalExpected))
+                bSendResponsePacket = true;
+            }
+            else if (command16 == WIFI_COMMAND_PIXELBATCH64)
+            {
+                uint16_t entryCount = WORDFromMemory(&_pBuffer.get()[2]);
+                uint32_t length32   = DWORDFromMemory(&_pBuffer.get()[4]);
+                uint64_t seconds    = ULONGFromMemory(&_pBuffer.get()[8]);
+                uint64_t micros     = ULONGFromMemory(&_pBuffer.get()[16]);
+
+                // In-order batches are never read whole, but still can't promise more than every channel could use
+                size_t totalExpected = 0;
+                if (!PixelBatch::CheckedPacketSize(entryCount, length32, totalExpected) ||
+                    length32 > PixelBatch::kMaxEntries * NUM_LEDS)
                 {
-                    debugE("Error in processing pixel data from wifi\n");
+                    debugE("Invalid pixel batch: entries=%u length=%lu\n", entryCount, (unsigned long)length32);
                     break;
                 }
 
-                // Consume the data by resetting the buffer
-                debugV("Consuming the data as WIFI_COMMAND_PIXELDATA64 by setting _cbReceived to from %zu down 0.", (size_t)_cbReceived);
+                if (false == ReceivePixelBatch(new_socket, entryCount, length32, seconds, micros))
+                {
+                    debugE("Error in getting pixel batch from wifi\n");
+                    break;
+                }
                 ResetReadBuffer();
 
                 bSendResponsePacket = true;
@@ -583,9 +918,17 @@ bool SocketServer::ProcessIncomingConnectionsLoop()
             static uint64_t sequence = 0;
 
             debugV("Sending Response Packet from Socket Server");
-            auto& bufferManager = g_ptrSystem->GetBufferManagers()[0];
+            auto& bufferManagers = g_ptrSystem->GetBufferManagers();
+            const size_t channel = _responseChannel < bufferManagers.size() ? _responseChannel : 0;
+            auto& bufferManager  = bufferManagers[channel];
+            const auto& scheduler = bufferManager.Scheduler();
+
+            // How far ahead of the render task the queue runs, on the clock the due times are kept on
+            const uint64_t now = LEDBufferManager::ClockMicros();
+            uint64_t oldestDue = now, newestDue = now;
+            bufferManager.PeekOldestDue(oldestDue);
+            bufferManager.PeekNewestDue(newestDue);
 
-            std::lock_guard guard(g_buffer_mutex);
             SocketResponse response = {
                                         .size = sizeof(SocketResponse),
                                         .sequence     = sequence++,
@@ -598,7 +941,14 @@ bool SocketServer::ProcessIncomingConnectionsLoop()
                                         .bufferSize   = bufferManager.BufferCount(),
                                         .bufferPos    = bufferManager.Depth(),
                                         .fpsDrawing   = g_Values.FPS,
-                                        .watts        = g_Values.Watts
+                                        .watts        = g_Values.Watts,
+                                        .oldestDue    = ((int64_t)oldestDue - (int64_t)now) / (double)MICROS_PER_SECOND,
+                                        .newestDue    = ((int64_t)newestDue - (int64_t)now) / (double)MICROS_PER_SECOND,
+                                        .droppedFrames     = scheduler.DroppedFrames(),
+                                        .overwrittenFrames = scheduler.OverwrittenFrames(),
+                                        .lateFrames        = scheduler.LateFrames(),
+                                        .playoutDelay      = scheduler.PlayoutDelay(),
+                                        .channel           = (uint32_t)channel
                                     };
 
             // I dont think this is fatal, and doesn't affect the read buffer, so content to ignore for now if it happens
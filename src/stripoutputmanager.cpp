@@ -0,0 +1,48 @@
+//+--------------------------------------------------------------------------
+//
+// File:        stripoutputmanager.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    The device-buffer Show() shared by every strip output manager.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#if USE_STRIP
+
+#include <array>
+
+#include "gfxbase.h"
+#include "stripoutputmanager.h"
+
+void IStripOutputManager::Show(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader)
+{
+    std::array<ChannelPlanes, NUM_CHANNELS> planes;
+    const size_t channelCount = std::min(devices.size(), planes.size());
+    for (size_t i = 0; i < channelCount; ++i)
+        planes[i] = { devices[i]->leds, devices[i]->whites, devices[i]->GetLEDCount() };
+
+    ShowPlanes(planes.data(), channelCount, pixelsDrawn, brightness, fader);
+}
+
+#endif
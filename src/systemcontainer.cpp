@@ -37,13 +37,16 @@
 #include "gfxbase.h"
 #include "jsonserializer.h"
 #include "ledbuffer.h"
+#include "lightingserver.h"
 #include "nd_network.h"
+#include "outputservice.h"
 #include "remotecontrol.h"
 #include "renderservice.h"
 #include "screen.h"
 #include "socketserver.h"
 #include "systemcontainer.h"
 #include "taskmgr.h"
+#include "udpserver.h"
 #include "webserver.h"
 #include "websocketserver.h"
 #if USE_STRIP
@@ -160,6 +163,22 @@ SocketServer& SystemContainer::GetSocketServer() const
 }
 #endif
 
+#if UDP_PIXEL_SERVER_ENABLED
+UdpServer& SystemContainer::GetUdpServer() const
+{
+    CheckPointer(!!_ptrUdpServer, "UdpServer");
+    return *_ptrUdpServer;
+}
+#endif
+
+#if LIGHTING_PROTOCOLS_ENABLED
+LightingServer& SystemContainer::GetLightingServer() const
+{
+    CheckPointer(!!_ptrLightingServer, "LightingServer");
+    return *_ptrLightingServer;
+}
+#endif
+
 #if USE_STRIP
 IStripOutputManager& SystemContainer::GetStripOutputManager() const
 {
@@ -168,6 +187,14 @@ IStripOutputManager& SystemContainer::GetStripOutputManager() const
 }
 #endif
 
+#if USE_STRIP && ASYNC_STRIP_OUTPUT
+OutputService& SystemContainer::GetOutputService() const
+{
+    CheckPointer(!!_ptrOutputService, "OutputService");
+    return *_ptrOutputService;
+}
+#endif
+
 #if WEB_SOCKETS_ANY_ENABLED
 WebSocketServer& SystemContainer::GetWebSocketServer() const
 {
@@ -354,6 +381,13 @@ SuccessResultWithMessage SystemContainer::ApplyRuntimeConfiguration()
         // changes stay on one transport path instead of handing off between different driver backends.
         if (_ptrDevices)
         {
+            // Frames already posted were drawn for the old layout, so they go out before the transport
+            // changes under them. The render task is held off by g_render_mutex, so none are posted meanwhile.
+            #if ASYNC_STRIP_OUTPUT
+            if (_ptrOutputService)
+                _ptrOutputService->Flush();
+            #endif
+
             auto [applyConfigSucceeded, applyConfigError] = SetupStripOutputManager().ApplyConfig(config, *_ptrDevices);
             if (!applyConfigSucceeded)
                 return { false, applyConfigError };
@@ -441,6 +475,24 @@ SocketServer& SystemContainer::SetupSocketServer(NetworkPort port, int ledCount)
 }
 #endif
 
+#if UDP_PIXEL_SERVER_ENABLED
+UdpServer& SystemContainer::SetupUdpServer(NetworkPort port)
+{
+    if (!_ptrUdpServer)
+        _ptrUdpServer = make_unique_internal<UdpServer>(port);
+    return *_ptrUdpServer;
+}
+#endif
+
+#if LIGHTING_PROTOCOLS_ENABLED
+LightingServer& SystemContainer::SetupLightingServer()
+{
+    if (!_ptrLightingServer)
+        _ptrLightingServer = make_unique_internal<LightingServer>();
+    return *_ptrLightingServer;
+}
+#endif
+
 #if USE_STRIP
 IStripOutputManager& SystemContainer::SetupStripOutputManager()
 {
@@ -456,6 +508,15 @@ IStripOutputManager& SystemContainer::SetupStripOutputManager()
 }
 #endif
 
+#if USE_STRIP && ASYNC_STRIP_OUTPUT
+OutputService& SystemContainer::SetupOutputService()
+{
+    if (!_ptrOutputService)
+        _ptrOutputService = make_unique_internal<OutputService>(SetupStripOutputManager());
+    return *_ptrOutputService;
+}
+#endif
+
 #if WEB_SOCKETS_ANY_ENABLED
 WebSocketServer& SystemContainer::SetupWebSocketServer(CWebServer& webServer)
 {
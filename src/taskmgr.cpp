@@ -62,6 +62,12 @@ float IdleTask::GetCPUUsage() const
 
 void TaskManager::begin()
 {
+    #if HOST_BUILD
+        // The host OS has a real scheduler and its own idle accounting; two threads spinning at
+        // "idle" priority would just steal CPU from the benchmark being measured.
+        return;
+    #endif
+
     Serial.printf("Replacing Idle Tasks with TaskManager...\n");
     // The idle tasks get created with a priority just ABOVE idle so that they steal idle time but nothing else.  They then
     // measure how much time is "wasted" at that lower priority and deem it to have been free CPU
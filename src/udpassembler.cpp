@@ -0,0 +1,208 @@
+//+--------------------------------------------------------------------------
+//
+// File:        udpassembler.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Reassembly of fragmented packets for the UDP server; see
+//    udpassembler.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+
+#include <cstring>
+
+#include "byte_utils.h"
+#include "udpassembler.h"
+
+UdpFrameAssembler::UdpFrameAssembler(size_t maxPacketSize) :
+    _maxPacketSize(maxPacketSize)
+{
+    for (auto& slot : _slots)
+        slot.packet = make_unique_psram<uint8_t[]>(maxPacketSize);
+}
+
+void UdpFrameAssembler::WriteHeader(uint8_t * pHeader, uint32_t sequence, uint16_t index, uint16_t count, uint32_t offset, uint32_t size)
+{
+    auto put = [&pHeader](uint32_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+            *pHeader++ = static_cast<uint8_t>(value >> (8 * i));
+    };
+
+    put(UDP_FRAGMENT_HEADER, 4);
+    put(sequence, 4);
+    put(index, 2);
+    put(count, 2);
+    put(offset, 4);
+    put(size, 4);
+}
+
+void UdpFrameAssembler::Reset()
+{
+    for (auto& slot : _slots)
+        slot.active = false;
+    _hasLast = false;
+}
+
+// FindSlot
+//
+// The frame a fragment belongs to, starting it if it's new. A new frame takes a free slot or the older
+// frame's; one older than both frames in progress would only be evicted in turn, so it's late.
+
+UdpFrameAssembler::Slot * UdpFrameAssembler::FindSlot(uint32_t sequence, uint32_t size, uint16_t count, Result & result)
+{
+    Slot * pFree   = nullptr;
+    Slot * pOldest = nullptr;
+
+    for (auto& slot : _slots)
+    {
+        if (!slot.active)
+        {
+            pFree = &slot;
+            continue;
+        }
+        if (slot.sequence == sequence)
+        {
+            if (slot.size == size && slot.count == count)
+                return &slot;
+
+            result = Result::Malformed;
+            return nullptr;
+        }
+        if (!pOldest || IsNewer(pOldest->sequence, slot.sequence))
+            pOldest = &slot;
+    }
+
+    Slot * pSlot = pFree;
+    if (!pSlot)
+    {
+        if (!IsNewer(sequence, pOldest->sequence))
+        {
+            result = Result::Late;
+            return nullptr;
+        }
+        debugV("Abandoning UDP frame %lu with %u of %u fragments", (unsigned long)pOldest->sequence, pOldest->received, pOldest->count);
+        pSlot = pOldest;
+    }
+
+    pSlot->active   = true;
+    pSlot->sequence = sequence;
+    pSlot->size     = size;
+    pSlot->count    = count;
+    pSlot->received = 0;
+    pSlot->bytes    = 0;
+    pSlot->have.fill(0);
+    return pSlot;
+}
+
+UdpFrameAssembler::Result UdpFrameAssembler::Accept(const uint8_t * pDatagram, size_t cbDatagram)
+{
+    if (cbDatagram < UDP_FRAGMENT_HEADER_SIZE || DWORDFromMemory(&pDatagram[0]) != UDP_FRAGMENT_HEADER)
+    {
+        Count(_malformedDatagrams);
+        return Result::Malformed;
+    }
+
+    const uint32_t sequence = DWORDFromMemory(&pDatagram[4]);
+    const uint16_t index    = WORDFromMemory(&pDatagram[8]);
+    const uint16_t count    = WORDFromMemory(&pDatagram[10]);
+    const uint32_t offset   = DWORDFromMemory(&pDatagram[12]);
+    const uint32_t size     = DWORDFromMemory(&pDatagram[16]);
+    const size_t   cbData   = cbDatagram - UDP_FRAGMENT_HEADER_SIZE;
+
+    if (count == 0 || count > kMaxFragments || index >= count ||
+        size == 0 || size > _maxPacketSize || offset > size || cbData > size - offset)
+    {
+        debugW("Malformed UDP fragment: frame=%lu index=%u count=%u offset=%lu size=%lu bytes=%zu",
+               (unsigned long)sequence, index, count, (unsigned long)offset, (unsigned long)size, cbData);
+        Count(_malformedDatagrams);
+        return Result::Malformed;
+    }
+
+    // A sequence well behind everything seen is a sender that restarted, not a straggler
+
+    auto farBehind = [sequence](uint32_t than) { return static_cast<int32_t>(than - sequence) > static_cast<int32_t>(kResyncWindow); };
+
+    bool restarted = _hasLast && farBehind(_lastSequence);
+    for (const auto& slot : _slots)
+        restarted = restarted || (slot.active && farBehind(slot.sequence));
+
+    if (restarted)
+    {
+        debugI("UDP frame sequence went back to %lu, starting over", (unsigned long)sequence);
+        Reset();
+    }
+
+    if (_hasLast && !IsNewer(sequence, _lastSequence))
+    {
+        Count(_lateFragments);
+        return Result::Late;
+    }
+
+    Result result = Result::Incomplete;
+    Slot * pSlot = FindSlot(sequence, size, count, result);
+    if (!pSlot)
+    {
+        Count(result == Result::Late ? _lateFragments : _malformedDatagrams);
+        return result;
+    }
+
+    uint32_t& word = pSlot->have[index / 32];
+    const uint32_t bit = 1u << (index % 32);
+    if (word & bit)
+    {
+        Count(_duplicateFragments);
+        return Result::Duplicate;
+    }
+
+    memcpy(pSlot->packet.get() + offset, pDatagram + UDP_FRAGMENT_HEADER_SIZE, cbData);
+    word |= bit;
+    pSlot->received++;
+    pSlot->bytes += cbData;
+
+    if (pSlot->received < pSlot->count)
+        return Result::Incomplete;
+
+    pSlot->active = false;
+    if (pSlot->bytes != pSlot->size)
+    {
+        debugW("UDP frame %lu has all %u fragments but %zu of %lu bytes", (unsigned long)sequence, count, pSlot->bytes, (unsigned long)size);
+        Count(_malformedDatagrams);
+        return Result::Malformed;
+    }
+
+    // Every frame the sender numbered between the last one and this, including one still in
+    // progress behind it, is never going to be shown
+
+    if (_hasLast)
+        Count(_framesDropped, sequence - _lastSequence - 1);
+    for (auto& slot : _slots)
+        if (slot.active && !IsNewer(slot.sequence, sequence))
+            slot.active = false;
+
+    _hasLast      = true;
+    _lastSequence = sequence;
+    _completed    = pSlot - _slots;
+    Count(_framesCompleted);
+    return Result::Complete;
+}
@@ -0,0 +1,226 @@
+//+--------------------------------------------------------------------------
+//
+// File:        udpserver.cpp
+//
+// NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Receives fragmented LED data over UDP; see udpserver.h.
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+#include "byte_utils.h"
+#include "inflater.h"
+#include "nd_network.h"
+#include "socketserver.h"
+#include "taskmgr.h"   // SOCKET_STACK_SIZE / SOCKET_PRIORITY / SOCKET_CORE
+#include "udpserver.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#if UDP_PIXEL_SERVER_ENABLED
+
+namespace
+{
+    constexpr size_t kDatagramBufferSize = std::min<size_t>(UdpServer::kMaxDatagram, UDP_FRAGMENT_HEADER_SIZE + MAXIMUM_PACKET_SIZE);
+}
+
+UdpServer::UdpServer(int port) :
+    _port(port)
+{
+    _pDatagram = make_unique_psram<uint8_t[]>(kDatagramBufferSize);
+    _abOutputBuffer = make_unique_psram<uint8_t[]>(MAXIMUM_PACKET_SIZE + 1);                    // uzlib may touch one byte past the end
+    _pAssembler = make_unique_internal<UdpFrameAssembler>(MAXIMUM_PACKET_SIZE);
+}
+
+// ITaskService hooks
+//
+// Same task settings as the socket server, which this runs alongside. recvfrom() has a one second
+// timeout so the task sees ShouldShutdown() even when nothing is being sent.
+
+ITaskService::TaskConfig UdpServer::GetTaskConfig() const
+{
+    return TaskConfig {
+        "UDP Server Loop",
+        SOCKET_STACK_SIZE,
+        SOCKET_PRIORITY,
+        SOCKET_CORE,
+        1500
+    };
+}
+
+void UdpServer::OnBeforeWaitForStop()
+{
+    release();
+}
+
+void UdpServer::release()
+{
+    int fd = _socket_fd.exchange(-1);
+    if (fd >= 0)
+        close(fd);
+}
+
+bool UdpServer::begin()
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+    {
+        debugE("UDP socket error\n");
+        return false;
+    }
+
+    int opt = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)))
+    {
+        debugE("setsockopt SO_REUSEADDR failed on UDP socket %d: %s (%d)", fd, strerror(errno), errno);
+        close(fd);
+        return false;
+    }
+
+    struct timeval to;
+    to.tv_sec = 1;
+    to.tv_usec = 0;
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to)) < 0)
+    {
+        debugE("Unable to set read timeout on UDP socket %d", fd);
+        close(fd);
+        return false;
+    }
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(_port);
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0)
+    {
+        debugE("bind failed on UDP port %d, socket %d: %s (%d)", _port, fd, strerror(errno), errno);
+        close(fd);
+        return false;
+    }
+
+    // Whatever was half assembled before is from a sender that has since moved on
+    _pAssembler->Reset();
+
+    _socket_fd.store(fd);
+    debugI("UDP server %d listening on port %d", fd, _port);
+    return true;
+}
+
+// ProcessPacket
+//
+// A compressed packet is expanded whole, since it's already all here, and what it held is processed
+// like any other packet
+
+bool UdpServer::ProcessPacket(allocated_unique_ptr<uint8_t []> & packet, size_t cbPacket)
+{
+    if (cbPacket >= COMPRESSED_HEADER_SIZE && DWORDFromMemory(&packet[0]) == COMPRESSED_HEADER)
+    {
+        const uint32_t compressedSize = DWORDFromMemory(&packet[4]);
+        const uint32_t expandedSize   = DWORDFromMemory(&packet[8]);
+
+        if (compressedSize != cbPacket - COMPRESSED_HEADER_SIZE || expandedSize > MAXIMUM_PACKET_SIZE)
+        {
+            debugE("Compressed UDP packet sizes are invalid: compressed=%lu expanded=%lu packet=%zu",
+                   (unsigned long)compressedSize, (unsigned long)expandedSize, cbPacket);
+            return false;
+        }
+        if (!Inflater::DecompressBuffer(&packet[COMPRESSED_HEADER_SIZE], compressedSize, _abOutputBuffer.get(), expandedSize))
+            return false;
+
+        return ProcessIncomingData(_abOutputBuffer, expandedSize);
+    }
+
+    // Delta frames need every frame before them, which UDP doesn't promise; a batch stands alone
+    const uint16_t command16 = cbPacket >= sizeof(uint16_t) ? WORDFromMemory(&packet[0]) : 0;
+    if (command16 != WIFI_COMMAND_PIXELDATA64 && command16 != WIFI_COMMAND_PIXELBATCH64 && command16 != WIFI_COMMAND_PEAKDATA)
+    {
+        debugW("Command %u is not accepted over UDP", command16);
+        return false;
+    }
+    return ProcessIncomingData(packet, cbPacket);
+}
+
+// UdpServer::Run
+//
+// Opens the socket whenever WiFi is up and feeds every datagram to the assembler, processing each
+// frame as it completes.
+
+void UdpServer::Run()
+{
+    while (!ShouldShutdown())
+    {
+        if (!nd_network::IsWiFiConnected())
+        {
+            delay(500);
+            continue;
+        }
+
+        release();
+        if (!begin())
+        {
+            debugE("Failed to start UDP server, retrying in 5 seconds...");
+            delay(5000);
+            continue;
+        }
+
+        while (!ShouldShutdown())
+        {
+            const int fd = _socket_fd.load();
+            if (fd < 0)
+                break;
+
+            const int cbRead = recvfrom(fd, _pDatagram.get(), kDatagramBufferSize, 0, nullptr, nullptr);
+            if (cbRead < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    if (!nd_network::IsWiFiConnected())
+                        break;
+                    continue;
+                }
+                debugE("UDP server %d failed to receive: %s (%d)", fd, strerror(errno), errno);
+                break;
+            }
+
+            if (_pAssembler->Accept(_pDatagram.get(), cbRead) == UdpFrameAssembler::Result::Complete)
+            {
+                if (!ProcessPacket(_pAssembler->Packet(), _pAssembler->PacketSize()))
+                    debugW("UDP frame %lu was not processed", (unsigned long)_pAssembler->PacketSequence());
+            }
+        }
+        delay(500);
+    }
+
+    release();
+}
+
+#endif
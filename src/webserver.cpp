@@ -44,8 +44,10 @@
 #include "deviceconfig.h"
 #include "effectmanager.h"
 #include "effects.h"
+#include "frametiming.h"
 #include "gfxbase.h"
 #include "improvserial.h"
+#include "polarlut.h"
 #include "soundanalyzer.h"
 #include "systemcontainer.h"
 #include "taskmgr.h"
@@ -367,11 +369,50 @@ void CWebServer::GetStatistics(AsyncWebServerRequest * pRequest, StatisticsType
         j["DMA_MIN"]               = heap_caps_get_largest_free_block(MALLOC_CAP_DMA);
         j["PSRAM_FREE"]            = ESP.getFreePsram();
         j["PSRAM_MIN"]             = ESP.getMinFreePsram();
+        j["POLAR_LUT_BYTES"]       = PolarLUT::BytesInUse();
         auto& taskManager = g_ptrSystem->GetTaskManager();
 
         j["CPU_USED"]              = taskManager.GetCPUUsagePercent();
         j["CPU_USED_CORE0"]        = taskManager.GetCPUUsagePercent(0);
         j["CPU_USED_CORE1"]        = taskManager.GetCPUUsagePercent(1);
+
+        // Render loop stage latencies: p50/p95/p99 in microseconds over every frame since boot or the CLI's
+        // "timings reset", e.g. FRAME_LOCAL_DRAW_P99
+        for (size_t i = 0; i < static_cast<size_t>(RenderStage::Count); i++)
+        {
+            const auto stage = static_cast<RenderStage>(i);
+            const auto& histogram = g_FrameTimings.Stage(stage);
+            const String prefix = String("FRAME_") + FrameTimings::StageName(stage);
+
+            j[prefix + "_P50"] = histogram.Percentile(50);
+            j[prefix + "_P95"] = histogram.Percentile(95);
+            j[prefix + "_P99"] = histogram.Percentile(99);
+        }
+
+        // Incoming WiFi frames: queue depth and the late and dropped counts summed over the channels,
+        // and channel 0's playout estimates
+        if (g_ptrSystem->HasBufferManagers())
+        {
+            size_t depth = 0;
+            uint32_t late = 0, dropped = 0, overwritten = 0;
+            for (const auto& bufferManager : g_ptrSystem->GetBufferManagers())
+            {
+                depth   += bufferManager.Depth();
+                late    += bufferManager.Scheduler().LateFrames();
+                dropped += bufferManager.Scheduler().DroppedFrames();
+                overwritten += bufferManager.Scheduler().OverwrittenFrames();
+            }
+
+            const auto& scheduler = g_ptrSystem->GetBufferManagers()[0].Scheduler();
+            j["WIFI_BUFFER_DEPTH"]     = depth;
+            j["WIFI_FRAMES_LATE"]      = late;
+            j["WIFI_FRAMES_DROPPED"]   = dropped;
+            j["WIFI_FRAMES_OVERWRITTEN"] = overwritten;
+            j["WIFI_PLAYOUT_DELAY_US"] = scheduler.PlayoutDelay();
+            j["WIFI_JITTER_US"]        = scheduler.Jitter();
+            j["WIFI_CLOCK_DRIFT_PPM"]  = scheduler.ClockDriftPPM();
+            j["WIFI_CLOCK_SYNCED"]     = scheduler.IsSenderClockTrusted();
+        }
     }
 
     AddCORSHeaderAndSendResponse(pRequest, response);
@@ -36,6 +36,8 @@
 
 #include "deviceconfig.h"
 #include "effectmanager.h"
+#include "frametiming.h"
+#include "outputservice.h"
 #include "pixelformat.h"
 #include "systemcontainer.h"
 #include "values.h"
@@ -77,36 +79,64 @@ namespace
     constexpr uint8_t kDefaultAmbientWw = NIGHTDRIVER_DEFAULT_AMBIENT_WW;
     constexpr uint8_t kDefaultWhiteExtractRatio = SK6812_WHITE_EXTRACT_RATIO;
 
-    uint32_t EstimateRGBUnscaledPowerMw(const CRGB* leds, size_t ledCount)
+    // WS281X_POWER_FROM_PACK: 1 limits each frame's brightness by what the pack kernels
+    // summed as they packed the last frame shown, instead of a pass over every channel's
+    // pixels before Show(). 0 is that pass, which is exact for the frame itself.
+    #ifndef WS281X_POWER_FROM_PACK
+        #define WS281X_POWER_FROM_PACK 1
+    #endif
+    // WS281X_POWER_CORRECTION: with WS281X_POWER_FROM_PACK, also estimate this frame from
+    // every WS281X_POWER_SAMPLE_STRIDE-th pixel and limit by the higher of the two, so a
+    // frame that jumps from dark to bright isn't shown over the limit for a frame first
+    #ifndef WS281X_POWER_CORRECTION
+        #define WS281X_POWER_CORRECTION 1
+    #endif
+    #ifndef WS281X_POWER_SAMPLE_STRIDE
+        #define WS281X_POWER_SAMPLE_STRIDE 32
+    #endif
+
+    // Milliwatts for a frame's channel sums before brightness and fader
+    uint32_t UnscaledPowerMw(const PackSums& sums)
+    {
+        return ((sums.red * kPowerRedMw) >> 8)
+             + ((sums.green * kPowerGreenMw) >> 8)
+             + ((sums.blue * kPowerBlueMw) >> 8)
+             + ((sums.white * kPowerWhiteMw) >> 8)
+             + (kPowerDarkMw * sums.pixels);
+    }
+
+    // Sums taken over every stride-th pixel, scaled up to all ledCount of them
+    PackSums ScaleSample(PackSums sums, size_t stride, size_t ledCount)
     {
-        uint32_t red = 0;
-        uint32_t green = 0;
-        uint32_t blue = 0;
+        sums.red   *= stride;
+        sums.green *= stride;
+        sums.blue  *= stride;
+        sums.white *= stride;
+        sums.pixels = ledCount;
+        return sums;
+    }
 
-        for (size_t i = 0; i < ledCount; ++i)
+    PackSums SumRGB(const CRGB* leds, size_t ledCount, size_t stride)
+    {
+        PackSums sums;
+        for (size_t i = 0; i < ledCount; i += stride)
         {
-            red += leds[i].r;
-            green += leds[i].g;
-            blue += leds[i].b;
+            sums.red += leds[i].r;
+            sums.green += leds[i].g;
+            sums.blue += leds[i].b;
         }
-
-        return ((red * kPowerRedMw) >> 8)
-             + ((green * kPowerGreenMw) >> 8)
-             + ((blue * kPowerBlueMw) >> 8)
-             + (kPowerDarkMw * ledCount);
+        return ScaleSample(sums, stride, ledCount);
     }
 
-    uint32_t EstimateWS281xUnscaledPowerMw(const GFXBase& graphics, size_t ledCount)
+    // The same sums the SK6812 pack kernel takes, from the frame about to be packed
+    PackSums SumWS281x(const GFXBase& graphics, size_t ledCount, size_t stride)
     {
         #if defined(USE_SK6812) && USE_SK6812
-            uint32_t red = 0;
-            uint32_t green = 0;
-            uint32_t blue = 0;
-            uint32_t white = 0;
+            PackSums sums;
             const uint16_t ratio = static_cast<uint16_t>(kDefaultWhiteExtractRatio);
             const uint8_t ambientWhite = PixelFormatHelpers::SaturatingAdd(kDefaultAmbientCw, kDefaultAmbientWw);
 
-            for (size_t i = 0; i < ledCount; ++i)
+            for (size_t i = 0; i < ledCount; i += stride)
             {
                 CRGB color = graphics.leds[i];
                 uint8_t effectWhite = 0;
@@ -123,19 +153,15 @@ namespace
                     color.b -= pull;
                 }
 
-                red += color.r;
-                green += color.g;
-                blue += color.b;
-                white += std::max(PixelFormatHelpers::SaturatingAdd(pull, effectWhite), ambientWhite);
+                sums.red += color.r;
+                sums.green += color.g;
+                sums.blue += color.b;
+                sums.white += std::max(PixelFormatHelpers::SaturatingAdd(pull, effectWhite), ambientWhite);
             }
 
-            return ((red * kPowerRedMw) >> 8)
-                 + ((green * kPowerGreenMw) >> 8)
-                 + ((blue * kPowerBlueMw) >> 8)
-                 + ((white * kPowerWhiteMw) >> 8)
-                 + (kPowerDarkMw * ledCount);
+            return ScaleSample(sums, stride, ledCount);
         #else
-            return EstimateRGBUnscaledPowerMw(graphics.leds, ledCount);
+            return SumRGB(graphics.leds, ledCount, stride);
         #endif
     }
 
@@ -318,20 +344,49 @@ void WS281xGFX::PostProcessFrame(uint16_t localPixelsDrawn, uint16_t wifiPixelsD
         }
     }
 
+    // The power limit comes from what the last frame shown packed, summed by the pack
+    // kernels on their way through it. Until a frame has been shown, or built without
+    // WS281X_POWER_FROM_PACK, this frame's pixels are summed here first instead; with
+    // WS281X_POWER_CORRECTION a sample of them is, and the higher figure wins.
+
     auto& outputManager = g_ptrSystem->GetStripOutputManager();
-    uint32_t unscaledPowerMw = 0;
-    const size_t activeChannelCount = std::min<size_t>(outputManager.GetActiveChannelCount(), NUM_CHANNELS);
-    const size_t activeLEDCount = outputManager.GetActiveLEDCount();
-    for (size_t i = 0; i < activeChannelCount; ++i)
+    PackSums lastSums;
+    const bool fromLastFrame = WS281X_POWER_FROM_PACK && outputManager.GetLastFrameSums(lastSums);
+    uint32_t unscaledPowerMw = fromLastFrame ? UnscaledPowerMw(lastSums) : 0;
+
+    if (!fromLastFrame || WS281X_POWER_CORRECTION)
     {
-        auto& graphics = effectManager.g(i);
-        const size_t ledCount = std::min(activeLEDCount, graphics.GetLEDCount());
-        unscaledPowerMw += EstimateWS281xUnscaledPowerMw(graphics, ledCount);
+        const size_t stride = fromLastFrame ? WS281X_POWER_SAMPLE_STRIDE : 1;
+        const size_t activeChannelCount = std::min<size_t>(outputManager.GetActiveChannelCount(), NUM_CHANNELS);
+        const size_t activeLEDCount = outputManager.GetActiveLEDCount();
+        uint32_t framePowerMw = 0;
+        for (size_t i = 0; i < activeChannelCount; ++i)
+        {
+            auto& graphics = effectManager.g(i);
+            const size_t ledCount = std::min(activeLEDCount, graphics.GetLEDCount());
+            framePowerMw += UnscaledPowerMw(SumWS281x(graphics, ledCount, stride));
+        }
+        unscaledPowerMw = std::max(unscaledPowerMw, framePowerMw);
     }
 
     uint8_t outputBrightness = deviceConfig.GetBrightness();
     outputBrightness = LimitBrightnessForPower(unscaledPowerMw, outputBrightness, g_Values.Fader, deviceConfig.GetPowerLimit());
-    outputManager.Show(g_ptrSystem->GetDevices(), pixelsDrawn, outputBrightness, g_Values.Fader);
+
+    // With OutputService running the frame is copied and shown from the output task while
+    // the next one is drawn; otherwise it's shown here before the render task moves on
+
+    const auto& devices = g_ptrSystem->GetDevices();
+    #if ASYNC_STRIP_OUTPUT
+        const bool posted = g_ptrSystem->HasOutputService()
+                         && g_ptrSystem->GetOutputService().Post(devices, pixelsDrawn, outputBrightness, g_Values.Fader);
+    #else
+        constexpr bool posted = false;
+    #endif
+    if (!posted)
+    {
+        FrameTimings::ScopedStage showStage(g_FrameTimings, RenderStage::Show);
+        outputManager.Show(devices, pixelsDrawn, outputBrightness, g_Values.Fader);
+    }
 
     g_Values.Brite = 100.0 * outputBrightness / 255;
     g_Values.Watts = ScalePowerMw(unscaledPowerMw, outputBrightness, g_Values.Fader) / 1000; // 1000 for mW->W
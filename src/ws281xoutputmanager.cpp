@@ -21,6 +21,8 @@
 #include "ws281xoutputmanager.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
 
 #include <esp_err.h>
@@ -33,8 +35,14 @@
 // supported path. The legacy and driver_ng headers cannot be included in
 // the same translation unit on IDF 5 because they use the name
 // rmt_channel_t for two different types - the legacy as an enum, the new
-// as `struct rmt_channel_t *` - so we include only the one we'll use.
-#if ESP_IDF_VERSION_MAJOR >= 5
+// as `struct rmt_channel_t *` - so we include only the one we'll use. The
+// native host build has no RMT peripheral at all and gets a third backend.
+#if HOST_BUILD
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <driver/gpio.h>
+#elif ESP_IDF_VERSION_MAJOR >= 5
 #include <driver/rmt_tx.h>
 #else
 #if defined(CONFIG_RMT_SUPPRESS_DEPRECATE_WARN)
@@ -71,7 +79,9 @@ public:
     virtual void ReleaseChannel(size_t channelIndex) = 0;
 
     // Queue a frame for transmission on this channel. Implementation is
-    // responsible for any driver-specific error logging.
+    // responsible for any driver-specific error logging. The bytes are read
+    // as they go out, so they must not change until WaitForChannel() has
+    // returned; a pipelined Show() packs into the channel's other buffer.
     virtual void TransmitChannel(size_t channelIndex, const uint8_t* bytes, size_t byteCount, int8_t pin, size_t activeLEDCount) = 0;
 
     // Block until the most recent frame on this channel has finished
@@ -99,13 +109,19 @@ namespace
     // resolution_hz=40MHz on driver_ng). The wait timeout is shared.
     constexpr TickType_t kRmtWaitTimeout = pdMS_TO_TICKS(100);
 
+    // How long a frame of byteCount bytes takes to clock out at 800 kHz
+    constexpr uint64_t WireMicros(size_t byteCount)
+    {
+        return uint64_t(byteCount) * 8 * (kWs2812T0HighNs + kWs2812T0LowNs) / 1000;
+    }
+
     constexpr uint16_t NsToRmtTicks(uint32_t nanoseconds)
     {
         constexpr uint32_t kTickNs = 25;
         return static_cast<uint16_t>((nanoseconds + (kTickNs - 1)) / kTickNs);
     }
 
-#if ESP_IDF_VERSION_MAJOR < 5
+#if !HOST_BUILD && ESP_IDF_VERSION_MAJOR < 5
     // Legacy-only: clock divider model and per-bit rmt_item32_t entries
     // populated from ISR by the translator. driver_ng's bytes-encoder
     // has its own bit-symbol descriptors built inside DriverNgTransport
@@ -186,7 +202,7 @@ namespace
         return str_sprintf("%s failed (%s)", action, esp_err_to_name(error));
     }
 
-#if ESP_IDF_VERSION_MAJOR < 5
+#if !HOST_BUILD && ESP_IDF_VERSION_MAJOR < 5
     // Legacy IDF RMT API (driver/rmt.h). State-free: the channel index *is*
     // the rmt_channel_t value passed to every API call. Only present on
     // IDF 4 because legacy and driver_ng headers can't coexist in the same
@@ -423,9 +439,143 @@ namespace
     };
 #endif // ESP_IDF_VERSION_MAJOR >= 5
 
+#if HOST_BUILD
+    // The WS2812 reset latch: the line held low this long ends a frame. Newer
+    // WS2812B parts need 280us rather than the datasheet's original 50us.
+    constexpr uint64_t kWs2812ResetNanos = 280000;
+
+    // Nanoseconds a frame's bits hold the line, each 1 for T1H + T1L and each
+    // 0 for T0H + T0L, plus the reset latch that lets the next frame start
+    uint64_t WireNanos(const uint8_t* bytes, size_t byteCount)
+    {
+        uint64_t ones = 0;
+        for (size_t i = 0; i < byteCount; ++i)
+            ones += __builtin_popcount(bytes[i]);
+        const uint64_t zeros = uint64_t(byteCount) * 8 - ones;
+        return ones * (kWs2812T1HighNs + kWs2812T1LowNs) + zeros * (kWs2812T0HighNs + kWs2812T0LowNs) + kWs2812ResetNanos;
+    }
+
+    // Host stand-in used by the native nd_bench build. Channels always
+    // configure successfully and frames are accepted and dropped, so the
+    // full PostProcessFrame -> Show -> Pack path still runs and can be timed.
+    //
+    // With wire time simulated, a frame occupies its channel for as long as
+    // the RMT peripheral would take to clock its bits out, and waiting on the
+    // channel sleeps until then. The bytes are checksummed when the frame is
+    // queued and again when it finishes, which catches a Show() that packs
+    // into a buffer still on the wire.
+    //
+    // With capturing on, each frame's bytes are also copied as it's queued,
+    // along with when it started and how long its bits took, so tests can
+    // check exactly what a strip would have been sent.
+    class HostTransport : public ::Transport
+    {
+        using Clock = std::chrono::steady_clock;
+        using WireFrame = WS281xOutputManager::WireFrame;
+
+        struct Wire
+        {
+            const uint8_t* bytes = nullptr;
+            size_t byteCount = 0;
+            uint32_t checksum = 0;
+            Clock::time_point done;
+        };
+
+        std::array<Wire, NUM_CHANNELS> _wires{};
+        std::array<size_t, NUM_CHANNELS> _sequences{};
+        bool _simulateWireTime = false;
+        size_t _framesOverwritten = 0;
+        size_t _captureLimit = 0;
+        Clock::time_point _captureStart;
+        std::vector<WireFrame> _captured;
+
+        static uint32_t Checksum(const uint8_t* bytes, size_t byteCount)
+        {
+            uint32_t hash = 2166136261u;                    // FNV-1a
+            for (size_t i = 0; i < byteCount; ++i)
+                hash = (hash ^ bytes[i]) * 16777619u;
+            return hash;
+        }
+
+        void Finish(size_t channelIndex)
+        {
+            auto& wire = _wires[channelIndex];
+            if (!wire.bytes)
+                return;
+
+            std::this_thread::sleep_until(wire.done);
+            if (Checksum(wire.bytes, wire.byteCount) != wire.checksum)
+                _framesOverwritten++;
+            wire.bytes = nullptr;
+        }
+
+        void Capture(size_t channelIndex, int8_t pin, const uint8_t* bytes, size_t byteCount, Clock::time_point start, uint64_t wireNanos)
+        {
+            const size_t sequence = _sequences[channelIndex]++;
+            if (_captured.size() >= _captureLimit)
+                return;
+
+            const auto startNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(start - _captureStart).count();
+            _captured.push_back({ channelIndex, pin, sequence, static_cast<uint64_t>(startNanos), wireNanos,
+                                  std::vector<uint8_t>(bytes, bytes + byteCount) });
+        }
+
+    public:
+        void SimulateWireTime(bool enabled) { _simulateWireTime = enabled; }
+        size_t GetFramesOverwritten() const { return _framesOverwritten; }
+
+        void CaptureFrames(size_t maxFrames)
+        {
+            _captureLimit = maxFrames;
+            _captureStart = Clock::now();
+            _sequences.fill(0);
+            _captured.clear();
+            _captured.reserve(maxFrames);
+        }
+
+        std::vector<WireFrame> TakeCapturedFrames()
+        {
+            return std::exchange(_captured, {});
+        }
+
+        SuccessResultWithMessage ConfigureChannel(size_t /*channelIndex*/, gpio_num_t /*pin*/, size_t /*byteCount*/) override
+        {
+            return { true, "" };
+        }
+
+        void ReleaseChannel(size_t channelIndex) override
+        {
+            Finish(channelIndex);
+        }
+
+        void TransmitChannel(size_t channelIndex, const uint8_t* bytes, size_t byteCount, int8_t pin, size_t /*activeLEDCount*/) override
+        {
+            if (!_simulateWireTime && !_captureLimit)
+                return;
+
+            // Like the RMT driver, a frame queued behind another goes out when that one is done
+            Finish(channelIndex);
+
+            const auto start = Clock::now();
+            const uint64_t wireNanos = WireNanos(bytes, byteCount);
+            if (_captureLimit)
+                Capture(channelIndex, pin, bytes, byteCount, start, wireNanos);
+            if (_simulateWireTime)
+                _wires[channelIndex] = { bytes, byteCount, Checksum(bytes, byteCount), start + std::chrono::nanoseconds(wireNanos) };
+        }
+
+        void WaitForChannel(size_t channelIndex, int8_t /*pin*/, size_t /*activeLEDCount*/) override
+        {
+            Finish(channelIndex);
+        }
+    };
+#endif // HOST_BUILD
+
     std::unique_ptr<::Transport> CreateTransport()
     {
-#if ESP_IDF_VERSION_MAJOR >= 5
+#if HOST_BUILD
+        return std::make_unique<HostTransport>();
+#elif ESP_IDF_VERSION_MAJOR >= 5
         return std::make_unique<DriverNgTransport>();
 #else
         return std::make_unique<LegacyTransport>();
@@ -433,8 +583,42 @@ namespace
     }
 }
 
+// cctKelvin, ambient white and white-extract ratio defaults, baked in
+// pending the DeviceConfig knobs landing in a follow-up commit. Each can be
+// overridden at build time via a -D in the env's build_src_flags.
+
+#ifndef NIGHTDRIVER_DEFAULT_CCT_KELVIN
+    #define NIGHTDRIVER_DEFAULT_CCT_KELVIN 4000
+#endif
+#ifndef NIGHTDRIVER_DEFAULT_AMBIENT_CW
+    #define NIGHTDRIVER_DEFAULT_AMBIENT_CW 0
+#endif
+#ifndef NIGHTDRIVER_DEFAULT_AMBIENT_WW
+    #define NIGHTDRIVER_DEFAULT_AMBIENT_WW 0
+#endif
+
+// SK6812_WHITE_EXTRACT_RATIO: 0..255, fraction of shared-portion
+// white pulled into the dedicated W LED
+
+#ifndef SK6812_WHITE_EXTRACT_RATIO
+    #define SK6812_WHITE_EXTRACT_RATIO 128
+#endif
+
+// WS281X_OUTPUT_GAMMA: output gamma in tenths (22 = 2.2), applied in the
+// pack scale table at no per-pixel cost. 0 leaves output linear, as effects
+// have always been tuned for.
+
+#ifndef WS281X_OUTPUT_GAMMA
+    #define WS281X_OUTPUT_GAMMA 0
+#endif
+
 namespace
 {
+    constexpr uint16_t kDefaultCctKelvin    = NIGHTDRIVER_DEFAULT_CCT_KELVIN;
+    constexpr uint8_t  kDefaultAmbientCw    = NIGHTDRIVER_DEFAULT_AMBIENT_CW;
+    constexpr uint8_t  kDefaultAmbientWw    = NIGHTDRIVER_DEFAULT_AMBIENT_WW;
+    constexpr uint8_t  kDefaultExtractRatio = SK6812_WHITE_EXTRACT_RATIO;
+
     // Pick the PixelFormat that matches the LED chip on the wire. Currently
     // selected by compile-time flag - eventually this could become a
     // DeviceConfig runtime knob. SK6812 (4-channel RGBW) is the second chip
@@ -445,6 +629,23 @@ namespace
         return std::make_unique<Sk6812Format>();
 #else
         return std::make_unique<Ws2812Format>();
+#endif
+    }
+
+    // The WS281X_OUTPUT_GAMMA curve, or nullptr when output is linear
+    const uint8_t* OutputGamma()
+    {
+#if WS281X_OUTPUT_GAMMA
+        static const auto table = []
+        {
+            std::array<uint8_t, 256> curve{};
+            for (size_t i = 0; i < curve.size(); ++i)
+                curve[i] = static_cast<uint8_t>(powf(i / 255.0f, WS281X_OUTPUT_GAMMA / 10.0f) * 255.0f + 0.5f);
+            return curve;
+        }();
+        return table.data();
+#else
+        return nullptr;
 #endif
     }
 }
@@ -452,9 +653,11 @@ namespace
 // Out-of-line so the unique_ptr<Transport> default-deleter sees the full
 // Transport definition above, and the unique_ptr<PixelFormat> deleter sees
 // the full PixelFormat hierarchy from pixelformat.h.
-WS281xOutputManager::WS281xOutputManager()
-    : _transport(CreateTransport()), _format(CreatePixelFormat())
+WS281xOutputManager::WS281xOutputManager(bool pipelined)
+    : _transport(CreateTransport()), _format(CreatePixelFormat()), _pipelined(pipelined)
 {
+    _packParams.SetWhitePolicy(kDefaultCctKelvin, kDefaultAmbientCw, kDefaultAmbientWw, kDefaultExtractRatio);
+    SelectPackKernel();
 }
 
 WS281xOutputManager::~WS281xOutputManager()
@@ -474,6 +677,32 @@ void WS281xOutputManager::Reset()
     _activeChannelCount = 0;
     _activeLEDCount = 0;
     _colorOrder = DeviceConfig::GetCompiledWS281xColorOrder();
+    SelectPackKernel();
+    ForgetLastFrameSums();
+}
+
+void WS281xOutputManager::SelectPackKernel()
+{
+    // The color order is the only per-frame branch Pack() has; resolving it
+    // here leaves Show() a straight call through _pack
+    _pack = _format->SelectKernel(_colorOrder);
+}
+
+// The last frame's sums describe the old channels after a reconfigure, so the
+// power limiter goes back to estimating until a frame has been shown on the new ones
+
+void WS281xOutputManager::ForgetLastFrameSums()
+{
+    std::lock_guard guard(_sumsMutex);
+    _haveLastSums = false;
+}
+
+bool WS281xOutputManager::GetLastFrameSums(PackSums& sums) const
+{
+    std::lock_guard guard(_sumsMutex);
+    if (_haveLastSums)
+        sums = _lastSums;
+    return _haveLastSums;
 }
 
 SuccessResultWithMessage WS281xOutputManager::RecreateChannel(size_t channelIndex, int8_t pin, size_t ledCount)
@@ -490,7 +719,7 @@ SuccessResultWithMessage WS281xOutputManager::RecreateChannel(size_t channelInde
     if (state.installed)
         ReleaseChannel(channelIndex);
 
-    if (!state.outputBytes || state.byteCount != byteCount)
+    if (!state.outputBytes[0] || state.byteCount != byteCount)
     {
         // The legacy driver DMAs from this buffer (so it MUST live in
         // DMA-capable internal RAM) and driver_ng's non-DMA mode does fine
@@ -500,16 +729,20 @@ SuccessResultWithMessage WS281xOutputManager::RecreateChannel(size_t channelInde
         // path with:
         //   "rmt: Using buffer allocated from psram"  -> ESP_ERR_INVALID_ARG
         // heap_caps_malloc with DMA+INTERNAL pins it correctly for both
-        // drivers, so we use the same allocator either way.
-        auto* mem = static_cast<uint8_t*>(heap_caps_malloc(byteCount,
-                            MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
-        if (!mem)
-            return { false, "failed to allocate DMA-capable WS281x byte buffer" };
-
-        std::fill_n(mem, byteCount, 0);
-        // unique_ptr<uint8_t[]> default deleter calls free(), which is the
-        // correct deallocator for heap_caps_malloc'd memory on ESP-IDF.
-        state.outputBytes.reset(mem);
+        // drivers, so we use the same allocator either way. A pipelined
+        // Show() packs one buffer while the other is on the wire.
+        for (size_t buffer = 0; buffer < (_pipelined ? 2 : 1); ++buffer)
+        {
+            auto* mem = static_cast<uint8_t*>(heap_caps_malloc(byteCount,
+                                MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+            if (!mem)
+                return { false, "failed to allocate DMA-capable WS281x byte buffer" };
+
+            std::fill_n(mem, byteCount, 0);
+            // unique_ptr<uint8_t[]> default deleter calls free(), which is the
+            // correct deallocator for heap_caps_malloc'd memory on ESP-IDF.
+            state.outputBytes[buffer].reset(mem);
+        }
         state.byteCount = byteCount;
     }
 
@@ -538,6 +771,9 @@ void WS281xOutputManager::ReleaseChannel(size_t channelIndex)
         state.installed = false;
     }
 
+    state.inFlight = false;
+    state.back = 0;
+
     if (state.pin >= 0)
     {
         pinMode(state.pin, OUTPUT);
@@ -587,12 +823,14 @@ SuccessResultWithMessage WS281xOutputManager::ApplyConfig(const DeviceConfig& co
     _activeChannelCount = channelCount;
     _activeLEDCount = ledCount;
     _colorOrder = config.GetWS281xColorOrder();
+    SelectPackKernel();
+    ForgetLastFrameSums();
 
     LogRuntimeWS281xConfiguration(config, devices, "apply");
     return { true, "" };
 }
 
-void WS281xOutputManager::Show(const std::vector<std::shared_ptr<GFXBase>>& devices, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader)
+void WS281xOutputManager::ShowPlanes(const ChannelPlanes* channels, size_t channelCount, uint16_t pixelsDrawn, uint8_t brightness, uint8_t fader)
 {
     // The same mutex used by ApplyConfig() keeps live transport mutations from
     // colliding with the draw loop while it is filling buffers or transmitting.
@@ -604,96 +842,146 @@ void WS281xOutputManager::Show(const std::vector<std::shared_ptr<GFXBase>>& devi
 
     const size_t pixelsToShow = std::min(static_cast<size_t>(pixelsDrawn), _activeLEDCount);
 
+    // Brightness and fader go into the scale table once here rather than per pixel
+
+    _packParams.SetScale(brightness, fader, OutputGamma());
+
+    const auto showStartMicros = micros();
+
+    const PackSums sums = _pipelined ? ShowPipelined(channels, channelCount, pixelsToShow)
+                                     : ShowSynchronous(channels, channelCount, pixelsToShow);
+    {
+        std::lock_guard sumsGuard(_sumsMutex);
+        _lastSums = sums;
+        _haveLastSums = true;
+    }
+
+    // Slow is 50ms beyond the time the frame itself takes on the wire, which
+    // a long enough strip can never beat
+    const auto showElapsedMicros = micros() - showStartMicros;
+    if (showElapsedMicros > 50000UL + WireMicros(_activeLEDCount * _format->BytesPerPixel()))
+    {
+        debugW("WS281x runtime show slow: channels=%zu leds=%zu elapsed=%lu us",
+               _activeChannelCount,
+               _activeLEDCount,
+               static_cast<unsigned long>(showElapsedMicros));
+    }
+}
+
+// A channel is shown when it's installed and its planes cover every active LED;
+// planes queued before a reconfigure grew the strip are skipped rather than
+// read past their end.
+
+bool WS281xOutputManager::CanShow(size_t channelIndex, const ChannelPlanes* channels, size_t channelCount) const
+{
+    const auto& state = _channels[channelIndex];
+    return channelIndex < channelCount
+        && state.active
+        && state.installed
+        && channels[channelIndex].leds
+        && channels[channelIndex].ledCount >= _activeLEDCount;
+}
+
+PackSums WS281xOutputManager::ShowPipelined(const ChannelPlanes* channels, size_t channelCount, size_t pixelsToShow)
+{
+    // Each channel is packed into its back buffer while the previous frame may
+    // still be going out of the front one, and starts transmitting as soon as
+    // it's packed, so channel N is on the wire while channel N + 1 is packed.
+    // Nothing waits for the last transmission: the render task goes on to
+    // draw the next frame, and only blocks here if it gets back to a channel
+    // before that channel's wire is free. Strips start one channel's pack
+    // time apart rather than together, which is tens of microseconds.
+
+    PackSums sums;
+    for (size_t channelIndex = 0; channelIndex < _activeChannelCount; ++channelIndex)
+    {
+        auto& state = _channels[channelIndex];
+        auto* output = state.outputBytes[state.back].get();
+        if (!output || !CanShow(channelIndex, channels, channelCount))
+            continue;
+
+        const auto& planes = channels[channelIndex];
+        sums += _pack(output, planes.leds, planes.whites, _activeLEDCount, pixelsToShow, _packParams);
+
+        if (state.inFlight)
+            _transport->WaitForChannel(channelIndex, state.pin, _activeLEDCount);
+
+        _transport->TransmitChannel(channelIndex, output, state.byteCount, state.pin, _activeLEDCount);
+        state.inFlight = true;
+        state.back ^= 1;
+    }
+    return sums;
+}
+
+PackSums WS281xOutputManager::ShowSynchronous(const ChannelPlanes* channels, size_t channelCount, size_t pixelsToShow)
+{
     // First build packed output bytes for every active channel.  The GFX layer
     // owns CRGB frame buffers; the runtime transport owns these temporary-once-
     // per-channel packed bytes that match the selected color order.
 
-    for (size_t channelIndex = 0; channelIndex < _activeChannelCount && channelIndex < devices.size(); ++channelIndex)
+    PackSums sums;
+    for (size_t channelIndex = 0; channelIndex < _activeChannelCount; ++channelIndex)
     {
         auto& state = _channels[channelIndex];
-        if (!state.active || !state.installed || !state.outputBytes)
+        if (!state.outputBytes[0] || !CanShow(channelIndex, channels, channelCount))
             continue;
 
-        const auto& device = devices[channelIndex];
-        auto* output = state.outputBytes.get();
-
-        // Delegate to the chip-specific format. Passes the optional whites
-        // plane (nullptr for plain WS2812 builds; populated by setPixelCCT /
-        // setPixelWhite calls on SK6812+ builds). cctKelvin, ambient white,
-        // and white-extract ratio defaults are baked in here pending the
-        // DeviceConfig knobs landing in a follow-up commit. Each can be
-        // overridden at build time via a -D in the env's build_src_flags.
-
-        #ifndef NIGHTDRIVER_DEFAULT_CCT_KELVIN
-            #define NIGHTDRIVER_DEFAULT_CCT_KELVIN 4000
-        #endif
-        #ifndef NIGHTDRIVER_DEFAULT_AMBIENT_CW
-            #define NIGHTDRIVER_DEFAULT_AMBIENT_CW 0
-        #endif
-        #ifndef NIGHTDRIVER_DEFAULT_AMBIENT_WW
-            #define NIGHTDRIVER_DEFAULT_AMBIENT_WW 0
-        #endif
-
-        // SK6812_WHITE_EXTRACT_RATIO: 0..255, fraction of shared-portion
-        // white pulled into the dedicated W LED
-
-        #ifndef SK6812_WHITE_EXTRACT_RATIO
-            #define SK6812_WHITE_EXTRACT_RATIO 128
-        #endif
-
-        constexpr uint16_t kDefaultCctKelvin   = NIGHTDRIVER_DEFAULT_CCT_KELVIN;
-        constexpr uint8_t  kDefaultAmbientCw   = NIGHTDRIVER_DEFAULT_AMBIENT_CW;
-        constexpr uint8_t  kDefaultAmbientWw   = NIGHTDRIVER_DEFAULT_AMBIENT_WW;
-        constexpr uint8_t  kDefaultExtractRatio = SK6812_WHITE_EXTRACT_RATIO;
-
-        _format->Pack(output,
-                      device->leds,
-                      device->whites,                 // may be nullptr
-                      _activeLEDCount,
-                      pixelsToShow,
-                      brightness, fader,
-                      _colorOrder,
-                      kDefaultCctKelvin,
-                      kDefaultAmbientCw,
-                      kDefaultAmbientWw,
-                      kDefaultExtractRatio);
+        // Passes the optional whites plane (nullptr for plain WS2812 builds;
+        // populated by setPixelCCT / setPixelWhite calls on SK6812+ builds).
+        const auto& planes = channels[channelIndex];
+        sums += _pack(state.outputBytes[0].get(), planes.leds, planes.whites, _activeLEDCount, pixelsToShow, _packParams);
     }
 
-    const auto showStartMicros = micros();
-
     // Queue every active channel first, then wait for completion in a second
     // pass. This keeps all strips in the same frame as closely aligned as the
     // RMT API allows.
 
-    for (size_t channelIndex = 0; channelIndex < _activeChannelCount && channelIndex < devices.size(); ++channelIndex)
+    for (size_t channelIndex = 0; channelIndex < _activeChannelCount; ++channelIndex)
     {
         auto& state = _channels[channelIndex];
-        if (!state.active || !state.installed || !state.outputBytes)
+        if (!state.outputBytes[0] || !CanShow(channelIndex, channels, channelCount))
             continue;
 
-        _transport->TransmitChannel(channelIndex, state.outputBytes.get(), state.byteCount, state.pin, _activeLEDCount);
+        _transport->TransmitChannel(channelIndex, state.outputBytes[0].get(), state.byteCount, state.pin, _activeLEDCount);
     }
 
     // The transmit wait is also where live reconfiguration pressure tends to
     // show up first, so failures here are logged separately from the queue step.
 
-    for (size_t channelIndex = 0; channelIndex < _activeChannelCount && channelIndex < devices.size(); ++channelIndex)
+    for (size_t channelIndex = 0; channelIndex < _activeChannelCount; ++channelIndex)
     {
         auto& state = _channels[channelIndex];
-        if (!state.active || !state.installed)
+        if (!state.outputBytes[0] || !CanShow(channelIndex, channels, channelCount))
             continue;
 
         _transport->WaitForChannel(channelIndex, state.pin, _activeLEDCount);
     }
+    return sums;
+}
 
-    const auto showElapsedMicros = micros() - showStartMicros;
-    if (showElapsedMicros > 50000UL)
-    {
-        debugW("WS281x runtime show slow: channels=%zu leds=%zu elapsed=%lu us",
-               _activeChannelCount,
-               _activeLEDCount,
-               static_cast<unsigned long>(showElapsedMicros));
-    }
+#if HOST_BUILD
+void WS281xOutputManager::SimulateWireTime(bool enabled)
+{
+    std::lock_guard guard(WS281xGFX::TransportMutex());
+    static_cast<HostTransport&>(*_transport).SimulateWireTime(enabled);
+}
+
+size_t WS281xOutputManager::GetFramesOverwrittenOnWire() const
+{
+    return static_cast<const HostTransport&>(*_transport).GetFramesOverwritten();
+}
+
+void WS281xOutputManager::CaptureFrames(size_t maxFrames)
+{
+    std::lock_guard guard(WS281xGFX::TransportMutex());
+    static_cast<HostTransport&>(*_transport).CaptureFrames(maxFrames);
+}
+
+std::vector<WS281xOutputManager::WireFrame> WS281xOutputManager::TakeCapturedFrames()
+{
+    std::lock_guard guard(WS281xGFX::TransportMutex());
+    return static_cast<HostTransport&>(*_transport).TakeCapturedFrames();
 }
+#endif
 
 #endif
@@ -0,0 +1,68 @@
+#--------------------------------------------------------------------------
+#
+# File:        native_bench.py
+#
+# NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+#
+# This file is part of the NightDriver software project.
+#
+#    NightDriver is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    NightDriver is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Nightdriver.  It is normally found in copying.txt
+#    If not, see <https://www.gnu.org/licenses/>.
+#
+# Description:
+#
+#    PlatformIO pre-build script for [env:native]. It names the program
+#    nd_bench, applies the matrix size from ND_MATRIX_WIDTH/ND_MATRIX_HEIGHT
+#    (default 64x32), links pthreads, and drops the library sources that
+#    only make sense on a microcontroller (SPI/I2C displays and buses).
+#
+import os
+
+Import("env")
+
+DEFAULT_WIDTH = 64
+DEFAULT_HEIGHT = 32
+
+# Library sources that talk to SPI/I2C hardware; nothing in the render core
+# calls them, and they don't compile without the real Arduino core.
+HARDWARE_ONLY_SOURCES = (
+    "Adafruit_SPITFT.cpp",
+    "Adafruit_GrayOLED.cpp",
+)
+
+
+def read_dimension(name, default):
+    value = os.environ.get(name, "").strip()
+    if not value:
+        return default
+    if not value.isdigit() or int(value) <= 0:
+        raise SystemExit(f"native_bench.py: {name} must be a positive integer, got '{value}'")
+    return int(value)
+
+
+def skip_hardware_source(node):
+    if os.path.basename(node.get_path()) in HARDWARE_ONLY_SOURCES:
+        return None
+    return node
+
+
+width = read_dimension("ND_MATRIX_WIDTH", DEFAULT_WIDTH)
+height = read_dimension("ND_MATRIX_HEIGHT", DEFAULT_HEIGHT)
+
+print(f"nd_bench: {width}x{height} matrix")
+
+env.Replace(PROGNAME="nd_bench")
+env.Append(CPPDEFINES=[("MATRIX_WIDTH", width), ("MATRIX_HEIGHT", height)])
+env.Append(LINKFLAGS=["-pthread"])
+env.AddBuildMiddleware(skip_hardware_source)
@@ -16,6 +16,7 @@ import time
 import struct
 import threading
 import queue
+import colorsys
 
 import os
 
@@ -407,6 +408,205 @@ class ColorClient:
         if self.verbose: print(f"capture_frames: Exiting. Total frames captured: {self.frames_captured}, Total frames in error: {self.frames_in_error}")
         return frames
 
+class SocketResponse:
+    """
+    The status a NightDriver device's SocketServer sends back after every frame. Older firmware
+    sends only the first 72 bytes; size says how many there are.
+    """
+    BASE = struct.Struct('<IQIdddddIIII')
+    FLOW = struct.Struct('<ddIIIiI')            # Flow-control fields, after the base ones
+
+    def __init__(self, data):
+        (self.size, self.sequence, self.flash_version, self.current_clock, self.oldest_packet,
+         self.newest_packet, self.brightness, self.wifi_signal, self.buffer_size, self.buffer_pos,
+         self.fps_drawing, self.watts) = self.BASE.unpack_from(data)
+
+        self.has_flow_control = len(data) >= self.BASE.size + self.FLOW.size
+        if self.has_flow_control:
+            (self.oldest_due, self.newest_due, self.dropped_frames, self.overwritten_frames,
+             self.late_frames, self.playout_delay, self.channel) = self.FLOW.unpack_from(data, self.BASE.size)
+        else:
+            self.oldest_due = self.newest_due = 0.0
+            self.dropped_frames = self.overwritten_frames = self.late_frames = self.playout_delay = self.channel = 0
+
+
+class FlowControl:
+    """
+    Paces a sender from the device's responses. The send rate creeps up towards the rate asked for
+    while every frame is being shown, and backs off to what the device is drawing whenever it drops
+    frames: either a full queue pushed one out, or the device skipped frames that came due together
+    because they arrived faster than it draws. A queue running close to full counts as a warning.
+    """
+    INCREASE_FPS = 0.5                          # Gained each second while nothing is lost
+    DECREASE = 0.8                              # Rate kept when frames are lost
+    HIGH_WATER = 0.75                           # Fraction of the queue that's too full
+
+    def __init__(self, fps, min_fps=1.0):
+        self.max_fps = fps
+        self.min_fps = min(min_fps, fps)
+        self.fps = fps
+        self.last = None
+        self.backoffs = 0
+
+    @property
+    def interval(self):
+        return 1.0 / self.fps
+
+    def update(self, response):
+        last, self.last = self.last, response
+        if last is None or not response.has_flow_control:
+            return
+
+        overwritten = (response.overwritten_frames - last.overwritten_frames) & 0xFFFFFFFF
+        skipped = ((response.dropped_frames - last.dropped_frames) & 0xFFFFFFFF) - overwritten
+        full = response.buffer_size and response.buffer_pos >= response.buffer_size * self.HIGH_WATER
+        drawing = response.fps_drawing or self.fps
+
+        if overwritten or skipped > 0:
+            # Back off to the rate the device is drawing at, but by no more than two steps at once
+            self.fps = min(self.fps * self.DECREASE, max(drawing, self.fps * self.DECREASE * self.DECREASE))
+            self.backoffs += 1
+        elif full:
+            # Let the queue drain a little below the rate it's emptied at
+            self.fps = min(self.fps, drawing * 0.95)
+        else:
+            self.fps += self.INCREASE_FPS * self.interval
+
+        self.fps = max(self.min_fps, min(self.max_fps, self.fps))
+
+
+class PixelStreamer:
+    """
+    Sends frames to a NightDriver device's SocketServer (port 49152) as WIFI_COMMAND_PIXELDATA64
+    packets, or WIFI_COMMAND_PIXELBATCH64 ones for several channels at once, reading the response to
+    each and pacing itself from them with a FlowControl.
+    """
+    WIFI_COMMAND_PIXELDATA64 = 3
+    WIFI_COMMAND_PIXELBATCH64 = 6
+    HEADER = struct.Struct('<HHIQQ')            # command, channel mask or entry count, LEDs, seconds, microseconds
+    BATCH_ENTRY = struct.Struct('<II')          # pixel offset, LEDs
+
+    def __init__(self, host, port=49152, fps=30.0, verbose=False):
+        self.host = host
+        self.port = port
+        self.verbose = verbose
+        self.flow = FlowControl(fps)
+        self.sock = None
+        self.pending = b''
+        self.frames_sent = 0
+        self.responses = 0
+
+    def __enter__(self):
+        self.sock = socket.create_connection((self.host, self.port), timeout=5.0)
+        self.sock.setblocking(False)
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        if self.sock:
+            self.sock.close()
+
+    def _read_responses(self):
+        try:
+            while True:
+                chunk = self.sock.recv(4096)
+                if not chunk:
+                    raise ConnectionError("device closed the connection")
+                self.pending += chunk
+        except BlockingIOError:
+            pass
+
+        while len(self.pending) >= 4:
+            size = struct.unpack_from('<I', self.pending)[0]
+            if size < SocketResponse.BASE.size:
+                raise ConnectionError(f"response of {size} bytes is too small")
+            if len(self.pending) < size:
+                break
+            response = SocketResponse(self.pending[:size])
+            self.pending = self.pending[size:]
+            self.responses += 1
+            self.flow.update(response)
+            if self.verbose:
+                print(f"PixelStreamer: depth {response.buffer_pos}/{response.buffer_size}, due {response.oldest_due:+.3f}..{response.newest_due:+.3f}s, "
+                      f"dropped {response.dropped_frames} ({response.overwritten_frames} full), late {response.late_frames}, "
+                      f"drawing {response.fps_drawing}fps, sending {self.flow.fps:.1f}fps")
+
+    def send_frame(self, pixels, channel=1, stamp=None):
+        """
+        Sends one frame of RGB bytes, stamped with stamp (seconds on the sender's clock) or now.
+        """
+        stamp = time.time() if stamp is None else stamp
+        seconds, micros = divmod(int(stamp * 1000000), 1000000)
+        self.sock.sendall(self.HEADER.pack(self.WIFI_COMMAND_PIXELDATA64, channel, len(pixels) // 3, seconds, micros) + bytes(pixels))
+        self.frames_sent += 1
+
+    def send_batch(self, frames, stamp=None):
+        """
+        Sends a frame for each of channels 0..len(frames)-1 in one packet, shown together. An empty
+        or None frame leaves its channel alone, and frames that are the same object are sent once.
+        """
+        stamp = time.time() if stamp is None else stamp
+        seconds, micros = divmod(int(stamp * 1000000), 1000000)
+
+        table, data, offsets = b'', bytearray(), {}
+        for pixels in frames:
+            if not pixels:
+                table += self.BATCH_ENTRY.pack(0, 0)
+                continue
+            if id(pixels) not in offsets:
+                offsets[id(pixels)] = len(data) // 3
+                data += pixels
+            table += self.BATCH_ENTRY.pack(offsets[id(pixels)], len(pixels) // 3)
+
+        header = self.HEADER.pack(self.WIFI_COMMAND_PIXELBATCH64, len(frames), len(data) // 3, seconds, micros)
+        self.sock.sendall(header + table + bytes(data))
+        self.frames_sent += 1
+
+    def stream(self, frame_source, duration_seconds, channel=1, batch_channels=0):
+        """
+        Sends frame_source(n) for duration_seconds, as fast as the device's responses allow: to the
+        channel mask, or to each of channels 0..batch_channels-1 in one batch if batch_channels is set.
+        """
+        start = next_due = time.time()
+        while time.time() - start < duration_seconds:
+            self._read_responses()
+            now = time.time()
+            if now < next_due:
+                time.sleep(min(next_due - now, 0.005))
+                continue
+
+            if batch_channels:
+                self.send_batch([frame_source(self.frames_sent)] * batch_channels)
+            else:
+                self.send_frame(frame_source(self.frames_sent), channel)
+            next_due = max(next_due + self.flow.interval, now - self.flow.interval)
+
+        self._read_responses()
+        return self.flow.last
+
+
+def stream_test_pattern(host, duration_seconds, leds, fps, channel=1, batch_channels=0, verbose=False):
+    """
+    Streams a moving rainbow to the device, pacing from its responses, and reports how it went.
+    """
+    def frame(n):
+        pixels = bytearray()
+        for i in range(leds):
+            r, g, b = colorsys.hsv_to_rgb(((i + n) % 256) / 256.0, 1.0, 1.0)
+            pixels += bytes((int(r * 255), int(g * 255), int(b * 255)))
+        return pixels
+
+    with PixelStreamer(host, fps=fps, verbose=verbose) as streamer:
+        last = streamer.stream(frame, duration_seconds, channel, batch_channels)
+
+    print(f"Sent {streamer.frames_sent} frames in {duration_seconds}s, ending at {streamer.flow.fps:.1f}fps after {streamer.flow.backoffs} backoffs")
+    if last is None:
+        print("No response from the device.")
+    elif not last.has_flow_control:
+        print("Firmware doesn't report flow control; sent at a fixed rate.")
+    else:
+        print(f"Device: drawing {last.fps_drawing}fps, queue {last.buffer_pos}/{last.buffer_size}, "
+              f"dropped {last.dropped_frames} ({last.overwritten_frames} from a full queue), late {last.late_frames}")
+
 def create_animated_gif(frames, output_filename, frame_duration=100, scale=None, verbose=False):
     """
     Creates an animated GIF from a list of frames.
@@ -970,6 +1170,11 @@ def main():
     parser.add_argument("--restore", metavar="FILENAME", help="Restore the device configuration from a JSON file.")
     parser.add_argument("--generate-gallery", action="store_true", help="Generate an HTML gallery from captured GIFs.")
     parser.add_argument("--mapping", type=str, default="auto", choices=["auto", "row-major", "column-major", "serpentine", "spectrum"], help="Specify pixel mapping (auto, row-major, column-major, serpentine, spectrum). Default: auto.")
+    parser.add_argument("--stream", type=float, metavar="SECONDS", help="Stream a test pattern to the device's socket server, pacing from its responses.")
+    parser.add_argument("--leds", type=int, default=1024, help="LEDs per streamed frame (default: 1024).")
+    parser.add_argument("--channel", type=int, default=1, help="Channel mask for streamed frames (default: 1).")
+    parser.add_argument("--fps", type=float, default=30.0, help="Most frames per second to stream (default: 30).")
+    parser.add_argument("--batch-channels", type=int, default=0, metavar="N", help="Stream to channels 0..N-1 as one batch packet per frame instead of to --channel.")
     parser.add_argument("--verbose", action="store_true", help="Enable verbose output for debugging.")
     parser.add_argument("command", nargs="*", help="Optional command: next, prev, or an effect name/index.")
 
@@ -1100,6 +1305,10 @@ def main():
     if args.live_view:
         live_view(args.host, args.hex_layout, verbose=args.verbose, gain=args.preview_gain, scale=args.scale, mapping=args.mapping)
 
+    if args.stream:
+        stream_test_pattern(args.host, args.stream, args.leds, args.fps, channel=args.channel,
+                            batch_channels=args.batch_channels, verbose=args.verbose)
+
     if args.backup:
         backup_configuration(client, args.backup)
 
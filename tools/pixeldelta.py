@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+#--------------------------------------------------------------------------
+#
+# File:        pixeldelta.py
+#
+# NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+#
+# This file is part of the NightDriver software project.
+#
+#    NightDriver is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    NightDriver is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Nightdriver.  It is normally found in copying.txt
+#    If not, see <https://www.gnu.org/licenses/>.
+#
+# Description:
+#
+#    Reference encoder for WIFI_COMMAND_PIXELDELTA64, the socket server's
+#    delta-frame packet. The wire format and the rules the device applies
+#    are described in include/pixeldelta.h; DeltaEncoder below is what a
+#    sender needs, and apply_delta() decodes the way the device does.
+#
+#    Usage:
+#      tools/pixeldelta.py --selftest
+#      tools/pixeldelta.py --write-stream deltas.bin --leds 2048 --frames 300
+#
+#    --write-stream writes a socket stream in which every delta packet is
+#    followed by the same frame as a full WIFI_COMMAND_PIXELDATA64 packet;
+#    "nd_bench --suite delta --capture deltas.bin" replays it through the
+#    device's decoder and checks each delta against the full frame.
+#
+import argparse
+import random
+import struct
+import sys
+
+WIFI_COMMAND_PIXELDATA64 = 3
+WIFI_COMMAND_PIXELDELTA64 = 5
+
+KEYFRAME = 0x0001
+MAX_RUN = 0xFFFF
+
+HEADER = struct.Struct("<HHIQQ")    # command, channel mask, LEDs, seconds, microseconds
+DELTA = struct.Struct("<IHH")       # sequence, flags, run count
+RUN = struct.Struct("<HH")          # unchanged pixels to skip, changed pixels that follow
+
+
+def fail(message):
+    raise SystemExit(f"pixeldelta.py: {message}")
+
+
+def changed_spans(base, frame):
+    """[start, end) pixel spans where frame differs from base, with one-pixel gaps folded in: an
+    unchanged pixel costs 3 bytes to resend, and splitting the run around it costs 4."""
+    spans = []
+    for i in range(len(frame) // 3):
+        if frame[3 * i:3 * i + 3] != base[3 * i:3 * i + 3]:
+            if spans and i - spans[-1][1] <= 1:
+                spans[-1][1] = i + 1
+            else:
+                spans.append([i, i + 1])
+    return spans
+
+
+def encode_runs(base, frame):
+    """The run table and changed pixels that turn base into frame."""
+    runs = []
+    pixels = bytearray()
+    position = 0
+
+    for start, end in changed_spans(base, frame):
+        skip = start - position
+        while skip > MAX_RUN:
+            runs.append((MAX_RUN, 0))
+            skip -= MAX_RUN
+        while start < end:
+            count = min(end - start, MAX_RUN)
+            runs.append((skip, count))
+            pixels += frame[3 * start:3 * (start + count)]
+            skip = 0
+            start += count
+        position = end
+
+    if len(runs) > MAX_RUN:
+        raise ValueError(f"{len(runs)} runs is more than a delta packet can hold")
+    return runs, bytes(pixels)
+
+
+def delta_packet(channel, leds, seconds, micros, sequence, flags, runs, pixels):
+    table = b"".join(RUN.pack(skip, count) for skip, count in runs)
+    return (HEADER.pack(WIFI_COMMAND_PIXELDELTA64, channel, leds, seconds, micros)
+            + DELTA.pack(sequence, flags, len(runs)) + table + pixels)
+
+
+def full_packet(channel, frame, seconds, micros):
+    return HEADER.pack(WIFI_COMMAND_PIXELDATA64, channel, len(frame) // 3, seconds, micros) + bytes(frame)
+
+
+class DeltaEncoder:
+    """Turns a sender's frames into delta packets for one channel mask.
+
+    Frames are bytes of 3 * leds, in the order the device stores its CRGBs. A keyframe, encoded
+    against black, goes out first, every keyframe_interval frames, after resync(), and whenever it
+    would be no bigger than the delta; the device drops deltas that don't follow on from the frame
+    it queued last, so the interval bounds how long a lost frame shows."""
+
+    def __init__(self, leds, channel=1, keyframe_interval=30):
+        if keyframe_interval < 1:
+            raise ValueError("keyframe_interval must be at least 1")
+        self.leds = leds
+        self.channel = channel
+        self.keyframe_interval = keyframe_interval
+        self.sequence = 0
+        self._black = bytes(3 * leds)
+        self._previous = None
+        self._since_keyframe = 0
+
+    def resync(self):
+        """Make the next frame a keyframe, as after reconnecting."""
+        self._previous = None
+
+    def encode(self, frame, seconds, micros):
+        if len(frame) != 3 * self.leds:
+            raise ValueError(f"frame is {len(frame)} bytes, expected {3 * self.leds}")
+
+        key_runs, key_pixels = encode_runs(self._black, frame)
+        flags = KEYFRAME
+        runs, pixels = key_runs, key_pixels
+
+        if self._previous is not None and self._since_keyframe + 1 < self.keyframe_interval:
+            delta_runs, delta_pixels = encode_runs(self._previous, frame)
+            if RUN.size * len(delta_runs) + len(delta_pixels) < RUN.size * len(key_runs) + len(key_pixels):
+                flags = 0
+                runs, pixels = delta_runs, delta_pixels
+
+        self._since_keyframe = 0 if flags & KEYFRAME else self._since_keyframe + 1
+        self._previous = bytes(frame)
+        self.sequence = (self.sequence + 1) & 0xFFFFFFFF
+        return delta_packet(self.channel, self.leds, seconds, micros, self.sequence, flags, runs, pixels)
+
+
+def apply_delta(packet, previous, previous_sequence):
+    """Decode a delta packet as the device does. Returns the new frame and its sequence number, or None
+    when the delta doesn't follow previous_sequence (previous being None means nothing to follow)."""
+    command, _, leds, _, _ = HEADER.unpack_from(packet, 0)
+    sequence, flags, run_count = DELTA.unpack_from(packet, HEADER.size)
+    if command != WIFI_COMMAND_PIXELDELTA64:
+        raise ValueError(f"not a delta packet: command {command}")
+
+    if flags & KEYFRAME:
+        frame = bytearray(3 * leds)
+    elif previous is None or sequence != (previous_sequence + 1) & 0xFFFFFFFF or len(previous) != 3 * leds:
+        return None
+    else:
+        frame = bytearray(previous)
+
+    offset = HEADER.size + DELTA.size
+    data = offset + RUN.size * run_count
+    position = 0
+    for _ in range(run_count):
+        skip, count = RUN.unpack_from(packet, offset)
+        offset += RUN.size
+        position += skip
+        if position + count > leds:
+            raise ValueError("delta runs go past the end of the frame")
+        frame[3 * position:3 * (position + count)] = packet[data:data + 3 * count]
+        data += 3 * count
+        position += count
+
+    if data != len(packet):
+        raise ValueError(f"delta packet is {len(packet)} bytes, runs account for {data}")
+    return bytes(frame), sequence
+
+
+def test_frames(leds, count, seed):
+    """A mix of what deltas are for and what they aren't: a mostly dark frame with a few moving dots,
+    sparse twinkles, and now and then every pixel changing at once."""
+    rng = random.Random(seed)
+    frame = bytearray(3 * leds)
+    for n in range(count):
+        if n % 50 == 49:
+            frame = bytearray(rng.randrange(256) for _ in range(3 * leds))
+        for dot in range(3):
+            i = (n * (dot + 1) * 7) % leds
+            frame[3 * i:3 * i + 3] = bytes((255, 64 * dot, 255 - 64 * dot))
+        for _ in range(leds // 50):
+            i = rng.randrange(leds)
+            frame[3 * i:3 * i + 3] = bytes((0, 0, 0)) if rng.random() < 0.5 else bytes(rng.randrange(256) for _ in range(3))
+        yield bytes(frame)
+
+
+def selftest(leds, frames, interval, seed):
+    rng = random.Random(seed)
+    encoder = DeltaEncoder(leds, keyframe_interval=interval)
+    device, device_sequence = None, 0
+    full_bytes = delta_bytes = lost = resynced = 0
+
+    for n, frame in enumerate(test_frames(leds, frames, seed)):
+        packet = encoder.encode(frame, n // 30, n % 30 * 33333)
+        full_bytes += HEADER.size + len(frame)
+        delta_bytes += len(packet)
+
+        # Lose the odd packet on the way, as a dropped or refused frame would be
+        if n > 0 and rng.random() < 0.03:
+            lost += 1
+            continue
+
+        decoded = apply_delta(packet, device, device_sequence)
+        if decoded is None:
+            if device is not None and device_sequence == encoder.sequence - 1:
+                fail(f"frame {n}: delta refused although it follows on")
+            resynced += 1
+            device = None
+            continue
+
+        device, device_sequence = decoded
+        if device != frame:
+            fail(f"frame {n}: decoded frame differs from the one encoded")
+
+    if lost and not resynced:
+        fail("losing frames never made the decoder wait for a keyframe")
+    print(f"selftest passed: {frames} frames of {leds} LEDs, {lost} lost, {resynced} waited for a keyframe; "
+          f"{delta_bytes} bytes as deltas against {full_bytes} as full frames ({100 * delta_bytes / full_bytes:.1f}%)")
+
+
+def write_stream(path, leds, frames, interval, seed):
+    encoder = DeltaEncoder(leds, keyframe_interval=interval)
+    with open(path, "wb") as f:
+        for n, frame in enumerate(test_frames(leds, frames, seed)):
+            seconds, micros = 100 + n // 30, 1 + n % 30 * 33333
+            f.write(encoder.encode(frame, seconds, micros))
+            f.write(full_packet(encoder.channel, frame, seconds, micros))
+    print(f"Wrote {frames} delta frames of {leds} LEDs, each followed by its full frame, to {path}", file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Reference encoder for NightDriverStrip delta frames")
+    parser.add_argument("--selftest", action="store_true", help="round-trip frames through the encoder and decoder, losing some")
+    parser.add_argument("--write-stream", metavar="FILE", help="write delta frames, each followed by its full frame, for nd_bench --suite delta")
+    parser.add_argument("--leds", type=int, default=2048, help="LEDs per frame (default 2048)")
+    parser.add_argument("--frames", type=int, default=300, help="frames to encode (default 300)")
+    parser.add_argument("--keyframe-interval", type=int, default=30, help="frames between keyframes (default 30)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if not args.selftest and not args.write_stream:
+        parser.error("give --selftest, --write-stream FILE, or both")
+    if args.leds < 1:
+        parser.error("--leds must be at least 1")
+
+    if args.selftest:
+        selftest(args.leds, args.frames, args.keyframe_interval, args.seed)
+    if args.write_stream:
+        write_stream(args.write_stream, args.leds, args.frames, args.keyframe_interval, args.seed)
+
+
+if __name__ == "__main__":
+    main()
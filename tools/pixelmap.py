@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#--------------------------------------------------------------------------
+#
+# File:        pixelmap.py
+#
+# NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+#
+# This file is part of the NightDriver software project.
+#
+#    NightDriver is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    NightDriver is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Nightdriver.  It is normally found in copying.txt
+#    If not, see <https://www.gnu.org/licenses/>.
+#
+# Description:
+#
+#    Builds the binary pixel map (/pixelmap.bin) that GFXBase loads from
+#    SPIFFS, from the same layout JSON the device accepts as
+#    /pixelmap.json. The layout format and the table semantics are
+#    described in include/pixelmap.h; this script follows the same rules
+#    as PixelMap::FromTiles so both paths produce identical tables.
+#
+#    Usage:
+#      tools/pixelmap.py layout.json data/pixelmap.bin
+#      tools/pixelmap.py layout.json --print
+#
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"NDPM"
+VERSION = 1
+UNMAPPED = 0xFFFF
+
+
+def fail(message):
+    raise SystemExit(f"pixelmap.py: {message}")
+
+
+def build_table(layout):
+    width = int(layout["width"])
+    height = int(layout["height"])
+    led_count = width * height
+    if led_count == 0 or led_count > UNMAPPED:
+        fail(f"pixel map size {width}x{height} is out of range")
+
+    tiles = layout.get("tiles", [])
+    if not tiles:
+        fail("layout has no tiles")
+
+    table = [UNMAPPED] * led_count
+    next_led = 0
+
+    for t, tile in enumerate(tiles):
+        x = tile.get("x", 0)
+        y = tile.get("y", 0)
+        tile_width = tile.get("width", 0)
+        tile_height = tile.get("height", 0)
+        rotation = tile.get("rotation", 0)
+        serpentine = tile.get("serpentine", True)
+
+        if rotation not in (0, 90, 180, 270):
+            fail(f"tile {t}: rotation must be 0, 90, 180 or 270")
+        if tile_width == 0 or tile_height == 0 or x + tile_width > width or y + tile_height > height:
+            fail(f"tile {t} does not fit in the {width}x{height} matrix")
+
+        next_led += tile.get("skip", 0)
+
+        sideways = rotation in (90, 270)
+        columns = tile_height if sideways else tile_width
+        rows = tile_width if sideways else tile_height
+
+        for u in range(columns):
+            for i in range(rows):
+                v = rows - 1 - i if serpentine and (u & 1) else i
+                if rotation == 90:
+                    dx, dy = rows - 1 - v, u
+                elif rotation == 180:
+                    dx, dy = columns - 1 - u, rows - 1 - v
+                elif rotation == 270:
+                    dx, dy = v, columns - 1 - u
+                else:
+                    dx, dy = u, v
+
+                cell = (y + dy) * width + x + dx
+                if table[cell] != UNMAPPED:
+                    fail(f"tile {t} overlaps an earlier tile at ({x + dx}, {y + dy})")
+                if next_led >= led_count:
+                    fail(f"layout needs more than the {led_count} LEDs a {width}x{height} matrix has")
+                table[cell] = next_led
+                next_led += 1
+
+    used = set(entry for entry in table if entry != UNMAPPED)
+    spares = (index for index in range(led_count) if index not in used)
+    table = [entry if entry != UNMAPPED else next(spares) for entry in table]
+
+    return width, height, table
+
+
+def to_binary(width, height, table):
+    header = MAGIC + struct.pack("<BBHH", VERSION, 0, width, height)
+    return header + struct.pack(f"<{len(table)}H", *table)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build a NightDriverStrip pixel map from a layout JSON file")
+    parser.add_argument("layout", help="layout JSON, as described in include/pixelmap.h")
+    parser.add_argument("output", nargs="?", help="binary map to write (normally data/pixelmap.bin)")
+    parser.add_argument("--print", action="store_true", help="print the table as a grid of LED indices")
+    args = parser.parse_intermixed_args()
+
+    if not args.output and not args.print:
+        parser.error("give an output file, --print, or both")
+
+    with open(args.layout, "r", encoding="utf-8") as f:
+        width, height, table = build_table(json.load(f))
+
+    if args.print:
+        cell_width = len(str(width * height - 1))
+        for y in range(height):
+            print(" ".join(str(table[y * width + x]).rjust(cell_width) for x in range(width)))
+
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(to_binary(width, height, table))
+        print(f"Wrote {width}x{height} pixel map to {args.output}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
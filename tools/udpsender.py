@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#--------------------------------------------------------------------------
+#
+# File:        udpsender.py
+#
+# NightDriverStrip - (c) 2026 Plummer's Software LLC.  All Rights Reserved.
+#
+# This file is part of the NightDriver software project.
+#
+#    NightDriver is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    NightDriver is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Nightdriver.  It is normally found in copying.txt
+#    If not, see <https://www.gnu.org/licenses/>.
+#
+# Description:
+#
+#    Reference sender for the UDP server. Each WIFI_COMMAND_PIXELDATA64
+#    packet, or its compressed "DAVE" form, is split across datagrams that
+#    each start with the fragment header described in include/udpassembler.h.
+#    FragmentSender below is what a sender needs; the rest sends a test
+#    pattern, optionally losing, duplicating and reordering datagrams on
+#    the way to see how the device copes. The device must be built with
+#    UDP_PIXEL_SERVER_ENABLED=1.
+#
+#    Usage:
+#      tools/udpsender.py 192.168.1.50 --leds 1024 --fps 30 --compress
+#      tools/udpsender.py 127.0.0.1 --frames 300 --loss 2 --reorder 8
+#
+#    The test pattern is the one "nd_bench --suite udp --listen 49152"
+#    checks every frame it receives against, so the two together test the
+#    sender and the device's reassembly end to end on one machine.
+#
+import argparse
+import random
+import socket
+import struct
+import sys
+import time
+import zlib
+
+WIFI_COMMAND_PIXELDATA64 = 3
+
+COMPRESSED_HEADER = 0x44415645                      # "DAVE"
+UDP_FRAGMENT_HEADER = 0x46504455                    # "UDPF"
+
+HEADER = struct.Struct("<HHIQQ")                    # command, channel mask, LEDs, seconds, microseconds
+COMPRESSED = struct.Struct("<IIII")                 # "DAVE", compressed size, expanded size, reserved
+FRAGMENT = struct.Struct("<IIHHII")                 # "UDPF", frame sequence, index, count, offset, packet size
+
+MAX_FRAGMENTS = 1024
+DEFAULT_FRAGMENT = 1400                             # Fragment header and data in one 1500-byte Ethernet MTU
+
+
+def fail(message):
+    raise SystemExit(f"udpsender.py: {message}")
+
+
+def pixel_packet(channel, frame, seconds, micros):
+    return HEADER.pack(WIFI_COMMAND_PIXELDATA64, channel, len(frame) // 3, seconds, micros) + bytes(frame)
+
+
+def compressed_packet(packet):
+    stream = zlib.compress(packet)
+    return COMPRESSED.pack(COMPRESSED_HEADER, len(stream), len(packet), 0) + stream
+
+
+class FragmentSender:
+    """Numbers packets and splits each across datagrams of at most fragment_size bytes of packet."""
+
+    def __init__(self, fragment_size=DEFAULT_FRAGMENT):
+        if fragment_size < 1:
+            raise ValueError("fragment_size must be at least 1")
+        self.fragment_size = fragment_size
+        self.sequence = 0
+
+    def fragments(self, packet):
+        count = max(1, -(-len(packet) // self.fragment_size))
+        if count > MAX_FRAGMENTS:
+            raise ValueError(f"{len(packet)} bytes needs {count} fragments, more than {MAX_FRAGMENTS}")
+
+        self.sequence = (self.sequence + 1) & 0xFFFFFFFF
+        datagrams = []
+        for index in range(count):
+            offset = index * self.fragment_size
+            data = packet[offset:offset + self.fragment_size]
+            datagrams.append(FRAGMENT.pack(UDP_FRAGMENT_HEADER, self.sequence, index, count, offset, len(packet)) + data)
+        return datagrams
+
+
+def test_pixel(frame, i):
+    """The pattern nd_bench checks a received frame against; bytes in the device's CRGB order."""
+    return bytes((((i + frame) * 7) & 0xFF, (i * 3 + frame) & 0xFF, (frame * 5) & 0xFF))
+
+
+def test_frame(sequence, leds):
+    return b"".join(test_pixel(sequence, i) for i in range(leds))
+
+
+class LossyLink:
+    """Loses, duplicates and reorders datagrams the way a bad Wi-Fi link does, before sending them."""
+
+    def __init__(self, sock, address, loss, duplicate, reorder, seed):
+        self.sock = sock
+        self.address = address
+        self.loss = loss
+        self.duplicate = duplicate
+        self.reorder = reorder
+        self.rng = random.Random(seed)
+        self.held = []
+        self.sent = self.lost = 0
+
+    def send(self, datagram):
+        if self.rng.random() < self.loss:
+            self.lost += 1
+            return
+        copies = 2 if self.rng.random() < self.duplicate else 1
+        for _ in range(copies):
+            self.held.append(datagram)
+
+        # Hold up to reorder datagrams and let a random one go first
+        while len(self.held) > self.reorder:
+            self._send(self.held.pop(self.rng.randrange(len(self.held))))
+
+    def flush(self):
+        self.rng.shuffle(self.held)
+        for datagram in self.held:
+            self._send(datagram)
+        self.held = []
+
+    def _send(self, datagram):
+        self.sock.sendto(datagram, self.address)
+        self.sent += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Send a test pattern to a NightDriverStrip device over UDP")
+    parser.add_argument("host", help="device address, or 127.0.0.1 for nd_bench --suite udp --listen")
+    parser.add_argument("--port", type=int, default=49152, help="UDP port (default 49152)")
+    parser.add_argument("--leds", type=int, default=1024, help="LEDs per frame (default 1024)")
+    parser.add_argument("--channel", type=int, default=1, help="channel mask (default 1)")
+    parser.add_argument("--frames", type=int, default=300, help="frames to send (default 300)")
+    parser.add_argument("--fps", type=float, default=30, help="frames per second (default 30)")
+    parser.add_argument("--compress", action="store_true", help="send compressed packets")
+    parser.add_argument("--fragment", type=int, default=DEFAULT_FRAGMENT, help=f"packet bytes per datagram (default {DEFAULT_FRAGMENT})")
+    parser.add_argument("--loss", type=float, default=0, help="percent of datagrams to lose")
+    parser.add_argument("--duplicate", type=float, default=0, help="percent of datagrams to send twice")
+    parser.add_argument("--reorder", type=int, default=0, help="datagrams held back to reorder among (default 0)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.leds < 1:
+        parser.error("--leds must be at least 1")
+    if args.fps <= 0:
+        parser.error("--fps must be positive")
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    link = LossyLink(sock, (args.host, args.port), args.loss / 100, args.duplicate / 100, args.reorder, args.seed)
+    sender = FragmentSender(args.fragment)
+
+    start = time.time()
+    for n in range(args.frames):
+        due = start + n / args.fps
+        time.sleep(max(0, due - time.time()))
+
+        seconds, micros = divmod(int(due * 1000000), 1000000)
+        packet = pixel_packet(args.channel, test_frame(sender.sequence + 1, args.leds), seconds, micros)
+        if args.compress:
+            packet = compressed_packet(packet)
+
+        try:
+            for datagram in sender.fragments(packet):
+                link.send(datagram)
+        except ValueError as e:
+            fail(str(e))
+    link.flush()
+
+    print(f"Sent {args.frames} frames of {args.leds} LEDs in {link.sent} datagrams, {link.lost} lost on purpose", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()